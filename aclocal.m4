@@ -1191,6 +1191,7 @@ m4_include([m4/configure_amgxwrapper.m4])
 m4_include([m4/configure_cuda.m4])
 m4_include([m4/configure_gtest.m4])
 m4_include([m4/configure_petsc.m4])
+m4_include([m4/configure_pthread.m4])
 m4_include([m4/configure_yamlcpp.m4])
 m4_include([m4/libtool.m4])
 m4_include([m4/ltoptions.m4])
@@ -8,6 +8,7 @@
  */
 
 #include <fstream>
+#include <map>
 #include <sstream>
 #include <string>
 
@@ -42,8 +43,20 @@
 PetscErrorCode writeSingleXDMF(const std::string &directory,
                                const std::string &name, const PetscInt &dim,
                                const petibm::type::IntVec1D &n,
-                               const PetscInt &bg, const PetscInt &ed,
-                               const PetscInt &step);
+                               const petibm::type::IntVec1D &steps,
+                               const petibm::type::RealVec1D &times,
+                               const PetscInt &level = 0,
+                               const petibm::type::RealVec2D &coords = {});
+
+PetscErrorCode getSnapshots(const std::string &directory, const PetscInt &bg,
+                            const PetscInt &ed, const PetscInt &step,
+                            const PetscBool &useIndex,
+                            petibm::type::IntVec1D &steps,
+                            petibm::type::RealVec1D &times);
+
+PetscErrorCode getCoarseGrid(const petibm::type::Mesh &mesh, const PetscInt &f,
+                             const PetscInt &level, petibm::type::IntVec1D &n,
+                             petibm::type::RealVec2D &coords);
 
 int main(int argc, char **argv)
 {
@@ -74,17 +87,28 @@ int main(int argc, char **argv)
     CHKERRQ(ierr);
     if (!isSet) step = setting["parameters"]["nsave"].as<PetscInt>();
 
+    // time steps of the snapshots (from the index file, unless a step is
+    // given on the command line)
+    petibm::type::IntVec1D steps;
+    petibm::type::RealVec1D times;
+    ierr = getSnapshots(setting["output"].as<std::string>(), bg, ed, step,
+                        isSet ? PETSC_FALSE : PETSC_TRUE, steps, times);
+    CHKERRQ(ierr);
+
     // u
     ierr = writeSingleXDMF(setting["output"].as<std::string>(), "u",
-                           mesh->dim, mesh->n[0], bg, ed, step); CHKERRQ(ierr);
+                           mesh->dim, mesh->n.row(0), steps, times);
+    CHKERRQ(ierr);
 
     // v
     ierr = writeSingleXDMF(setting["output"].as<std::string>(), "v",
-                           mesh->dim, mesh->n[1], bg, ed, step); CHKERRQ(ierr);
+                           mesh->dim, mesh->n.row(1), steps, times);
+    CHKERRQ(ierr);
 
     // p
     ierr = writeSingleXDMF(setting["output"].as<std::string>(), "p",
-                           mesh->dim, mesh->n[3], bg, ed, step); CHKERRQ(ierr);
+                           mesh->dim, mesh->n.row(3), steps, times);
+    CHKERRQ(ierr);
 
     // wz
     petibm::type::IntVec1D wn(3);
@@ -93,13 +117,13 @@ int main(int argc, char **argv)
     wn[1] = mesh->n[4][1];
     wn[2] = mesh->n[3][2];
     ierr = writeSingleXDMF(setting["output"].as<std::string>(), "wz",
-                           mesh->dim, wn, bg, ed, step); CHKERRQ(ierr);
+                           mesh->dim, wn, steps, times); CHKERRQ(ierr);
 
     if (mesh->dim == 3)
     {
         // w
         ierr = writeSingleXDMF(setting["output"].as<std::string>(), "w",
-                               mesh->dim, mesh->n[2], bg, ed, step);
+                               mesh->dim, mesh->n.row(2), steps, times);
         CHKERRQ(ierr);
 
         // wx
@@ -107,14 +131,34 @@ int main(int argc, char **argv)
         wn[1] = mesh->n[4][1];
         wn[2] = mesh->n[4][2];
         ierr = writeSingleXDMF(setting["output"].as<std::string>(), "wx",
-                               mesh->dim, wn, bg, ed, step); CHKERRQ(ierr);
+                               mesh->dim, wn, steps, times); CHKERRQ(ierr);
 
         // wy
         wn[0] = mesh->n[4][0];
         wn[1] = mesh->n[3][1];
         wn[2] = mesh->n[4][2];
         ierr = writeSingleXDMF(setting["output"].as<std::string>(), "wy",
-                               mesh->dim, wn, bg, ed, step); CHKERRQ(ierr);
+                               mesh->dim, wn, steps, times); CHKERRQ(ierr);
+    }
+
+    // coarsened levels of the velocity components and of the pressure
+    PetscInt nLevels = 0;
+    ierr = PetscOptionsGetInt(nullptr, nullptr, "-lod_levels", &nLevels,
+                              nullptr); CHKERRQ(ierr);
+    for (PetscInt l = 1; l <= nLevels; ++l)
+    {
+        for (PetscInt f = 0; f < 4; ++f)
+        {
+            if (f >= mesh->dim && f < 3) continue;
+
+            petibm::type::IntVec1D ln;
+            petibm::type::RealVec2D coords;
+            ierr = getCoarseGrid(mesh, f, l, ln, coords); CHKERRQ(ierr);
+            ierr = writeSingleXDMF(
+                setting["output"].as<std::string>(),
+                petibm::type::fd2str[petibm::type::Field(f)], mesh->dim, ln,
+                steps, times, l, coords); CHKERRQ(ierr);
+        }
     }
 
     // manually destroy PETSc objects inside the mesh instance
@@ -125,11 +169,87 @@ int main(int argc, char **argv)
     return 0;
 }  // main
 
+PetscErrorCode getCoarseGrid(const petibm::type::Mesh &mesh, const PetscInt &f,
+                             const PetscInt &level, petibm::type::IntVec1D &n,
+                             petibm::type::RealVec2D &coords)
+{
+    PetscFunctionBeginUser;
+
+    n = mesh->n.row(f);
+    coords = petibm::type::RealVec2D(mesh->dim);
+
+    for (PetscInt d = 0; d < mesh->dim; ++d)
+    {
+        coords[d].assign(mesh->coord[f][d], mesh->coord[f][d] + n[d]);
+
+        // same pairing as io::coarsenDMDAVec: a coarse point is located at
+        // the center of the (one or two) fine points it covers
+        for (PetscInt l = 0; l < level; ++l)
+        {
+            PetscInt nc = (n[d] + 1) / 2;
+            for (PetscInt i = 0; i < nc; ++i)
+                coords[d][i] = (2 * i + 1 < n[d])
+                                   ? 0.5 * (coords[d][2 * i] +
+                                            coords[d][2 * i + 1])
+                                   : coords[d][2 * i];
+            coords[d].resize(nc);
+            n[d] = nc;
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // getCoarseGrid
+
+PetscErrorCode getSnapshots(const std::string &directory, const PetscInt &bg,
+                            const PetscInt &ed, const PetscInt &step,
+                            const PetscBool &useIndex,
+                            petibm::type::IntVec1D &steps,
+                            petibm::type::RealVec1D &times)
+{
+    PetscFunctionBeginUser;
+
+    steps.clear();
+    times.clear();
+
+    // the index file lists the time step and the time value of each
+    // snapshot; entries of a restarted run override the previous ones
+    std::ifstream index(directory + "/snapshots.txt");
+    if (useIndex && index.good())
+    {
+        std::map<PetscInt, PetscReal> snapshots;
+        std::string line;
+        while (std::getline(index, line))
+        {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream ss(line);
+            long long ite;
+            double time;
+            if (!(ss >> ite >> time)) continue;
+            if ((ite >= bg) && (ite <= ed)) snapshots[PetscInt(ite)] = time;
+        }
+
+        for (const auto &s : snapshots)
+        {
+            steps.push_back(s.first);
+            times.push_back(s.second);
+        }
+
+        PetscFunctionReturn(0);
+    }
+
+    // no index: snapshots every step time steps
+    for (PetscInt t = bg; t <= ed; t += step) steps.push_back(t);
+
+    PetscFunctionReturn(0);
+}  // getSnapshots
+
 PetscErrorCode writeSingleXDMF(const std::string &directory,
                                const std::string &name, const PetscInt &dim,
                                const petibm::type::IntVec1D &n,
-                               const PetscInt &bg, const PetscInt &ed,
-                               const PetscInt &step)
+                               const petibm::type::IntVec1D &steps,
+                               const petibm::type::RealVec1D &times,
+                               const PetscInt &level,
+                               const petibm::type::RealVec2D &coords)
 {
     PetscErrorCode ierr;
 
@@ -137,7 +257,11 @@ PetscErrorCode writeSingleXDMF(const std::string &directory,
 
     PetscViewer viewer;
 
-    std::string file = directory + "/" + name + ".xmf";
+    // coarsened levels are in their own files and groups
+    std::string suffix = (level > 0) ? "-lod" + std::to_string(level) : "",
+                group = (level > 0) ? "lod" + std::to_string(level) + "/" : "";
+
+    std::string file = directory + "/" + name + suffix + ".xmf";
 
     ierr = PetscViewerASCIIOpen(PETSC_COMM_WORLD, file.c_str(), &viewer);
     CHKERRQ(ierr);
@@ -157,7 +281,7 @@ PetscErrorCode writeSingleXDMF(const std::string &directory,
     for (int i = 0; i < 3; ++i)
     {
         ierr = PetscViewerASCIIPrintf(
-            viewer, "\t<!ENTITY N%s \"%d\">\n",
+            viewer, "\t<!ENTITY N%s \"%D\">\n",
             petibm::type::dir2str[petibm::type::Dir(i)].c_str(), n[i]);
         CHKERRQ(ierr);
     }
@@ -177,6 +301,26 @@ PetscErrorCode writeSingleXDMF(const std::string &directory,
     for (int i = 0; i < dim; ++i)
     {
         std::string dir = petibm::type::dir2str[petibm::type::Dir(i)];
+
+        // the gridlines of coarsened levels are small enough to be inlined
+        if (level > 0)
+        {
+            ierr = PetscViewerASCIIPrintf(
+                viewer,
+                "\t\t\t"
+                "<DataItem Dimensions=\'&N%s;\' Format=\'XML\' "
+                "Precision=\'8\'>\n\t\t\t\t",
+                dir.c_str()); CHKERRQ(ierr);
+            for (const auto &x : coords[i])
+            {
+                ierr = PetscViewerASCIIPrintf(viewer, "%.16e ", x);
+                CHKERRQ(ierr);
+            }
+            ierr = PetscViewerASCIIPrintf(viewer, "\n\t\t\t</DataItem>\n");
+            CHKERRQ(ierr);
+            continue;
+        }
+
         ierr = PetscViewerASCIIPrintf(
             viewer,
             "\t\t\t"
@@ -217,18 +361,31 @@ PetscErrorCode writeSingleXDMF(const std::string &directory,
     CHKERRQ(ierr);
 
     // write each step
-    for (PetscInt t = bg; t <= ed; t += step)
+    for (std::size_t k = 0; k < steps.size(); ++k)
     {
+        PetscInt t = steps[k];
+
         ierr = PetscViewerASCIIPrintf(
             viewer,
             "\t\t"
             "<Grid GridType=\"Uniform\" Name=\"%s Grid\">\n",
             name.c_str()); CHKERRQ(ierr);
 
-        ierr = PetscViewerASCIIPrintf(viewer,
-                                      "\t\t\t"
-                                      "<Time Value=\"%07d\" />\n",
-                                      t); CHKERRQ(ierr);
+        // time value of the snapshot if known, time-step index otherwise
+        if (times.size() > 0)
+        {
+            ierr = PetscViewerASCIIPrintf(viewer,
+                                          "\t\t\t"
+                                          "<Time Value=\"%.10e\" />\n",
+                                          (double)times[k]); CHKERRQ(ierr);
+        }
+        else
+        {
+            ierr = PetscViewerASCIIPrintf(viewer,
+                                          "\t\t\t"
+                                          "<Time Value=\"%07D\" />\n",
+                                          t); CHKERRQ(ierr);
+        }
         ierr = PetscViewerASCIIPrintf(viewer, "\t\t\t&Topo; &Geo;\n");
         CHKERRQ(ierr);
         ierr = PetscViewerASCIIPrintf(
@@ -247,8 +404,9 @@ PetscErrorCode writeSingleXDMF(const std::string &directory,
         CHKERRQ(ierr);
         ierr = PetscViewerASCIIPrintf(viewer,
                                       "\t\t\t\t\t"
-                                      "&CaseDir;/%07d.h5:/%s\n",
-                                      t, name.c_str()); CHKERRQ(ierr);
+                                      "&CaseDir;/%07D.h5:/%s%s\n",
+                                      t, group.c_str(), name.c_str());
+        CHKERRQ(ierr);
         ierr = PetscViewerASCIIPrintf(viewer,
                                       "\t\t\t\t"
                                       "</DataItem>\n"); CHKERRQ(ierr);
@@ -10,6 +10,7 @@
 #include <petscviewerhdf5.h>
 
 #include <petibm/delta.h>
+#include <petibm/misc.h>
 
 #include "decoupledibpm.h"
 
@@ -40,6 +41,11 @@ PetscErrorCode DecoupledIBPMSolver::destroy()
     PetscFunctionBeginUser;
 
     fSolver.reset();
+    for (auto sampler : samplers)
+    {
+        ierr = sampler->destroy(); CHKERRQ(ierr);
+    }
+    samplers.clear();
     bodies.reset();
     ierr = VecDestroy(&df); CHKERRQ(ierr);
     ierr = VecDestroy(&f); CHKERRQ(ierr);
@@ -63,13 +69,24 @@ PetscErrorCode DecoupledIBPMSolver::init(const MPI_Comm &world,
 
     ierr = NavierStokesSolver::init(world, node); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageInitialize); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageInitialize); CHKERRQ(ierr);
 
     // create a pack of immersed bodies
     ierr = petibm::body::createBodyPack(
         comm, mesh->dim, config, bodies); CHKERRQ(ierr);
     ierr = bodies->updateMeshIdx(mesh); CHKERRQ(ierr);
 
+    // matrix-free Delta operators with factorized weights, if requested
+    compactDelta = PETSC_FALSE;
+    ierr = PetscOptionsGetBool(nullptr, nullptr, "-compact_delta",
+                               &compactDelta, nullptr); CHKERRQ(ierr);
+
+    // add the immersed bodies to the key of the operator cache
+    if (config["cache"])
+    {
+        ierr = createCacheKey(); CHKERRQ(ierr);
+    }
+
     // create the linear solver object for the Lagrangian forces
     ierr = petibm::linsolver::createLinSolver(
         "forces", config, fSolver); CHKERRQ(ierr);
@@ -89,14 +106,32 @@ PetscErrorCode DecoupledIBPMSolver::init(const MPI_Comm &world,
         "/forces-" + std::to_string(ite) + ".txt",
         FILE_MODE_WRITE, forcesViewer); CHKERRQ(ierr);
 
+    // create samplers of the pressure and traction on the body surfaces
+    samplers.resize(config["surfaceSampling"].size());
+    for (unsigned int i = 0; i < samplers.size(); ++i)
+    {
+        YAML::Node samplerNode = config["surfaceSampling"][i];
+        // prepend relative path with output directory
+        samplerNode["path"] = config["output"].as<std::string>() + "/" +
+                              samplerNode["path"].as<std::string>();
+        // use the same regularized delta function as the solver by default
+        if (!samplerNode["delta"])
+            samplerNode["delta"] = config["parameters"]["delta"].as<
+                std::string>("ROMA_ET_AL_1999");
+        ierr = petibm::misc::createSurfaceSampler(
+            comm, samplerNode, mesh, bc, bodies, samplers[i]); CHKERRQ(ierr);
+    }
+
     // register additional logging stages
-    ierr = PetscLogStageRegister("rhsForces", &stageRHSForces); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
+        "rhsForces", &stageRHSForces); CHKERRQ(ierr);
+    ierr = petibm::misc::logStageRegister(
         "solveForces", &stageSolveForces); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "integrateForces", &stageIntegrateForces); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageInitialize
+    // end of stageInitialize
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // init
@@ -142,9 +177,37 @@ PetscErrorCode DecoupledIBPMSolver::write()
     // write body forces
     ierr = writeForcesASCII(); CHKERRQ(ierr);
 
+    // sample the pressure and traction on the body surfaces
+    ierr = monitorSurfaces(); CHKERRQ(ierr);
+
     PetscFunctionReturn(0);
 }  // write
 
+// get a read-only view of the local Lagrangian forces
+PetscErrorCode DecoupledIBPMSolver::getForcesArrayRead(const PetscReal *&array)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = VecGetArrayRead(f, &array); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // getForcesArrayRead
+
+// return a view obtained with getForcesArrayRead
+PetscErrorCode DecoupledIBPMSolver::restoreForcesArrayRead(
+    const PetscReal *&array)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = VecRestoreArrayRead(f, &array); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // restoreForcesArrayRead
+
 // create additional operators (PETSc Mat objects) for the decoupled IBPM
 PetscErrorCode DecoupledIBPMSolver::createExtraOperators()
 {
@@ -154,7 +217,6 @@ PetscErrorCode DecoupledIBPMSolver::createExtraOperators()
 
     Mat R;
     Mat MHat;
-    Mat BN;
     Vec RDiag;
     Vec MHatDiag;
 
@@ -174,9 +236,19 @@ PetscErrorCode DecoupledIBPMSolver::createExtraOperators()
     petibm::delta::DeltaKernel kernel;
     PetscInt kernelSize;
     ierr = petibm::delta::getKernel(name, kernel, kernelSize); CHKERRQ(ierr);
-    ierr = petibm::operators::createDelta(
-        mesh, bc, bodies, kernel, kernelSize, E); CHKERRQ(ierr);
-    ierr = MatTranspose(E, MAT_INITIAL_MATRIX, &H); CHKERRQ(ierr);
+    if (compactDelta)
+    {
+        ierr = petibm::operators::createCompactDelta(
+            mesh, bc, bodies, kernel, kernelSize, E); CHKERRQ(ierr);
+        ierr = petibm::operators::createCompactDeltaTranspose(E, H);
+        CHKERRQ(ierr);
+    }
+    else
+    {
+        ierr = petibm::operators::createDelta(
+            mesh, bc, bodies, kernel, kernelSize, E); CHKERRQ(ierr);
+        ierr = MatTranspose(E, MAT_INITIAL_MATRIX, &H); CHKERRQ(ierr);
+    }
 
     // create the regularization operator: E
     ierr = MatDiagonalScale(E, nullptr, RDiag); CHKERRQ(ierr);
@@ -191,30 +263,162 @@ PetscErrorCode DecoupledIBPMSolver::createExtraOperators()
     // on the assumption that the size of Lagrangian element is equal to the
     // size of the Eulerian grid near by.
 
-    // create the operator BN
-    PetscInt N;  // order of the truncate Taylor series expansion
-    N = config["parameters"]["BN"].as<PetscInt>(1);
-    ierr = petibm::operators::createBnHead(
-        L, dt, diffCoeffs->implicitCoeff * nu, N, BN); CHKERRQ(ierr);
-
-    // create the operator BNH
-    ierr = MatMatMult(
-        BN, H, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &BNH); CHKERRQ(ierr);
-
-    // create the operator EBNH
-    ierr = MatMatMult(
-        E, BNH, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &EBNH); CHKERRQ(ierr);
+    // create the operators BNH and EBNH
+    ierr = createForceOperators(); CHKERRQ(ierr);
 
     // destroy temporary PETSc Vec and Mat objects
     ierr = VecDestroy(&RDiag); CHKERRQ(ierr);
     ierr = VecDestroy(&MHatDiag); CHKERRQ(ierr);
     ierr = MatDestroy(&MHat); CHKERRQ(ierr);
     ierr = MatDestroy(&R); CHKERRQ(ierr);
-    ierr = MatDestroy(&BN); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // createExtraOperators
 
+// create the operators BNH and EBNH of the system for the Lagrangian forces
+PetscErrorCode DecoupledIBPMSolver::createForceOperators()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    Mat BN;  // a temporary operator
+
+    // with compact Delta operators, BNH and EBNH are applied on the fly
+    if (compactDelta)
+    {
+        ierr = createCompactForceOperators(); CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+    }
+
+    // load the operators BNH and EBNH from the cache, if possible; they
+    // depend on the positions of the bodies, which are only in the key of
+    // the cache if the bodies do not move
+    PetscBool useCache = bodiesCanMove() ? PETSC_FALSE : PETSC_TRUE;
+    PetscBool cachedBNH = PETSC_FALSE, cachedEBNH = PETSC_FALSE;
+    if (useCache)
+    {
+        PetscInt nU, nF;  // local sizes of the velocity and force systems
+        ierr = MatGetLocalSize(H, &nU, &nF); CHKERRQ(ierr);
+        ierr = readCachedOperator("BNH", nU, nF, BNH, cachedBNH);
+        CHKERRQ(ierr);
+        ierr = readCachedOperator("EBNH", nF, nF, EBNH, cachedEBNH);
+        CHKERRQ(ierr);
+    }
+
+    // create the operator BNH
+    if (!cachedBNH)
+    {
+        // create the operator BN
+        ierr = createBN(BN); CHKERRQ(ierr);
+
+        ierr = MatMatMult(
+            BN, H, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &BNH); CHKERRQ(ierr);
+        if (useCache)
+        {
+            ierr = writeCachedOperator("BNH", BNH); CHKERRQ(ierr);
+        }
+        ierr = MatDestroy(&BN); CHKERRQ(ierr);
+    }
+
+    // create the operator EBNH
+    if (!cachedEBNH)
+    {
+        ierr = MatMatMult(
+            E, BNH, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &EBNH); CHKERRQ(ierr);
+        if (useCache)
+        {
+            ierr = writeCachedOperator("EBNH", EBNH); CHKERRQ(ierr);
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // createForceOperators
+
+// create the matrix-free operators BNH and EBNH from compact Delta operators
+PetscErrorCode DecoupledIBPMSolver::createCompactForceOperators()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    Mat BN;     // a temporary operator
+    Vec BNDiag; // diagonal of the operator BN
+
+    // the product E BN H is expanded on the fly only for a diagonal BN
+    PetscInt N;  // order of the truncate Taylor series expansion
+    N = config["parameters"]["BN"].as<PetscInt>(1);
+    if (N != 1)
+        SETERRQ1(comm, PETSC_ERR_ARG_INCOMP,
+                 "Compact Delta operators need a diagonal operator BN (order "
+                 "1), but the order is %D.\n", N);
+
+    ierr = createBN(BN); CHKERRQ(ierr);
+    ierr = MatCreateVecs(BN, nullptr, &BNDiag); CHKERRQ(ierr);
+    ierr = MatGetDiagonal(BN, BNDiag); CHKERRQ(ierr);
+    ierr = MatDestroy(&BN); CHKERRQ(ierr);
+
+    // BNH is the spreading operator scaled by the diagonal of BN
+    ierr = petibm::operators::createCompactDeltaTranspose(E, BNH);
+    CHKERRQ(ierr);
+    ierr = MatDiagonalScale(BNH, BNDiag, nullptr); CHKERRQ(ierr);
+    ierr = VecDestroy(&BNDiag); CHKERRQ(ierr);
+
+    ierr = petibm::operators::createCompactDeltaProduct(E, BNH, EBNH);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createCompactForceOperators
+
+// change the viscous coefficient and the time-step size of the solver
+PetscErrorCode DecoupledIBPMSolver::updateParameters(const PetscReal &newNu,
+                                                     const PetscReal &newDt)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = NavierStokesSolver::updateParameters(newNu, newDt); CHKERRQ(ierr);
+
+    // re-assemble the operators of the force system that depend on BN
+    ierr = MatDestroy(&BNH); CHKERRQ(ierr);
+    ierr = MatDestroy(&EBNH); CHKERRQ(ierr);
+    ierr = createForceOperators(); CHKERRQ(ierr);
+    ierr = fSolver->setMatrix(EBNH); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // updateParameters
+
+// compute the key of the operator cache, including the immersed bodies
+PetscErrorCode DecoupledIBPMSolver::createCacheKey()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = NavierStokesSolver::createCacheKey(); CHKERRQ(ierr);
+
+    // the bodies are created after the operators of the Navier-Stokes solver
+    if (!bodies) PetscFunctionReturn(0);
+
+    // the regularized delta kernel
+    std::string name =
+        config["parameters"]["delta"].as<std::string>("ROMA_ET_AL_1999");
+    ierr = updateCacheKey(name.data(), name.size()); CHKERRQ(ierr);
+
+    // the Lagrangian points and their distribution among processes
+    for (auto &body : bodies->bodies)
+    {
+        ierr = updateCacheKey(body->coords.data(),
+                              body->coords.size() * body->coords.nCols() *
+                                  sizeof(PetscReal)); CHKERRQ(ierr);
+    }
+    ierr = updateCacheKey(&bodies->nLclPts, sizeof(PetscInt), PETSC_TRUE);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createCacheKey
+
 // create additional vectors (PETSc Vec objects) for the decoupled IBPM
 PetscErrorCode DecoupledIBPMSolver::createExtraVectors()
 {
@@ -239,12 +443,13 @@ PetscErrorCode DecoupledIBPMSolver::assembleRHSVelocity()
     // assemble the part coming from underlying Navier-Stokes solver
     ierr = NavierStokesSolver::assembleRHSVelocity(); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageRHSVelocity); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageRHSVelocity); CHKERRQ(ierr);
 
     // add the Lagrangian forces spread to the Eulerian grid
     ierr = MatMultAdd(H, f, rhs1, rhs1); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageRHSVelocity
+    // end of stageRHSVelocity
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // assembleRHSVelocity
@@ -256,13 +461,13 @@ PetscErrorCode DecoupledIBPMSolver::assembleRHSForces()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageRHSForces); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageRHSForces); CHKERRQ(ierr);
 
     // rhsf is -E u^{**}
     ierr = MatMult(E, solution->UGlobal, rhsf); CHKERRQ(ierr);
     ierr = VecScale(rhsf, -1.0); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageRHSForces
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageRHSForces
 
     PetscFunctionReturn(0);
 }  // assembleRHSForces
@@ -274,12 +479,13 @@ PetscErrorCode DecoupledIBPMSolver::solveForces()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageSolveForces); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageSolveForces); CHKERRQ(ierr);
 
     // solve for the increment in the Lagrangian forces
     ierr = fSolver->solve(df, rhsf); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageSolveForces
+    // end of stageSolveForces
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // solveForces
@@ -305,12 +511,12 @@ PetscErrorCode DecoupledIBPMSolver::updateForces()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageUpdate); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageUpdate); CHKERRQ(ierr);
 
     // f = f + df
     ierr = VecAXPY(f, 1.0, df); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageUpdate
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageUpdate
 
     PetscFunctionReturn(0);
 }  // updateForces
@@ -325,7 +531,7 @@ PetscErrorCode DecoupledIBPMSolver::writeRestartDataHDF5(
 
     ierr = NavierStokesSolver::writeRestartDataHDF5(filePath); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
     // create PetscViewer object with append mode
     PetscViewer viewer;
@@ -337,14 +543,18 @@ PetscErrorCode DecoupledIBPMSolver::writeRestartDataHDF5(
     // go to the root node first (just in case, not necessary)
     ierr = PetscViewerHDF5PushGroup(viewer, "/"); CHKERRQ(ierr);
 
-    // write the Lagrangian forces
-    ierr = PetscObjectSetName((PetscObject)f, "force"); CHKERRQ(ierr);
-    ierr = VecView(f, viewer); CHKERRQ(ierr);
+    // write the Lagrangian forces (in the order of the body files)
+    Vec fFile;
+    ierr = VecDuplicate(f, &fFile); CHKERRQ(ierr);
+    ierr = bodies->reorderVec(f, fFile, PETSC_TRUE); CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject)fFile, "force"); CHKERRQ(ierr);
+    ierr = VecView(fFile, viewer); CHKERRQ(ierr);
+    ierr = VecDestroy(&fFile); CHKERRQ(ierr);
 
     // destroy viewer
     ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageWrite
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageWrite
 
     PetscFunctionReturn(0);
 }  // writeRestartDataHDF5
@@ -369,9 +579,13 @@ PetscErrorCode DecoupledIBPMSolver::readRestartDataHDF5(
     // go to the root node first (just in case, not necessary)
     ierr = PetscViewerHDF5PushGroup(viewer, "/"); CHKERRQ(ierr);
 
-    // read the Lagrangian forces
-    ierr = PetscObjectSetName((PetscObject)f, "force"); CHKERRQ(ierr);
-    ierr = VecLoad(f, viewer); CHKERRQ(ierr);
+    // read the Lagrangian forces (in the order of the body files)
+    Vec fFile;
+    ierr = VecDuplicate(f, &fFile); CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject)fFile, "force"); CHKERRQ(ierr);
+    ierr = VecLoad(fFile, viewer); CHKERRQ(ierr);
+    ierr = bodies->reorderVec(fFile, f, PETSC_FALSE); CHKERRQ(ierr);
+    ierr = VecDestroy(&fFile); CHKERRQ(ierr);
 
     // destroy viewer
     ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
@@ -388,30 +602,30 @@ PetscErrorCode DecoupledIBPMSolver::writeLinSolversInfo()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
     // write the time value
-    ierr = PetscViewerASCIIPrintf(solversViewer, "%d\t", ite); CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(solversViewer, "%D\t", ite); CHKERRQ(ierr);
 
     // write iterations number and residual for the velocity solver
     ierr = vSolver->getIters(nIters); CHKERRQ(ierr);
     ierr = vSolver->getResidual(res); CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(
-        solversViewer, "%d\t%e\t", nIters, res); CHKERRQ(ierr);
+        solversViewer, "%D\t%e\t", nIters, res); CHKERRQ(ierr);
 
     // write iterations number and residual for the Poisson solver
     ierr = pSolver->getIters(nIters); CHKERRQ(ierr);
     ierr = pSolver->getResidual(res); CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(
-        solversViewer, "%d\t%e\t", nIters, res); CHKERRQ(ierr);
+        solversViewer, "%D\t%e\t", nIters, res); CHKERRQ(ierr);
 
     // write iterations number and residual for the forces solver
     ierr = fSolver->getIters(nIters); CHKERRQ(ierr);
     ierr = fSolver->getResidual(res); CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(
-        solversViewer, "%d\t%e\n", nIters, res); CHKERRQ(ierr);
+        solversViewer, "%D\t%e\n", nIters, res); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageWrite
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageWrite
 
     PetscFunctionReturn(0);
 }  // writeLinSolversInfo
@@ -424,22 +638,24 @@ PetscErrorCode DecoupledIBPMSolver::writeForcesASCII()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageIntegrateForces); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageIntegrateForces); CHKERRQ(ierr);
 
     // get averaged forces first
     ierr = bodies->calculateAvgForces(f, fAvg); CHKERRQ(ierr);
+    // add the contribution of the mirror images, if any symmetry plane
+    ierr = petibm::boundary::mirrorForces(bc, bodies, f, fAvg); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
     // write the time value
     ierr = PetscViewerASCIIPrintf(forcesViewer, "%10.8e\t", t); CHKERRQ(ierr);
 
     // write forces for each immersed body
-    for (int i = 0; i < bodies->nBodies; ++i)
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
     {
-        for (int d = 0; d < mesh->dim; ++d)
+        for (PetscInt d = 0; d < mesh->dim; ++d)
         {
             ierr = PetscViewerASCIIPrintf(
                 forcesViewer, "%10.8e\t", fAvg[i][d]); CHKERRQ(ierr);
@@ -447,7 +663,30 @@ PetscErrorCode DecoupledIBPMSolver::writeForcesASCII()
     }
     ierr = PetscViewerASCIIPrintf(forcesViewer, "\n"); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageIntegrateForces
+    // end of stageIntegrateForces
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // writeForcesASCII
+
+// sample the pressure and traction on the body surfaces
+PetscErrorCode DecoupledIBPMSolver::monitorSurfaces()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = petibm::misc::logStagePush(stageMonitor); CHKERRQ(ierr);
+
+    Vec p;
+    ierr = getPressureVec(p); CHKERRQ(ierr);
+    for (auto sampler : samplers)
+    {
+        ierr = sampler->monitor(
+            bodies, solution->UGlobal, p, nu, ite, t); CHKERRQ(ierr);
+    }
+
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageMonitor
+
+    PetscFunctionReturn(0);
+}  // monitorSurfaces
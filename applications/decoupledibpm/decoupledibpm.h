@@ -10,6 +10,7 @@
 #pragma once
 
 #include <petibm/bodypack.h>
+#include <petibm/surfacesampler.h>
 
 #include "../navierstokes/navierstokes.h"
 
@@ -55,6 +56,38 @@ public:
 
     using NavierStokesSolver::finished;
 
+    using NavierStokesSolver::steer;
+
+    using NavierStokesSolver::getMesh;
+
+    using NavierStokesSolver::getTime;
+
+    using NavierStokesSolver::getFieldArrayRead;
+
+    using NavierStokesSolver::restoreFieldArrayRead;
+
+    /** \brief Get the pack of immersed bodies. */
+    const petibm::type::BodyPack &getBodies() const { return bodies; };
+
+    /** \brief Get a read-only view of the local Lagrangian forces.
+     *
+     * No data are copied: the array holds the forces applied to the fluid at
+     * the Lagrangian points owned by this process (body after body, `dim`
+     * values per point). The view must be returned with
+     * restoreForcesArrayRead before the solution is advanced.
+     *
+     * \param array [out] Read-only array of local forces
+     * \return PetscErrorCode
+     */
+    PetscErrorCode getForcesArrayRead(const PetscReal *&array);
+
+    /** \brief Return a view obtained with getForcesArrayRead.
+     *
+     * \param array [in, out] Read-only array of local forces
+     * \return PetscErrorCode
+     */
+    PetscErrorCode restoreForcesArrayRead(const PetscReal *&array);
+
 protected:
     /** \brief Pack of immersed bodies. */
     petibm::type::BodyPack bodies;
@@ -74,6 +107,9 @@ protected:
     /** \brief Projection operator for the forces. */
     Mat BNH;
 
+    /** \brief Whether the Delta operators are compact and matrix-free. */
+    PetscBool compactDelta;
+
     /** \brief Vector to hold the forces at time step n. */
     Vec f;
 
@@ -95,6 +131,9 @@ protected:
     /** \brief ASCII PetscViewer object to output the forces. */
     PetscViewer forcesViewer;
 
+    /** \brief Samplers of the pressure and traction on the body surfaces. */
+    std::vector<petibm::type::SurfaceSampler> samplers;
+
     /** \brief Assemble the RHS vector of the velocity system. */
     virtual PetscErrorCode assembleRHSVelocity();
 
@@ -113,9 +152,29 @@ protected:
     /** \brief Assemble additional operators. */
     virtual PetscErrorCode createExtraOperators();
 
+    /** \brief Assemble the operators BNH and EBNH (they depend on BN). */
+    virtual PetscErrorCode createForceOperators();
+
+    /** \brief Create BNH and EBNH from compact Delta operators. */
+    virtual PetscErrorCode createCompactForceOperators();
+
     /** \brief Create additional vectors. */
     virtual PetscErrorCode createExtraVectors();
 
+    /** \brief Compute the key of the operator cache, including the bodies. */
+    virtual PetscErrorCode createCacheKey();
+
+    /** \copydoc NavierStokesSolver::getCacheScope() */
+    virtual std::string getCacheScope() const { return "decoupledibpm"; };
+
+    /** \brief Whether the bodies can move during the run.
+     *
+     * The key of the operator cache holds the initial positions of the
+     * bodies, so the operators of the force system are not cached for
+     * bodies that can move.
+     */
+    virtual PetscBool bodiesCanMove() const { return PETSC_FALSE; };
+
     /** \brief Write data required to restart a simulation into a HDF5 file.
      *
      * \param filePath [in] Path of the file to write in
@@ -133,7 +192,19 @@ protected:
     /** \brief Write numbers of iterations and residuals of solvers to file. */
     virtual PetscErrorCode writeLinSolversInfo();
 
+    /** \brief Change the viscous coefficient and the time-step size.
+     *
+     * \param newNu [in] New viscous diffusion coefficient
+     * \param newDt [in] New time-step size
+     * \return PetscErrorCode
+     */
+    virtual PetscErrorCode updateParameters(const PetscReal &newNu,
+                                            const PetscReal &newDt);
+
     /** \brief Write the forces acting on the bodies into an ASCII file. */
     virtual PetscErrorCode writeForcesASCII();
 
+    /** \brief Sample the surface pressure and traction of the bodies. */
+    virtual PetscErrorCode monitorSurfaces();
+
 };  // DecoupledIBPMSolver
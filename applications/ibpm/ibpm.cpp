@@ -11,6 +11,7 @@
 
 #include <petibm/delta.h>
 #include <petibm/io.h>
+#include <petibm/misc.h>
 
 #include "ibpm.h"
 
@@ -40,6 +41,11 @@ PetscErrorCode IBPMSolver::destroy()
 
     PetscFunctionBeginUser;
 
+    for (auto sampler : samplers)
+    {
+        ierr = sampler->destroy(); CHKERRQ(ierr);
+    }
+    samplers.clear();
     bodies.reset();
     ierr = ISDestroy(&isDE[0]); CHKERRQ(ierr);
     ierr = ISDestroy(&isDE[1]); CHKERRQ(ierr);
@@ -64,7 +70,7 @@ PetscErrorCode IBPMSolver::init(const MPI_Comm &world, const YAML::Node &node)
 
     ierr = NavierStokesSolver::init(world, node); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageInitialize); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageInitialize); CHKERRQ(ierr);
 
     // create an ASCII PetscViewer to output the body forces
     ierr = createPetscViewerASCII(
@@ -72,11 +78,27 @@ PetscErrorCode IBPMSolver::init(const MPI_Comm &world, const YAML::Node &node)
         "/forces-" + std::to_string(ite) + ".txt",
         FILE_MODE_WRITE, forcesViewer); CHKERRQ(ierr);
 
+    // create samplers of the pressure and traction on the body surfaces
+    samplers.resize(config["surfaceSampling"].size());
+    for (unsigned int i = 0; i < samplers.size(); ++i)
+    {
+        YAML::Node samplerNode = config["surfaceSampling"][i];
+        // prepend relative path with output directory
+        samplerNode["path"] = config["output"].as<std::string>() + "/" +
+                              samplerNode["path"].as<std::string>();
+        // use the same regularized delta function as the solver by default
+        if (!samplerNode["delta"])
+            samplerNode["delta"] = config["parameters"]["delta"].as<
+                std::string>("ROMA_ET_AL_1999");
+        ierr = petibm::misc::createSurfaceSampler(
+            comm, samplerNode, mesh, bc, bodies, samplers[i]); CHKERRQ(ierr);
+    }
+
     // register additional logging stage
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "integrateForces", &stageIntegrateForces); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // init
@@ -93,6 +115,9 @@ PetscErrorCode IBPMSolver::write()
     // write body forces
     ierr = writeForcesASCII(); CHKERRQ(ierr);
 
+    // sample the pressure and traction on the body surfaces
+    ierr = monitorSurfaces(); CHKERRQ(ierr);
+
     PetscFunctionReturn(0);
 }  // write
 
@@ -103,7 +128,7 @@ PetscErrorCode IBPMSolver::createOperators()
 
     PetscFunctionBeginUser;
 
-    Mat R, MHat, BN, GH[2], DE[2];  // temporary operators
+    Mat R, MHat, GH[2], DE[2];  // temporary operators
     Vec RDiag, MHatDiag;            // temporary vectors
     IS is[2];                       // temporary index sets
 
@@ -115,9 +140,8 @@ PetscErrorCode IBPMSolver::createOperators()
     ierr = petibm::operators::createGradient(
         mesh, GH[0], PETSC_FALSE); CHKERRQ(ierr);
     
-    // create the Laplacian operator: L
-    ierr = petibm::operators::createLaplacian(
-        mesh, bc, L, LCorrection); CHKERRQ(ierr);
+    // create the Laplacian operators: L (and LExplicit)
+    ierr = createLaplacianOperators(); CHKERRQ(ierr);
     
     // create the operator for the convective terms: N
     ierr = petibm::operators::createConvection(
@@ -128,6 +152,9 @@ PetscErrorCode IBPMSolver::createOperators()
     ierr = MatScale(A, -diffCoeffs->implicitCoeff * nu); CHKERRQ(ierr);
     ierr = MatShift(A, 1.0 / dt); CHKERRQ(ierr);
 
+    // create the damping operator of the sponge zones (if any): S
+    ierr = createSpongeOperator(); CHKERRQ(ierr);
+
     // create diagonal matrix R and hold the diagonal in a PETSc Vec object
     ierr = petibm::operators::createR(mesh, R); CHKERRQ(ierr);
     ierr = MatCreateVecs(R, nullptr, &RDiag); CHKERRQ(ierr);
@@ -181,26 +208,49 @@ PetscErrorCode IBPMSolver::createOperators()
     ierr = MatDestroy(&DE[0]); CHKERRQ(ierr);
     ierr = MatDestroy(&DE[1]); CHKERRQ(ierr);
 
-    // create the projection operator: BNG
-    PetscInt N;  // order of the truncate Taylor series expansion
-    N = config["parameters"]["BN"].as<PetscInt>(1);
-    ierr = petibm::operators::createBnHead(
-        L, dt, diffCoeffs->implicitCoeff * nu, N, BN); CHKERRQ(ierr);
-    ierr = MatMatMult(
-        BN, G, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &BNG); CHKERRQ(ierr);
+    // create the projection and modified Poisson operators: BNG and DBNG
+    ierr = createProjectionOperators(); CHKERRQ(ierr);
 
-    // create the modified Poisson operator
-    ierr = MatMatMult(
-        D, BNG, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &DBNG); CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+}  // createOperators
 
-    // set the nullspace of the modified Poisson system
-    ierr = setNullSpace(); CHKERRQ(ierr);
+// compute the key of the operator cache, including the immersed bodies
+PetscErrorCode IBPMSolver::createCacheKey()
+{
+    PetscErrorCode ierr;
 
-    // destroy temporary operator
-    ierr = MatDestroy(&BN); CHKERRQ(ierr);
+    PetscFunctionBeginUser;
+
+    ierr = NavierStokesSolver::createCacheKey(); CHKERRQ(ierr);
+
+    // the regularized delta kernel
+    std::string name =
+        config["parameters"]["delta"].as<std::string>("ROMA_ET_AL_1999");
+    ierr = updateCacheKey(name.data(), name.size()); CHKERRQ(ierr);
+
+    // the Lagrangian points and their distribution among processes
+    for (auto &body : bodies->bodies)
+    {
+        ierr = updateCacheKey(body->coords.data(),
+                              body->coords.size() * body->coords.nCols() *
+                                  sizeof(PetscReal)); CHKERRQ(ierr);
+    }
+    ierr = updateCacheKey(&bodies->nLclPts, sizeof(PetscInt), PETSC_TRUE);
+    CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
-}  // createOperators
+}  // createCacheKey
+
+// get the vector holding the pressure field only
+PetscErrorCode IBPMSolver::getPressureVec(Vec &p)
+{
+    PetscFunctionBeginUser;
+
+    // solution->pGlobal holds the pressure and the Lagrangian forces
+    p = P;
+
+    PetscFunctionReturn(0);
+}  // getPressureVec
 
 // create the vectors of the solver (PETSc Vec objects)
 PetscErrorCode IBPMSolver::createVectors()
@@ -289,7 +339,7 @@ PetscErrorCode IBPMSolver::assembleRHSPoisson()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageRHSPoisson); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageRHSPoisson); CHKERRQ(ierr);
 
     // compute the divergence of the intermediate velocity field
     ierr = MatMult(D, solution->UGlobal, rhs2); CHKERRQ(ierr);
@@ -307,7 +357,7 @@ PetscErrorCode IBPMSolver::assembleRHSPoisson()
         ierr = VecAssemblyEnd(rhs2); CHKERRQ(ierr);
     }
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // assembleRHSPoisson
@@ -343,11 +393,15 @@ PetscErrorCode IBPMSolver::writeRestartDataHDF5(const std::string &filePath)
 
     ierr = NavierStokesSolver::writeRestartDataHDF5(filePath); CHKERRQ(ierr);
 
-    // write forces
-    Vec f;
+    // write forces (in the order of the body files)
+    Vec f, fFile;
     ierr = VecGetSubVector(solution->pGlobal, isDE[1], &f); CHKERRQ(ierr);
+    ierr = VecDuplicate(f, &fFile); CHKERRQ(ierr);
+    ierr = bodies->reorderVec(f, fFile, PETSC_TRUE); CHKERRQ(ierr);
     ierr = petibm::io::writeHDF5Vecs(
-        comm, filePath, "/", {"force"}, {f}, FILE_MODE_APPEND); CHKERRQ(ierr);
+        comm, filePath, "/", {"force"}, {fFile}, FILE_MODE_APPEND);
+    CHKERRQ(ierr);
+    ierr = VecDestroy(&fFile); CHKERRQ(ierr);
     ierr = VecRestoreSubVector(solution->pGlobal, isDE[1], &f); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
@@ -372,13 +426,16 @@ PetscErrorCode IBPMSolver::readRestartDataHDF5(const std::string &filePath)
     solution->pGlobal = temp;
     temp = PETSC_NULL;
 
-    // write forces
-    std::vector<Vec> f(1);
-    ierr = VecGetSubVector(solution->pGlobal, isDE[1], &f[0]); CHKERRQ(ierr);
+    // read forces (in the order of the body files)
+    Vec f;
+    std::vector<Vec> fFile(1);
+    ierr = VecGetSubVector(solution->pGlobal, isDE[1], &f); CHKERRQ(ierr);
+    ierr = VecDuplicate(f, &fFile[0]); CHKERRQ(ierr);
     ierr = petibm::io::readHDF5Vecs(
-        comm, filePath, "/", {"force"}, f); CHKERRQ(ierr);
-    ierr = VecRestoreSubVector(
-        solution->pGlobal, isDE[1], &f[0]); CHKERRQ(ierr);
+        comm, filePath, "/", {"force"}, fFile); CHKERRQ(ierr);
+    ierr = bodies->reorderVec(fFile[0], f, PETSC_FALSE); CHKERRQ(ierr);
+    ierr = VecDestroy(&fFile[0]); CHKERRQ(ierr);
+    ierr = VecRestoreSubVector(solution->pGlobal, isDE[1], &f); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // readRestartDataHDF5
@@ -391,25 +448,27 @@ PetscErrorCode IBPMSolver::writeForcesASCII()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageIntegrateForces); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageIntegrateForces); CHKERRQ(ierr);
 
     // get sub section f and calculate averaged forces
     Vec f;
     ierr = VecGetSubVector(solution->pGlobal, isDE[1], &f); CHKERRQ(ierr);
     ierr = bodies->calculateAvgForces(f, fAvg); CHKERRQ(ierr);
+    // add the contribution of the mirror images, if any symmetry plane
+    ierr = petibm::boundary::mirrorForces(bc, bodies, f, fAvg); CHKERRQ(ierr);
     ierr = VecRestoreSubVector(solution->pGlobal, isDE[1], &f); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
     // write the time value
     ierr = PetscViewerASCIIPrintf(forcesViewer, "%10.8e\t", t); CHKERRQ(ierr);
 
     // write forces for each immersed body
-    for (int i = 0; i < bodies->nBodies; ++i)
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
     {
-        for (int d = 0; d < mesh->dim; ++d)
+        for (PetscInt d = 0; d < mesh->dim; ++d)
         {
             ierr = PetscViewerASCIIPrintf(
                 forcesViewer, "%10.8e\t", fAvg[i][d]); CHKERRQ(ierr);
@@ -417,7 +476,29 @@ PetscErrorCode IBPMSolver::writeForcesASCII()
     }
     ierr = PetscViewerASCIIPrintf(forcesViewer, "\n"); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // writeForcesASCII
+
+// sample the pressure and traction on the body surfaces
+PetscErrorCode IBPMSolver::monitorSurfaces()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = petibm::misc::logStagePush(stageMonitor); CHKERRQ(ierr);
+
+    Vec p;
+    ierr = getPressureVec(p); CHKERRQ(ierr);
+    for (auto sampler : samplers)
+    {
+        ierr = sampler->monitor(
+            bodies, solution->UGlobal, p, nu, ite, t); CHKERRQ(ierr);
+    }
+
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageMonitor
+
+    PetscFunctionReturn(0);
+}  // monitorSurfaces
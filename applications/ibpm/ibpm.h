@@ -10,6 +10,7 @@
 #pragma once
 
 #include <petibm/bodypack.h>
+#include <petibm/surfacesampler.h>
 
 #include "../navierstokes/navierstokes.h"
 
@@ -56,6 +57,16 @@ public:
 
     using NavierStokesSolver::finished;
 
+    using NavierStokesSolver::steer;
+
+    using NavierStokesSolver::getMesh;
+
+    using NavierStokesSolver::getTime;
+
+    using NavierStokesSolver::getFieldArrayRead;
+
+    using NavierStokesSolver::restoreFieldArrayRead;
+
 protected:
     /** \brief Pack of immersed bodies. */
     petibm::type::BodyPack bodies;
@@ -72,6 +83,9 @@ protected:
     /** \brief ASCII PetscViewer object to output the forces. */
     PetscViewer forcesViewer;
 
+    /** \brief Samplers of the pressure and traction on the body surfaces. */
+    std::vector<petibm::type::SurfaceSampler> samplers;
+
     /** \brief Assemble the RHS vector of the Poisson system. */
     virtual PetscErrorCode assembleRHSPoisson();
 
@@ -84,6 +98,15 @@ protected:
     /** \brief Set Poisson nullspace or pin pressure at a reference point. */
     virtual PetscErrorCode setNullSpace();
 
+    /** \brief Compute the key of the operator cache, including the bodies. */
+    virtual PetscErrorCode createCacheKey();
+
+    /** \copydoc NavierStokesSolver::getCacheScope() */
+    virtual std::string getCacheScope() const { return "ibpm"; };
+
+    /** \brief Get the vector holding the pressure field only. */
+    virtual PetscErrorCode getPressureVec(Vec &p);
+
     /** \brief Write the solution fields into a HDF5 file.
      *
      * \param filePath [in] Path of the file to write in
@@ -108,4 +131,7 @@ protected:
     /** \brief Write the forces acting on the bodies into an ASCII file. */
     virtual PetscErrorCode writeForcesASCII();
 
+    /** \brief Sample the surface pressure and traction of the bodies. */
+    virtual PetscErrorCode monitorSurfaces();
+
 };  // IBPMSolver
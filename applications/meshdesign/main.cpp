@@ -0,0 +1,396 @@
+/**
+ * \file meshdesign/main.cpp
+ * \brief Small application to design the sub-domains of a Cartesian mesh.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ * \see meshdesign
+ * \ingroup meshdesign
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <string>
+
+#include <petscsys.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/io.h>
+#include <petibm/parser.h>
+#include <petibm/type.h>
+
+/**
+ * \defgroup meshdesign Pre-processing utility: meshdesign
+ * \brief A pre-processing utility that designs the sub-domains of a
+ *        Cartesian mesh under spacing constraints.
+ *
+ * The utility reads the node `meshDesign` of the YAML configuration (domain
+ * extents, target spacing around the bodies, and maximum stretching ratio)
+ * and the bounding boxes of the immersed bodies. In each direction, the box
+ * that holds all bodies is covered with uniform cells of the target spacing
+ * and the far field with cells that grow at (at most) the maximum stretching
+ * ratio, which gives the smallest number of cells under these constraints.
+ * The utility prints (and optionally writes) the YAML node `mesh` and
+ * reports the number of cells before any run starts.
+ *
+ * \ingroup apps
+ */
+
+PetscErrorCode getBodyBoxes(const YAML::Node &config, const PetscInt &dim,
+                            petibm::type::RealVec2D &boxes);
+
+PetscErrorCode designStretchedRegion(const PetscReal &length,
+                                     const PetscReal &h, const PetscReal &rMax,
+                                     PetscInt &n, PetscReal &r);
+
+PetscErrorCode designAxis(const YAML::Node &axis, const PetscInt &d,
+                          const petibm::type::RealVec2D &boxes,
+                          const PetscReal &spacing, const PetscReal &rMax,
+                          const PetscReal &margin, YAML::Node &out);
+
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr;
+    YAML::Node config;
+
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+
+    // parse configuration files; store info in YAML node
+    ierr = petibm::parser::getSettings(config); CHKERRQ(ierr);
+
+    if (!config["meshDesign"])
+        SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                "No node \"meshDesign\" found in the configuration.\n");
+
+    const YAML::Node &design = config["meshDesign"];
+    const YAML::Node &domain = design["domain"];
+    PetscInt dim = domain.size();
+    if ((dim != 2) && (dim != 3))
+        SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                 "The domain should have 2 or 3 directions (got %D).\n", dim);
+
+    PetscReal spacing = design["spacing"].as<PetscReal>();
+    PetscReal rMax = design["maxStretchRatio"].as<PetscReal>();
+    PetscReal margin = design["margin"].as<PetscReal>(0.0);
+    if ((spacing <= 0.0) || (rMax < 1.0))
+        SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE,
+                "The spacing should be positive and the maximum stretching "
+                "ratio should be at least 1.\n");
+
+    // bounding boxes of the bodies (and of the user-defined boxes)
+    petibm::type::RealVec2D boxes;
+    ierr = getBodyBoxes(config, dim, boxes); CHKERRQ(ierr);
+    if (boxes.size() == 0)
+        SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                "No body or box to refine the mesh around.\n");
+
+    // design each direction, then parse the result as a regular mesh node
+    YAML::Node mesh;
+    petibm::type::IntVec1D n(dim);
+    petibm::type::RealVec1D dLMin(dim), dLMax(dim);
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        YAML::Node axis;
+        ierr = designAxis(domain[d], d, boxes,
+                          domain[d]["spacing"].as<PetscReal>(spacing), rMax,
+                          margin, axis); CHKERRQ(ierr);
+        mesh.push_back(axis);
+
+        PetscReal ed;
+        petibm::type::RealVec1D dL;
+        ierr = petibm::parser::parseSubDomains(
+            axis["subDomains"], axis["start"].as<PetscReal>(), n[d], ed, dL);
+        CHKERRQ(ierr);
+        dLMin[d] = *std::min_element(dL.begin(), dL.end());
+        dLMax[d] = *std::max_element(dL.begin(), dL.end());
+    }
+
+    YAML::Emitter emitter;
+    emitter.SetDoublePrecision(12);
+    YAML::Node root;
+    root["mesh"] = mesh;
+    emitter << root;
+
+    ierr = PetscPrintf(PETSC_COMM_WORLD, "%s\n\n", emitter.c_str());
+    CHKERRQ(ierr);
+
+    // write the mesh node into a file (if requested)
+    char s[PETSC_MAX_PATH_LEN];
+    PetscBool flag = PETSC_FALSE;
+    ierr = PetscOptionsGetString(nullptr, nullptr, "-file", s, sizeof(s),
+                                 &flag); CHKERRQ(ierr);
+    if (flag)
+    {
+        PetscMPIInt rank;
+        ierr = MPI_Comm_rank(PETSC_COMM_WORLD, &rank); CHKERRQ(ierr);
+        if (rank == 0)
+        {
+            std::ofstream file(s);
+            file << emitter.c_str() << std::endl;
+        }
+    }
+
+    // report the size of the mesh and of the systems
+    PetscInt nCells = 1;
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        nCells *= n[d];
+        ierr = PetscPrintf(PETSC_COMM_WORLD,
+                           "# direction %s: %D cells, spacing from %g to %g\n",
+                           petibm::type::dir2str[petibm::type::Dir(d)].c_str(),
+                           n[d], (double)dLMin[d], (double)dLMax[d]);
+        CHKERRQ(ierr);
+    }
+
+    // velocity unknowns without periodic boundaries
+    PetscInt nVelocity = 0;
+    for (PetscInt c = 0; c < dim; ++c)
+    {
+        PetscInt nc = 1;
+        for (PetscInt d = 0; d < dim; ++d) nc *= (d == c) ? n[d] - 1 : n[d];
+        nVelocity += nc;
+    }
+
+    // the implicit velocity operator and the Poisson operator have
+    // 2 * dim + 1 non-zeros per row
+    ierr = PetscPrintf(PETSC_COMM_WORLD,
+                       "# total: %D cells, %D velocity and %D pressure "
+                       "unknowns, about %D non-zeros in the velocity and "
+                       "Poisson operators\n",
+                       nCells, nVelocity, nCells,
+                       (2 * dim + 1) * (nVelocity + nCells)); CHKERRQ(ierr);
+
+    // cost per step from the measured time per cell of a previous run
+    PetscReal timePerCell = 0.0;
+    ierr = PetscOptionsGetReal(nullptr, nullptr, "-time_per_cell",
+                               &timePerCell, &flag); CHKERRQ(ierr);
+    if (flag)
+    {
+        ierr = PetscPrintf(PETSC_COMM_WORLD,
+                           "# estimated wall time per time step: %g s\n",
+                           (double)(timePerCell * nCells)); CHKERRQ(ierr);
+    }
+
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return 0;
+}  // main
+
+PetscErrorCode getBodyBoxes(const YAML::Node &config, const PetscInt &dim,
+                            petibm::type::RealVec2D &boxes)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    // each box holds the minimum and the maximum in each direction
+    const PetscReal inf = std::numeric_limits<PetscReal>::max();
+    boxes.clear();
+
+    // boxes prescribed by the user: a list of [min, max] per direction
+    const YAML::Node &userBoxes = config["meshDesign"]["boxes"];
+    for (unsigned int b = 0; b < userBoxes.size(); ++b)
+    {
+        petibm::type::RealVec1D box(2 * dim);
+        for (PetscInt d = 0; d < dim; ++d)
+        {
+            box[2 * d] = userBoxes[b][d][0].as<PetscReal>();
+            box[2 * d + 1] = userBoxes[b][d][1].as<PetscReal>();
+        }
+        boxes.push_back(box);
+    }
+
+    const YAML::Node &bodies = config["bodies"];
+    for (unsigned int i = 0; i < bodies.size(); ++i)
+    {
+        const YAML::Node &node = bodies[i];
+        std::string type = node["type"].as<std::string>("points");
+        petibm::type::RealVec1D box(2 * dim);
+        for (PetscInt d = 0; d < dim; ++d)
+        {
+            box[2 * d] = inf;
+            box[2 * d + 1] = -inf;
+        }
+
+        // add a point (and a radius around it) to the box
+        auto extend = [&box, &dim](const petibm::type::RealVec1D &x,
+                                   const PetscReal radius, const PetscInt nd) {
+            for (PetscInt d = 0; d < std::min(dim, nd); ++d)
+            {
+                box[2 * d] = std::min(box[2 * d], x[d] - radius);
+                box[2 * d + 1] = std::max(box[2 * d + 1], x[d] + radius);
+            }
+        };
+
+        if (type == "points")
+        {
+            std::string filePath = node["file"].as<std::string>();
+            if (filePath[0] != '/')
+                filePath = config["directory"].as<std::string>() + "/" +
+                           filePath;
+
+            PetscInt nPts;
+            petibm::type::RealArray2D coords;
+            ierr = petibm::io::readLagrangianPoints(filePath, nPts, coords);
+            CHKERRQ(ierr);
+            for (PetscInt k = 0; k < nPts; ++k)
+                extend(coords.row(k), 0.0, dim);
+        }
+        else if ((type == "cylinder") || (type == "sphere"))
+        {
+            extend(node["center"].as<petibm::type::RealVec1D>(),
+                   node["radius"].as<PetscReal>(), (type == "sphere") ? 3 : 2);
+        }
+        else if (type == "plate")
+        {
+            extend(node["start"].as<petibm::type::RealVec1D>(), 0.0, 2);
+            extend(node["end"].as<petibm::type::RealVec1D>(), 0.0, 2);
+        }
+        else if (type == "naca")
+        {
+            // chord line rotated about the leading edge, padded by the
+            // largest half-thickness (t / 2 with a 4-digit designation)
+            std::string digits = node["designation"].as<std::string>();
+            PetscReal chord = node["chord"].as<PetscReal>();
+            PetscReal t = std::stod(digits.substr(2)) / 100.0;
+            PetscReal alpha =
+                node["angle"].as<PetscReal>(0.0) * PETSC_PI / 180.0;
+            petibm::type::RealVec1D le =
+                node["leadingEdge"].as<petibm::type::RealVec1D>();
+            petibm::type::RealVec1D te = {le[0] + chord * std::cos(alpha),
+                                          le[1] - chord * std::sin(alpha)};
+            extend(le, 0.5 * t * chord, 2);
+            extend(te, 0.5 * t * chord, 2);
+        }
+        else
+            SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                     "The body type \"%s\" is not recognized!\n",
+                     type.c_str());
+
+        // the 2D sections are extruded over the span in 3D
+        if ((dim == 3) && (type != "points") && (type != "sphere"))
+        {
+            petibm::type::RealVec1D span =
+                node["span"].as<petibm::type::RealVec1D>();
+            box[4] = span[0];
+            box[5] = span[1];
+        }
+
+        boxes.push_back(box);
+    }
+
+    PetscFunctionReturn(0);
+}  // getBodyBoxes
+
+PetscErrorCode designStretchedRegion(const PetscReal &length,
+                                     const PetscReal &h, const PetscReal &rMax,
+                                     PetscInt &n, PetscReal &r)
+{
+    PetscFunctionBeginUser;
+
+    // total length of n cells growing from h by a ratio r
+    auto total = [&h](const PetscReal &ratio, const PetscInt &nCells) {
+        return (std::abs(ratio - 1.0) <= 1e-12)
+                   ? nCells * h
+                   : h * (std::pow(ratio, nCells) - 1.0) / (ratio - 1.0);
+    };
+
+    // smallest number of cells with the maximum ratio
+    n = 1;
+    while (total(rMax, n) < length) ++n;
+
+    // uniform cells (no wider than h) are enough
+    r = 1.0;
+    if (n * h >= length) PetscFunctionReturn(0);
+
+    // ratio at which the n cells grow from h to fill the region exactly
+    PetscReal lo = 1.0, hi = rMax;
+    for (int it = 0; it < 200; ++it)
+    {
+        r = 0.5 * (lo + hi);
+        if (total(r, n) < length)
+            lo = r;
+        else
+            hi = r;
+    }
+    r = 0.5 * (lo + hi);
+
+    PetscFunctionReturn(0);
+}  // designStretchedRegion
+
+PetscErrorCode designAxis(const YAML::Node &axis, const PetscInt &d,
+                          const petibm::type::RealVec2D &boxes,
+                          const PetscReal &spacing, const PetscReal &rMax,
+                          const PetscReal &margin, YAML::Node &out)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    std::string dir = petibm::type::dir2str[petibm::type::Dir(d)];
+    if (axis["direction"].as<std::string>() != dir)
+        SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                 "The directions of the domain should be in the order x, y, "
+                 "z (expected %s).\n", dir.c_str());
+
+    PetscReal start = axis["start"].as<PetscReal>(),
+              end = axis["end"].as<PetscReal>();
+
+    // uniform region: all boxes (with the margin), clipped to the domain
+    PetscReal lo = std::numeric_limits<PetscReal>::max(), hi = -lo;
+    for (const auto &box : boxes)
+    {
+        lo = std::min(lo, box[2 * d] - margin);
+        hi = std::max(hi, box[2 * d + 1] + margin);
+    }
+    lo = std::max(lo, start);
+    hi = std::min(hi, end);
+    if (lo >= hi)
+        SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE,
+                 "The bodies are outside the domain in the direction %s.\n",
+                 dir.c_str());
+
+    // the uniform spacing is at most the target spacing
+    PetscInt nUniform = PetscInt(std::ceil((hi - lo) / spacing - 1e-10));
+    PetscReal h = (hi - lo) / nUniform;
+
+    out["direction"] = dir;
+    out["start"] = start;
+
+    // region between the start and the uniform region: the cells shrink
+    // toward the bodies
+    if (lo - start > 1e-12 * (end - start))
+    {
+        PetscInt n;
+        PetscReal r;
+        ierr = designStretchedRegion(lo - start, h, rMax, n, r);
+        CHKERRQ(ierr);
+        YAML::Node sub;
+        sub["end"] = lo;
+        sub["cells"] = n;
+        sub["stretchRatio"] = 1.0 / r;
+        out["subDomains"].push_back(sub);
+    }
+
+    YAML::Node uniform;
+    uniform["end"] = hi;
+    uniform["cells"] = nUniform;
+    uniform["stretchRatio"] = 1.0;
+    out["subDomains"].push_back(uniform);
+
+    // region between the uniform region and the end: the cells grow
+    if (end - hi > 1e-12 * (end - start))
+    {
+        PetscInt n;
+        PetscReal r;
+        ierr = designStretchedRegion(end - hi, h, rMax, n, r); CHKERRQ(ierr);
+        YAML::Node sub;
+        sub["end"] = end;
+        sub["cells"] = n;
+        sub["stretchRatio"] = r;
+        out["subDomains"].push_back(sub);
+    }
+
+    PetscFunctionReturn(0);
+}  // designAxis
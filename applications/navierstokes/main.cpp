@@ -67,6 +67,8 @@ int main(int argc, char **argv)
         ierr = solver.advance(); CHKERRQ(ierr);
         // output data to files
         ierr = solver.write(); CHKERRQ(ierr);
+        // apply the runtime steering settings (if any)
+        ierr = solver.steer(); CHKERRQ(ierr);
     }
 
     // destroy the Navier-Stokes solver
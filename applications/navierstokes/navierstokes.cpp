@@ -7,14 +7,70 @@
  * \ingroup nssolver
  */
 
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <petscviewerhdf5.h>
 
 #include <petibm/io.h>
+#include <petibm/misc.h>
+#include <petibm/parser.h>
 
 #include "navierstokes.h"
 
+// parameters of the 64-bit FNV-1a hash used for the key of the operator cache
+static const std::uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+static const std::uint64_t fnvPrime = 1099511628211ULL;
+
+// get the modification time (in nanoseconds) and the size of a file;
+// return false if the file does not exist
+static bool getFileStamp(const std::string &path, long long stamp[2])
+{
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) return false;
+    stamp[0] = (long long)info.st_mtim.tv_sec * 1000000000LL +
+               (long long)info.st_mtim.tv_nsec;
+    stamp[1] = (long long)info.st_size;
+    return true;
+}  // getFileStamp
+
+// set the default options of a linear solver whose operator only couples the
+// unknowns along the lines of some directions: block Jacobi with a direct
+// solve (LU, reordered with reverse Cuthill-McKee) of the local lines; the
+// options of the command line and of the configuration file prevail
+static PetscErrorCode setLineSolverDefaults(const std::string &prefix)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    const std::vector<std::pair<std::string, std::string>> defaults = {
+        {"pc_type", "bjacobi"},
+        {"sub_ksp_type", "preonly"},
+        {"sub_pc_type", "lu"},
+        {"sub_pc_factor_mat_ordering_type", "rcm"}};
+
+    for (const auto &option : defaults)
+    {
+        std::string name = "-" + prefix + "_" + option.first;
+        PetscBool set;
+        ierr = PetscOptionsHasName(nullptr, nullptr, name.c_str(), &set);
+        CHKERRQ(ierr);
+        if (set) continue;
+        ierr = PetscOptionsSetValue(nullptr, name.c_str(),
+                                    option.second.c_str()); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // setLineSolverDefaults
+
 NavierStokesSolver::NavierStokesSolver(const MPI_Comm &world,
                                        const YAML::Node &node)
 {
@@ -41,14 +97,20 @@ PetscErrorCode NavierStokesSolver::destroy()
 
     PetscFunctionBeginUser;
 
+    // the restart file may still be read in the background
+    ierr = petibm::io::joinPrefetch(); CHKERRQ(ierr);
+
     comm = MPI_COMM_NULL;
     commSize = commRank = 0;
 
     // destroy vectors of the solver (PETSc Vec objects)
     ierr = VecDestroy(&dP); CHKERRQ(ierr);
-    ierr = VecDestroy(&bc1); CHKERRQ(ierr);
     ierr = VecDestroy(&rhs1); CHKERRQ(ierr);
     ierr = VecDestroy(&rhs2); CHKERRQ(ierr);
+    ierr = VecDestroy(&UPrev); CHKERRQ(ierr);
+    ierr = VecDestroy(&ULastSave); CHKERRQ(ierr);
+    ierr = VecDestroy(&pLastSave); CHKERRQ(ierr);
+    ierr = VecDestroy(&spongeRHS); CHKERRQ(ierr);
     for (unsigned int i = 0; i < conv.size(); ++i)
     {
         ierr = VecDestroy(&conv[i]); CHKERRQ(ierr);
@@ -60,6 +122,7 @@ PetscErrorCode NavierStokesSolver::destroy()
 
     // destroy operators of the solver (PETSc Mat objects)
     ierr = MatDestroy(&A); CHKERRQ(ierr);
+    ierr = MatDestroy(&S); CHKERRQ(ierr);
     ierr = MatDestroy(&DBNG); CHKERRQ(ierr);
     ierr = MatDestroy(&BNG); CHKERRQ(ierr);
     ierr = MatDestroy(&N); CHKERRQ(ierr);
@@ -68,6 +131,8 @@ PetscErrorCode NavierStokesSolver::destroy()
     ierr = MatDestroy(&DCorrection); CHKERRQ(ierr);
     ierr = MatDestroy(&L); CHKERRQ(ierr);
     ierr = MatDestroy(&LCorrection); CHKERRQ(ierr);
+    ierr = MatDestroy(&LExplicit); CHKERRQ(ierr);
+    ierr = MatDestroy(&LCorrectionExplicit); CHKERRQ(ierr);
 
     // destroy the probes
     for (auto probe : probes)
@@ -96,9 +161,12 @@ PetscErrorCode NavierStokesSolver::init(const MPI_Comm &world, const YAML::Node
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStageRegister(
+    // start the energy metering of the logging stages (if requested)
+    ierr = petibm::misc::initEnergyMeter(world); CHKERRQ(ierr);
+
+    ierr = petibm::misc::logStageRegister(
         "initialize", &stageInitialize); CHKERRQ(ierr);
-    ierr = PetscLogStagePush(stageInitialize); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageInitialize); CHKERRQ(ierr);
 
     // record the MPI communicator, size, and process rank
     comm = world;
@@ -119,9 +187,77 @@ PetscErrorCode NavierStokesSolver::init(const MPI_Comm &world, const YAML::Node
     // get the saving frequencies
     nsave = config["parameters"]["nsave"].as<PetscInt>();
     nrestart = config["parameters"]["nrestart"].as<PetscInt>();
+    // get the policy of change-driven snapshots (if any)
+    saveThreshold = 0.0;
+    saveMinInterval = 1;
+    saveNorm = NORM_2;
+    lastSave = nstart;
+    ULastSave = pLastSave = PETSC_NULL;
+    snapshotWritten = PETSC_FALSE;
+    if (config["parameters"]["adaptiveSave"])
+    {
+        const YAML::Node &node = config["parameters"]["adaptiveSave"];
+        saveThreshold = node["threshold"].as<PetscReal>();
+        saveMinInterval = node["minInterval"].as<PetscInt>(1);
+        std::string norm = node["norm"].as<std::string>("L2");
+        if (norm == "L2")
+            saveNorm = NORM_2;
+        else if (norm == "Linf")
+            saveNorm = NORM_INFINITY;
+        else
+            SETERRQ1(comm, PETSC_ERR_ARG_WRONG,
+                     "Unknown norm \"%s\" for adaptive saving (use L2 or "
+                     "Linf)\n", norm.c_str());
+        if ((saveThreshold <= 0.0) || (saveMinInterval < 1))
+            SETERRQ(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                    "Adaptive saving requires a positive threshold and a "
+                    "minimum interval of at least one time step\n");
+    }
     // get the viscous diffusion coefficient
     nu = config["flow"]["nu"].as<PetscReal>();
 
+    // get the cases of a parameter-continuation run (if any)
+    sweepIdx = 0;
+    sweepStart = nstart;
+    sweepDone = PETSC_FALSE;
+    resetHistory = PETSC_FALSE;
+    UPrev = PETSC_NULL;
+    if (config["parameters"]["continuation"])
+    {
+        const YAML::Node &node = config["parameters"]["continuation"];
+        nuSweep = node["nu"].as<std::vector<PetscReal>>();
+        dtSweep = node["dt"].as<std::vector<PetscReal>>(
+            std::vector<PetscReal>(nuSweep.size(), dt));
+        if ((nuSweep.size() == 0) || (dtSweep.size() != nuSweep.size()))
+            SETERRQ(comm, PETSC_ERR_ARG_SIZ,
+                    "The continuation requires as many values of dt as "
+                    "values of nu\n");
+        sweepTol = node["tolerance"].as<PetscReal>(1.0e-8);
+        sweepMaxSteps = node["maxSteps"].as<PetscInt>(nt);
+        // the first case overrides the parameters of the simulation
+        nu = nuSweep[0];
+        dt = dtSweep[0];
+        config["flow"]["nu"] = nu;
+        config["parameters"]["dt"] = dt;
+    }
+
+    // get the control file of runtime steering (if any)
+    char path[PETSC_MAX_PATH_LEN];
+    PetscBool isSet = PETSC_FALSE;
+    ierr = PetscOptionsGetString(nullptr, nullptr, "-steering_file", path,
+                                 sizeof(path), &isSet); CHKERRQ(ierr);
+    steeringFile = isSet ? path : "";
+    steeringInterval = 10;
+    ierr = PetscOptionsGetInt(nullptr, nullptr, "-steering_interval",
+                              &steeringInterval, nullptr); CHKERRQ(ierr);
+    if (steeringInterval < 1)
+        SETERRQ(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                "The steering interval should be at least one time step\n");
+    // only modifications made during the run are applied
+    steeringStamp[0] = steeringStamp[1] = -1;
+    if (isSet) getFileStamp(steeringFile, steeringStamp);
+    stopRequested = PETSC_FALSE;
+
     // create the Cartesian mesh
     ierr = petibm::mesh::createMesh(comm, config, mesh); CHKERRQ(ierr);
     // write the grid points into a HDF5 file
@@ -147,17 +283,61 @@ PetscErrorCode NavierStokesSolver::init(const MPI_Comm &world, const YAML::Node
     ierr = petibm::timeintegration::createTimeIntegration(
         "diffusion", config, diffCoeffs); CHKERRQ(ierr);
 
-    // create the linear solver objects
+    // read the parts of the restart file owned by this process in the
+    // background while the operators are assembled (joined in ioInitialData)
+    PetscBool prefetch = PETSC_FALSE;
+    ierr = PetscOptionsGetBool(nullptr, nullptr, "-prefetch_restart",
+                               &prefetch, nullptr); CHKERRQ(ierr);
+    if (prefetch && (ite != 0))
+    {
+        std::stringstream ss;
+        ss << std::setfill('0') << std::setw(7) << ite;
+        ierr = prefetchRestartDataHDF5(
+            config["output"].as<std::string>() + "/" + ss.str() + ".h5");
+        CHKERRQ(ierr);
+    }
+
+    // create the linear solver objects; when the diffusion is implicit in
+    // some directions only, the velocity system defaults to direct solves of
+    // the local lines
+    if (diffCoeffs->implicitDirections.size() > 0 &&
+        PetscInt(diffCoeffs->implicitDirections.size()) < mesh->dim)
+    {
+        ierr = setLineSolverDefaults("velocity"); CHKERRQ(ierr);
+    }
     ierr = petibm::linsolver::createLinSolver(
         "velocity", config, vSolver); CHKERRQ(ierr);
     ierr = petibm::linsolver::createLinSolver(
         "poisson", config, pSolver); CHKERRQ(ierr);
 
+    // no field solution is lent yet
+    fieldViews.assign(4, PETSC_NULL);
+
+    // compute the key of the operator cache (if requested)
+    if (config["cache"])
+    {
+        ierr = createCacheKey(); CHKERRQ(ierr);
+    }
+
+    // no sponge zone until the operators are created
+    S = PETSC_NULL;
+    spongeRHS = PETSC_NULL;
+    spongeImplicit = PETSC_TRUE;
+
     // create operators (PETSc Mat objects)
     ierr = createOperators(); CHKERRQ(ierr);
 
     // create PETSc Vec objects
     ierr = createVectors(); CHKERRQ(ierr);
+    if (nuSweep.size() > 0)
+    {
+        ierr = VecDuplicate(solution->UGlobal, &UPrev); CHKERRQ(ierr);
+    }
+    if (saveThreshold > 0.0)
+    {
+        ierr = VecDuplicate(solution->UGlobal, &ULastSave); CHKERRQ(ierr);
+        ierr = VecDuplicate(solution->pGlobal, &pLastSave); CHKERRQ(ierr);
+    }
 
     // set coefficient matrix of the linear solvers
     ierr = vSolver->setMatrix(A); CHKERRQ(ierr);
@@ -175,6 +355,7 @@ PetscErrorCode NavierStokesSolver::init(const MPI_Comm &world, const YAML::Node
         ierr = petibm::misc::createProbe(mesh->comm, config["probes"][i],
                                          mesh, probes[i]); CHKERRQ(ierr);
     }
+    probeActive.assign(probes.size(), PETSC_TRUE);
 
     // create an ASCII PetscViewer to output linear solvers info
     ierr = createPetscViewerASCII(
@@ -183,22 +364,23 @@ PetscErrorCode NavierStokesSolver::init(const MPI_Comm &world, const YAML::Node
         FILE_MODE_WRITE, solversViewer); CHKERRQ(ierr);
 
     // register logging stages
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "rhsVelocity", &stageRHSVelocity); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "solveVelocity", &stageSolveVelocity); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "rhsPoisson", &stageRHSPoisson); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "solvePoisson", &stageSolvePoisson); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "update", &stageUpdate); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "write", &stageWrite); CHKERRQ(ierr);
-    ierr = PetscLogStageRegister(
+    ierr = petibm::misc::logStageRegister(
         "monitor", &stageMonitor); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageInitialize
+    // end of stageInitialize
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // init
@@ -212,14 +394,7 @@ PetscErrorCode NavierStokesSolver::ioInitialData()
 
     if (ite == 0)  // write the initial solution fields to a HDF5 file
     {
-        std::stringstream ss;
-        std::string filePath;
-        ss << std::setfill('0') << std::setw(7) << ite;
-        filePath = config["output"].as<std::string>() + "/" + ss.str() + ".h5";
-        ierr = PetscPrintf(comm, "[time step %d] Writing solution data... ",
-                            ite); CHKERRQ(ierr);
-        ierr = writeSolutionHDF5(filePath); CHKERRQ(ierr);
-        ierr = PetscPrintf(comm, "done\n"); CHKERRQ(ierr);
+        ierr = writeSnapshot(); CHKERRQ(ierr);
     }
     else  // read restart data from HDF5 file
     {
@@ -227,10 +402,25 @@ PetscErrorCode NavierStokesSolver::ioInitialData()
         std::string filePath;
         ss << std::setfill('0') << std::setw(7) << ite;
         filePath = config["output"].as<std::string>() + "/" + ss.str() + ".h5";
-        ierr = PetscPrintf(comm, "[time step %d] Reading restart data... ",
+        ierr = PetscPrintf(comm, "[time step %D] Reading restart data... ",
                             ite); CHKERRQ(ierr);
+        ierr = petibm::io::joinPrefetch(); CHKERRQ(ierr);
         ierr = readRestartDataHDF5(filePath); CHKERRQ(ierr);
         ierr = PetscPrintf(comm, "done\n"); CHKERRQ(ierr);
+
+        // the restart data is the reference of the next adaptive snapshot
+        lastSave = ite;
+        if (ULastSave != PETSC_NULL)
+        {
+            ierr = VecCopy(solution->UGlobal, ULastSave); CHKERRQ(ierr);
+            ierr = VecCopy(solution->pGlobal, pLastSave); CHKERRQ(ierr);
+        }
+    }
+
+    // record the initial velocity of a continuation run
+    if (UPrev != PETSC_NULL)
+    {
+        ierr = VecCopy(solution->UGlobal, UPrev); CHKERRQ(ierr);
     }
 
     PetscFunctionReturn(0);
@@ -275,44 +465,272 @@ PetscErrorCode NavierStokesSolver::write()
     // write linear solvers info
     ierr = writeLinSolversInfo(); CHKERRQ(ierr);
 
-    if (ite % nsave == 0)  // write solution fields
+    ierr = checkSnapshot(snapshotWritten); CHKERRQ(ierr);
+    if (snapshotWritten)  // write solution fields
     {
         std::stringstream ss;
         std::string filePath;
         ss << std::setfill('0') << std::setw(7) << ite;
-        filePath = config["output"].as<std::string>() + "/" + ss.str() + ".h5";
-        ierr = PetscPrintf(comm, "[time step %d] Writing solution data... ",
-                           ite); CHKERRQ(ierr);
-        ierr = writeSolutionHDF5(filePath); CHKERRQ(ierr);
-        ierr = PetscPrintf(comm, "done\n"); CHKERRQ(ierr);
+        ierr = writeSnapshot(); CHKERRQ(ierr);
         // output the PETSc log to an ASCII file
         filePath = config["logs"].as<std::string>() + "/" + ss.str() + ".log";
         ierr = petibm::io::writePetscLog(comm, filePath); CHKERRQ(ierr);
+        // output the energy consumed in each stage (if metered)
+        filePath = config["logs"].as<std::string>() + "/" + ss.str() +
+                   "-energy.log";
+        ierr = petibm::misc::writeEnergyLog(comm, filePath, ite - nstart);
+        CHKERRQ(ierr);
     }
     if (ite % nrestart == 0)  // write restart data
     {
-        std::string filePath;
-        std::stringstream ss;
-        ss << std::setfill('0') << std::setw(7) << ite;
-        filePath = config["output"].as<std::string>() + "/" + ss.str() + ".h5";
-        ierr = PetscPrintf(comm, "[time step %d] Writing restart data... ",
-                           ite); CHKERRQ(ierr);
-        ierr = writeRestartDataHDF5(filePath); CHKERRQ(ierr);
-        ierr = PetscPrintf(comm, "done\n"); CHKERRQ(ierr);
+        ierr = writeCheckpoint(); CHKERRQ(ierr);
     }
 
     // monitor probes and write to files
     ierr = monitorProbes(); CHKERRQ(ierr);
 
+    // move to the next case of a continuation run once converged
+    ierr = monitorContinuation(); CHKERRQ(ierr);
+
     PetscFunctionReturn(0);
 }  // write
 
 // evaluate if the simulation is finished
 bool NavierStokesSolver::finished()
 {
-    return ite >= nstart + nt;
+    return (ite >= nstart + nt) || sweepDone || stopRequested;
 }  // finished
 
+// apply the settings of the steering control file (if any)
+PetscErrorCode NavierStokesSolver::steer()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (steeringFile.empty() || (ite % steeringInterval != 0))
+        PetscFunctionReturn(0);
+
+    // the first process reads the file if it was modified since last applied
+    // (same modification time and size: unchanged)
+    std::string content;
+    PetscInt size = -1;
+    if (commRank == 0)
+    {
+        long long stamp[2];
+        if (getFileStamp(steeringFile, stamp) &&
+            ((stamp[0] != steeringStamp[0]) || (stamp[1] != steeringStamp[1])))
+        {
+            std::ifstream file(steeringFile);
+            std::stringstream ss;
+            ss << file.rdbuf();
+            content = ss.str();
+            size = content.size();
+            steeringStamp[0] = stamp[0];
+            steeringStamp[1] = stamp[1];
+        }
+    }
+    ierr = MPI_Bcast(&size, 1, MPIU_INT, 0, comm); CHKERRQ(ierr);
+    if (size < 0) PetscFunctionReturn(0);
+
+    content.resize(size);
+    ierr = MPI_Bcast(&content[0], PetscMPIInt(size), MPI_CHAR, 0, comm);
+    CHKERRQ(ierr);
+
+    // a file being written may not be valid yet: try again at the next check
+    YAML::Node node;
+    try
+    {
+        node = YAML::Load(content);
+    }
+    catch (YAML::Exception &err)
+    {
+        node = YAML::Node();
+    }
+    if (!node.IsMap())
+    {
+        if (commRank == 0) steeringStamp[0] = steeringStamp[1] = -1;
+        ierr = PetscPrintf(comm, "[time step %D] Steering file %s is not "
+                           "a valid YAML map; ignored\n", ite,
+                           steeringFile.c_str()); CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+    }
+
+    ierr = PetscPrintf(comm, "[time step %D] Applying steering file %s\n",
+                       ite, steeringFile.c_str()); CHKERRQ(ierr);
+
+    // validate all the entries into temporaries (the content is the same on
+    // all processes, so are the decisions); invalid entries are ignored
+    PetscInt newNsave = nsave, newNrestart = nrestart, newNt = nt;
+    std::vector<PetscBool> newProbeActive(probeActive);
+    PetscBool stop = PETSC_FALSE, checkpoint = PETSC_FALSE;
+    std::vector<std::string> invalid;
+
+    if (node["nsave"])
+    {
+        try
+        {
+            PetscInt value = node["nsave"].as<PetscInt>();
+            if (value < 1) throw std::out_of_range("nsave");
+            newNsave = value;
+        }
+        catch (std::exception &err)
+        {
+            invalid.push_back("nsave (a positive integer)");
+        }
+    }
+
+    if (node["nrestart"])
+    {
+        try
+        {
+            PetscInt value = node["nrestart"].as<PetscInt>();
+            if (value < 1) throw std::out_of_range("nrestart");
+            newNrestart = value;
+        }
+        catch (std::exception &err)
+        {
+            invalid.push_back("nrestart (a positive integer)");
+        }
+    }
+
+    if (node["endStep"])
+    {
+        try
+        {
+            PetscInt value = node["endStep"].as<PetscInt>();
+            if (value < ite) throw std::out_of_range("endStep");
+            newNt = value - nstart;
+        }
+        catch (std::exception &err)
+        {
+            invalid.push_back("endStep (an integer not before the current "
+                              "time step)");
+        }
+    }
+
+    // either a switch for all probes or a map of switches by probe name
+    if (node["probes"])
+    {
+        try
+        {
+            const YAML::Node &probesNode = node["probes"];
+            for (unsigned int i = 0; i < probes.size(); ++i)
+            {
+                if (probesNode.IsScalar())
+                    newProbeActive[i] = probesNode.as<bool>() ? PETSC_TRUE
+                                                              : PETSC_FALSE;
+                else if (probesNode.IsMap() &&
+                         probesNode[probes[i]->getName()])
+                    newProbeActive[i] =
+                        probesNode[probes[i]->getName()].as<bool>()
+                            ? PETSC_TRUE : PETSC_FALSE;
+                else if (!probesNode.IsMap())
+                    throw std::invalid_argument("probes");
+            }
+        }
+        catch (std::exception &err)
+        {
+            newProbeActive = probeActive;
+            invalid.push_back("probes (a boolean or a map of booleans)");
+        }
+    }
+
+    if (node["stop"])
+    {
+        try
+        {
+            stop = node["stop"].as<bool>() ? PETSC_TRUE : PETSC_FALSE;
+        }
+        catch (std::exception &err)
+        {
+            invalid.push_back("stop (a boolean)");
+        }
+    }
+
+    if (node["checkpoint"])
+    {
+        try
+        {
+            checkpoint = node["checkpoint"].as<bool>() ? PETSC_TRUE
+                                                       : PETSC_FALSE;
+        }
+        catch (std::exception &err)
+        {
+            invalid.push_back("checkpoint (a boolean)");
+        }
+    }
+
+    for (const std::string &entry : invalid)
+    {
+        ierr = PetscPrintf(comm, "\tinvalid entry ignored: %s\n",
+                           entry.c_str()); CHKERRQ(ierr);
+    }
+
+    // apply the valid settings
+    if (newNsave != nsave)
+    {
+        nsave = newNsave;
+        ierr = PetscPrintf(comm, "\tnsave: %D\n", nsave); CHKERRQ(ierr);
+    }
+
+    if (newNrestart != nrestart)
+    {
+        nrestart = newNrestart;
+        ierr = PetscPrintf(comm, "\tnrestart: %D\n", nrestart);
+        CHKERRQ(ierr);
+    }
+
+    if (newNt != nt)
+    {
+        nt = newNt;
+        ierr = PetscPrintf(comm, "\tendStep: %D\n", nstart + nt);
+        CHKERRQ(ierr);
+    }
+
+    for (unsigned int i = 0; i < probes.size(); ++i)
+    {
+        if (newProbeActive[i] == probeActive[i]) continue;
+        probeActive[i] = newProbeActive[i];
+        ierr = PetscPrintf(comm, "\tprobe %s: %s\n",
+                           probes[i]->getName().c_str(),
+                           probeActive[i] ? "active" : "inactive");
+        CHKERRQ(ierr);
+    }
+
+    // a clean stop leaves the data to restart from the current time step
+    stopRequested = stop;
+    if ((stopRequested || checkpoint) && (ite % nrestart != 0))
+    {
+        ierr = writeCheckpoint(); CHKERRQ(ierr);
+    }
+    if (stopRequested)
+    {
+        ierr = PetscPrintf(comm, "\tstop requested\n"); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // steer
+
+// write the data required to restart at the current time step
+PetscErrorCode NavierStokesSolver::writeCheckpoint()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    std::string filePath;
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(7) << ite;
+    filePath = config["output"].as<std::string>() + "/" + ss.str() + ".h5";
+    ierr = PetscPrintf(comm, "[time step %D] Writing restart data... ",
+                       ite); CHKERRQ(ierr);
+    ierr = writeRestartDataHDF5(filePath); CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "done\n"); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // writeCheckpoint
+
 // create the linear operators of the solver (PETSc Mat objects)
 PetscErrorCode NavierStokesSolver::createOperators()
 {
@@ -320,8 +738,6 @@ PetscErrorCode NavierStokesSolver::createOperators()
 
     PetscFunctionBeginUser;
 
-    Mat BN;  // a temporary operator
-
     // create the divergence operator: D
     ierr = petibm::operators::createDivergence(
         mesh, bc, D, DCorrection, PETSC_FALSE); CHKERRQ(ierr);
@@ -330,9 +746,8 @@ PetscErrorCode NavierStokesSolver::createOperators()
     ierr = petibm::operators::createGradient(
         mesh, G, PETSC_FALSE); CHKERRQ(ierr);
     
-    // create the Laplacian operator: L
-    ierr = petibm::operators::createLaplacian(
-        mesh, bc, L, LCorrection); CHKERRQ(ierr);
+    // create the Laplacian operators: L (and LExplicit)
+    ierr = createLaplacianOperators(); CHKERRQ(ierr);
     
     // create the operator for the convective terms: N
     ierr = petibm::operators::createConvection(
@@ -343,26 +758,537 @@ PetscErrorCode NavierStokesSolver::createOperators()
     ierr = MatScale(A, -diffCoeffs->implicitCoeff * nu); CHKERRQ(ierr);
     ierr = MatShift(A, 1.0 / dt); CHKERRQ(ierr);
 
-    // create the projection operator: BNG
+    // create the damping operator of the sponge zones (if any): S
+    ierr = createSpongeOperator(); CHKERRQ(ierr);
+
+    // create the projection and Poisson operators: BNG and DBNG
+    ierr = createProjectionOperators(); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createOperators
+
+// create the Laplacian operators, split between the directions in which the
+// diffusion is treated implicitly and explicitly
+PetscErrorCode NavierStokesSolver::createLaplacianOperators()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    const petibm::type::IntVec1D &dirs = diffCoeffs->implicitDirections;
+
+    ierr = petibm::operators::createLaplacian(
+        mesh, bc, L, LCorrection, dirs); CHKERRQ(ierr);
+
+    LExplicit = LCorrectionExplicit = PETSC_NULL;
+    if ((dirs.size() == 0) || (PetscInt(dirs.size()) == mesh->dim))
+        PetscFunctionReturn(0);
+
+    // the explicit part is integrated with the scheme of the convective terms
+    if (convCoeffs->nExplicit == 0)
+        SETERRQ(mesh->comm, PETSC_ERR_ARG_INCOMP,
+                "Treating the diffusion explicitly in some directions "
+                "requires an explicit scheme for the convective terms.\n");
+
+    petibm::type::IntVec1D others;
+    for (PetscInt d = 0; d < mesh->dim; ++d)
+        if (std::find(dirs.begin(), dirs.end(), d) == dirs.end())
+            others.push_back(d);
+
+    ierr = petibm::operators::createLaplacian(
+        mesh, bc, LExplicit, LCorrectionExplicit, others); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createLaplacianOperators
+
+// create the damping operator of the sponge zones and add it to A if implicit
+PetscErrorCode NavierStokesSolver::createSpongeOperator()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (!config["flow"]["sponge"]) PetscFunctionReturn(0);
+
+    const YAML::Node &node = config["flow"]["sponge"];
+    ierr = petibm::operators::createSponge(mesh, node, S); CHKERRQ(ierr);
+    spongeImplicit = node["implicit"].as<bool>(true) ? PETSC_TRUE
+                                                     : PETSC_FALSE;
+
+    // the implicit damping is added to the implicit operator
+    if (spongeImplicit)
+    {
+        ierr = MatAXPY(A, 1.0, S, SUBSET_NONZERO_PATTERN); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // createSpongeOperator
+
+// create the operator BN, the truncated Taylor series of the inverse of A
+PetscErrorCode NavierStokesSolver::createBN(Mat &BN)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
     PetscInt N;  // order of the truncate Taylor series expansion
     N = config["parameters"]["BN"].as<PetscInt>(1);
-    ierr = petibm::operators::createBnHead(
-        L, dt, diffCoeffs->implicitCoeff * nu, N, BN); CHKERRQ(ierr);
-    ierr = MatMatMult(
-        BN, G, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &BNG); CHKERRQ(ierr);
+
+    if ((S == PETSC_NULL) || !spongeImplicit)
+    {
+        ierr = petibm::operators::createBnHead(
+            L, dt, diffCoeffs->implicitCoeff * nu, N, BN); CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+    }
+
+    // with an implicit damping, A = I / dt - (coeff nu L - S)
+    Mat Op;
+    ierr = MatDuplicate(L, MAT_COPY_VALUES, &Op); CHKERRQ(ierr);
+    ierr = MatScale(Op, diffCoeffs->implicitCoeff * nu); CHKERRQ(ierr);
+    ierr = MatAXPY(Op, -1.0, S, SUBSET_NONZERO_PATTERN); CHKERRQ(ierr);
+    ierr = petibm::operators::createBnHead(Op, dt, 1.0, N, BN); CHKERRQ(ierr);
+    ierr = MatDestroy(&Op); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createBN
+
+// create the projection operator BNG and the Poisson operator DBNG
+PetscErrorCode NavierStokesSolver::createProjectionOperators()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    Mat BN;  // a temporary operator
+
+    // load the projection and Poisson operators from the cache, if possible
+    PetscInt nU, nP;  // local sizes of the velocity and pressure systems
+    PetscBool cachedBNG, cachedDBNG;
+    ierr = MatGetLocalSize(G, &nU, &nP); CHKERRQ(ierr);
+    ierr = readCachedOperator("BNG", nU, nP, BNG, cachedBNG); CHKERRQ(ierr);
+    ierr = readCachedOperator("DBNG", nP, nP, DBNG, cachedDBNG); CHKERRQ(ierr);
+
+    // create the projection operator: BNG
+    if (!cachedBNG)
+    {
+        ierr = createBN(BN); CHKERRQ(ierr);
+        ierr = MatMatMult(
+            BN, G, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &BNG); CHKERRQ(ierr);
+        ierr = writeCachedOperator("BNG", BNG); CHKERRQ(ierr);
+
+        // destroy the temporary operator
+        ierr = MatDestroy(&BN); CHKERRQ(ierr);
+    }
 
     // create the Poisson operator: DBNG
-    ierr = MatMatMult(
-        D, BNG, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &DBNG); CHKERRQ(ierr);
+    if (!cachedDBNG)
+    {
+        ierr = MatMatMult(
+            D, BNG, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &DBNG); CHKERRQ(ierr);
+        ierr = writeCachedOperator("DBNG", DBNG); CHKERRQ(ierr);
+    }
 
     // set the nullspace of the Poisson system
     ierr = setNullSpace(); CHKERRQ(ierr);
 
-    // destroy the temporary operator
-    ierr = MatDestroy(&BN); CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+}  // createProjectionOperators
+
+// get a read-only view of the local values of a field solution
+PetscErrorCode NavierStokesSolver::getFieldArrayRead(const PetscInt &field,
+                                                     const PetscReal *&array)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if ((field < 0) || (field > 3) || ((field < 3) && (field >= mesh->dim)))
+        SETERRQ1(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                 "Field %D does not exist\n", field);
+    if (fieldViews[field] != PETSC_NULL)
+        SETERRQ1(comm, PETSC_ERR_ARG_WRONGSTATE,
+                 "Field %D is already lent\n", field);
+
+    if (field == 3)
+    {
+        ierr = getPressureVec(fieldViews[field]); CHKERRQ(ierr);
+    }
+    else
+    {
+        ierr = DMCompositeGetAccessArray(mesh->UPack, solution->UGlobal, 1,
+                                         &field, &fieldViews[field]);
+        CHKERRQ(ierr);
+    }
+    ierr = VecGetArrayRead(fieldViews[field], &array); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
-}  // createOperators
+}  // getFieldArrayRead
+
+// return a view obtained with getFieldArrayRead
+PetscErrorCode NavierStokesSolver::restoreFieldArrayRead(
+    const PetscInt &field, const PetscReal *&array)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if ((field < 0) || (field > 3) || (fieldViews[field] == PETSC_NULL))
+        SETERRQ1(comm, PETSC_ERR_ARG_WRONGSTATE,
+                 "Field %D is not lent\n", field);
+
+    ierr = VecRestoreArrayRead(fieldViews[field], &array); CHKERRQ(ierr);
+    if (field != 3)
+    {
+        ierr = DMCompositeRestoreAccessArray(mesh->UPack, solution->UGlobal,
+                                             1, &field, &fieldViews[field]);
+        CHKERRQ(ierr);
+    }
+    fieldViews[field] = PETSC_NULL;
+
+    PetscFunctionReturn(0);
+}  // restoreFieldArrayRead
+
+// get the vector holding the pressure field only
+PetscErrorCode NavierStokesSolver::getPressureVec(Vec &p)
+{
+    PetscFunctionBeginUser;
+
+    p = solution->pGlobal;
+
+    PetscFunctionReturn(0);
+}  // getPressureVec
+
+// compute the key of the operator cache
+PetscErrorCode NavierStokesSolver::createCacheKey()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    cacheKey = fnvOffsetBasis;
+
+    // the solver (the definition of the operators)
+    std::string scope = getCacheScope();
+    ierr = updateCacheKey(scope.data(), scope.size()); CHKERRQ(ierr);
+
+    // the mesh and the boundary conditions (L, G, and D)
+    std::string node = YAML::Dump(config["mesh"]) +
+                       YAML::Dump(config["flow"]["boundaryConditions"]);
+    // the sponge zones (an implicit damping is part of BN)
+    if (config["flow"]["sponge"])
+        node += YAML::Dump(config["flow"]["sponge"]);
+    ierr = updateCacheKey(node.data(), node.size()); CHKERRQ(ierr);
+
+    // the coefficients and the order of the BN operator
+    PetscReal coeffs[2] = {dt, diffCoeffs->implicitCoeff * nu};
+    ierr = updateCacheKey(coeffs, sizeof(coeffs)); CHKERRQ(ierr);
+    const petibm::type::IntVec1D &dirs = diffCoeffs->implicitDirections;
+    if (dirs.size() > 0)
+    {
+        ierr = updateCacheKey(
+            dirs.data(), dirs.size() * sizeof(PetscInt)); CHKERRQ(ierr);
+    }
+    PetscInt N = config["parameters"]["BN"].as<PetscInt>(1);
+    ierr = updateCacheKey(&N, sizeof(N)); CHKERRQ(ierr);
+
+    // the layout of the processes and the distribution of the unknowns
+    PetscInt layout[4] = {commSize, mesh->nProc[0], mesh->nProc[1],
+                          mesh->nProc[2]};
+    ierr = updateCacheKey(layout, sizeof(layout)); CHKERRQ(ierr);
+    PetscInt sizes[2] = {mesh->UNLocal, mesh->pNLocal};
+    ierr = updateCacheKey(sizes, sizeof(sizes), PETSC_TRUE); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createCacheKey
+
+// mix some data into the key of the operator cache
+PetscErrorCode NavierStokesSolver::updateCacheKey(const void *data,
+                                                  const std::size_t &bytes,
+                                                  const PetscBool &local)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    const unsigned char *c = static_cast<const unsigned char *>(data);
+    std::uint64_t h = (local) ? fnvOffsetBasis : cacheKey;
+    for (std::size_t i = 0; i < bytes; ++i)
+    {
+        h ^= c[i];
+        h *= fnvPrime;
+    }
+
+    if (local)
+    {
+        // mix the hashes of all processes in the order of their ranks
+        std::vector<std::uint64_t> hashes(commSize);
+        ierr = MPI_Allgather(&h, 1, MPI_UINT64_T, hashes.data(), 1,
+                             MPI_UINT64_T, comm); CHKERRQ(ierr);
+        ierr = updateCacheKey(hashes.data(),
+                              hashes.size() * sizeof(std::uint64_t));
+        CHKERRQ(ierr);
+    }
+    else
+        cacheKey = h;
+
+    PetscFunctionReturn(0);
+}  // updateCacheKey
+
+// load an operator from the cache
+PetscErrorCode NavierStokesSolver::readCachedOperator(const std::string &name,
+                                                      const PetscInt &m,
+                                                      const PetscInt &n,
+                                                      Mat &mat,
+                                                      PetscBool &found)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    found = PETSC_FALSE;
+    if (!config["cache"]) PetscFunctionReturn(0);
+
+    std::stringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << cacheKey;
+    ierr = petibm::io::readMatCache(comm, config["cache"].as<std::string>(),
+                                    getCacheScope() + "-" + name, key.str(),
+                                    m, n, mat, found);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // readCachedOperator
+
+// store an operator in the cache
+PetscErrorCode NavierStokesSolver::writeCachedOperator(const std::string &name,
+                                                       const Mat &mat)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (!config["cache"]) PetscFunctionReturn(0);
+
+    std::stringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << cacheKey;
+    ierr = petibm::io::writeMatCache(comm, config["cache"].as<std::string>(),
+                                     getCacheScope() + "-" + name, key.str(),
+                                     mat); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // writeCachedOperator
+
+// change the viscous coefficient and the time-step size of the solver
+PetscErrorCode NavierStokesSolver::updateParameters(const PetscReal &newNu,
+                                                    const PetscReal &newDt)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    nu = newNu;
+    dt = newDt;
+    config["flow"]["nu"] = nu;
+    config["parameters"]["dt"] = dt;
+
+    // the explicit terms of the previous time steps are stale
+    resetHistory = PETSC_TRUE;
+
+    // the cached operators depend on the parameters
+    if (config["cache"])
+    {
+        ierr = createCacheKey(); CHKERRQ(ierr);
+    }
+
+    // re-scale the implicit operator of the velocity system from L
+    ierr = MatCopy(L, A, SAME_NONZERO_PATTERN); CHKERRQ(ierr);
+    ierr = MatScale(A, -diffCoeffs->implicitCoeff * nu); CHKERRQ(ierr);
+    ierr = MatShift(A, 1.0 / dt); CHKERRQ(ierr);
+    if ((S != PETSC_NULL) && spongeImplicit)
+    {
+        ierr = MatAXPY(A, 1.0, S, SUBSET_NONZERO_PATTERN); CHKERRQ(ierr);
+    }
+
+    // re-assemble the operators that depend on BN
+    ierr = MatDestroy(&BNG); CHKERRQ(ierr);
+    ierr = MatDestroy(&DBNG); CHKERRQ(ierr);
+    ierr = createProjectionOperators(); CHKERRQ(ierr);
+
+    // reset the coefficient matrices (and preconditioners) of the solvers
+    ierr = vSolver->setMatrix(A); CHKERRQ(ierr);
+    ierr = pSolver->setMatrix(DBNG); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // updateParameters
+
+// monitor the current case of a continuation run
+PetscErrorCode NavierStokesSolver::monitorContinuation()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if ((nuSweep.size() == 0) || sweepDone) PetscFunctionReturn(0);
+
+    // maximum rate of change of the velocity over the last time step
+    PetscReal rate;
+    ierr = VecAYPX(UPrev, -1.0, solution->UGlobal); CHKERRQ(ierr);
+    ierr = VecNorm(UPrev, NORM_INFINITY, &rate); CHKERRQ(ierr);
+    rate /= dt;
+    ierr = VecCopy(solution->UGlobal, UPrev); CHKERRQ(ierr);
+
+    PetscBool converged = (rate < sweepTol) ? PETSC_TRUE : PETSC_FALSE;
+    if (!converged && (ite - sweepStart < sweepMaxSteps))
+        PetscFunctionReturn(0);
+
+    ierr = PetscPrintf(comm, "[time step %D] Continuation case %D "
+                       "(nu = %g, dt = %g) %s after %D time steps "
+                       "(rate of change: %g)\n",
+                       ite, sweepIdx, (double)nu, (double)dt,
+                       converged ? "converged" : "stopped",
+                       ite - sweepStart, (double)rate); CHKERRQ(ierr);
+
+    // write the solution of the case (if not already done)
+    if (!snapshotWritten)
+    {
+        ierr = writeSnapshot(); CHKERRQ(ierr);
+        snapshotWritten = PETSC_TRUE;
+    }
+
+    sweepIdx++;
+    if (sweepIdx == (PetscInt)nuSweep.size())
+    {
+        sweepDone = PETSC_TRUE;
+        PetscFunctionReturn(0);
+    }
+
+    // the solution of the case is the initial condition of the next one
+    ierr = updateParameters(nuSweep[sweepIdx], dtSweep[sweepIdx]);
+    CHKERRQ(ierr);
+    sweepStart = ite;
+
+    PetscFunctionReturn(0);
+}  // monitorContinuation
+
+// decide whether a snapshot of the solution is due
+PetscErrorCode NavierStokesSolver::checkSnapshot(PetscBool &save)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    save = PETSC_FALSE;
+
+    if (saveThreshold <= 0.0)  // fixed frequency
+    {
+        save = (ite % nsave == 0) ? PETSC_TRUE : PETSC_FALSE;
+        PetscFunctionReturn(0);
+    }
+
+    if (ite - lastSave >= nsave)  // maximum interval reached
+    {
+        save = PETSC_TRUE;
+        PetscFunctionReturn(0);
+    }
+
+    if (ite - lastSave < saveMinInterval) PetscFunctionReturn(0);
+
+    // relative change of the velocity and of the pressure since the last
+    // snapshot; both norms are reduced with a single collective call
+    const Vec current[2] = {solution->UGlobal, solution->pGlobal};
+    const Vec last[2] = {ULastSave, pLastSave};
+    PetscReal norms[4] = {0.0, 0.0, 0.0, 0.0};  // (change, reference) pairs
+
+    for (unsigned int f = 0; f < 2; ++f)
+    {
+        PetscInt n;
+        const PetscScalar *x, *x0;
+
+        ierr = VecGetLocalSize(current[f], &n); CHKERRQ(ierr);
+        ierr = VecGetArrayRead(current[f], &x); CHKERRQ(ierr);
+        ierr = VecGetArrayRead(last[f], &x0); CHKERRQ(ierr);
+        for (PetscInt i = 0; i < n; ++i)
+        {
+            PetscReal dx = PetscAbsScalar(x[i] - x0[i]),
+                      ref = PetscAbsScalar(x0[i]);
+            if (saveNorm == NORM_2)
+            {
+                norms[2 * f] += dx * dx;
+                norms[2 * f + 1] += ref * ref;
+            }
+            else
+            {
+                norms[2 * f] = PetscMax(norms[2 * f], dx);
+                norms[2 * f + 1] = PetscMax(norms[2 * f + 1], ref);
+            }
+        }
+        ierr = VecRestoreArrayRead(last[f], &x0); CHKERRQ(ierr);
+        ierr = VecRestoreArrayRead(current[f], &x); CHKERRQ(ierr);
+    }
+
+    ierr = MPI_Allreduce(MPI_IN_PLACE, norms, 4, MPIU_REAL,
+                         (saveNorm == NORM_2) ? MPIU_SUM : MPIU_MAX, comm);
+    CHKERRQ(ierr);
+
+    PetscReal change = 0.0;
+    for (unsigned int f = 0; f < 2; ++f)
+    {
+        if (saveNorm == NORM_2)
+        {
+            norms[2 * f] = PetscSqrtReal(norms[2 * f]);
+            norms[2 * f + 1] = PetscSqrtReal(norms[2 * f + 1]);
+        }
+        // absolute change for a field that was zero at the last snapshot
+        change = PetscMax(change, norms[2 * f] / ((norms[2 * f + 1] > 0.0)
+                                                      ? norms[2 * f + 1]
+                                                      : 1.0));
+    }
+
+    save = (change >= saveThreshold) ? PETSC_TRUE : PETSC_FALSE;
+
+    PetscFunctionReturn(0);
+}  // checkSnapshot
+
+// write a snapshot of the solution fields and record it in the index file
+PetscErrorCode NavierStokesSolver::writeSnapshot()
+{
+    PetscErrorCode ierr;
+    PetscViewer viewer;
+
+    PetscFunctionBeginUser;
+
+    std::stringstream ss;
+    std::string filePath;
+    ss << std::setfill('0') << std::setw(7) << ite;
+    filePath = config["output"].as<std::string>() + "/" + ss.str() + ".h5";
+    ierr = PetscPrintf(comm, "[time step %D] Writing solution data... ",
+                       ite); CHKERRQ(ierr);
+    ierr = writeSolutionHDF5(filePath); CHKERRQ(ierr);
+    ierr = PetscPrintf(comm, "done\n"); CHKERRQ(ierr);
+
+    // a new index is started with the initial solution
+    filePath = config["output"].as<std::string>() + "/snapshots.txt";
+    ierr = createPetscViewerASCII(
+        filePath, (ite == 0) ? FILE_MODE_WRITE : FILE_MODE_APPEND, viewer);
+    CHKERRQ(ierr);
+    if (ite == 0)
+    {
+        ierr = PetscViewerASCIIPrintf(viewer, "# time step, time\n");
+        CHKERRQ(ierr);
+    }
+    ierr = PetscViewerASCIIPrintf(viewer, "%D %.10e\n", ite, (double)t);
+    CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+
+    // the snapshot is the reference of the next adaptive one
+    lastSave = ite;
+    if (ULastSave != PETSC_NULL)
+    {
+        ierr = VecCopy(solution->UGlobal, ULastSave); CHKERRQ(ierr);
+        ierr = VecCopy(solution->pGlobal, pLastSave); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // writeSnapshot
 
 // create the vectors of the solver (PETSc Vec objects)
 PetscErrorCode NavierStokesSolver::createVectors()
@@ -372,7 +1298,6 @@ PetscErrorCode NavierStokesSolver::createVectors()
     PetscFunctionBeginUser;
 
     ierr = VecDuplicate(solution->pGlobal, &dP); CHKERRQ(ierr);
-    ierr = VecDuplicate(solution->UGlobal, &bc1); CHKERRQ(ierr);
     ierr = VecDuplicate(solution->UGlobal, &rhs1); CHKERRQ(ierr);
     ierr = VecDuplicate(solution->pGlobal, &rhs2); CHKERRQ(ierr);
 
@@ -388,6 +1313,37 @@ PetscErrorCode NavierStokesSolver::createVectors()
         ierr = VecDuplicate(solution->UGlobal, &diff[i]); CHKERRQ(ierr);
     }
 
+    // damping of the reference state in the sponge zones: S u_ref
+    // (the reference state defaults to the initial velocity)
+    if (S != PETSC_NULL)
+    {
+        petibm::type::RealVec1D ref;
+        ierr = petibm::parser::parseICs(config, ref); CHKERRQ(ierr);
+        const YAML::Node &node = config["flow"]["sponge"]["reference"];
+        for (unsigned int i = 0; i < node.size(); ++i)
+            ref[i] = node[i].as<PetscReal>();
+
+        Vec URef;
+        std::vector<Vec> URefs(mesh->dim);
+        ierr = petibm::misc::getWorkVec(
+            mesh->UPack, PETSC_FALSE, URef); CHKERRQ(ierr);
+        ierr = DMCompositeGetAccessArray(
+            mesh->UPack, URef, mesh->dim, nullptr, URefs.data());
+        CHKERRQ(ierr);
+        for (PetscInt f = 0; f < mesh->dim; ++f)
+        {
+            ierr = VecSet(URefs[f], ref[f]); CHKERRQ(ierr);
+        }
+        ierr = DMCompositeRestoreAccessArray(
+            mesh->UPack, URef, mesh->dim, nullptr, URefs.data());
+        CHKERRQ(ierr);
+
+        ierr = VecDuplicate(solution->UGlobal, &spongeRHS); CHKERRQ(ierr);
+        ierr = MatMult(S, URef, spongeRHS); CHKERRQ(ierr);
+        ierr = petibm::misc::restoreWorkVec(
+            mesh->UPack, PETSC_FALSE, URef); CHKERRQ(ierr);
+    }
+
     PetscFunctionReturn(0);
 }  // createVectors
 
@@ -435,7 +1391,7 @@ PetscErrorCode NavierStokesSolver::assembleRHSVelocity()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageRHSVelocity); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageRHSVelocity); CHKERRQ(ierr);
 
     // initialize RHS vector with pressure gradient at time-step n
     // $rhs_1 = - \frac{\partial p^n}{\partial x}$
@@ -446,12 +1402,29 @@ PetscErrorCode NavierStokesSolver::assembleRHSVelocity()
     // $rhs_1 += \frac{u^n}{\Delta t}$
     ierr = VecAXPY(rhs1, 1.0 / dt, solution->UGlobal); CHKERRQ(ierr);
 
+    // add the damping toward the reference state in the sponge zones
+    // $rhs_1 += S u_{ref}$ (and $rhs_1 -= S u^n$ if the damping is explicit)
+    if (S != PETSC_NULL)
+    {
+        ierr = VecAXPY(rhs1, 1.0, spongeRHS); CHKERRQ(ierr);
+        if (!spongeImplicit)
+        {
+            Vec damping;
+            ierr = petibm::misc::getWorkVec(
+                mesh->UPack, PETSC_FALSE, damping); CHKERRQ(ierr);
+            ierr = MatMult(S, solution->UGlobal, damping); CHKERRQ(ierr);
+            ierr = VecAXPY(rhs1, -1.0, damping); CHKERRQ(ierr);
+            ierr = petibm::misc::restoreWorkVec(
+                mesh->UPack, PETSC_FALSE, damping); CHKERRQ(ierr);
+        }
+    }
+
     // add all explicit convective terms to the RHS vector
     // $rhs_1 += \sum_{k=0}^s conv_{n - k}$
     {
         // 1. discard the term at the oldest time-step
         // and decrease the time-step by 1
-        for (int i = conv.size() - 1; i > 0; i--)
+        for (PetscInt i = conv.size() - 1; i > 0; i--)
         {
             ierr = VecSwap(conv[i], conv[i - 1]); CHKERRQ(ierr);
         }
@@ -464,9 +1437,34 @@ PetscErrorCode NavierStokesSolver::assembleRHSVelocity()
             // 3. scale the newest convective term by -1
             // (to be added to the RHS vector)
             ierr = VecScale(conv[0], -1.0); CHKERRQ(ierr);
+
+            // 4. add the diffusion in the directions treated explicitly,
+            // which shares the time-integration scheme of the convection
+            if (LExplicit != PETSC_NULL)
+            {
+                Vec diffE;
+                ierr = petibm::misc::getWorkVec(
+                    mesh->UPack, PETSC_FALSE, diffE); CHKERRQ(ierr);
+                ierr = MatMult(LExplicit, solution->UGlobal, diffE);
+                CHKERRQ(ierr);
+                ierr = MatMultAdd(LCorrectionExplicit, solution->UGlobal,
+                                  diffE, diffE); CHKERRQ(ierr);
+                ierr = VecAXPY(conv[0], nu, diffE); CHKERRQ(ierr);
+                ierr = petibm::misc::restoreWorkVec(
+                    mesh->UPack, PETSC_FALSE, diffE); CHKERRQ(ierr);
+            }
+
+            // 5. after a switch of parameters, the older terms (computed
+            // with the old viscosity and time-step size) are replaced with
+            // the newest one: the explicit coefficients sum up to one, so
+            // the time step is a first-order explicit Euler step
+            for (unsigned int i = 1; resetHistory && i < conv.size(); ++i)
+            {
+                ierr = VecCopy(conv[0], conv[i]); CHKERRQ(ierr);
+            }
         }
 
-        // 4. add all explicit convective terms to the RHS vector
+        // 6. add all explicit convective terms to the RHS vector
         for (unsigned int i = 0; i < conv.size(); ++i)
         {
             ierr = VecAXPY(rhs1, convCoeffs->explicitCoeffs[i], conv[i]);
@@ -479,7 +1477,7 @@ PetscErrorCode NavierStokesSolver::assembleRHSVelocity()
     {
         // 1. discard the term at the oldest time-step
         // and decrease the time-step by 1
-        for (int i = diff.size() - 1; i > 0; i--)
+        for (PetscInt i = diff.size() - 1; i > 0; i--)
         {
             ierr = VecSwap(diff[i], diff[i - 1]); CHKERRQ(ierr);
         }
@@ -491,15 +1489,22 @@ PetscErrorCode NavierStokesSolver::assembleRHSVelocity()
             ierr = MatMultAdd(
                 LCorrection, solution->UGlobal, diff[0], diff[0]); CHKERRQ(ierr);
             ierr = VecScale(diff[0], nu); CHKERRQ(ierr);
+
+            // 3. after a switch of parameters, discard the older terms
+            for (unsigned int i = 1; resetHistory && i < diff.size(); ++i)
+            {
+                ierr = VecCopy(diff[0], diff[i]); CHKERRQ(ierr);
+            }
         }
 
-        // 3. add all explicit diffusion terms to the RHS vector
+        // 4. add all explicit diffusion terms to the RHS vector
         for (unsigned int i = 0; i < diff.size(); ++i)
         {
             ierr = VecAXPY(
                 rhs1, diffCoeffs->explicitCoeffs[i], diff[i]); CHKERRQ(ierr);
         }
     }
+    resetHistory = PETSC_FALSE;
 
     // add implicit BC correction terms arising from the diffusion term
     // to the RHS vector
@@ -507,15 +1512,21 @@ PetscErrorCode NavierStokesSolver::assembleRHSVelocity()
         // 1. update the ghost-point equations
         ierr = bc->updateEqs(solution, dt); CHKERRQ(ierr);
 
-        // 2. compute the implicit BC correction terms
+        // 2. compute the implicit BC correction terms in a work vector
+        Vec bc1;
+        ierr = petibm::misc::getWorkVec(
+            mesh->UPack, PETSC_FALSE, bc1); CHKERRQ(ierr);
         ierr = MatMult(LCorrection, solution->UGlobal, bc1); CHKERRQ(ierr);
         ierr = VecScale(bc1, nu); CHKERRQ(ierr);
 
         // 3. add the correction terms to the RHS vector
         ierr = VecAXPY(rhs1, diffCoeffs->implicitCoeff, bc1); CHKERRQ(ierr);
+        ierr = petibm::misc::restoreWorkVec(
+            mesh->UPack, PETSC_FALSE, bc1); CHKERRQ(ierr);
     }
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageRHSVelocity
+    // end of stageRHSVelocity
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // assembleRHSVelocity
@@ -527,11 +1538,12 @@ PetscErrorCode NavierStokesSolver::solveVelocity()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageSolveVelocity); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageSolveVelocity); CHKERRQ(ierr);
 
     ierr = vSolver->solve(solution->UGlobal, rhs1); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageSolveVelocity
+    // end of stageSolveVelocity
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // solveVelocity
@@ -543,7 +1555,7 @@ PetscErrorCode NavierStokesSolver::assembleRHSPoisson()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageRHSPoisson); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageRHSPoisson); CHKERRQ(ierr);
 
     // compute the divergence of the intermediate velocity field
     ierr = MatMult(D, solution->UGlobal, rhs2); CHKERRQ(ierr);
@@ -557,7 +1569,8 @@ PetscErrorCode NavierStokesSolver::assembleRHSPoisson()
         ierr = VecAssemblyEnd(rhs2); CHKERRQ(ierr);
     }
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageRHSPoisson
+    // end of stageRHSPoisson
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // assembleRHSPoisson
@@ -569,12 +1582,13 @@ PetscErrorCode NavierStokesSolver::solvePoisson()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageSolvePoisson); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageSolvePoisson); CHKERRQ(ierr);
 
     // solve for the pressure correction
     ierr = pSolver->solve(dP, rhs2); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageSolvePoisson
+    // end of stageSolvePoisson
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // solvePoisson
@@ -586,13 +1600,13 @@ PetscErrorCode NavierStokesSolver::applyDivergenceFreeVelocity()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageUpdate); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageUpdate); CHKERRQ(ierr);
 
     // u = u - BN G dp
     ierr = MatMult(BNG, dP, rhs1); CHKERRQ(ierr);
     ierr = VecAXPY(solution->UGlobal, -1.0, rhs1); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageUpdate
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageUpdate
 
     PetscFunctionReturn(0);
 }  // applyDivergenceFreeVelocity
@@ -604,12 +1618,12 @@ PetscErrorCode NavierStokesSolver::updatePressure()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageUpdate); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageUpdate); CHKERRQ(ierr);
 
     // p = p + dp
     ierr = VecAXPY(solution->pGlobal, 1.0, dP); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageUpdate
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageUpdate
 
     PetscFunctionReturn(0);
 }  // updatePressure
@@ -621,14 +1635,14 @@ PetscErrorCode NavierStokesSolver::writeSolutionHDF5(const std::string &filePath
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
     // write the solution fields to a file
     ierr = solution->write(filePath); CHKERRQ(ierr);
     // write the time value as an attribute of the pressure field dataset
     ierr = writeTimeHDF5(t, filePath); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageWrite
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageWrite
 
     PetscFunctionReturn(0);
 }  // writeSolutionHDF5
@@ -638,12 +1652,12 @@ PetscErrorCode NavierStokesSolver::writeRestartDataHDF5(
     const std::string &filePath)
 {
     PetscErrorCode ierr;
-    PetscViewer viewer;
     PetscBool fileExist = PETSC_FALSE;
+    std::vector<std::string> names;
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
     // check if file exist
     ierr = PetscTestFile(filePath.c_str(), 'w', &fileExist); CHKERRQ(ierr);
@@ -653,36 +1667,19 @@ PetscErrorCode NavierStokesSolver::writeRestartDataHDF5(
         ierr = writeSolutionHDF5(filePath); CHKERRQ(ierr);
     }
 
-    // create PetscViewer object with append mode
-    ierr = PetscViewerCreate(comm, &viewer); CHKERRQ(ierr);
-    ierr = PetscViewerSetType(viewer, PETSCVIEWERHDF5); CHKERRQ(ierr);
-    ierr = PetscViewerFileSetMode(viewer, FILE_MODE_APPEND); CHKERRQ(ierr);
-    ierr = PetscViewerFileSetName(viewer, filePath.c_str()); CHKERRQ(ierr);
-
-    // go to the root node first (just in case, not necessary)
-    ierr = PetscViewerHDF5PushGroup(viewer, "/"); CHKERRQ(ierr);
-
     // write explicit convective terms
-    ierr = PetscViewerHDF5PushGroup(viewer, "/convection"); CHKERRQ(ierr);
-    for (unsigned int i = 0; i < conv.size(); ++i)
-    {
-        ierr = PetscObjectSetName(
-            (PetscObject)conv[i], std::to_string(i).c_str()); CHKERRQ(ierr);
-        ierr = VecView(conv[i], viewer); CHKERRQ(ierr);
-    }
-    // write explicit diffusion terms
-    ierr = PetscViewerHDF5PushGroup(viewer, "/diffusion"); CHKERRQ(ierr);
-    for (unsigned int i = 0; i < diff.size(); ++i)
-    {
-        ierr = PetscObjectSetName(
-            (PetscObject)diff[i], std::to_string(i).c_str()); CHKERRQ(ierr);
-        ierr = VecView(diff[i], viewer); CHKERRQ(ierr);
-    }
+    names.resize(conv.size());
+    for (unsigned int i = 0; i < conv.size(); ++i) names[i] = std::to_string(i);
+    ierr = petibm::io::writeHDF5Vecs(comm, filePath, "/convection", names, conv,
+                                     FILE_MODE_APPEND); CHKERRQ(ierr);
 
-    // destroy viewer
-    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+    // write explicit diffusion terms
+    names.resize(diff.size());
+    for (unsigned int i = 0; i < diff.size(); ++i) names[i] = std::to_string(i);
+    ierr = petibm::io::writeHDF5Vecs(comm, filePath, "/diffusion", names, diff,
+                                     FILE_MODE_APPEND); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageWrite
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageWrite
 
     PetscFunctionReturn(0);
 }  // writeRestartDataHDF5
@@ -692,8 +1689,8 @@ PetscErrorCode NavierStokesSolver::readRestartDataHDF5(
     const std::string &filePath)
 {
     PetscErrorCode ierr;
-    PetscViewer viewer;
     PetscBool fileExist = PETSC_FALSE;
+    std::vector<std::string> names;
 
     PetscFunctionBeginUser;
 
@@ -709,34 +1706,17 @@ PetscErrorCode NavierStokesSolver::readRestartDataHDF5(
     ierr = solution->read(filePath); CHKERRQ(ierr);
     ierr = readTimeHDF5(filePath, t); CHKERRQ(ierr);
 
-    // create a PetscViewer object with append mode
-    ierr = PetscViewerCreate(comm, &viewer); CHKERRQ(ierr);
-    ierr = PetscViewerSetType(viewer, PETSCVIEWERHDF5); CHKERRQ(ierr);
-    ierr = PetscViewerFileSetMode(viewer, FILE_MODE_READ); CHKERRQ(ierr);
-    ierr = PetscViewerFileSetName(viewer, filePath.c_str()); CHKERRQ(ierr);
-
-    // go to the root node first (just in case, not necessary)
-    ierr = PetscViewerHDF5PushGroup(viewer, "/"); CHKERRQ(ierr);
-
     // read explicit convective terms
-    ierr = PetscViewerHDF5PushGroup(viewer, "/convection"); CHKERRQ(ierr);
-    for (unsigned int i = 0; i < conv.size(); ++i)
-    {
-        ierr = PetscObjectSetName(
-            (PetscObject)conv[i], std::to_string(i).c_str()); CHKERRQ(ierr);
-        ierr = VecLoad(conv[i], viewer); CHKERRQ(ierr);
-    }
-    // read explicit diffusion terms
-    ierr = PetscViewerHDF5PushGroup(viewer, "/diffusion"); CHKERRQ(ierr);
-    for (unsigned int i = 0; i < diff.size(); ++i)
-    {
-        ierr = PetscObjectSetName(
-            (PetscObject)diff[i], std::to_string(i).c_str()); CHKERRQ(ierr);
-        ierr = VecLoad(diff[i], viewer); CHKERRQ(ierr);
-    }
+    names.resize(conv.size());
+    for (unsigned int i = 0; i < conv.size(); ++i) names[i] = std::to_string(i);
+    ierr = petibm::io::readHDF5Vecs(comm, filePath, "/convection", names, conv);
+    CHKERRQ(ierr);
 
-    // destroy viewer
-    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+    // read explicit diffusion terms
+    names.resize(diff.size());
+    for (unsigned int i = 0; i < diff.size(); ++i) names[i] = std::to_string(i);
+    ierr = petibm::io::readHDF5Vecs(comm, filePath, "/diffusion", names, diff);
+    CHKERRQ(ierr);
 
     // update ghost-point values and equations based on the current solutio
     // TODO: for convective BCs, it's not totally correct
@@ -745,6 +1725,50 @@ PetscErrorCode NavierStokesSolver::readRestartDataHDF5(
     PetscFunctionReturn(0);
 }  // readRestartDataHDF5
 
+// start reading the restart data of this process in the background
+PetscErrorCode NavierStokesSolver::prefetchRestartDataHDF5(
+    const std::string &filePath)
+{
+    PetscErrorCode ierr;
+    std::vector<std::string> names(mesh->dim + 1);
+    std::vector<Vec> vecs(mesh->dim + 1);
+
+    PetscFunctionBeginUser;
+
+    // primary fields
+    for (PetscInt f = 0; f < mesh->dim; ++f)
+        names[f] = petibm::type::fd2str[petibm::type::Field(f)];
+    names.back() = "p";
+    ierr = DMCompositeGetAccessArray(mesh->UPack, solution->UGlobal,
+                                     mesh->dim, nullptr, vecs.data());
+    CHKERRQ(ierr);
+    vecs.back() = solution->pGlobal;
+    ierr = petibm::io::prefetchHDF5Vecs(filePath, "/", names, vecs);
+    CHKERRQ(ierr);
+    vecs.back() = PETSC_NULL;
+    ierr = DMCompositeRestoreAccessArray(mesh->UPack, solution->UGlobal,
+                                         mesh->dim, nullptr, vecs.data());
+    CHKERRQ(ierr);
+
+    // explicit convective and diffusion terms (not created yet), which have
+    // the layout of the velocity
+    names.resize(convCoeffs->nExplicit);
+    for (unsigned int i = 0; i < names.size(); ++i)
+        names[i] = std::to_string(i);
+    vecs.assign(names.size(), solution->UGlobal);
+    ierr = petibm::io::prefetchHDF5Vecs(filePath, "/convection", names, vecs);
+    CHKERRQ(ierr);
+
+    names.resize(diffCoeffs->nExplicit);
+    for (unsigned int i = 0; i < names.size(); ++i)
+        names[i] = std::to_string(i);
+    vecs.assign(names.size(), solution->UGlobal);
+    ierr = petibm::io::prefetchHDF5Vecs(filePath, "/diffusion", names, vecs);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // prefetchRestartDataHDF5
+
 // initialize an ASCII PetscViewer object
 PetscErrorCode NavierStokesSolver::createPetscViewerASCII(
     const std::string &filePath, const PetscFileMode &mode,
@@ -771,24 +1795,24 @@ PetscErrorCode NavierStokesSolver::writeLinSolversInfo()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
     // write the time value
-    ierr = PetscViewerASCIIPrintf(solversViewer, "%d\t", ite); CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(solversViewer, "%D\t", ite); CHKERRQ(ierr);
 
     // write iterations number and residual for the velocity solver
     ierr = vSolver->getIters(nIters); CHKERRQ(ierr);
     ierr = vSolver->getResidual(res); CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(
-        solversViewer, "%d\t%e\t", nIters, res); CHKERRQ(ierr);
+        solversViewer, "%D\t%e\t", nIters, res); CHKERRQ(ierr);
 
     // write iterations number and residual for the Poisson solver
     ierr = pSolver->getIters(nIters); CHKERRQ(ierr);
     ierr = pSolver->getResidual(res); CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(
-        solversViewer, "%d\t%e\n", nIters, res); CHKERRQ(ierr);
+        solversViewer, "%D\t%e\n", nIters, res); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageWrite
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageWrite
 
     PetscFunctionReturn(0);
 }  // writeLinSolversInfo
@@ -842,14 +1866,15 @@ PetscErrorCode NavierStokesSolver::monitorProbes()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageMonitor); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageMonitor); CHKERRQ(ierr);
 
-    for (auto probe : probes)
+    for (unsigned int i = 0; i < probes.size(); ++i)
     {
-        ierr = probe->monitor(solution, mesh, ite, t); CHKERRQ(ierr);
+        if (!probeActive[i]) continue;
+        ierr = probes[i]->monitor(solution, mesh, ite, t); CHKERRQ(ierr);
     }
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageMonitor
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageMonitor
 
     PetscFunctionReturn(0);
 }  // monitorProbes
@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+
 #include <yaml-cpp/yaml.h>
 
 #include <petibm/boundary.h>
@@ -72,6 +75,57 @@ public:
     /** \brief Evaluate if the simulation is finished. */
     bool finished();
 
+    /** \brief Apply the settings of the steering control file (if any).
+     *
+     * Every `-steering_interval` time steps, the first process checks the
+     * control file given with the command-line option `-steering_file`; when
+     * it was modified since it was last applied (or since the start of the
+     * run), its YAML content is broadcast and applied by all processes. The
+     * file may change `nsave`, `nrestart`, the last time step (`endStep`),
+     * and the probes that are active (`probes`), and it may request a
+     * checkpoint (`checkpoint`) or a clean stop (`stop`) at the current time
+     * step. All the entries are validated before any is applied; an invalid
+     * entry is ignored with a warning.
+     *
+     * \return PetscErrorCode
+     */
+    PetscErrorCode steer();
+
+    /** \brief Get the structured Cartesian mesh.
+     *
+     * The mesh provides the gridlines and the local box (`bg`, `ed`) of each
+     * field owned by this process.
+     */
+    const petibm::type::Mesh &getMesh() const { return mesh; };
+
+    /** \brief Get the time value of the solution. */
+    PetscReal getTime() const { return t; };
+
+    /** \brief Get a read-only view of the local values of a field solution.
+     *
+     * No data are copied: the array points to the values of the field owned
+     * by this process, in the layout of the DMDA of the field (the x index
+     * runs the fastest over the local box `mesh->bg[field]` to
+     * `mesh->ed[field]`). The view must be returned with
+     * restoreFieldArrayRead before the solution is advanced.
+     *
+     * \param field [in] Index of the field (0, 1, 2 for the velocity
+     *                   components, 3 for the pressure)
+     * \param array [out] Read-only array of local values
+     * \return PetscErrorCode
+     */
+    PetscErrorCode getFieldArrayRead(const PetscInt &field,
+                                     const PetscReal *&array);
+
+    /** \brief Return a view obtained with getFieldArrayRead.
+     *
+     * \param field [in] Index of the field
+     * \param array [in, out] Read-only array of local values
+     * \return PetscErrorCode
+     */
+    PetscErrorCode restoreFieldArrayRead(const PetscInt &field,
+                                         const PetscReal *&array);
+
 protected:
     /** \brief MPI communicator. */
     MPI_Comm comm;
@@ -124,7 +178,8 @@ protected:
     /** \brief Number of time steps to compute. */
     PetscInt nt;
 
-    /** \brief Frequency at which the solution fields are written to files. */
+    /** \brief Frequency at which the solution fields are written to files
+     * (maximum interval between snapshots with adaptive saving). */
     PetscInt nsave;
 
     /** \brief Frequency at which data to restart are written to files. */
@@ -139,6 +194,14 @@ protected:
     /** \brief Laplacian correction operator for boundary conditions. */
     Mat LCorrection;
 
+    /** \brief Laplacian operator in the directions where the diffusion is
+     * treated explicitly (null if it is implicit in all directions). */
+    Mat LExplicit;
+
+    /** \brief Laplacian correction operator in the directions where the
+     * diffusion is treated explicitly (null if none). */
+    Mat LCorrectionExplicit;
+
     /** \brief Gradient operator. */
     Mat G;
 
@@ -160,12 +223,18 @@ protected:
     /** \brief Poisson operator. */
     Mat DBNG;
 
+    /** \brief Damping rates of the sponge zones (diagonal; null if none). */
+    Mat S;
+
+    /** \brief Whether the sponge damping is folded into the operator A. */
+    PetscBool spongeImplicit;
+
+    /** \brief Damping of the reference state in the sponge zones. */
+    Vec spongeRHS;
+
     /** \brief Pressure-correction vector. */
     Vec dP;
 
-    /** \brief Inhomogeneous boundary terms for the velocity system. */
-    Vec bc1;
-
     /** \brief Right-hand side vector of the velocity system. */
     Vec rhs1;
 
@@ -208,6 +277,72 @@ protected:
     /** \brief ASCII PetscViewer object to output solvers info. */
     PetscViewer solversViewer;
 
+    /** \brief Field vectors currently lent through getFieldArrayRead. */
+    std::vector<Vec> fieldViews;
+
+    /** \brief Key of the operator cache (hash of the configuration). */
+    std::uint64_t cacheKey;
+
+    /** \brief Values of the viscous coefficient of a continuation run. */
+    std::vector<PetscReal> nuSweep;
+
+    /** \brief Values of the time-step size of a continuation run. */
+    std::vector<PetscReal> dtSweep;
+
+    /** \brief Index of the current case of a continuation run. */
+    PetscInt sweepIdx;
+
+    /** \brief Time-step index at which the current case started. */
+    PetscInt sweepStart;
+
+    /** \brief Maximum number of time steps of a case. */
+    PetscInt sweepMaxSteps;
+
+    /** \brief Steady-state tolerance on the rate of change of the velocity. */
+    PetscReal sweepTol;
+
+    /** \brief True once the last case of a continuation run is done. */
+    PetscBool sweepDone;
+
+    /** \brief True until the first time step after a switch of parameters. */
+    PetscBool resetHistory;
+
+    /** \brief Velocity at the previous time step (continuation run only). */
+    Vec UPrev;
+
+    /** \brief Relative change that triggers a snapshot (0: every nsave). */
+    PetscReal saveThreshold;
+
+    /** \brief Minimum number of time steps between adaptive snapshots. */
+    PetscInt saveMinInterval;
+
+    /** \brief Norm used to measure the change since the last snapshot. */
+    NormType saveNorm;
+
+    /** \brief Time-step index of the last snapshot. */
+    PetscInt lastSave;
+
+    /** \brief Velocity and pressure of the last snapshot (adaptive only). */
+    Vec ULastSave, pLastSave;
+
+    /** \brief Whether a snapshot was written at the current time step. */
+    PetscBool snapshotWritten;
+
+    /** \brief Path of the steering control file (empty: no steering). */
+    std::string steeringFile;
+
+    /** \brief Number of time steps between two checks of the control file. */
+    PetscInt steeringInterval;
+
+    /** \brief Modification time (ns) and size of the file last applied. */
+    long long steeringStamp[2];
+
+    /** \brief Whether a clean stop was requested. */
+    PetscBool stopRequested;
+
+    /** \brief Whether each probe is active. */
+    std::vector<PetscBool> probeActive;
+
     /** \brief Assemble the RHS vector of the velocity system. */
     virtual PetscErrorCode assembleRHSVelocity();
 
@@ -227,12 +362,97 @@ protected:
     /** \brief Create operators. */
     virtual PetscErrorCode createOperators();
 
+    /** \brief Create the Laplacian operators.
+     *
+     * L and LCorrection only hold the directions in which the diffusion is
+     * treated implicitly; the other directions go to LExplicit and
+     * LCorrectionExplicit.
+     */
+    virtual PetscErrorCode createLaplacianOperators();
+
+    /** \brief Create the damping operator of the sponge zones (if any).
+     *
+     * With an implicit damping, the operator is added to A.
+     */
+    virtual PetscErrorCode createSpongeOperator();
+
+    /** \brief Create the operator BN, approximate inverse of A.
+     *
+     * The implicit damping of the sponge zones (if any) is included, so that
+     * the projection step is consistent with the velocity system.
+     *
+     * \param BN [out] Operator BN
+     */
+    PetscErrorCode createBN(Mat &BN);
+
+    /** \brief Create the projection operator and the Poisson operator.
+     *
+     * Both products depend on BN, hence on the viscous coefficient and on
+     * the time-step size.
+     */
+    virtual PetscErrorCode createProjectionOperators();
+
     /** \brief Create vectors. */
     virtual PetscErrorCode createVectors();
 
     /** \brief Set Poisson nullspace or pin pressure at a reference point. */
     virtual PetscErrorCode setNullSpace();
 
+    /** \brief Get the vector holding the pressure field only.
+     *
+     * \param p [out] Pressure vector (not a copy)
+     * \return PetscErrorCode
+     */
+    virtual PetscErrorCode getPressureVec(Vec &p);
+
+    /** \brief Compute the key of the operator cache.
+     *
+     * The key hashes everything the cached operators depend on: the mesh,
+     * the boundary conditions, the time-step size, the viscous coefficient,
+     * the order of the BN operator, and the layout of the processes.
+     */
+    virtual PetscErrorCode createCacheKey();
+
+    /** \brief Name of the solver in the operator cache.
+     *
+     * The solvers define some operators with the same name differently (the
+     * BNG of the IBPM solver includes the forces, for example), so the name
+     * prefixes the entries of the cache and is mixed into the key.
+     */
+    virtual std::string getCacheScope() const { return "navierstokes"; };
+
+    /** \brief Mix some data into the key of the operator cache.
+     *
+     * \param data [in] Pointer to the data
+     * \param bytes [in] Number of bytes to hash
+     * \param local [in] PETSC_TRUE if the data differ between processes
+     * \return PetscErrorCode
+     */
+    PetscErrorCode updateCacheKey(const void *data, const std::size_t &bytes,
+                                  const PetscBool &local = PETSC_FALSE);
+
+    /** \brief Load an operator from the cache (if caching is enabled).
+     *
+     * \param name [in] Name of the operator
+     * \param m [in] Local number of rows
+     * \param n [in] Local number of columns
+     * \param mat [out] The operator
+     * \param found [out] PETSC_TRUE if the operator was loaded
+     * \return PetscErrorCode
+     */
+    PetscErrorCode readCachedOperator(const std::string &name,
+                                      const PetscInt &m, const PetscInt &n,
+                                      Mat &mat, PetscBool &found);
+
+    /** \brief Store an operator in the cache (if caching is enabled).
+     *
+     * \param name [in] Name of the operator
+     * \param mat [in] The operator
+     * \return PetscErrorCode
+     */
+    PetscErrorCode writeCachedOperator(const std::string &name,
+                                       const Mat &mat);
+
     /** \brief Create an ASCII PetscViewer.
      *
      * \param filePath [in] Path of the file to write in
@@ -258,6 +478,9 @@ protected:
      */
     virtual PetscErrorCode writeRestartDataHDF5(const std::string &filePath);
 
+    /** \brief Write the data required to restart at the current time step. */
+    PetscErrorCode writeCheckpoint();
+
     /** \brief Read data required to restart a simulation from a HDF5 file.
      *
      * \param filePath [in] Path of the file to read from
@@ -265,6 +488,14 @@ protected:
      */
     virtual PetscErrorCode readRestartDataHDF5(const std::string &filePath);
 
+    /** \brief Start reading the restart data of this process in the
+     *         background (see petibm::io::prefetchHDF5Vecs).
+     *
+     * \param filePath [in] Path of the file to read from
+     * \return PetscErrorCode
+     */
+    PetscErrorCode prefetchRestartDataHDF5(const std::string &filePath);
+
     /** \brief Write numbers of iterations and residuals of solvers to file. */
     virtual PetscErrorCode writeLinSolversInfo();
 
@@ -289,4 +520,51 @@ protected:
     /** \brief Monitor the solution at probes. */
     virtual PetscErrorCode monitorProbes();
 
+    /** \brief Change the viscous coefficient and the time-step size.
+     *
+     * The implicit operator is re-scaled from the Laplacian operator, only the
+     * operators that depend on BN are re-assembled, and the coefficient
+     * matrices of the linear solvers (and their preconditioners) are reset.
+     * The solution fields are left untouched.
+     *
+     * The explicit terms stored from the previous time steps were computed
+     * with the old parameters (and the coefficients of the multistep schemes
+     * assume a constant time-step size), so they are discarded: the next
+     * time step uses only the newest explicit terms, i.e. it is a first-order
+     * explicit Euler step, and the history builds up again from there.
+     *
+     * \param newNu [in] New viscous diffusion coefficient
+     * \param newDt [in] New time-step size
+     * \return PetscErrorCode
+     */
+    virtual PetscErrorCode updateParameters(const PetscReal &newNu,
+                                            const PetscReal &newDt);
+
+    /** \brief Monitor the current case of a continuation run.
+     *
+     * Once the maximum rate of change of the velocity drops below the
+     * tolerance (or the case reached its maximum number of time steps), the
+     * solution is written and the solver moves to the next case.
+     */
+    PetscErrorCode monitorContinuation();
+
+    /** \brief Decide whether a snapshot of the solution is due.
+     *
+     * Without adaptive saving, a snapshot is due every nsave time steps.
+     * Otherwise, it is due once the relative change of the velocity or of
+     * the pressure since the last snapshot reaches the threshold (at least
+     * saveMinInterval and at most nsave time steps after the last snapshot).
+     *
+     * \param save [out] Whether a snapshot is due
+     * \return PetscErrorCode
+     */
+    PetscErrorCode checkSnapshot(PetscBool &save);
+
+    /** \brief Write a snapshot of the solution fields and record it.
+     *
+     * The time step and the time value of the snapshot are appended to the
+     * index file `snapshots.txt` of the output directory.
+     */
+    PetscErrorCode writeSnapshot();
+
 };  // NavierStokesSolver
@@ -0,0 +1,53 @@
+/**
+ * \file rigidkinematics/main.cpp
+ * \brief Main function of the decoupled IBPM solver with moving rigid bodies.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ * \see decoupledibpm
+ * \ingroup decoupledibpm
+ */
+
+#include <petscsys.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/parser.h>
+
+#include "rigidkinematics.h"
+
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr;
+    YAML::Node config;
+    RigidKinematicsSolver solver;
+
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    ierr = PetscLogDefaultBegin(); CHKERRQ(ierr);
+
+    // parse configuration files; store info in YAML node
+    ierr = petibm::parser::getSettings(config); CHKERRQ(ierr);
+
+    // initialize the solver; the motions of the bodies are prescribed in the
+    // configuration (key `motion` of the bodies)
+    ierr = solver.init(PETSC_COMM_WORLD, config); CHKERRQ(ierr);
+    ierr = solver.ioInitialData(); CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,
+                       "Completed initialization stage\n"); CHKERRQ(ierr);
+
+    // integrate the solution in time
+    while (!solver.finished())
+    {
+        // move the bodies and compute the solution at the next time step
+        ierr = solver.advance(); CHKERRQ(ierr);
+        // output data to files
+        ierr = solver.write(); CHKERRQ(ierr);
+        // apply the runtime steering settings (if any)
+        ierr = solver.steer(); CHKERRQ(ierr);
+    }
+
+    // destroy the solver
+    ierr = solver.destroy(); CHKERRQ(ierr);
+
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return 0;
+}  // main
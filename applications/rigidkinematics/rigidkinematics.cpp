@@ -9,6 +9,8 @@
 
 #include <iomanip>
 
+#include <petibm/misc.h>
+
 #include "rigidkinematics.h"
 
 RigidKinematicsSolver::RigidKinematicsSolver(const MPI_Comm &world,
@@ -53,14 +55,46 @@ PetscErrorCode RigidKinematicsSolver::init(const MPI_Comm &world,
 
     ierr = DecoupledIBPMSolver::init(world, node); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageInitialize); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageInitialize); CHKERRQ(ierr);
 
-    ierr = PetscLogStageRegister("moveIB", &stageMoveIB); CHKERRQ(ierr);
+    ierr = petibm::misc::logStageRegister(
+        "moveIB", &stageMoveIB); CHKERRQ(ierr);
 
     ierr = VecDuplicate(f, &UB); CHKERRQ(ierr);
     ierr = VecSet(UB, 0.0); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageInitialize
+    externalKinematics = PETSC_FALSE;
+
+    // prescribed motions of the bodies (if any)
+    kinematics.assign(bodies->nBodies, petibm::type::Kinematics());
+    coordinatesOutdated = PETSC_FALSE;
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
+    {
+        const YAML::Node &motion = config["bodies"][i]["motion"];
+        if (!motion) continue;
+        ierr = petibm::body::createKinematics(
+            comm, mesh->dim, bodies->bodies[i]->name, motion,
+            config["directory"].as<std::string>(), kinematics[i]);
+        CHKERRQ(ierr);
+        // the bodies are moved to the initial time before being written
+        coordinatesOutdated = PETSC_TRUE;
+    }
+    moved.assign(bodies->nBodies, PETSC_TRUE);
+
+    // the sampling points follow the bodies, if any of them moves
+    PetscBool anyMotion = PETSC_FALSE;
+    for (const auto &k : kinematics)
+        if (k) anyMotion = PETSC_TRUE;
+    if (anyMotion)
+    {
+        for (auto sampler : samplers)
+        {
+            ierr = sampler->setMoving(PETSC_TRUE); CHKERRQ(ierr);
+        }
+    }
+
+    // end of stageInitialize
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // init
@@ -89,13 +123,13 @@ PetscErrorCode RigidKinematicsSolver::write()
 
     ierr = DecoupledIBPMSolver::write(); CHKERRQ(ierr);
 
-    if (ite % nsave == 0)
+    if (snapshotWritten)
     {
-        ierr = PetscLogStagePush(stageWrite); CHKERRQ(ierr);
+        ierr = petibm::misc::logStagePush(stageWrite); CHKERRQ(ierr);
 
         ierr = writeBodies(); CHKERRQ(ierr);
 
-        ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageWrite
+        ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageWrite
     }
 
     PetscFunctionReturn(0);
@@ -115,6 +149,68 @@ PetscErrorCode RigidKinematicsSolver::ioInitialData()
     PetscFunctionReturn(0);
 }  // ioInitialData
 
+// get a writable view of the coordinates of a body
+PetscErrorCode RigidKinematicsSolver::getBodyCoordinatesArray(
+    const PetscInt &i, PetscReal *&array)
+{
+    PetscFunctionBeginUser;
+
+    if ((i < 0) || (i >= bodies->nBodies))
+        SETERRQ1(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                 "Body %D does not exist\n", i);
+
+    array = bodies->bodies[i]->coords.data();
+
+    PetscFunctionReturn(0);
+}  // getBodyCoordinatesArray
+
+// get a writable view of the local velocities of the bodies
+PetscErrorCode RigidKinematicsSolver::getBodyVelocitiesArray(PetscReal *&array)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = VecGetArray(UB, &array); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // getBodyVelocitiesArray
+
+// return a view obtained with getBodyVelocitiesArray
+PetscErrorCode RigidKinematicsSolver::restoreBodyVelocitiesArray(
+    PetscReal *&array)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = VecRestoreArray(UB, &array); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // restoreBodyVelocitiesArray
+
+// accept kinematics computed outside of the solver
+PetscErrorCode RigidKinematicsSolver::setExternalKinematics(
+    const PetscBool &flag)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    externalKinematics = flag;
+
+    // the bodies are moved from outside of the solver
+    if (externalKinematics)
+    {
+        for (auto sampler : samplers)
+        {
+            ierr = sampler->setMoving(PETSC_TRUE); CHKERRQ(ierr);
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // setExternalKinematics
+
 // update Lagrangian points, boundary velocity, and operators
 PetscErrorCode RigidKinematicsSolver::moveBodies(const PetscReal &ti)
 {
@@ -122,23 +218,104 @@ PetscErrorCode RigidKinematicsSolver::moveBodies(const PetscReal &ti)
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageMoveIB); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageMoveIB); CHKERRQ(ierr);
 
-    ierr = setCoordinatesBodies(ti); CHKERRQ(ierr);
-    ierr = setVelocityBodies(ti); CHKERRQ(ierr);
-    ierr = bodies->updateMeshIdx(mesh); CHKERRQ(ierr);
-    if (E != PETSC_NULL) {ierr = MatDestroy(&E); CHKERRQ(ierr);}
-    if (H != PETSC_NULL) {ierr = MatDestroy(&H); CHKERRQ(ierr);}
-    if (BNH != PETSC_NULL) {ierr = MatDestroy(&BNH); CHKERRQ(ierr);}
-    if (EBNH != PETSC_NULL) {ierr = MatDestroy(&EBNH); CHKERRQ(ierr);}
-    ierr = createExtraOperators(); CHKERRQ(ierr);
-    ierr = fSolver->setMatrix(EBNH); CHKERRQ(ierr);
+    // the hooks may flag the bodies that did not move
+    moved.assign(bodies->nBodies, PETSC_TRUE);
+    if (!externalKinematics)
+    {
+        ierr = setCoordinatesBodies(ti); CHKERRQ(ierr);
+        ierr = setVelocityBodies(ti); CHKERRQ(ierr);
+    }
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);  // end of stageMoveIB
+    // operators are re-assembled only if at least one body moved
+    PetscBool anyMoved = PETSC_FALSE;
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
+    {
+        if (!moved[i]) continue;
+        ierr = bodies->bodies[i]->updateMeshIdx(mesh); CHKERRQ(ierr);
+        anyMoved = PETSC_TRUE;
+    }
+    if (anyMoved)
+    {
+        if (E != PETSC_NULL) {ierr = MatDestroy(&E); CHKERRQ(ierr);}
+        if (H != PETSC_NULL) {ierr = MatDestroy(&H); CHKERRQ(ierr);}
+        if (BNH != PETSC_NULL) {ierr = MatDestroy(&BNH); CHKERRQ(ierr);}
+        if (EBNH != PETSC_NULL) {ierr = MatDestroy(&EBNH); CHKERRQ(ierr);}
+        ierr = createExtraOperators(); CHKERRQ(ierr);
+        ierr = fSolver->setMatrix(EBNH); CHKERRQ(ierr);
+    }
+
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);  // end of stageMoveIB
 
     PetscFunctionReturn(0);
 }  // moveBodies
 
+// apply the prescribed motions to the local Lagrangian points
+PetscErrorCode RigidKinematicsSolver::setCoordinatesBodies(const PetscReal &ti)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    // velocities of the local points are stored body after body
+    PetscReal *UBArray;
+    PetscInt offset = 0;
+    ierr = VecGetArray(UB, &UBArray); CHKERRQ(ierr);
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
+    {
+        const petibm::type::SingleBody &body = bodies->bodies[i];
+        if (kinematics[i])
+        {
+            ierr = kinematics[i]->update(
+                body, ti, UBArray + offset, moved[i]); CHKERRQ(ierr);
+            coordinatesOutdated = PETSC_TRUE;
+        }
+        else
+            moved[i] = PETSC_FALSE;
+        offset += body->nLclPts * body->dim;
+    }
+    ierr = VecRestoreArray(UB, &UBArray); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // setCoordinatesBodies
+
+// move all the Lagrangian points with a prescribed motion
+PetscErrorCode RigidKinematicsSolver::syncCoordinatesBodies(
+    const PetscReal &ti)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (!coordinatesOutdated || externalKinematics) PetscFunctionReturn(0);
+
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
+    {
+        if (!kinematics[i]) continue;
+        ierr = kinematics[i]->updateAll(bodies->bodies[i], ti); CHKERRQ(ierr);
+    }
+    coordinatesOutdated = PETSC_FALSE;
+
+    PetscFunctionReturn(0);
+}  // syncCoordinatesBodies
+
+// sample the surfaces of the bodies at their current location
+PetscErrorCode RigidKinematicsSolver::monitorSurfaces()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (samplers.size() > 0)
+    {
+        ierr = syncCoordinatesBodies(t); CHKERRQ(ierr);
+    }
+    ierr = DecoupledIBPMSolver::monitorSurfaces(); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // monitorSurfaces
+
 // assemble the right-hand side of the system for the Lagrangian forces
 PetscErrorCode RigidKinematicsSolver::assembleRHSForces()
 {
@@ -146,14 +323,14 @@ PetscErrorCode RigidKinematicsSolver::assembleRHSForces()
 
     PetscFunctionBeginUser;
 
-    ierr = PetscLogStagePush(stageRHSForces); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageRHSForces); CHKERRQ(ierr);
 
     // rhsf = UB - E u^{**}
     ierr = MatMult(E, solution->UGlobal, rhsf); CHKERRQ(ierr);
     ierr = VecScale(rhsf, -1.0); CHKERRQ(ierr);
     ierr = VecAYPX(rhsf, 1.0, UB); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // assembleRHSForces
@@ -165,6 +342,9 @@ PetscErrorCode RigidKinematicsSolver::writeBodies()
 
     PetscFunctionBeginUser;
 
+    // the files hold the coordinates of all the points
+    ierr = syncCoordinatesBodies(t); CHKERRQ(ierr);
+
     std::string directory = config["output"].as<std::string>(".");
     std::stringstream ss_ite;
     ss_ite << std::setfill('0') << std::setw(7) << ite;
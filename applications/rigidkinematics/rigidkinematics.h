@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <petibm/kinematics.h>
+
 #include "../decoupledibpm/decoupledibpm.h"
 
 /**
@@ -54,13 +56,85 @@ public:
 
     using DecoupledIBPMSolver::finished;
 
+    using DecoupledIBPMSolver::steer;
+
+    using DecoupledIBPMSolver::getMesh;
+
+    using DecoupledIBPMSolver::getTime;
+
+    using DecoupledIBPMSolver::getFieldArrayRead;
+
+    using DecoupledIBPMSolver::restoreFieldArrayRead;
+
+    using DecoupledIBPMSolver::getBodies;
+
+    using DecoupledIBPMSolver::getForcesArrayRead;
+
+    using DecoupledIBPMSolver::restoreForcesArrayRead;
+
+    /** \brief Get a writable view of the coordinates of a body.
+     *
+     * No data are copied: the array holds the coordinates of all the
+     * Lagrangian points of the body (`dim` values per point); every process
+     * holds a copy and must write the same values. The new coordinates are
+     * used at the next call to advance.
+     *
+     * \param i [in] Index of the body
+     * \param array [out] Writable array of coordinates
+     * \return PetscErrorCode
+     */
+    PetscErrorCode getBodyCoordinatesArray(const PetscInt &i,
+                                           PetscReal *&array);
+
+    /** \brief Get a writable view of the local velocities of the bodies.
+     *
+     * No data are copied: the array holds the prescribed velocities of the
+     * Lagrangian points owned by this process (body after body, `dim` values
+     * per point). The view must be returned with restoreBodyVelocitiesArray
+     * before the solution is advanced.
+     *
+     * \param array [out] Writable array of local velocities
+     * \return PetscErrorCode
+     */
+    PetscErrorCode getBodyVelocitiesArray(PetscReal *&array);
+
+    /** \brief Return a view obtained with getBodyVelocitiesArray.
+     *
+     * \param array [in, out] Writable array of local velocities
+     * \return PetscErrorCode
+     */
+    PetscErrorCode restoreBodyVelocitiesArray(PetscReal *&array);
+
+    /** \brief Accept kinematics computed outside of the solver.
+     *
+     * When turned on, the hooks setCoordinatesBodies and setVelocityBodies
+     * are not called anymore; the coordinates and velocities written through
+     * the views above are used as they are.
+     *
+     * \param flag [in] PETSC_TRUE to use external kinematics
+     * \return PetscErrorCode
+     */
+    PetscErrorCode setExternalKinematics(const PetscBool &flag);
+
 protected:
     /** \brief Prescribed boundary velocity vector. */
     Vec UB;
 
+    /** \brief True if the kinematics are computed outside of the solver. */
+    PetscBool externalKinematics;
+
     /** \brief Log stage for moving the bodies. */
     PetscLogStage stageMoveIB;
 
+    /** \brief Prescribed motions of the bodies (null for fixed bodies). */
+    std::vector<petibm::type::Kinematics> kinematics;
+
+    /** \brief Flags of the bodies that moved during the last time step. */
+    std::vector<PetscBool> moved;
+
+    /** \brief True if only the local points follow the prescribed motions. */
+    PetscBool coordinatesOutdated;
+
     /** \brief Move the bodies and update the solver state.
      *
      * Update the position of the Lagrangian points.
@@ -73,23 +147,42 @@ protected:
 
     /** \brief Update the position of the Lagrangian points.
      *
-     * The present implementation does nothing.
-     * The method should be implemented by the user in a child class.
+     * The present implementation applies the motions prescribed in the YAML
+     * configuration (key `motion` of the bodies): the coordinates and the
+     * velocities of the local Lagrangian points are set together, and the
+     * bodies that did not move are flagged in `moved`.
+     * The method can be overridden by the user in a child class.
      *
      * \param ti [in] Time
      */
-    virtual PetscErrorCode setCoordinatesBodies(
-        const PetscReal &ti){PetscFunctionReturn(0);};
+    virtual PetscErrorCode setCoordinatesBodies(const PetscReal &ti);
     
     /** \brief Update the velocity of the Lagrangian points.
      *
-     * The present implementation does nothing.
-     * The method should be implemented by the user in a child class.
+     * The present implementation does nothing (the prescribed motions set
+     * the velocities along with the coordinates).
+     * The method can be overridden by the user in a child class.
      *
      * \param ti [in] Time
      */
     virtual PetscErrorCode setVelocityBodies(
         const PetscReal &ti){PetscFunctionReturn(0);};
+
+    /** \brief Move all the Lagrangian points with a prescribed motion.
+     *
+     * Only the local points follow the prescribed motions when advancing;
+     * the coordinates of the other points are updated here when they are
+     * needed (to write the bodies or to sample their surfaces).
+     *
+     * \param ti [in] Time
+     */
+    virtual PetscErrorCode syncCoordinatesBodies(const PetscReal &ti);
+
+    /** \brief Sample the surfaces of the bodies at their current location. */
+    virtual PetscErrorCode monitorSurfaces();
+
+    /** \brief The bodies can move (prescribed or external kinematics). */
+    virtual PetscBool bodiesCanMove() const { return PETSC_TRUE; };
     
     /** \brief Assemble the right-hand side of the system for the forces. */
     virtual PetscErrorCode assembleRHSForces();
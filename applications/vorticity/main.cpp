@@ -7,7 +7,9 @@
  * \ingroup vorticity
  */
 
+#include <fstream>
 #include <iomanip>
+#include <set>
 #include <sstream>
 
 #include <petsc.h>
@@ -118,6 +120,25 @@ int main(int argc, char **argv)
     CHKERRQ(ierr);
     if (!isSet) step = setting["parameters"]["nsave"].as<PetscInt>();
 
+    // time steps of the snapshots: listed in the index file of the output
+    // directory (if any), unless a step is given on the command line
+    std::set<PetscInt> steps;
+    std::ifstream index(setting["output"].as<std::string>() +
+                        "/snapshots.txt");
+    if (!isSet && index.good())
+    {
+        std::string line;
+        while (std::getline(index, line))
+        {
+            std::istringstream ls(line);
+            long long ite;
+            if (line.empty() || line[0] == '#' || !(ls >> ite)) continue;
+            if ((ite >= bg) && (ite <= ed)) steps.insert(PetscInt(ite));
+        }
+    }
+    else
+        for (PetscInt i = bg; i <= ed; i += step) steps.insert(i);
+
     // start calculating vorticity
     ierr = PetscPrintf(PETSC_COMM_WORLD,
                        "====================================\n"
@@ -126,15 +147,15 @@ int main(int argc, char **argv)
     CHKERRQ(ierr);
 
     ierr = PetscPrintf(PETSC_COMM_WORLD,
-                       "Beginning: %d\n"
-                       "End: %d\n"
-                       "Step: %d\n\n",
+                       "Beginning: %D\n"
+                       "End: %D\n"
+                       "Step: %D\n\n",
                        bg, ed, step); CHKERRQ(ierr);
 
-    for (int i = bg; i <= ed; i += step)
+    for (const PetscInt &i : steps)
     {
         ierr = PetscPrintf(PETSC_COMM_WORLD,
-                           "Calculating vorticity fields for time step %d ... ",
+                           "Calculating vorticity fields for time step %D ... ",
                            i); CHKERRQ(ierr);
 
         // read solution
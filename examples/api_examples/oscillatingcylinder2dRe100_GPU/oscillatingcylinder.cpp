@@ -8,6 +8,7 @@
 #include "oscillatingcylinder.h"
 
 #include <petibm/io.h>
+#include <petibm/misc.h>
 
 OscillatingCylinderSolver::OscillatingCylinderSolver(const MPI_Comm &world, const YAML::Node & node)
 {
@@ -37,7 +38,7 @@ PetscErrorCode OscillatingCylinderSolver::init(const MPI_Comm &world,
     // initialize the decoupled IBPM solver for rigid body motion
     ierr = RigidKinematicsSolver::init(world, node); CHKERRQ(ierr);
 
-    ierr = PetscLogStagePush(stageInitialize); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePush(stageInitialize); CHKERRQ(ierr);
 
     // parse the configuration file to get kinematics parameters
     const YAML::Node &config_kin = node["bodies"][0]["kinematics"];
@@ -55,7 +56,7 @@ PetscErrorCode OscillatingCylinderSolver::init(const MPI_Comm &world,
     Xc0 = config_kin["center"][0].as<PetscReal>(0.0);
     Yc0 = config_kin["center"][1].as<PetscReal>(0.0);
 
-    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+    ierr = petibm::misc::logStagePop(); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // init
@@ -67,8 +68,8 @@ PetscErrorCode OscillatingCylinderSolver::setCoordinatesBodies(
               Yd;  // displacement in the y-direction
     // make references for code readability
     petibm::type::SingleBody &body = bodies->bodies[0];
-    petibm::type::RealVec2D &coords = body->coords;
-    petibm::type::RealVec2D &coords0 = body->coords0;
+    petibm::type::RealArray2D &coords = body->coords;
+    petibm::type::RealArray2D &coords0 = body->coords0;
 
     PetscFunctionBeginUser;
 
@@ -0,0 +1,131 @@
+/**
+ * \file main.cpp
+ * \brief Main function for the simulation of a two-dimensional cylinder
+ *        mounted on springs (coupled in-process with a mass-spring model).
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <petscsys.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/parser.h>
+#include <petibm/rigidkinematics/rigidkinematics.h>
+
+#include "massspring.h"
+
+// compute the fluid force acting on the immersed body
+PetscErrorCode getBodyForce(const MPI_Comm &comm,
+                            RigidKinematicsSolver &solver,
+                            petibm::type::RealVec1D &force);
+
+// move the immersed body with the structural model
+PetscErrorCode setBodyKinematics(RigidKinematicsSolver &solver,
+                                 const MassSpringModel &structure);
+
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr;
+    YAML::Node config;
+    RigidKinematicsSolver solver;
+    MassSpringModel structure;
+    petibm::type::RealVec1D force;
+    PetscReal dt;
+
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    ierr = PetscLogDefaultBegin(); CHKERRQ(ierr);
+
+    // parse configuration files; store info in YAML node
+    ierr = petibm::parser::getSettings(config); CHKERRQ(ierr);
+    dt = config["parameters"]["dt"].as<PetscReal>();
+
+    // initialize the flow solver; the kinematics of the body are provided
+    // by the structural model instead of the solver
+    ierr = solver.init(PETSC_COMM_WORLD, config); CHKERRQ(ierr);
+    ierr = solver.setExternalKinematics(PETSC_TRUE); CHKERRQ(ierr);
+    ierr = solver.ioInitialData(); CHKERRQ(ierr);
+
+    // initialize the structural model
+    ierr = structure.init(PETSC_COMM_WORLD, config["structure"],
+                          solver.getMesh()->dim,
+                          config["output"].as<std::string>() +
+                              "/structure.txt"); CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,
+                       "Completed initialization stage\n"); CHKERRQ(ierr);
+
+    // integrate the coupled system in time (loose coupling)
+    while (!solver.finished())
+    {
+        // advance the structure with the fluid force of the last time step
+        ierr = getBodyForce(PETSC_COMM_WORLD, solver, force); CHKERRQ(ierr);
+        ierr = structure.advance(dt, force); CHKERRQ(ierr);
+        ierr = setBodyKinematics(solver, structure); CHKERRQ(ierr);
+
+        // advance the flow around the body at its new position
+        ierr = solver.advance(); CHKERRQ(ierr);
+
+        // output data to files
+        ierr = solver.write(); CHKERRQ(ierr);
+        ierr = structure.write(solver.getTime()); CHKERRQ(ierr);
+    }
+
+    // destroy the solver and the structural model
+    ierr = structure.destroy(); CHKERRQ(ierr);
+    ierr = solver.destroy(); CHKERRQ(ierr);
+
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return 0;
+}  // main
+
+PetscErrorCode getBodyForce(const MPI_Comm &comm,
+                            RigidKinematicsSolver &solver,
+                            petibm::type::RealVec1D &force)
+{
+    PetscErrorCode ierr;
+    const PetscReal *f;
+
+    PetscFunctionBeginUser;
+
+    const petibm::type::BodyPack &bodies = solver.getBodies();
+    petibm::type::RealVec1D local(bodies->dim, 0.0);
+    force.assign(bodies->dim, 0.0);
+
+    // the solver holds the forces applied to the fluid
+    ierr = solver.getForcesArrayRead(f); CHKERRQ(ierr);
+    for (PetscInt k = 0; k < bodies->nLclPts; ++k)
+        for (PetscInt d = 0; d < bodies->dim; ++d)
+            local[d] -= f[k * bodies->dim + d];
+    ierr = solver.restoreForcesArrayRead(f); CHKERRQ(ierr);
+
+    ierr = MPI_Allreduce(local.data(), force.data(), bodies->dim, MPIU_REAL,
+                         MPI_SUM, comm); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // getBodyForce
+
+PetscErrorCode setBodyKinematics(RigidKinematicsSolver &solver,
+                                 const MassSpringModel &structure)
+{
+    PetscErrorCode ierr;
+    PetscReal *xyz, *UB;
+
+    PetscFunctionBeginUser;
+
+    const petibm::type::SingleBody &body = solver.getBodies()->bodies[0];
+
+    // every process holds all the Lagrangian points
+    ierr = solver.getBodyCoordinatesArray(0, xyz); CHKERRQ(ierr);
+    for (PetscInt k = 0; k < body->nPts; ++k)
+        for (PetscInt d = 0; d < body->dim; ++d)
+            xyz[k * body->dim + d] = body->coords0[k][d] + structure.x[d];
+
+    // each process sets the velocity of the points it owns
+    ierr = solver.getBodyVelocitiesArray(UB); CHKERRQ(ierr);
+    for (PetscInt k = 0; k < body->nLclPts; ++k)
+        for (PetscInt d = 0; d < body->dim; ++d)
+            UB[k * body->dim + d] = structure.v[d];
+    ierr = solver.restoreBodyVelocitiesArray(UB); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // setBodyKinematics
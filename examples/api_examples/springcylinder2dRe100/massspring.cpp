@@ -0,0 +1,113 @@
+/**
+ * \file massspring.cpp
+ * \brief Implementation of the class \c MassSpringModel.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include "massspring.h"
+
+MassSpringModel::~MassSpringModel()
+{
+    PetscErrorCode ierr;
+    PetscBool finalized;
+
+    PetscFunctionBeginUser;
+
+    ierr = PetscFinalized(&finalized); CHKERRV(ierr);
+    if (finalized) return;
+
+    ierr = destroy(); CHKERRV(ierr);
+}  // ~MassSpringModel
+
+PetscErrorCode MassSpringModel::destroy()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // destroy
+
+PetscErrorCode MassSpringModel::init(const MPI_Comm &world,
+                                     const YAML::Node &node,
+                                     const PetscInt &_dim,
+                                     const std::string &filePath)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    dim = _dim;
+    mass = node["mass"].as<PetscReal>();
+    stiffness = node["stiffness"].as<petibm::type::RealVec1D>();
+    damping = node["damping"].as<petibm::type::RealVec1D>(
+        petibm::type::RealVec1D(dim, 0.0));
+    free.assign(dim, PETSC_TRUE);
+    if (node["free"])
+        for (PetscInt d = 0; d < dim; ++d)
+            free[d] = PetscBool(node["free"][d].as<bool>());
+
+    if (PetscInt(stiffness.size()) != dim || PetscInt(damping.size()) != dim)
+        SETERRQ1(world, PETSC_ERR_ARG_SIZ,
+                 "The stiffness and damping of the structure should have "
+                 "%D components\n", dim);
+
+    // the body starts at rest, from its position in the body file
+    x.assign(dim, 0.0);
+    v.assign(dim, 0.0);
+    a.assign(dim, 0.0);
+
+    ierr = PetscViewerASCIIOpen(world, filePath.c_str(), &viewer);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // init
+
+PetscErrorCode MassSpringModel::advance(const PetscReal &dt,
+                                        const petibm::type::RealVec1D &force)
+{
+    PetscFunctionBeginUser;
+
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        if (!free[d]) continue;
+
+        // Newmark average-acceleration scheme (unconditionally stable)
+        PetscReal k = stiffness[d] + 2.0 * damping[d] / dt +
+                      4.0 * mass / (dt * dt);
+        PetscReal rhs = force[d] +
+                        mass * (4.0 * x[d] / (dt * dt) + 4.0 * v[d] / dt +
+                                a[d]) +
+                        damping[d] * (2.0 * x[d] / dt + v[d]);
+        PetscReal xNew = rhs / k;
+        PetscReal vNew = 2.0 * (xNew - x[d]) / dt - v[d];
+        a[d] = 4.0 * (xNew - x[d]) / (dt * dt) - 4.0 * v[d] / dt - a[d];
+        x[d] = xNew;
+        v[d] = vNew;
+    }
+
+    PetscFunctionReturn(0);
+}  // advance
+
+PetscErrorCode MassSpringModel::write(const PetscReal &t)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = PetscViewerASCIIPrintf(viewer, "%10.8e", t); CHKERRQ(ierr);
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        ierr = PetscViewerASCIIPrintf(viewer, "\t%10.8e", x[d]); CHKERRQ(ierr);
+    }
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        ierr = PetscViewerASCIIPrintf(viewer, "\t%10.8e", v[d]); CHKERRQ(ierr);
+    }
+    ierr = PetscViewerASCIIPrintf(viewer, "\n"); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // write
@@ -0,0 +1,93 @@
+/**
+ * \file massspring.h
+ * \brief Definition of the class \c MassSpringModel.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <petscsys.h>
+#include <petscviewer.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/type.h>
+
+/**
+ * \class MassSpringModel
+ * \brief Rigid body mounted on linear springs and dampers.
+ *
+ * The model stands in for an external structural solver: it receives the
+ * fluid force acting on the body and returns the displacement and velocity of
+ * the body. In each direction, the displacement \f$ x \f$ follows
+ * \f$ m \ddot{x} + c \dot{x} + k x = F \f$, which is integrated with the
+ * Newmark average-acceleration scheme. Every process integrates the same
+ * model with the same force.
+ */
+class MassSpringModel
+{
+public:
+    /** \brief Default constructor. */
+    MassSpringModel() = default;
+
+    /** \brief Default destructor. */
+    ~MassSpringModel();
+
+    /** \brief Manually destroy data. */
+    PetscErrorCode destroy();
+
+    /** \brief Initialize the model.
+     *
+     * \param world [in] MPI communicator
+     * \param node [in] YAML configuration settings (node `structure`)
+     * \param dim [in] Number of dimensions
+     * \param filePath [in] Path of the ASCII file to write the motion in
+     */
+    PetscErrorCode init(const MPI_Comm &world, const YAML::Node &node,
+                        const PetscInt &dim, const std::string &filePath);
+
+    /** \brief Advance the motion of the body by one time step.
+     *
+     * \param dt [in] Time-step size
+     * \param force [in] Fluid force acting on the body
+     */
+    PetscErrorCode advance(const PetscReal &dt,
+                           const petibm::type::RealVec1D &force);
+
+    /** \brief Write the displacement and velocity of the body.
+     *
+     * \param t [in] Time
+     */
+    PetscErrorCode write(const PetscReal &t);
+
+    /** \brief Displacement of the body. */
+    petibm::type::RealVec1D x;
+
+    /** \brief Velocity of the body. */
+    petibm::type::RealVec1D v;
+
+protected:
+    /** \brief Number of dimensions. */
+    PetscInt dim;
+
+    /** \brief Mass of the body. */
+    PetscReal mass;
+
+    /** \brief Stiffness of the spring in each direction. */
+    petibm::type::RealVec1D stiffness;
+
+    /** \brief Damping coefficient in each direction. */
+    petibm::type::RealVec1D damping;
+
+    /** \brief True if the body is free to move in a direction. */
+    petibm::type::BoolVec1D free;
+
+    /** \brief Acceleration of the body. */
+    petibm::type::RealVec1D a;
+
+    /** \brief ASCII PetscViewer object to output the motion of the body. */
+    PetscViewer viewer = PETSC_NULL;
+
+};  // MassSpringModel
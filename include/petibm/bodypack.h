@@ -205,6 +205,23 @@ public:
      */
     PetscErrorCode updateMeshIdx(const type::Mesh &mesh);
 
+    /**
+     * \brief Permute a packed Vec between the order of the Lagrangian points
+     *        in memory and the order of the body files.
+     *
+     * \param in [in] Packed Vec.
+     * \param out [out] Packed Vec (same layout) with the permuted values.
+     * \param toFile [in] PETSC_TRUE to permute to the order of the files,
+     *        PETSC_FALSE to permute from it.
+     *
+     * \return PetscErrorCode.
+     *
+     * Note: `out` is a copy of `in` if the points of no body were sorted
+     * (see petibm::body::SingleBodyBase::order).
+     */
+    PetscErrorCode reorderVec(const Vec &in, Vec &out,
+                              const PetscBool &toFile) const;
+
 protected:
     /**
      * \brief Initialize the pack of bodies.
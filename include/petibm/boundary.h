@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include <petibm/bodypack.h>
 #include <petibm/mesh.h>
 #include <petibm/singleboundary.h>
 #include <petibm/solution.h>
@@ -191,6 +192,28 @@ namespace boundary
 PetscErrorCode createBoundary(const type::Mesh &mesh, const YAML::Node &node,
                               type::Boundary &boundary);
 
+/**
+ * \brief Account for the mirror images of bodies across symmetry planes.
+ *
+ * \param bc [in] Data object with boundary conditions.
+ * \param bodies [in] Pack of bodies.
+ * \param f [in] Lagrangian forces applied to the fluid (packed Vec).
+ * \param forces [in, out] Averaged forces on the bodies (one row per body).
+ *
+ * When a domain is truncated by a symmetry plane, only half of the flow is
+ * simulated. The forces on a body and its mirror image are recovered by
+ * doubling the force components tangential to the plane and cancelling the
+ * normal component. A Lagrangian point lying on a plane (within a tolerance
+ * relative to the size of the domain) is its own image and is counted once.
+ * Nothing is changed if there is no symmetry BC.
+ *
+ * \see boundaryModule, petibm::type::Boundary
+ * \ingroup boundaryModule
+ */
+PetscErrorCode mirrorForces(const type::Boundary &bc,
+                            const type::BodyPack &bodies, const Vec &f,
+                            type::RealVec2D &forces);
+
 }  // end of namespace boundary
 
 }  // end of namespace petibm
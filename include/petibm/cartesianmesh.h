@@ -10,7 +10,6 @@
 #include <string>
 #include <vector>
 
-#include <petscao.h>
 #include <petscdmcomposite.h>
 #include <petscdmda.h>
 #include <petscsys.h>
@@ -43,6 +42,14 @@ public:
     virtual PetscBool isPointOnLocalProc(const type::RealVec1D &point,
                                          const type::Field &field);
 
+    // doc is the same as MeshBase::locate
+    virtual PetscErrorCode locate(const PetscInt &f, const PetscInt &d,
+                                  const PetscReal &x, PetscInt &idx) const;
+
+    // doc is the same as MeshBase::locateFrom
+    virtual PetscErrorCode locateFrom(const PetscInt &f, const PetscInt &d,
+                                      const PetscReal &x, PetscInt &idx) const;
+
     // doc is the same as MeshBase::write
     virtual PetscErrorCode write(const std::string &filePath) const;
 
@@ -97,8 +104,15 @@ protected:
     /** \brief Underlying data for mesh point coordinates. */
     type::RealVec3D coordTrue;
 
-    /** \brief References to underlying AO objects of velocity DMs. */
-    std::vector<AO> ao;
+    /**
+     * \brief Starting indices of the processes of each field in each
+     *        direction (from the ownership ranges of the DMDAs), followed by
+     *        the number of points.
+     *
+     * Global indices are computed from them locally, without application
+     * orderings (AO) of the full grid.
+     */
+    type::IntVec3D ownStarts;
 
     /** \brief Number of local velocity points (without ghost points) for all
      *         processes and all velocity fields. */
@@ -115,6 +129,37 @@ protected:
     /** \brief Offsets of packed velocity points in packed DM. */
     type::IntVec1D offsetsPackAllProcs;
 
+    /**
+     * \brief Point-location index of a gridline.
+     *
+     * A gridline is split into segments. In uniform segments, the index of a
+     * point is computed with arithmetic; stretched segments are split into
+     * buckets holding the index of the first point of each bucket.
+     */
+    struct GridLineIndex
+    {
+        /** \brief Coordinate of the first point of each segment. */
+        type::RealVec1D bound;
+
+        /** \brief Index of the first point of each segment. */
+        type::IntVec1D first;
+
+        /** \brief Number of cells (or buckets) of each segment. */
+        type::IntVec1D count;
+
+        /** \brief Cell (or bucket) width of each segment. */
+        type::RealVec1D h;
+
+        /** \brief Offset of each segment in `table` (-1 if uniform). */
+        type::IntVec1D offset;
+
+        /** \brief Index of the first point of each bucket. */
+        type::IntVec1D table;
+    };
+
+    /** \brief Point-location indices of all fields in all directions. */
+    std::vector<std::vector<GridLineIndex>> lineIdx;
+
     /** \brief Create vertex information. */
     PetscErrorCode createVertexMesh();
 
@@ -124,6 +169,9 @@ protected:
     /** \brief Create velocity mesh information. */
     PetscErrorCode createVelocityMesh();
 
+    /** \brief Create the point-location indices of all gridlines. */
+    PetscErrorCode createLineIndices();
+
     /** \brief Create a string of information. */
     PetscErrorCode createInfoString();
 
@@ -144,6 +192,14 @@ protected:
     /** \brief Create DMDA for pressure. */
     PetscErrorCode createPressureDMDA();
 
+    /**
+     * \brief Store the ownership ranges of a DMDA in `ownStarts`.
+     *
+     * \param f [in] The index of the field (0 ~ 3 represents u, v, w, and
+     *          pressure respectively).
+     */
+    PetscErrorCode createOwnershipRanges(const PetscInt &f);
+
     /** \brief Create DMDAs for velocity fields and make a DMComposite. */
     PetscErrorCode createVelocityPack();
 
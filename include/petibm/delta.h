@@ -70,6 +70,20 @@ PetscReal delta(const std::vector<PetscReal> &source,
                 const std::vector<PetscReal> &widths,
                 const DeltaKernel &kernel);
 
+/** \brief Discrete delta function (raw pointers to the coordinates).
+ *
+ * \param source [in] Coordinates of the source point
+ * \param target [in] Coordinates of the target point
+ * \param h [in] Cell width
+ *
+ * \returns The value of the discrete delta function.
+ *
+ * \ingroup miscModule
+ */
+PetscReal delta(const PetscReal *source, const PetscReal *target,
+                const std::vector<PetscReal> &widths,
+                const DeltaKernel &kernel);
+
 }  // end of namespace delta
 
 }  // end of namespace petibm
@@ -9,6 +9,8 @@
 
 #include <string>
 
+#include <petscdm.h>
+#include <petscmat.h>
 #include <petscsys.h>
 
 #include <petibm/singlebody.h>
@@ -27,12 +29,12 @@ namespace io
  *
  * \param file [in] Path of the file to read from.
  * \param nPts [out] Number of Lagrangian points.
- * \param coords [out] Coordinates of the Lagrangian points as a 2D STL vector.
+ * \param coords [out] Coordinates of the Lagrangian points (one row per point).
  *
  * \ingroup miscModule
  */
 PetscErrorCode readLagrangianPoints(const std::string &file, PetscInt &nPts,
-                                    type::RealVec2D &coords);
+                                    type::RealArray2D &coords);
 
 /**
  * \brief Print information of a parallel object to standard output.
@@ -57,6 +59,10 @@ PetscErrorCode print(const std::string &info);
  *
  * Note: this function doesn't check the length of the vector of Vec objects
  * and of the vector of names.
+ *
+ * If the command-line option `-io_aggregators <n>` is given with `n > 0` and
+ * all Vec objects are managed by a DMDA (or a DMComposite of DMDAs), the data
+ * are written through `n` aggregators (see writeHDF5VecsAggregated).
  */
 PetscErrorCode writeHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
                              const std::string &loc,
@@ -64,6 +70,37 @@ PetscErrorCode writeHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
                              const std::vector<Vec> &vecs,
                              const PetscFileMode mode = FILE_MODE_WRITE);
 
+/**
+ * \brief Write a vector of DMDA Vec objects to a HDF5 file through aggregators.
+ *
+ * \param comm [in] MPI communicator (should be the same as the one in Vecs).
+ * \param filePath [in] Path of the index file to write in.
+ * \param loc [in] Location in the HDF5 file for data to write.
+ * \param names [in] Vector with the name of each Vec object to write.
+ * \param vecs [in] Vector of Vec objects to write.
+ * \param nAgg [in] Number of aggregators.
+ * \param mode [in] Either FILE_MODE_WRITE (default) or FILE_MODE_APPEND.
+ *
+ * \ingroup miscModule
+ *
+ * Processes are split into `nAgg` groups of consecutive ranks. The first
+ * process of each group gathers the data of its group and writes them in a
+ * subfile `<stem>.sub<k>.h5` (next to the index file), one dataset per process.
+ * The index file `filePath` only holds HDF5 virtual datasets that map these
+ * pieces onto the global arrays, so it can be read as one regular file (e.g.,
+ * with the XDMF files created by petibm-createxdmf). Vec objects managed by a
+ * DMComposite are written as a group with one dataset per sub-Vec.
+ *
+ * Requires HDF5 1.10 or later.
+ */
+PetscErrorCode writeHDF5VecsAggregated(const MPI_Comm comm,
+                                       const std::string &filePath,
+                                       const std::string &loc,
+                                       const std::vector<std::string> &names,
+                                       const std::vector<Vec> &vecs,
+                                       const PetscInt &nAgg,
+                                       const PetscFileMode mode = FILE_MODE_WRITE);
+
 /**
  * \brief Write a vector of raw arrays to a HDF5 file.
  *
@@ -108,6 +145,54 @@ PetscErrorCode writeHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
                              const type::RealVec2D &vecs,
                              const PetscFileMode mode = FILE_MODE_WRITE);
 
+/**
+ * \brief Coarsen a DMDA Vec by a factor 2 in each direction.
+ *
+ * Each point of the coarse Vec holds the average of the box of (up to) 2x2 (in
+ * 2D) or 2x2x2 (in 3D) fine points it covers; the last coarse point of a
+ * direction covers only one fine point if the number of fine points is odd.
+ * The coarse Vec is managed by a new DMDA (with one layer of ghost points)
+ * created on the communicator of the fine Vec, with the same process grid: a
+ * process owns the coarse points whose first fine point it owns, so only one
+ * layer of fine points is exchanged between neighbors. If a process would
+ * own no coarse point in a direction, the level can not be distributed and
+ * both outputs are set to `PETSC_NULL`. The caller owns both objects.
+ *
+ * \param fine [in] Vec managed by a DMDA.
+ * \param coarseDA [out] DMDA of the coarse Vec.
+ * \param coarse [out] Coarse Vec.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode coarsenDMDAVec(const Vec &fine, DM &coarseDA, Vec &coarse);
+
+/**
+ * \brief Write a pyramid of coarsened levels of DMDA Vec objects to a HDF5
+ *        file.
+ *
+ * Level `l` (from 1 to `nLevels`) is obtained by coarsening level `l - 1`
+ * with coarsenDMDAVec (level 0 being the given Vecs) and it is written in the
+ * group `<loc>/lod<l>` of the file, with the same names as the full-resolution
+ * Vecs. The pyramid stops before `nLevels` if a level can not be distributed
+ * over the processes (see coarsenDMDAVec). The file should already exist; it
+ * is opened in append mode.
+ *
+ * \param comm [in] MPI communicator (should be the same as the one in Vecs).
+ * \param filePath [in] Path of the file to write in.
+ * \param loc [in] Location in the HDF5 file of the full-resolution data.
+ * \param names [in] Vector with the name of each Vec object.
+ * \param vecs [in] Vector of Vec objects managed by DMDAs.
+ * \param nLevels [in] Number of coarsened levels to write.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode writeHDF5Pyramid(const MPI_Comm comm,
+                                const std::string &filePath,
+                                const std::string &loc,
+                                const std::vector<std::string> &names,
+                                const std::vector<Vec> &vecs,
+                                const PetscInt &nLevels);
+
 /**
  * \brief Read a vector of Vec objects from a HDF5 file.
  *
@@ -121,12 +206,58 @@ PetscErrorCode writeHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
  *
  * Note: this function doesn't check the length of the vector of Vec objects
  * and of the vector of names.
+ *
+ * Files written through aggregators are detected automatically; each process
+ * then reads its own part of the virtual datasets, so the number of processes
+ * does not have to match the one used to write the file.
  */
 PetscErrorCode readHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
                             const std::string &loc,
                             const std::vector<std::string> &names,
                             std::vector<Vec> &vecs);
 
+/**
+ * \brief Load an operator from the on-disk cache.
+ *
+ * The operator is stored in the PETSc binary file `<dir>/<name>.dat` and the
+ * key it was assembled with is stored in the ASCII file `<dir>/<name>.key`.
+ * The operator is only loaded if the cached key matches the given one; it is
+ * then distributed with the given local sizes.
+ *
+ * \param comm [in] MPI communicator.
+ * \param dir [in] Directory of the cache.
+ * \param name [in] Name of the operator.
+ * \param key [in] Key of the current configuration.
+ * \param m [in] Local number of rows.
+ * \param n [in] Local number of columns.
+ * \param mat [out] The operator (untouched if not found).
+ * \param found [out] PETSC_TRUE if the operator was loaded from the cache.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode readMatCache(const MPI_Comm comm, const std::string &dir,
+                            const std::string &name, const std::string &key,
+                            const PetscInt &m, const PetscInt &n, Mat &mat,
+                            PetscBool &found);
+
+/**
+ * \brief Store an operator in the on-disk cache.
+ *
+ * The key file is written after the operator, so an interrupted write never
+ * leaves a valid entry behind.
+ *
+ * \param comm [in] MPI communicator.
+ * \param dir [in] Directory of the cache.
+ * \param name [in] Name of the operator.
+ * \param key [in] Key of the current configuration.
+ * \param mat [in] The operator.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode writeMatCache(const MPI_Comm comm, const std::string &dir,
+                             const std::string &name, const std::string &key,
+                             const Mat &mat);
+
 /**
  * \brief Write a summary of the PETSc logging into a ASCII file.
  *
@@ -137,6 +268,38 @@ PetscErrorCode readHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
  */
 PetscErrorCode writePetscLog(const MPI_Comm comm, const std::string &filePath);
 
+/**
+ * \brief Start reading in the background the parts of HDF5 datasets that
+ *        this process will read into Vec objects.
+ *
+ * The byte ranges holding the box of each Vec owned by this process are
+ * located in the file (or in its subfiles, for datasets written through
+ * aggregators); a separate thread then reads them by chunks, without any
+ * PETSc, HDF5, or MPI call, so that the processes of a node only bring into
+ * its page cache the data they will read. Datasets that do not exist, or
+ * whose storage can not be located (e.g., chunked datasets with HDF5 older
+ * than 1.10.5), are skipped; the function can be called several times
+ * before joinPrefetch.
+ *
+ * \param filePath [in] Path of the file.
+ * \param loc [in] Location in the HDF5 file of the data to prefetch.
+ * \param names [in] Vector with the name of each Vec object.
+ * \param vecs [in] Vector of Vec objects with the layout of the data to read.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode prefetchHDF5Vecs(const std::string &filePath,
+                                const std::string &loc,
+                                const std::vector<std::string> &names,
+                                const std::vector<Vec> &vecs);
+
+/**
+ * \brief Wait for the background reads started by prefetchHDF5Vecs (if any).
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode joinPrefetch();
+
 }  // namespace io
 
 }  // namespace petibm
@@ -0,0 +1,266 @@
+/**
+ * \file kinematics.h
+ * \brief Definition of body::MotionLaw, body::Kinematics, type::Kinematics,
+ *        and factory function.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <petscsys.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/singlebody.h>
+#include <petibm/type.h>
+
+namespace petibm
+{
+namespace body
+{
+/**
+ * \brief Prescribed time law of one degree of freedom of a rigid motion.
+ *
+ * Supported laws (YAML key `law`):
+ *
+ * - `linear`: \f$ s(t) = s_0 + r t \f$ (keys `value` and `rate`);
+ * - `fourier`: \f$ s(t) = a_0 + \sum_k a_k \cos(2 \pi k f t) +
+ *   b_k \sin(2 \pi k f t) \f$ (keys `frequency`, `a0`, `a`, and `b`);
+ * - `table`: piecewise-linear interpolation of tabulated values, held
+ *   constant outside of the table (keys `times` and `values`, or `file`
+ *   with two columns).
+ *
+ * The time derivative is computed analytically (piecewise constant for a
+ * table).
+ *
+ * \see bodyModule, petibm::body::Kinematics
+ * \ingroup bodyModule
+ */
+class MotionLaw
+{
+public:
+    /** \brief Default constructor; the degree of freedom is fixed. */
+    MotionLaw() = default;
+
+    /**
+     * \brief Constructor. Parse the law from a YAML node.
+     *
+     * \param comm [in] MPI communicator.
+     * \param node [in] YAML node of the law.
+     * \param directory [in] Directory of relative paths of tables.
+     */
+    MotionLaw(const MPI_Comm &comm, const YAML::Node &node,
+              const std::string &directory);
+
+    /**
+     * \brief Evaluate the law and its time derivative.
+     *
+     * \param t [in] Time.
+     * \param s [out] Value.
+     * \param ds [out] Time derivative of the value.
+     */
+    void evaluate(const PetscReal &t, PetscReal &s, PetscReal &ds) const;
+
+protected:
+    /** \brief Name of the law. */
+    std::string law = "linear";
+
+    /** \brief Value at time zero (`linear`) or mean value (`fourier`). */
+    PetscReal value = 0.0;
+
+    /** \brief Rate of change (`linear`). */
+    PetscReal rate = 0.0;
+
+    /** \brief Fundamental frequency (`fourier`). */
+    PetscReal frequency = 0.0;
+
+    /** \brief Coefficients of the cosine and sine terms (`fourier`). */
+    type::RealVec1D a, b;
+
+    /** \brief Tabulated times and values (`table`). */
+    type::RealVec1D times, values;
+
+    /**
+     * \brief Parse the law from a YAML node.
+     *
+     * \param comm [in] MPI communicator.
+     * \param node [in] YAML node of the law.
+     * \param directory [in] Directory of relative paths of tables.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode init(const MPI_Comm &comm, const YAML::Node &node,
+                        const std::string &directory);
+
+};  // MotionLaw
+
+/**
+ * \brief Prescribed rigid motion of an immersed body.
+ *
+ * The motion is a rotation about a pivot followed by a translation:
+ * \f$ X(t) = c + d(t) + R(t) (X_0 - c) \f$, where \f$ c \f$ is the initial
+ * position of the pivot, \f$ d \f$ the displacement, and \f$ R \f$ the
+ * rotation by the angles (in degrees) about the x, y, and z axes (in that
+ * order; only about z in 2D). The velocity of a point is the analytic time
+ * derivative \f$ \dot{d} + \dot{R} (X_0 - c) \f$.
+ *
+ * YAML node (key `motion` of a body):
+ *
+ * \code{.yaml}
+ * motion:
+ *   pivot: [0.0, 0.0]
+ *   translation:
+ *     x: {law: fourier, frequency: 0.2, b: [-0.25]}
+ *   rotation:
+ *     z: {law: linear, rate: 10.0}
+ * \endcode
+ *
+ * The coordinates and velocities of the local Lagrangian points are updated
+ * in one pass from the initial coordinates; the coordinates of the other
+ * points are updated only when requested (updateAll).
+ *
+ * \see bodyModule, petibm::type::Kinematics, petibm::body::createKinematics
+ * \ingroup bodyModule
+ */
+class Kinematics
+{
+public:
+    /** \brief Default constructor. */
+    Kinematics() = default;
+
+    /**
+     * \brief Constructor. Parse the motion of a body.
+     *
+     * \param comm [in] MPI communicator.
+     * \param dim [in] Number of dimensions.
+     * \param name [in] Name of the body.
+     * \param node [in] YAML node of the motion.
+     * \param directory [in] Directory of relative paths of tables.
+     */
+    Kinematics(const MPI_Comm &comm, const PetscInt &dim,
+               const std::string &name, const YAML::Node &node,
+               const std::string &directory);
+
+    /** \brief Default destructor. */
+    virtual ~Kinematics() = default;
+
+    /**
+     * \brief Get the displacement, the rotation, and their time derivatives.
+     *
+     * \param t [in] Time.
+     * \param d [out] Displacement of the pivot.
+     * \param dd [out] Velocity of the pivot.
+     * \param R [out] Rotation matrix.
+     * \param dR [out] Time derivative of the rotation matrix.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode getTransform(const PetscReal &t, PetscReal d[3],
+                                PetscReal dd[3], PetscReal R[3][3],
+                                PetscReal dR[3][3]) const;
+
+    /**
+     * \brief Move the local Lagrangian points and set their velocities.
+     *
+     * \param body [in, out] Body to move.
+     * \param t [in] Time.
+     * \param U [out] Velocities of the local points (`dim` values per point).
+     * \param moved [out] PETSC_TRUE if the points moved since the last call.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode update(const type::SingleBody &body, const PetscReal &t,
+                          PetscReal *U, PetscBool &moved);
+
+    /**
+     * \brief Move all the Lagrangian points of the body.
+     *
+     * \param body [in, out] Body to move.
+     * \param t [in] Time.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode updateAll(const type::SingleBody &body,
+                             const PetscReal &t) const;
+
+protected:
+    /** \brief MPI communicator. */
+    MPI_Comm comm;
+
+    /** \brief Number of dimensions. */
+    PetscInt dim;
+
+    /** \brief Name of the body. */
+    std::string name;
+
+    /** \brief Initial position of the pivot. */
+    type::RealVec1D pivot;
+
+    /** \brief Laws of the displacement in the x, y, and z directions. */
+    std::vector<MotionLaw> translation;
+
+    /** \brief Laws of the angles (in degrees) about the x, y, and z axes. */
+    std::vector<MotionLaw> rotation;
+
+    /** \brief Displacement applied at the last update. */
+    PetscReal dLast[3];
+
+    /** \brief Rotation matrix applied at the last update. */
+    PetscReal RLast[3][3];
+
+    /**
+     * \brief Parse the motion of a body.
+     *
+     * \param comm [in] MPI communicator.
+     * \param dim [in] Number of dimensions.
+     * \param name [in] Name of the body.
+     * \param node [in] YAML node of the motion.
+     * \param directory [in] Directory of relative paths of tables.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode init(const MPI_Comm &comm, const PetscInt &dim,
+                        const std::string &name, const YAML::Node &node,
+                        const std::string &directory);
+
+};  // Kinematics
+
+}  // end of namespace body
+
+namespace type
+{
+/**
+ * \brief Definition of type::Kinematics.
+ *
+ * \see bodyModule, petibm::body::createKinematics
+ * \ingroup bodyModule
+ */
+typedef std::shared_ptr<body::Kinematics> Kinematics;
+
+}  // end of namespace type
+
+namespace body
+{
+/**
+ * \brief Factory function to create the prescribed motion of a body.
+ *
+ * \param comm [in] MPI communicator.
+ * \param dim [in] Number of dimensions.
+ * \param name [in] Name of the body.
+ * \param node [in] YAML node of the motion (key `motion` of the body).
+ * \param directory [in] Directory of relative paths of tables.
+ * \param kinematics [out] Kinematics object.
+ * \return PetscErrorCode.
+ *
+ * \see bodyModule, petibm::type::Kinematics
+ * \ingroup bodyModule
+ */
+PetscErrorCode createKinematics(const MPI_Comm &comm, const PetscInt &dim,
+                                const std::string &name,
+                                const YAML::Node &node,
+                                const std::string &directory,
+                                type::Kinematics &kinematics);
+
+}  // end of namespace body
+
+}  // end of namespace petibm
@@ -74,7 +74,7 @@ public:
     type::RealVec1D max;
 
     /** \brief Total number of points of all fields and in all directions. */
-    type::IntVec2D n;
+    type::IntArray2D n;
 
     /** \brief Bools indicating if any direction is periodic. */
     type::BoolVec2D periodic;
@@ -104,15 +104,15 @@ public:
 
     /** \brief The beginning index of all fields in all directions of this
      * process. */
-    type::IntVec2D bg;
+    type::IntArray2D bg;
 
     /** \brief The ending index of all fields in all directions of this process.
      */
-    type::IntVec2D ed;
+    type::IntArray2D ed;
 
     /** \brief The number of points of all fields in all directions of this
      * process. */
-    type::IntVec2D m;
+    type::IntArray2D m;
 
     /** \brief Total number of velocity points local to this process. */
     PetscInt UNLocal;
@@ -168,6 +168,37 @@ public:
     virtual PetscBool isPointOnLocalProc(const type::RealVec1D &point,
                                          const type::Field &field) = 0;
 
+    /**
+     * \brief Locate a coordinate among the gridline points of a field.
+     *
+     * \param f [in] Target field (u=0, v=1, w=2, p=3, vertex=4).
+     * \param d [in] Direction (x=0, y=1, z=2).
+     * \param x [in] Coordinate to locate.
+     * \param idx [out] Index of the last gridline point not greater than `x`
+     *        (-1 if `x` is smaller than the first point).
+     *
+     * The result is the same as `std::upper_bound` on `coord[f][d]` minus 1.
+     */
+    virtual PetscErrorCode locate(const PetscInt &f, const PetscInt &d,
+                                  const PetscReal &x, PetscInt &idx) const = 0;
+
+    /**
+     * \brief Locate a coordinate starting from a previous result.
+     *
+     * \param f [in] Target field (u=0, v=1, w=2, p=3, vertex=4).
+     * \param d [in] Direction (x=0, y=1, z=2).
+     * \param x [in] Coordinate to locate.
+     * \param idx [in, out] Previous index on input; index of the last
+     *        gridline point not greater than `x` on output.
+     *
+     * Useful for moving points: the search walks from the previous index to
+     * its neighbors and only falls back to locate() if the point moved by more
+     * than a couple of cells.
+     */
+    virtual PetscErrorCode locateFrom(const PetscInt &f, const PetscInt &d,
+                                      const PetscReal &x,
+                                      PetscInt &idx) const = 0;
+
     /**
      * \brief Get the local index of a point by providing MatStencil.
      *
@@ -228,6 +228,116 @@ inline PetscErrorCode tripleLoops(
     PetscFunctionReturn(0);
 }  // tripleLoops
 
+/**
+ * \brief Borrow a work vector of a DM from the shared workspace pool.
+ *
+ * \param dm [in] the DM the vector belongs to.
+ * \param local [in] PETSC_TRUE for a local (ghosted) vector, PETSC_FALSE for a
+ * global one.
+ * \param vec [out] the borrowed vector (its values are undefined).
+ *
+ * Work vectors are lent for the duration of a call and must be returned with
+ * misc::restoreWorkVec. Returned vectors are kept in the pool and lent again to
+ * the next caller asking for a vector of the same DM, so that temporaries of
+ * different objects (operators, probes, solvers) share the same memory.
+ * In memory-lean mode (command-line option `-lean_memory`), returned vectors
+ * are destroyed instead.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode getWorkVec(const DM &dm, const PetscBool &local, Vec &vec);
+
+/**
+ * \brief Return a work vector to the shared workspace pool.
+ *
+ * \param dm [in] the DM the vector belongs to.
+ * \param local [in] PETSC_TRUE for a local (ghosted) vector, PETSC_FALSE for a
+ * global one.
+ * \param vec [in, out] the vector to return (set to `nullptr`).
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode restoreWorkVec(const DM &dm, const PetscBool &local, Vec &vec);
+
+/**
+ * \brief Check if the memory-lean mode is on (command-line option
+ * `-lean_memory`).
+ *
+ * \param lean [out] PETSC_TRUE if the memory-lean mode is on.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode isLeanMemory(PetscBool &lean);
+
+/**
+ * \brief Destroy the work vectors held by the shared workspace pool.
+ *
+ * Vectors that are currently borrowed are not affected. The function is
+ * called automatically by `PetscFinalize`.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode clearWorkVecs();
+
+/**
+ * \brief Initialize the energy metering of logging stages.
+ *
+ * The metering is on with the command-line option `-energy_log`. The first
+ * process of each node then reads the Linux powercap (RAPL) energy counters of
+ * the packages and of their DRAM at every stage boundary (the files
+ * `/sys/class/powercap/intel-rapl:*` must be readable). Calling the function
+ * more than once has no effect.
+ *
+ * \param comm [in] MPI communicator of the simulation.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode initEnergyMeter(const MPI_Comm &comm);
+
+/**
+ * \brief Register a logging stage with PETSc and with the energy meter.
+ *
+ * \param name [in] Name of the stage.
+ * \param stage [out] The stage.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode logStageRegister(const char name[], PetscLogStage *stage);
+
+/**
+ * \brief Push a logging stage; the energy consumed until then is attributed
+ * to the previous stage.
+ *
+ * \param stage [in] The stage.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode logStagePush(const PetscLogStage &stage);
+
+/**
+ * \brief Pop the current logging stage; the energy consumed since the last
+ * stage boundary is attributed to it.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode logStagePop();
+
+/**
+ * \brief Write the energy consumed in each logging stage into a ASCII file.
+ *
+ * The energy of the package and of the DRAM counters is summed over all nodes
+ * and it is also reported per time step. Nothing is written if the metering is
+ * off.
+ *
+ * \param comm [in] MPI communicator.
+ * \param filePath [in] Path of the file to write in.
+ * \param nSteps [in] Number of time steps computed so far.
+ *
+ * \ingroup miscModule
+ */
+PetscErrorCode writeEnergyLog(const MPI_Comm comm, const std::string &filePath,
+                              const PetscInt &nSteps);
+
 }  // end of namespace misc
 
 }  // end of namespace petibm
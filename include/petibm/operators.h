@@ -167,6 +167,31 @@ PetscErrorCode createM(const type::Mesh &mesh, Mat &M);
  */
 PetscErrorCode createIdentity(const type::Mesh &mesh, Mat &I);
 
+/**
+ * \brief Create the diagonal matrix of damping rates of sponge zones,
+ *        \f$S\f$.
+ *
+ * \param mesh [in] Structured Cartesian mesh object.
+ * \param node [in] YAML node of the sponge (key `sponge` under `flow`).
+ * \param S [out] \f$S\f$ matrix.
+ *
+ * PETSc matrix S should not be created before calling this function.
+ *
+ * Each entry of the list `zones` of the node is a band of width `width`
+ * along the boundary `location` (e.g., `xPlus`). Inside a band, the damping
+ * rate of a velocity point ramps up from zero to `strength` at the boundary
+ * with the smooth profile \f$3\xi^2 - 2\xi^3\f$, where \f$\xi\f$ is the
+ * normalized depth in the band. The rate is zero outside the zones and the
+ * largest value is used where zones overlap.
+ *
+ * The sponge term \f$-S(u - u_{ref})\f$ damps the velocity toward a
+ * reference state.
+ *
+ * \ingroup operatorModule
+ */
+PetscErrorCode createSponge(const type::Mesh &mesh, const YAML::Node &node,
+                            Mat &S);
+
 /**
  * \brief Create a gradient operator, \f$G\f$, for pressure field.
  *
@@ -231,6 +256,8 @@ PetscErrorCode createDivergence(const type::Mesh &mesh,
  * \param bc [in] Data object for the boundary conditions.
  * \param L [out] Laplacian operator \f$L\f$.
  * \param LCorrection [out] Operator for boundary corrections, \f$L_{bc}\f$.
+ * \param directions [in] Directions (0, 1, or 2) included in the operator;
+ *                   all directions if empty (default).
  *
  * PETSc matrix L should not be created before calling this function.
  *
@@ -240,10 +267,35 @@ PetscErrorCode createDivergence(const type::Mesh &mesh,
  * the boundary correction \f$L_{bc}\f$ on right-hand side of a system, while
  * \f$L\f$ on left-hand side.
  *
+ * The operator may be restricted to some of the directions (for example, to
+ * treat the diffusion implicitly in the stiff directions of a stretched mesh
+ * only): the second-order differences along the other directions are then
+ * left out of both \f$L\f$ and \f$L_{bc}\f$, and the operators built for
+ * complementary lists of directions sum to the full Laplacian.
+ *
  * \ingroup operatorModule
  */
 PetscErrorCode createLaplacian(const type::Mesh &mesh, const type::Boundary &bc,
-                               Mat &L, Mat &LCorrection);
+                               Mat &L, Mat &LCorrection,
+                               const type::IntVec1D &directions = {});
+
+/**
+ * \brief Create the scatters gathering the velocity values read by the
+ *        kernels of the convective operator.
+ *
+ * \param mesh [in] Structured Cartesian mesh object.
+ * \param halo [out] One scatter per velocity component, from the packed global
+ *        velocity vector to the local (ghosted) vector of the component.
+ *
+ * Unlike the box-stencil halo of the DMDAs, only the owned points, the face
+ * neighbors, and the few edge neighbors read by the kernels are gathered. The
+ * ghost points on non-periodic boundaries are left untouched; they are set by
+ * the boundary object.
+ *
+ * \ingroup operatorModule
+ */
+PetscErrorCode createConvectionHalo(const type::Mesh &mesh,
+                                    std::vector<VecScatter> &halo);
 
 /**
  * \brief Create a matrix-free Mat for convection operator, \f$H\f$.
@@ -356,6 +408,11 @@ PetscErrorCode createBn(const Mat &Op, const Mat &M, const PetscReal &dt,
  * Lagrangian point, respectively.
  * \f$d(...)\f$ is discretized delta function following Roma et. al. (1999).
  *
+ * Near a symmetry boundary, the support of the kernel is mirrored across the
+ * plane: the images of interior grid points contribute to the weights of
+ * these points, with a negative sign for the velocity component normal to the
+ * plane.
+ *
  * \ingroup operatorModule
  */
 PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
@@ -364,6 +421,117 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
                            const PetscInt &kernelSize,
                            Mat &Op);
 
+/**
+ * \brief Create a compact, matrix-free Delta operator, \f$Delta\f$.
+ *
+ * \param mesh [in] Structured Cartesian mesh object.
+ * \param bc [in] Data object with boundary conditions.
+ * \param bodies [in] Data object with the immersed boundaries.
+ * \param kernel [in] Regularized delta kernel to use.
+ * \param kernelSize [in] Size of the kernel.
+ * \param Op [out] Matrix-free operator \f$Delta\f$.
+ *
+ * The operator is the same as the one created by
+ * \ref petibm::operators::createDelta "createDelta", but the discrete delta
+ * function is the product of 1D kernels, so only the base cell index and the
+ * \f$3 \times (2 \times kernelSize + 1)\f$ 1D weights of each Lagrangian
+ * point and component are stored; the entries are expanded on the fly.
+ *
+ * The operator supports MatMult, MatMultAdd, their transposed versions, and
+ * MatDiagonalScale.
+ *
+ * \ingroup operatorModule
+ */
+PetscErrorCode createCompactDelta(const type::Mesh &mesh,
+                                  const type::Boundary &bc,
+                                  const type::BodyPack &bodies,
+                                  const delta::DeltaKernel &kernel,
+                                  const PetscInt &kernelSize, Mat &Op);
+
+/**
+ * \brief Create the transpose of a compact Delta operator.
+ *
+ * \param Op [in] Compact operator (or its transpose).
+ * \param OpT [out] Compact transposed operator.
+ *
+ * The transpose shares the weights of `Op`, but not its diagonal scalings.
+ *
+ * \ingroup operatorModule
+ */
+PetscErrorCode createCompactDeltaTranspose(const Mat &Op, Mat &OpT);
+
+/**
+ * \brief Create the matrix-free product of a compact Delta operator and of a
+ *        compact transposed operator.
+ *
+ * \param A [in] Compact Delta operator, possibly scaled.
+ * \param B [in] Compact transposed operator sharing the weights of `A`,
+ *        possibly scaled.
+ * \param AB [out] Matrix-free product \f$A B\f$.
+ *
+ * With diagonal scalings, the product is \f$E D H\f$ where \f$D\f$ is a
+ * diagonal matrix; it is applied without being assembled. Besides MatMult, the
+ * product supports MatGetDiagonal, so Jacobi preconditioners can be used.
+ *
+ * \ingroup operatorModule
+ */
+PetscErrorCode createCompactDeltaProduct(const Mat &A, const Mat &B,
+                                         Mat &AB);
+
+/**
+ * \brief Create an operator interpolating the pressure at arbitrary points.
+ *
+ * \param mesh [in] Structured Cartesian mesh object.
+ * \param bc [in] Data object with boundary conditions.
+ * \param points [in] Coordinates of the points owned by the local process
+ *               (one row per point).
+ * \param kernel [in] Regularized delta kernel to use.
+ * \param kernelSize [in] Size of the kernel.
+ * \param P [out] Interpolation operator.
+ *
+ * Rows represent the points (in the order of the processes, then of
+ * `points`), while columns represent pressure points. Like the Delta operator
+ * (see \ref petibm::operators::createDelta "createDelta"), the weights are
+ * given by the regularized delta function, multiplied by the volume of the
+ * Eulerian cells; they are normalized to sum to one, so that a uniform field
+ * is reproduced exactly on stretched meshes.
+ *
+ * \ingroup operatorModule
+ */
+PetscErrorCode createPressureSampling(const type::Mesh &mesh,
+                                      const type::Boundary &bc,
+                                      const type::RealVec2D &points,
+                                      const delta::DeltaKernel &kernel,
+                                      const PetscInt &kernelSize, Mat &P);
+
+/**
+ * \brief Create an operator interpolating the gradient of the velocity at
+ *        arbitrary points.
+ *
+ * \param mesh [in] Structured Cartesian mesh object.
+ * \param bc [in] Data object with boundary conditions.
+ * \param points [in] Coordinates of the points owned by the local process
+ *               (one row per point).
+ * \param kernel [in] Regularized delta kernel to use.
+ * \param kernelSize [in] Size of the kernel.
+ * \param GU [out] Interpolation operator.
+ *
+ * Rows represent the derivatives \f$\partial u_i / \partial x_j\f$ at each
+ * point (row \f$(k \times dim + i) \times dim + j\f$ for the local point
+ * \f$k\f$), while columns represent velocity points. A derivative is the
+ * central difference of the velocity component interpolated (as in
+ * \ref petibm::operators::createPressureSampling "createPressureSampling")
+ * at two locations one cell width apart.
+ *
+ * \ingroup operatorModule
+ */
+PetscErrorCode createVelocityGradientSampling(const type::Mesh &mesh,
+                                              const type::Boundary &bc,
+                                              const type::RealVec2D &points,
+                                              const delta::DeltaKernel &kernel,
+                                              const PetscInt &kernelSize,
+                                              Mat &GU);
+
 }  // end of namespace operators
 
 }  // end of namespace petibm
@@ -37,6 +37,11 @@ namespace parser
  * -# `-directory`: working directory (default: current working directory).
  * -# `-output`: output directory
  *    (default: folder `output` in the working directory).
+ * -# `-logs`: directory for PETSc logging files
+ *    (default: folder `logs` in the output directory).
+ * -# `-cache`: directory for the on-disk cache of assembled operators
+ *    (default: not used; folder `cache` in the output directory if the
+ *    option is passed without a value).
  * -# `-config`: YAML file path with all settings
  *    (default: `config.yaml` file in the working directory).
  * -# `-mesh`: YAML file path with mesh settings
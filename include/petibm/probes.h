@@ -56,10 +56,13 @@ public:
      * \param t [in] Time
      * \return PetscErrorCode
      */
-    PetscErrorCode monitor(const type::Solution &solution,
-                           const type::Mesh &mesh,
-                           const PetscInt &n,
-                           const PetscReal &t);
+    virtual PetscErrorCode monitor(const type::Solution &solution,
+                                   const type::Mesh &mesh,
+                                   const PetscInt &n,
+                                   const PetscReal &t);
+
+    /** \brief Get the name of the probe. */
+    const std::string &getName() const { return name; };
 
 protected:
     /** \brief Name of the probe as a string. */
@@ -140,12 +143,37 @@ public:
     /** \brief Manually destroy the data. */
     PetscErrorCode destroy();
 
+    /** \brief Monitor the field solution and output data to file.
+     *
+     * Only the processes that own points of the volume take part; the
+     * others return immediately.
+     *
+     * \param solution [in] Data object with the field solutions
+     * \param mesh [in] Cartesian mesh object
+     * \param n [in] Time-step index
+     * \param t [in] Time
+     * \return PetscErrorCode
+     */
+    PetscErrorCode monitor(const type::Solution &solution,
+                           const type::Mesh &mesh,
+                           const PetscInt &n,
+                           const PetscReal &t);
+
 protected:
-    /** \brief Limits of the volume. */
-    type::RealVec2D box;
+    /** \brief Limits of the volume (one row per direction). */
+    type::RealArray2D box;
+
+    /** \brief Local indices of the points to monitor in the field vector. */
+    type::IntVec1D lclIdx;
 
-    /** \brief Index set for the grid points to monitor (PETSc ordering). */
-    IS isPetsc;
+    /** \brief Offset of the field in the local part of the solution vector. */
+    PetscInt offset;
+
+    /** \brief Values of the field in the volume (on the sub-communicator). */
+    Vec svec;
+
+    /** \brief Whether the communicator is a split owned by the probe. */
+    PetscBool ownComm = PETSC_FALSE;
 
     /** \brief Index set for the grid points to monitor (Natural ordering). */
     IS isNatural;
@@ -186,9 +214,12 @@ protected:
      * \return PetscErrorCode
      */
     PetscErrorCode getInfo(const type::Mesh &mesh,
-                           const type::RealVec2D &box);
+                           const type::RealArray2D &box);
 
     /** \brief Create the index set for the points to monitor.
+     *
+     * The communicator of the probe is replaced by a sub-communicator of the
+     * processes that own points of the volume (MPI_COMM_NULL on the others).
      *
      * \param mesh [in] Cartesian mesh object
      * \return PetscErrorCode
@@ -309,9 +340,6 @@ protected:
     /** \brief True if target point located on local sub-domain. */
     PetscBool pointOnLocalProc;
 
-    /** \brief Local (ghosted) PETSc Vec object with neighboring values. */
-    Vec svec;
-
     /** \brief Interpolated value. */
     PetscReal value;
 
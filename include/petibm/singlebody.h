@@ -26,8 +26,9 @@ namespace body
  * \see bodyModule, petibm::type::SingleBody, petibm::body::createSingleBody
  * \ingroup bodyModule
  *
- * There is currently only one implementation for this abstract class:
- * body::SingleBodyPoints.
+ * Implementations of this abstract class: body::SingleBodyPoints (points
+ * read from a file) and body::SingleBodyShape (points generated
+ * analytically).
  */
 class SingleBodyBase
 {
@@ -46,11 +47,17 @@ public:
     /** \brief Total number of Lagrangian points. */
     PetscInt nPts;
 
-    /** \brief Coordinates of ALL Lagrangian points. */
-    type::RealVec2D coords;
+    /** \brief Coordinates of ALL Lagrangian points (one row per point). */
+    type::RealArray2D coords;
 
     /** \brief Initial coordinates of ALL Lagrangian points. */
-    type::RealVec2D coords0;
+    type::RealArray2D coords0;
+
+    /**
+     * \brief Index in the body file of each Lagrangian point (empty if the
+     *        points are stored in the order of the file).
+     */
+    type::IntVec1D order;
 
     /** \brief Local number of Lagrangian points. */
     PetscInt nLclPts;
@@ -59,7 +66,7 @@ public:
      * \brief Index of the closest Eulerian mesh cell
      *        for each local Lagrangian point.
      */
-    type::IntVec2D meshIdx;
+    type::IntArray2D meshIdx;
 
     /** \brief Global index of the first local Lagrangian point. */
     PetscInt bgPt;
@@ -229,6 +236,29 @@ PetscErrorCode createSingleBody(const MPI_Comm &comm, const PetscInt &dim,
                                 const std::string &filePath,
                                 type::SingleBody &body);
 
+/**
+ * \brief Factory function to create a single body generated analytically.
+ *
+ * \param comm [in] MPI communicator.
+ * \param dim [in] Number of dimensions.
+ * \param type [in] Type of shape ("cylinder", "sphere", "plate", or "naca").
+ * \param name [in] Name of the body.
+ * \param node [in] YAML configuration node of the body.
+ * \param meshNode [in] YAML configuration node of the mesh.
+ * \param body [out] SingleBody data object.
+ *
+ * \return PetscErrorCode.
+ *
+ * \see bodyModule, petibm::type::SingleBody, petibm::body::SingleBodyShape
+ * \ingroup bodyModule
+ */
+PetscErrorCode createSingleBody(const MPI_Comm &comm, const PetscInt &dim,
+                                const std::string &type,
+                                const std::string &name,
+                                const YAML::Node &node,
+                                const YAML::Node &meshNode,
+                                type::SingleBody &body);
+
 }  // end of namespace body
 
 }  // end of namespace petibm
@@ -69,6 +69,17 @@ public:
     virtual PetscErrorCode writeBody(const std::string &filepath);
 
 protected:
+    /**
+     * \brief Constructor. Only set the basic attributes; derived classes call
+     * init once they are ready to provide the coordinates.
+     *
+     * \param comm [in] MPI communicator.
+     * \param dim [in] Number of dimensions.
+     * \param name [in] Name of the body.
+     */
+    SingleBodyPoints(const MPI_Comm &comm, const PetscInt &dim,
+                     const std::string &name);
+
     /**
      * \brief Initialize the body, reading coordinates from given file.
      *
@@ -82,6 +93,19 @@ protected:
     PetscErrorCode init(const MPI_Comm &comm, const PetscInt &dim,
                         const std::string &name, const std::string &filePath);
 
+    /**
+     * \brief Sort the Lagrangian points along a space-filling curve.
+     *
+     * The curve is selected with the command-line option `-lagrangian_order`
+     * (`none`, `morton`, or `hilbert`; default is `none`). The points are
+     * sorted before being distributed, so each process holds a compact
+     * segment of the curve; `order` keeps the index of each point in the
+     * body file.
+     *
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode reorderPoints();
+
     /**
      * \brief Create a parallel layout (1D DMDA object) of the body.
      *
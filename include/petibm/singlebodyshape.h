@@ -0,0 +1,120 @@
+/**
+ * \file singlebodyshape.h
+ * \brief Definition of body::SingleBodyShape.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#pragma once
+
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/singlebodypoints.h>
+
+namespace petibm
+{
+namespace body
+{
+/**
+ * \brief An implementation of body::SingleBodyPoints whose Lagrangian points
+ * are generated analytically instead of being read from a file.
+ *
+ * \see bodyModule, petibm::type::SingleBody, petibm::body::SingleBodyPoints
+ * \ingroup bodyModule
+ *
+ * Supported shapes (YAML key `type` of the body):
+ *
+ * - `cylinder`: circle of a given `center` and `radius`;
+ * - `sphere`: sphere of a given `center` and `radius` (3D only);
+ * - `plate`: flat plate (zero thickness) from `start` to `end`;
+ * - `naca`: 4-digit NACA section of a given `designation` (e.g. "0012"),
+ *   `chord`, `leadingEdge`, and angle of attack `angle` (in degrees).
+ *
+ * In 3D, the 2D sections (cylinder, plate, and NACA section) are extruded in
+ * the z-direction over the range `span`. The spacing between Lagrangian points
+ * is the smallest width of the Eulerian cell that contains the reference point
+ * of the shape, unless it is prescribed with the key `spacing`.
+ *
+ * Users should not initialize an instance of this class directly. They should
+ * use petibm::body::createSingleBody.
+ */
+class SingleBodyShape : public SingleBodyPoints
+{
+public:
+    /**
+     * \brief Constructor. Initialize a single body.
+     *
+     * \param comm [in] MPI communicator.
+     * \param dim [in] Number of dimensions.
+     * \param type [in] Type of shape.
+     * \param name [in] Name of the body.
+     * \param node [in] YAML configuration node of the body.
+     * \param meshNode [in] YAML configuration node of the mesh.
+     */
+    SingleBodyShape(const MPI_Comm &comm, const PetscInt &dim,
+                    const std::string &type, const std::string &name,
+                    const YAML::Node &node, const YAML::Node &meshNode);
+
+    /** \copydoc SingleBodyBase::~SingleBodyBase */
+    virtual ~SingleBodyShape() = default;
+
+    /**
+     * \brief Generate the coordinates of the Lagrangian points.
+     *
+     * No file is read; the argument is ignored.
+     *
+     * \param filepath [in] Unused.
+     *
+     * \return PetscErrorCode.
+     */
+    virtual PetscErrorCode readBody(const std::string &filepath);
+
+protected:
+    /** \brief Type of shape. */
+    std::string shape;
+
+    /** \brief YAML configuration node of the body. */
+    YAML::Node node;
+
+    /** \brief Spacing between the Lagrangian points. */
+    PetscReal ds;
+
+    /**
+     * \brief Compute the spacing between the Lagrangian points.
+     *
+     * \param meshNode [in] YAML configuration node of the mesh.
+     *
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode getSpacing(const YAML::Node &meshNode);
+
+    /**
+     * \brief Get the reference point of the shape.
+     *
+     * \param point [out] Coordinates of the reference point.
+     *
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode getReferencePoint(type::RealVec1D &point) const;
+
+    /**
+     * \brief Generate the points of a 2D section of the shape.
+     *
+     * \param section [out] Coordinates of the points (one row per point).
+     *
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode createSection(type::RealVec2D &section) const;
+
+    /**
+     * \brief Generate the points of a sphere.
+     *
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode createSphere();
+
+};  // SingleBodyShape
+
+}  // end of namespace body
+
+}  // end of namespace petibm
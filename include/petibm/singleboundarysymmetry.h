@@ -0,0 +1,55 @@
+/**
+ * \file singleboundarysymmetry.h
+ * \brief Definition of the class `SingleBoundarySymmetry`.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#pragma once
+
+// here goes headers from our PetIBM
+#include <petibm/singleboundary.h>
+
+namespace petibm
+{
+namespace boundary
+{
+/**
+ * \brief An implementation of SingleBoundaryBase for symmetry-plane BC.
+ * \see boundaryModule, petibm::type::SingleBoundary,
+ * petibm::boundary::createSingleBoundary \ingroup boundaryModule
+ *
+ * On a symmetry plane, the velocity component normal to the plane vanishes,
+ * while the tangential components (and the pressure) have zero normal
+ * gradient. The BC value is ignored.
+ */
+class SingleBoundarySymmetry : public SingleBoundaryBase
+{
+public:
+    /**
+     * \brief Constructor.
+     * \param mesh [in] a Mesh instance.
+     * \param loc [in] the location of the target boundary.
+     * \param field [in] the target field.
+     * \param value [in] BC value (not used).
+     */
+    SingleBoundarySymmetry(const type::Mesh &mesh, const type::BCLoc &loc,
+                           const type::Field &field, const PetscReal &value);
+
+    /** \copydoc SingleBoundaryBase::~SingleBoundaryBase */
+    virtual ~SingleBoundarySymmetry() = default;
+
+protected:
+    // implementation of SingleBoundaryBase::setGhostICsKernel
+    virtual PetscErrorCode setGhostICsKernel(const PetscReal &targetValue,
+                                             type::GhostPointInfo &p);
+
+    // implementation of SingleBoundaryBase::updateEqsKernel
+    virtual PetscErrorCode updateEqsKernel(const PetscReal &targetValue,
+                                           const PetscReal &dt,
+                                           type::GhostPointInfo &p);
+
+};  // SingleBoundarySymmetry
+
+}  // end of namespace boundary
+}  // end of namespace petibm
@@ -134,7 +134,9 @@ public:
     /**
      * \brief Write flow field solutions to a file.
      *
-     * Currently only supports HDF5 format.
+     * Currently only supports HDF5 format. With the command-line option
+     * `-lod_levels <n>`, `n` levels of 2x-coarsened fields are also written in
+     * the groups `lod1` to `lodn` of the file (see io::writeHDF5Pyramid).
      *
      * \param filePath [in] Path of the file to write in.
      *
@@ -0,0 +1,304 @@
+/**
+ * \file surfacesampler.h
+ * \brief Prototype of misc::SurfaceSampler, type::SurfaceSampler, and factory
+ *        function.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <petscmat.h>
+#include <petscsys.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/bodypack.h>
+#include <petibm/boundary.h>
+#include <petibm/delta.h>
+#include <petibm/mesh.h>
+#include <petibm/type.h>
+
+namespace petibm
+{
+namespace misc
+{
+/**
+ * \brief In-situ sampler of the pressure and of the viscous traction on the
+ *        surface of an immersed body.
+ *
+ * The sampling points are the Lagrangian points of the body, optionally
+ * offset along their outward normals (to sample outside of the region
+ * smeared by the regularized delta function). The pressure and the gradient
+ * of the velocity are interpolated at the sampling points with operators
+ * built like the Delta operator (see
+ * petibm::operators::createPressureSampling and
+ * petibm::operators::createVelocityGradientSampling); the viscous traction
+ * is \f$\nu (\nabla u + \nabla u^T) \cdot n\f$.
+ *
+ * The normal at a point is the direction of least variance of the points of
+ * the body within two cell widths, oriented away from the centroid of the
+ * body.
+ *
+ * The values are written into an HDF5 file: the group `points` holds the
+ * coordinates of the sampling points (`x`, `y`, `z`) and the normals (`nx`,
+ * `ny`, `nz`), and the groups `p`, `tx`, `ty`, and `tz` hold one dataset per
+ * sampled time step (named after the time-step index; the pressure datasets
+ * hold the time value as an attribute). For moving bodies, the coordinates
+ * and the normals are written in groups of the same names with one dataset
+ * per sampled time step. All datasets list the points in the order of the
+ * body file, even if the Lagrangian points are sorted in memory (command-line
+ * option `-lagrangian_order`).
+ *
+ * \see miscModule, petibm::type::SurfaceSampler,
+ *      petibm::misc::createSurfaceSampler
+ * \ingroup miscModule
+ */
+class SurfaceSampler
+{
+public:
+    /** \brief Default constructor. */
+    SurfaceSampler() = default;
+
+    /**
+     * \brief Constructor. Initialize the sampler.
+     *
+     * \param comm [in] MPI communicator.
+     * \param node [in] YAML configuration node of the sampler.
+     * \param mesh [in] Cartesian mesh object.
+     * \param bc [in] Data object with boundary conditions.
+     * \param bodies [in] Pack of immersed bodies.
+     */
+    SurfaceSampler(const MPI_Comm &comm, const YAML::Node &node,
+                   const type::Mesh &mesh, const type::Boundary &bc,
+                   const type::BodyPack &bodies);
+
+    /** \brief Destructor. */
+    virtual ~SurfaceSampler();
+
+    /** \brief Manually destroy data in the object. */
+    virtual PetscErrorCode destroy();
+
+    /**
+     * \brief Sample the pressure and the traction and write them to file.
+     *
+     * Nothing is done if the time step is not a sampling time step. For
+     * moving bodies, the sampling points and the operators are updated from
+     * the current coordinates of the body first.
+     *
+     * \param bodies [in] Pack of immersed bodies.
+     * \param U [in] Velocity vector (packed).
+     * \param p [in] Pressure vector.
+     * \param nu [in] Viscous diffusion coefficient.
+     * \param n [in] Time-step index.
+     * \param t [in] Time.
+     * \return PetscErrorCode.
+     */
+    virtual PetscErrorCode monitor(const type::BodyPack &bodies, const Vec &U,
+                                   const Vec &p, const PetscReal &nu,
+                                   const PetscInt &n, const PetscReal &t);
+
+    /**
+     * \brief Declare the body as moving.
+     *
+     * \param flag [in] PETSC_TRUE if the body moves.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode setMoving(const PetscBool &flag);
+
+    /** \brief Get the name of the sampler. */
+    const std::string &getName() const { return name; };
+
+protected:
+    /** \brief Name of the sampler (name of the body by default). */
+    std::string name;
+
+    /** \brief Path of the output HDF5 file. */
+    std::string path;
+
+    /** \brief Index of the body in the pack. */
+    PetscInt body;
+
+    /** \brief Frequency of sampling (number of time steps). */
+    PetscInt n_monitor;
+
+    /** \brief Sampling starting time. */
+    PetscReal t_start;
+
+    /** \brief Sampling ending time. */
+    PetscReal t_end;
+
+    /** \brief Distance of the sampling points along the normals. */
+    PetscReal offset;
+
+    /** \brief Whether the viscous traction is sampled. */
+    PetscBool shear;
+
+    /** \brief Whether the body moves (operators updated at each sample). */
+    PetscBool moving;
+
+    /** \brief Regularized delta kernel. */
+    delta::DeltaKernel kernel;
+
+    /** \brief Size of the kernel. */
+    PetscInt kernelSize;
+
+    /** \brief Cartesian mesh object. */
+    type::Mesh mesh;
+
+    /** \brief Data object with boundary conditions. */
+    type::Boundary bc;
+
+    /** \brief Coordinates of the local sampling points. */
+    type::RealVec2D points;
+
+    /** \brief Outward unit normals at the local sampling points. */
+    type::RealVec2D normals;
+
+    /** \brief Operator interpolating the pressure. */
+    Mat P;
+
+    /** \brief Operator interpolating the gradient of the velocity. */
+    Mat GU;
+
+    /** \brief Interpolated gradient of the velocity. */
+    Vec grad;
+
+    /** \brief Sampled values: pressure, then traction components. */
+    std::vector<Vec> values;
+
+    /** \brief Scatter from the order in memory to the order of the file. */
+    VecScatter toFile;
+
+    /** \brief Values in the order of the body file (sorted points only). */
+    Vec fileValues;
+
+    /** \brief PETSc viewer to output the samples. */
+    PetscViewer viewer;
+
+    /** \brief MPI communicator. */
+    MPI_Comm comm;
+
+    /** \brief Rank of the local process in the MPI communicator. */
+    PetscMPIInt commRank;
+
+    /**
+     * \brief Initialize the sampler.
+     *
+     * \param comm [in] MPI communicator.
+     * \param node [in] YAML configuration node of the sampler.
+     * \param mesh [in] Cartesian mesh object.
+     * \param bc [in] Data object with boundary conditions.
+     * \param bodies [in] Pack of immersed bodies.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode init(const MPI_Comm &comm, const YAML::Node &node,
+                        const type::Mesh &mesh, const type::Boundary &bc,
+                        const type::BodyPack &bodies);
+
+    /**
+     * \brief Compute the sampling points and the normals of the local
+     *        Lagrangian points, and create the interpolation operators.
+     *
+     * \param bodies [in] Pack of immersed bodies.
+     * \param strict [in] Whether sampling points outside of the domain are
+     *               an error (see placePoints).
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode createPoints(const type::BodyPack &bodies,
+                                const PetscBool &strict);
+
+    /**
+     * \brief Wrap the sampling points around periodic boundaries and keep
+     *        them inside of the domain.
+     *
+     * A point beyond a non-periodic boundary is an error if `strict`;
+     * otherwise (a moving body got too close to the boundary), it is moved
+     * to the center of the nearest cell of the domain, with a warning.
+     *
+     * \param strict [in] Whether points outside of the domain are an error.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode placePoints(const PetscBool &strict);
+
+    /**
+     * \brief Create the scatter permuting the sampled values to the order of
+     *        the body file (if the Lagrangian points were sorted).
+     *
+     * \param bodies [in] Pack of immersed bodies.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode createFileOrder(const type::BodyPack &bodies);
+
+    /**
+     * \brief Write the sampling points and the normals.
+     *
+     * \param dataset [in] Name of the datasets in the groups `x`, `y`, `z`,
+     *                `nx`, `ny`, and `nz`; if empty, the datasets of those
+     *                names are written in the group `points`.
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode writePoints(const std::string &dataset);
+
+    /**
+     * \brief Write a vector of sampled values.
+     *
+     * \param group [in] Name of the group.
+     * \param dataset [in] Name of the dataset.
+     * \param vec [in] Values at the local sampling points (written in the
+     *            order of the body file).
+     * \return PetscErrorCode.
+     */
+    PetscErrorCode writeVec(const std::string &group,
+                            const std::string &dataset, const Vec &vec);
+
+};  // SurfaceSampler
+
+}  // end of namespace misc
+
+namespace type
+{
+/**
+ * \brief Type definition of SurfaceSampler.
+ *
+ * Please use petibm::misc::createSurfaceSampler to create a SurfaceSampler
+ * object.
+ *
+ * \see miscModule, petibm::misc::createSurfaceSampler,
+ *      petibm::misc::SurfaceSampler
+ * \ingroup miscModule
+ */
+typedef std::shared_ptr<misc::SurfaceSampler> SurfaceSampler;
+
+}  // end of namespace type
+
+namespace misc
+{
+/**
+ * \brief Factory function to create a sampler of the surface of a body.
+ *
+ * \param comm [in] MPI communicator
+ * \param node [in] YAML configuration node of the sampler
+ * \param mesh [in] Cartesian mesh object
+ * \param bc [in] Data object with boundary conditions
+ * \param bodies [in] Pack of immersed bodies
+ * \param sampler [out] SurfaceSampler
+ * \return PetscErrorCode
+ *
+ * \see miscModule, petibm::type::SurfaceSampler
+ * \ingroup miscModule
+ */
+PetscErrorCode createSurfaceSampler(const MPI_Comm &comm,
+                                    const YAML::Node &node,
+                                    const type::Mesh &mesh,
+                                    const type::Boundary &bc,
+                                    const type::BodyPack &bodies,
+                                    type::SurfaceSampler &sampler);
+
+}  // end of namespace misc
+
+}  // end of namespace petibm
@@ -59,6 +59,15 @@ public:
     /** \brief Coefficients of explicit terms. */
     const type::RealVec1D explicitCoeffs;
 
+    /**
+     * \brief Directions (0, 1, or 2) in which the implicit term is treated
+     * implicitly; empty means all directions.
+     *
+     * Set by petibm::timeintegration::createTimeIntegration from the key
+     * `<name>ImplicitDirections` (e.g. `diffusionImplicitDirections: [y]`).
+     */
+    type::IntVec1D implicitDirections;
+
     /** \brief Default constructor. */
     TimeIntegrationBase() : TimeIntegrationBase("none", "none", 0.0, 0, {}){};
 
@@ -190,6 +199,11 @@ namespace timeintegration
  * \param node [in] YAML::Node of all configuration.
  * \param integration [out] resulting TimeIntegration object.
  * \return PetscErrorCode.
+ *
+ * For schemes with an implicit term, the optional key
+ * `parameters: <name>ImplicitDirections` (a list among x, y, and z) restricts
+ * the implicit treatment to the listed directions; solvers treat the term
+ * explicitly in the other directions.
  * \see timeModule, petibm::type::TimeIntegration
  * \ingroup timeModule
  */
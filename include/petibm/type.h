@@ -8,7 +8,9 @@
 #pragma once
 
 // here goes C++ STL
+#include <cstdlib>
 #include <map>
+#include <new>
 #include <string>
 #include <vector>
 
@@ -96,7 +98,8 @@ enum BCType
     PERIODIC,
     DIRICHLET,
     NEUMANN,
-    CONVECTIVE
+    CONVECTIVE,
+    SYMMETRY
 };
 /** \brief Mapping between `std::string` and \ref BCType. \ingroup type */
 extern std::map<std::string, BCType> str2bt;
@@ -150,6 +153,153 @@ typedef std::vector<BoolVec1D> BoolVec2D;
 /** \brief 3D std::vector holding PetscBool. \ingroup type */
 typedef std::vector<BoolVec2D> BoolVec3D;
 
+/**
+ * \brief An STL allocator returning memory aligned to `Align` bytes.
+ * \ingroup type
+ */
+template <typename T, std::size_t Align = 64>
+struct AlignedAllocator
+{
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef AlignedAllocator<U, Align> other;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align> &) {};
+
+    T *allocate(std::size_t n)
+    {
+        void *ptr = nullptr;
+        if (n == 0) return nullptr;
+        if (posix_memalign(&ptr, Align, n * sizeof(T)) != 0)
+            throw std::bad_alloc();
+        return static_cast<T *>(ptr);
+    };
+
+    void deallocate(T *ptr, std::size_t) { std::free(ptr); };
+};  // AlignedAllocator
+
+template <typename T, typename U, std::size_t Align>
+bool operator==(const AlignedAllocator<T, Align> &,
+                const AlignedAllocator<U, Align> &)
+{
+    return true;
+}
+
+template <typename T, typename U, std::size_t Align>
+bool operator!=(const AlignedAllocator<T, Align> &,
+                const AlignedAllocator<U, Align> &)
+{
+    return false;
+}
+
+/**
+ * \brief A 2D array stored row by row in one contiguous, aligned buffer.
+ * \ingroup type
+ *
+ * It replaces nested std::vector objects (e.g., \ref RealVec2D) for tables
+ * with a fixed number of columns, such as the coordinates of Lagrangian points.
+ * `a[i]` returns a pointer to the first element of row `i`, so `a[i][j]` has
+ * the same meaning as with nested std::vector objects, and `a.size()` returns
+ * the number of rows. Consecutive rows are `stride()` elements apart.
+ */
+template <typename T>
+class Array2D
+{
+public:
+    /** \brief Default constructor: an empty array. */
+    Array2D() = default;
+
+    /**
+     * \brief Constructor.
+     *
+     * \param nRows [in] Number of rows.
+     * \param nCols [in] Number of columns.
+     * \param value [in] Initial value of all elements.
+     */
+    Array2D(const std::size_t &nRows, const std::size_t &nCols,
+            const T &value = T())
+    {
+        resize(nRows, nCols, value);
+    };
+
+    /**
+     * \brief Resize the array; all elements are set to `value`.
+     *
+     * \param nRows [in] Number of rows.
+     * \param nCols [in] Number of columns.
+     * \param value [in] Value of all elements.
+     */
+    void resize(const std::size_t &nRows, const std::size_t &nCols,
+                const T &value = T())
+    {
+        rows = nRows;
+        cols = nCols;
+        buffer.assign(rows * cols, value);
+    };
+
+    /** \brief Release the memory and reset the array to an empty one. */
+    void clear()
+    {
+        rows = cols = 0;
+        std::vector<T, AlignedAllocator<T>>().swap(buffer);
+    };
+
+    /** \brief Number of rows. */
+    std::size_t size() const { return rows; };
+
+    /** \brief Number of columns. */
+    std::size_t nCols() const { return cols; };
+
+    /** \brief Distance (in number of elements) between consecutive rows. */
+    std::size_t stride() const { return cols; };
+
+    /** \brief Whether the array is empty. */
+    bool empty() const { return rows == 0; };
+
+    /** \brief Pointer to the first element of the array. */
+    T *data() { return buffer.data(); };
+
+    /** \brief Pointer to the first element of the array. */
+    const T *data() const { return buffer.data(); };
+
+    /** \brief Pointer to the first element of row `i`. */
+    T *operator[](const std::size_t &i) { return buffer.data() + i * cols; };
+
+    /** \brief Pointer to the first element of row `i`. */
+    const T *operator[](const std::size_t &i) const
+    {
+        return buffer.data() + i * cols;
+    };
+
+    /** \brief Copy of row `i` as a std::vector. */
+    std::vector<T> row(const std::size_t &i) const
+    {
+        return std::vector<T>((*this)[i], (*this)[i] + cols);
+    };
+
+protected:
+    /** \brief Number of rows. */
+    std::size_t rows = 0;
+
+    /** \brief Number of columns. */
+    std::size_t cols = 0;
+
+    /** \brief Contiguous storage of all elements, row by row. */
+    std::vector<T, AlignedAllocator<T>> buffer;
+};  // Array2D
+
+/** \brief Contiguous 2D array holding PetscInt. \ingroup type */
+typedef Array2D<PetscInt> IntArray2D;
+/** \brief Contiguous 2D array holding PetscReal. \ingroup type */
+typedef Array2D<PetscReal> RealArray2D;
+
 /** \brief a vector of pointers to mimic ghosted 1D vectors. \ingroup type */
 typedef std::vector<PetscReal*> GhostedVec2D;
 /** \brief a vector of vector pointers to mimic ghosted 2D vectors. \ingroup
@@ -0,0 +1,36 @@
+# CONFIGURE_PTHREAD
+# -----------------
+# brief: Finds the flag to compile and link programs using std::thread.
+AC_DEFUN([CONFIGURE_PTHREAD], [
+
+AC_MSG_CHECKING([for the flag to use std::thread])
+PTHREAD_FLAG=unknown
+for flag in -pthread -lpthread none; do
+  PTHREAD_save_CXXFLAGS=$CXXFLAGS
+  PTHREAD_save_LIBS=$LIBS
+  case $flag in
+    none) ;;
+    -l*) LIBS="$flag $LIBS" ;;
+    *) CXXFLAGS="$CXXFLAGS $flag"; LIBS="$flag $LIBS" ;;
+  esac
+  AC_LINK_IFELSE([AC_LANG_PROGRAM([[#include <thread>
+void work() {}]], [[std::thread t(work); t.join();]])],
+                 [PTHREAD_FLAG=$flag], [])
+  CXXFLAGS=$PTHREAD_save_CXXFLAGS
+  LIBS=$PTHREAD_save_LIBS
+  if test "x$PTHREAD_FLAG" != xunknown; then
+    break
+  fi
+done
+AC_MSG_RESULT([$PTHREAD_FLAG])
+
+case $PTHREAD_FLAG in
+  unknown)
+    AC_MSG_ERROR([Couldn't build a program using std::thread...
+Set CXXFLAGS and LIBS to the flags of the POSIX threads of the platform.]) ;;
+  none) ;;
+  -l*) LIBS="$PTHREAD_FLAG $LIBS" ;;
+  *) CXXFLAGS="$CXXFLAGS $PTHREAD_FLAG"; LIBS="$PTHREAD_FLAG $LIBS" ;;
+esac
+
+]) # CONFIGURE_PTHREAD
@@ -95,26 +95,35 @@ PetscErrorCode BodyPackBase::init(const MPI_Comm &inComm, const PetscInt &inDim,
         name = node["bodies"][i]["name"].as<std::string>("body" +
                                                          std::to_string(i));
 
-        // so far, we only have one type: points. So this is also the default
-        // value
+        // the default type is a file of points; other types are shapes
+        // generated analytically
         type = node["bodies"][i]["type"].as<std::string>("points");
 
-        // check if the key "file" exists
-        if (!node["bodies"][i]["file"].IsDefined())
-            SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
-                     "No key \"file\" found in the YAML node of the body "
-                     "\"%s\".\n",
-                     name.c_str());
-
-        filePath = node["bodies"][i]["file"].as<std::string>();
-
-        // check if file path is absolute; if not, prepend directory path
-        // note: this only works on Unix-like OS
-        if (filePath[0] != '/')
-            filePath = node["directory"].as<std::string>() + "/" + filePath;
-
-        ierr = createSingleBody(comm, dim, type, name, filePath, bodies[i]);
-        CHKERRQ(ierr);
+        if (type != "points")
+        {
+            ierr = createSingleBody(comm, dim, type, name, node["bodies"][i],
+                                    node["mesh"], bodies[i]); CHKERRQ(ierr);
+        }
+        else
+        {
+            // check if the key "file" exists
+            if (!node["bodies"][i]["file"].IsDefined())
+                SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                         "No key \"file\" found in the YAML node of the body "
+                         "\"%s\".\n",
+                         name.c_str());
+
+            filePath = node["bodies"][i]["file"].as<std::string>();
+
+            // check if file path is absolute; if not, prepend directory path
+            // note: this only works on Unix-like OS
+            if (filePath[0] != '/')
+                filePath =
+                    node["directory"].as<std::string>() + "/" + filePath;
+
+            ierr = createSingleBody(comm, dim, type, name, filePath, bodies[i]);
+            CHKERRQ(ierr);
+        }
 
         for (PetscMPIInt r = 0; r < mpiSize; ++r)
             nLclAllProcs[r] += bodies[i]->nLclAllProcs[r];
@@ -171,6 +180,69 @@ PetscErrorCode BodyPackBase::updateMeshIdx(const type::Mesh &mesh)
     PetscFunctionReturn(0);
 }  // updateMeshIdx
 
+PetscErrorCode BodyPackBase::reorderVec(const Vec &in, Vec &out,
+                                        const PetscBool &toFile) const
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    bool sorted = false;
+    for (auto body : bodies) sorted = sorted || (body->order.size() > 0);
+    if (!sorted)
+    {
+        ierr = VecCopy(in, out); CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+    }
+
+    // packed indices of the local points in memory and in the files
+    type::IntVec1D idxMem, idxFile;
+    idxMem.reserve(nLclPts * dim);
+    idxFile.reserve(nLclPts * dim);
+    for (PetscInt b = 0; b < nBodies; ++b)
+    {
+        const type::SingleBody &body = bodies[b];
+        for (PetscInt i = body->bgPt; i < body->edPt; ++i)
+        {
+            PetscInt j = (body->order.size() > 0) ? body->order[i] : i;
+            for (PetscInt d = 0; d < dim; ++d)
+            {
+                PetscInt idx;
+                ierr = getPackedGlobalIndex(b, i, d, idx); CHKERRQ(ierr);
+                idxMem.push_back(idx);
+                ierr = getPackedGlobalIndex(b, j, d, idx); CHKERRQ(ierr);
+                idxFile.push_back(idx);
+            }
+        }
+    }
+
+    IS isMem, isFile;
+    VecScatter scatter;
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, idxMem.size(), idxMem.data(),
+                           PETSC_USE_POINTER, &isMem); CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, idxFile.size(), idxFile.data(),
+                           PETSC_USE_POINTER, &isFile); CHKERRQ(ierr);
+    if (toFile)
+    {
+        ierr = VecScatterCreate(in, isMem, out, isFile, &scatter);
+        CHKERRQ(ierr);
+    }
+    else
+    {
+        ierr = VecScatterCreate(in, isFile, out, isMem, &scatter);
+        CHKERRQ(ierr);
+    }
+    ierr = VecScatterBegin(
+        scatter, in, out, INSERT_VALUES, SCATTER_FORWARD); CHKERRQ(ierr);
+    ierr = VecScatterEnd(
+        scatter, in, out, INSERT_VALUES, SCATTER_FORWARD); CHKERRQ(ierr);
+    ierr = VecScatterDestroy(&scatter); CHKERRQ(ierr);
+    ierr = ISDestroy(&isMem); CHKERRQ(ierr);
+    ierr = ISDestroy(&isFile); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // reorderVec
+
 PetscErrorCode BodyPackBase::createInfoString()
 {
     PetscFunctionBeginUser;
@@ -218,7 +290,7 @@ PetscErrorCode BodyPackBase::findProc(const PetscInt &bIdx,
 
     if ((bIdx < 0) || (bIdx >= nBodies))
         SETERRQ2(comm, PETSC_ERR_ARG_SIZ,
-                 "Body index %d is out of range. Total number of bodies is %d.",
+                 "Body index %D is out of range. Total number of bodies is %D.",
                  bIdx, nBodies);
 
     ierr = bodies[bIdx]->findProc(ptIdx, proc); CHKERRQ(ierr);
@@ -237,7 +309,7 @@ PetscErrorCode BodyPackBase::getGlobalIndex(const PetscInt &bIdx,
 
     if ((bIdx < 0) || (bIdx >= nBodies))
         SETERRQ2(comm, PETSC_ERR_ARG_SIZ,
-                 "Body index %d is out of range. Total number of bodies is %d.",
+                 "Body index %D is out of range. Total number of bodies is %D.",
                  bIdx, nBodies);
 
     ierr = bodies[bIdx]->getGlobalIndex(ptIdx, dof, idx); CHKERRQ(ierr);
@@ -0,0 +1,384 @@
+/**
+ * \file kinematics.cpp
+ * \brief Implementation of body::MotionLaw, body::Kinematics, and factory
+ *        function.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+// PetIBM
+#include <petibm/kinematics.h>
+
+namespace
+{
+// c = a b for 3x3 matrices
+void matMult(const PetscReal a[3][3], const PetscReal b[3][3],
+             PetscReal c[3][3])
+{
+    for (PetscInt i = 0; i < 3; ++i)
+        for (PetscInt j = 0; j < 3; ++j)
+            c[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] + a[i][2] * b[2][j];
+}  // matMult
+
+// rotation matrix about the axis `axis` and its derivative with respect to
+// the angle
+void getRotation(const PetscInt &axis, const PetscReal &theta,
+                 PetscReal R[3][3], PetscReal dR[3][3])
+{
+    const PetscInt i = (axis + 1) % 3, j = (axis + 2) % 3;
+    const PetscReal c = std::cos(theta), s = std::sin(theta);
+
+    for (PetscInt m = 0; m < 3; ++m)
+        for (PetscInt n = 0; n < 3; ++n) R[m][n] = dR[m][n] = 0.0;
+
+    R[axis][axis] = 1.0;
+    R[i][i] = c;
+    R[i][j] = -s;
+    R[j][i] = s;
+    R[j][j] = c;
+
+    dR[i][i] = -s;
+    dR[i][j] = -c;
+    dR[j][i] = c;
+    dR[j][j] = -s;
+}  // getRotation
+}  // end of anonymous namespace
+
+namespace petibm
+{
+namespace body
+{
+MotionLaw::MotionLaw(const MPI_Comm &comm, const YAML::Node &node,
+                     const std::string &directory)
+{
+    init(comm, node, directory);
+}  // MotionLaw
+
+PetscErrorCode MotionLaw::init(const MPI_Comm &comm, const YAML::Node &node,
+                               const std::string &directory)
+{
+    PetscFunctionBeginUser;
+
+    law = node["law"].as<std::string>("linear");
+
+    if (law == "linear")
+    {
+        value = node["value"].as<PetscReal>(0.0);
+        rate = node["rate"].as<PetscReal>(0.0);
+    }
+    else if (law == "fourier")
+    {
+        frequency = node["frequency"].as<PetscReal>();
+        value = node["a0"].as<PetscReal>(0.0);
+        a = node["a"].as<type::RealVec1D>(type::RealVec1D());
+        b = node["b"].as<type::RealVec1D>(type::RealVec1D());
+    }
+    else if (law == "table")
+    {
+        if (node["file"].IsDefined())
+        {
+            // check if file path is absolute; if not, prepend directory path
+            std::string filePath = node["file"].as<std::string>();
+            if (filePath[0] != '/') filePath = directory + "/" + filePath;
+
+            std::ifstream inFile(filePath.c_str());
+            if (!inFile.good())
+                SETERRQ1(comm, PETSC_ERR_FILE_OPEN,
+                         "Could not open the table of motion \"%s\".\n",
+                         filePath.c_str());
+
+            std::string line;
+            while (std::getline(inFile, line))
+            {
+                if (line.empty() || (line[0] == '#')) continue;
+                std::istringstream sline(line);
+                PetscReal ti, si;
+                if (!(sline >> ti >> si))
+                    SETERRQ1(comm, PETSC_ERR_FILE_UNEXPECTED,
+                             "Could not read the line \"%s\" of a table of "
+                             "motion.\n",
+                             line.c_str());
+                times.push_back(ti);
+                values.push_back(si);
+            }
+        }
+        else
+        {
+            times = node["times"].as<type::RealVec1D>();
+            values = node["values"].as<type::RealVec1D>();
+        }
+
+        if ((times.size() == 0) || (times.size() != values.size()))
+            SETERRQ(comm, PETSC_ERR_ARG_SIZ,
+                    "A table of motion needs as many times as values.\n");
+        for (std::size_t k = 1; k < times.size(); ++k)
+            if (times[k] <= times[k - 1])
+                SETERRQ(comm, PETSC_ERR_ARG_WRONG,
+                        "The times of a table of motion must increase.\n");
+    }
+    else
+        SETERRQ1(comm, PETSC_ERR_ARG_UNKNOWN_TYPE,
+                 "Unknown law of motion \"%s\" (choices are linear, fourier, "
+                 "and table).\n",
+                 law.c_str());
+
+    PetscFunctionReturn(0);
+}  // init
+
+void MotionLaw::evaluate(const PetscReal &t, PetscReal &s,
+                         PetscReal &ds) const
+{
+    if (law == "linear")
+    {
+        s = value + rate * t;
+        ds = rate;
+    }
+    else if (law == "fourier")
+    {
+        const PetscReal omega = 2.0 * PETSC_PI * frequency;
+        s = value;
+        ds = 0.0;
+        for (std::size_t k = 0; k < std::max(a.size(), b.size()); ++k)
+        {
+            PetscReal wk = (k + 1) * omega,
+                      ak = (k < a.size()) ? a[k] : 0.0,
+                      bk = (k < b.size()) ? b[k] : 0.0,
+                      c = std::cos(wk * t), sn = std::sin(wk * t);
+            s += ak * c + bk * sn;
+            ds += wk * (bk * c - ak * sn);
+        }
+    }
+    else  // table
+    {
+        if (t <= times.front())
+        {
+            s = values.front();
+            ds = 0.0;
+        }
+        else if (t >= times.back())
+        {
+            s = values.back();
+            ds = 0.0;
+        }
+        else
+        {
+            std::size_t k =
+                std::upper_bound(times.begin(), times.end(), t) -
+                times.begin();
+            ds = (values[k] - values[k - 1]) / (times[k] - times[k - 1]);
+            s = values[k - 1] + ds * (t - times[k - 1]);
+        }
+    }
+}  // evaluate
+
+Kinematics::Kinematics(const MPI_Comm &comm, const PetscInt &dim,
+                       const std::string &name, const YAML::Node &node,
+                       const std::string &directory)
+{
+    init(comm, dim, name, node, directory);
+}  // Kinematics
+
+PetscErrorCode Kinematics::init(const MPI_Comm &inComm, const PetscInt &inDim,
+                                const std::string &inName,
+                                const YAML::Node &node,
+                                const std::string &directory)
+{
+    PetscFunctionBeginUser;
+
+    comm = inComm;
+    dim = inDim;
+    name = inName;
+
+    pivot = type::RealVec1D(3, 0.0);
+    if (node["pivot"].IsDefined())
+    {
+        type::RealVec1D temp = node["pivot"].as<type::RealVec1D>();
+        if (temp.size() != (unsigned)dim)
+            SETERRQ2(comm, PETSC_ERR_ARG_SIZ,
+                     "The pivot of the body %s needs %D coordinates.\n",
+                     name.c_str(), dim);
+        std::copy(temp.begin(), temp.end(), pivot.begin());
+    }
+
+    // fixed degrees of freedom use the default law (zero)
+    const std::string dirs[3] = {"x", "y", "z"};
+    const YAML::Node &tNode = node["translation"], &rNode = node["rotation"];
+    translation.assign(3, MotionLaw());
+    rotation.assign(3, MotionLaw());
+    for (PetscInt d = 0; d < 3; ++d)
+    {
+        if (tNode && tNode[dirs[d]])
+        {
+            if (d >= dim)
+                SETERRQ2(comm, PETSC_ERR_ARG_WRONG,
+                         "The body %s cannot translate in the %s direction "
+                         "in 2D.\n",
+                         name.c_str(), dirs[d].c_str());
+            translation[d] = MotionLaw(comm, tNode[dirs[d]], directory);
+        }
+        if (rNode && rNode[dirs[d]])
+        {
+            if ((dim == 2) && (d != 2))
+                SETERRQ2(comm, PETSC_ERR_ARG_WRONG,
+                         "The body %s can only rotate about the z axis in "
+                         "2D (not about %s).\n",
+                         name.c_str(), dirs[d].c_str());
+            rotation[d] = MotionLaw(comm, rNode[dirs[d]], directory);
+        }
+    }
+
+    // the operators were assembled with the initial coordinates
+    for (PetscInt i = 0; i < 3; ++i)
+    {
+        dLast[i] = 0.0;
+        for (PetscInt j = 0; j < 3; ++j) RLast[i][j] = (i == j) ? 1.0 : 0.0;
+    }
+
+    PetscFunctionReturn(0);
+}  // init
+
+PetscErrorCode Kinematics::getTransform(const PetscReal &t, PetscReal d[3],
+                                        PetscReal dd[3], PetscReal R[3][3],
+                                        PetscReal dR[3][3]) const
+{
+    PetscFunctionBeginUser;
+
+    for (PetscInt i = 0; i < 3; ++i)
+        translation[i].evaluate(t, d[i], dd[i]);
+
+    // R = Rz Ry Rx; the angles are in degrees
+    PetscReal Rs[3][3][3], dRs[3][3][3];
+    for (PetscInt i = 0; i < 3; ++i)
+    {
+        PetscReal theta, dtheta;
+        rotation[i].evaluate(t, theta, dtheta);
+        getRotation(i, theta * PETSC_PI / 180.0, Rs[i], dRs[i]);
+        for (PetscInt m = 0; m < 3; ++m)
+            for (PetscInt n = 0; n < 3; ++n)
+                dRs[i][m][n] *= dtheta * PETSC_PI / 180.0;
+    }
+
+    PetscReal Ryx[3][3], temp[3][3];
+    matMult(Rs[1], Rs[0], Ryx);
+    matMult(Rs[2], Ryx, R);
+
+    // product rule: dR = dRz Ry Rx + Rz dRy Rx + Rz Ry dRx
+    matMult(dRs[2], Ryx, dR);
+    matMult(dRs[1], Rs[0], temp);
+    matMult(Rs[2], temp, Ryx);
+    for (PetscInt m = 0; m < 3; ++m)
+        for (PetscInt n = 0; n < 3; ++n) dR[m][n] += Ryx[m][n];
+    matMult(Rs[1], dRs[0], temp);
+    matMult(Rs[2], temp, Ryx);
+    for (PetscInt m = 0; m < 3; ++m)
+        for (PetscInt n = 0; n < 3; ++n) dR[m][n] += Ryx[m][n];
+
+    PetscFunctionReturn(0);
+}  // getTransform
+
+PetscErrorCode Kinematics::update(const type::SingleBody &body,
+                                  const PetscReal &t, PetscReal *U,
+                                  PetscBool &moved)
+{
+    PetscErrorCode ierr;
+    PetscReal d[3], dd[3], R[3][3], dR[3][3];
+
+    PetscFunctionBeginUser;
+
+    ierr = getTransform(t, d, dd, R, dR); CHKERRQ(ierr);
+
+    // the points moved if the transformation changed since the last update
+    moved = PETSC_FALSE;
+    for (PetscInt i = 0; i < 3; ++i)
+    {
+        if (d[i] != dLast[i]) moved = PETSC_TRUE;
+        dLast[i] = d[i];
+        for (PetscInt j = 0; j < 3; ++j)
+        {
+            if (R[i][j] != RLast[i][j]) moved = PETSC_TRUE;
+            RLast[i][j] = R[i][j];
+        }
+    }
+
+    // rows of the local points are contiguous in the coordinate arrays
+    const PetscInt n = body->nLclPts;
+    const PetscReal *X0 = body->coords0[body->bgPt];
+    PetscReal *X = body->coords[body->bgPt];
+    const PetscReal c[3] = {pivot[0], pivot[1], pivot[2]};
+
+    if (dim == 2)
+    {
+        for (PetscInt k = 0; k < n; ++k)
+        {
+            const PetscReal rx = X0[2 * k] - c[0], ry = X0[2 * k + 1] - c[1];
+            X[2 * k] = c[0] + d[0] + R[0][0] * rx + R[0][1] * ry;
+            X[2 * k + 1] = c[1] + d[1] + R[1][0] * rx + R[1][1] * ry;
+            U[2 * k] = dd[0] + dR[0][0] * rx + dR[0][1] * ry;
+            U[2 * k + 1] = dd[1] + dR[1][0] * rx + dR[1][1] * ry;
+        }
+    }
+    else
+    {
+        for (PetscInt k = 0; k < n; ++k)
+        {
+            const PetscReal r[3] = {X0[3 * k] - c[0], X0[3 * k + 1] - c[1],
+                                    X0[3 * k + 2] - c[2]};
+            for (PetscInt i = 0; i < 3; ++i)
+            {
+                X[3 * k + i] = c[i] + d[i] + R[i][0] * r[0] +
+                               R[i][1] * r[1] + R[i][2] * r[2];
+                U[3 * k + i] = dd[i] + dR[i][0] * r[0] + dR[i][1] * r[1] +
+                               dR[i][2] * r[2];
+            }
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // update
+
+PetscErrorCode Kinematics::updateAll(const type::SingleBody &body,
+                                     const PetscReal &t) const
+{
+    PetscErrorCode ierr;
+    PetscReal d[3], dd[3], R[3][3], dR[3][3];
+
+    PetscFunctionBeginUser;
+
+    ierr = getTransform(t, d, dd, R, dR); CHKERRQ(ierr);
+
+    for (PetscInt k = 0; k < body->nPts; ++k)
+    {
+        const PetscReal *X0 = body->coords0[k];
+        PetscReal *X = body->coords[k];
+        PetscReal r[3] = {0.0, 0.0, 0.0};
+        for (PetscInt i = 0; i < dim; ++i) r[i] = X0[i] - pivot[i];
+        for (PetscInt i = 0; i < dim; ++i)
+            X[i] = pivot[i] + d[i] + R[i][0] * r[0] + R[i][1] * r[1] +
+                   R[i][2] * r[2];
+    }
+
+    PetscFunctionReturn(0);
+}  // updateAll
+
+PetscErrorCode createKinematics(const MPI_Comm &comm, const PetscInt &dim,
+                                const std::string &name,
+                                const YAML::Node &node,
+                                const std::string &directory,
+                                type::Kinematics &kinematics)
+{
+    PetscFunctionBeginUser;
+
+    kinematics = std::make_shared<Kinematics>(comm, dim, name, node, directory);
+
+    PetscFunctionReturn(0);
+}  // createKinematics
+
+}  // end of namespace body
+
+}  // end of namespace petibm
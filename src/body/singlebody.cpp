@@ -8,6 +8,7 @@
 #include <petibm/io.h>
 #include <petibm/singlebody.h>
 #include <petibm/singlebodypoints.h>
+#include <petibm/singlebodyshape.h>
 
 namespace petibm
 {
@@ -58,8 +59,10 @@ PetscErrorCode SingleBodyBase::destroy()
     dim = -1;
     name = filePath = info = "";
     nPts = nLclPts = bgPt = edPt = 0;
-    type::RealVec2D().swap(coords);
-    type::IntVec2D().swap(meshIdx);
+    coords.clear();
+    coords0.clear();
+    order.clear();
+    meshIdx.clear();
     ierr = DMDestroy(&da); CHKERRQ(ierr);
     comm = MPI_COMM_NULL;
     mpiSize = mpiRank = 0;
@@ -98,6 +101,27 @@ PetscErrorCode createSingleBody(const MPI_Comm &comm, const PetscInt &dim,
     PetscFunctionReturn(0);
 }  // createSingleBody
 
+PetscErrorCode createSingleBody(const MPI_Comm &comm, const PetscInt &dim,
+                                const std::string &type,
+                                const std::string &name,
+                                const YAML::Node &node,
+                                const YAML::Node &meshNode,
+                                type::SingleBody &body)
+{
+    PetscFunctionBeginUser;
+
+    if ((type == "cylinder") || (type == "sphere") || (type == "plate") ||
+        (type == "naca"))
+        body = std::make_shared<SingleBodyShape>(comm, dim, type, name, node,
+                                                 meshNode);
+    else
+        SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                 "The type of body \"%s\" is not recognized!\n",
+                 type.c_str());
+
+    PetscFunctionReturn(0);
+}  // createSingleBody
+
 }  // end of namespace body
 
 }  // end of namespace petibm
@@ -7,11 +7,59 @@
 
 // STL
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
 
 // PetIBM
 #include <petibm/io.h>
 #include <petibm/singlebodypoints.h>
 
+namespace  // anonymous namespace for internal linkage only
+{
+// position along a Morton or Hilbert curve of a point with integer
+// coordinates of `bits` bits each
+std::uint64_t getCurveKey(std::uint32_t X[3], const PetscInt &n,
+                          const PetscInt &bits, const bool &hilbert)
+{
+    if (hilbert)
+    {
+        // transform the coordinates into the "transposed" Hilbert index
+        // (Skilling, AIP Conference Proceedings 707, 2004)
+        const std::uint32_t M = 1u << (bits - 1);
+        for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+        {
+            const std::uint32_t P = Q - 1;
+            for (PetscInt i = 0; i < n; ++i)
+            {
+                if (X[i] & Q)
+                    X[0] ^= P;  // invert
+                else
+                {
+                    std::uint32_t t = (X[0] ^ X[i]) & P;  // exchange
+                    X[0] ^= t;
+                    X[i] ^= t;
+                }
+            }
+        }
+        // Gray encode
+        for (PetscInt i = 1; i < n; ++i) X[i] ^= X[i - 1];
+        std::uint32_t t = 0;
+        for (std::uint32_t Q = M; Q > 1; Q >>= 1)
+            if (X[n - 1] & Q) t ^= Q - 1;
+        for (PetscInt i = 0; i < n; ++i) X[i] ^= t;
+    }
+
+    // interleave the bits, from the most significant ones
+    std::uint64_t key = 0;
+    for (PetscInt b = bits - 1; b >= 0; --b)
+        for (PetscInt i = 0; i < n; ++i)
+            key = (key << 1) | ((X[i] >> b) & 1u);
+
+    return key;
+}  // getCurveKey
+}  // end of anonymous namespace
+
 namespace petibm
 {
 namespace body
@@ -24,6 +72,12 @@ SingleBodyPoints::SingleBodyPoints(const MPI_Comm &comm, const PetscInt &dim,
     init(comm, dim, name, filePath);
 }  // SingleBodyPoints
 
+SingleBodyPoints::SingleBodyPoints(const MPI_Comm &comm, const PetscInt &dim,
+                                   const std::string &name)
+    : SingleBodyBase(comm, dim, name, "")
+{
+}  // SingleBodyPoints
+
 PetscErrorCode SingleBodyPoints::init(const MPI_Comm &comm, const PetscInt &dim,
                                       const std::string &name,
                                       const std::string &filePath)
@@ -36,11 +90,14 @@ PetscErrorCode SingleBodyPoints::init(const MPI_Comm &comm, const PetscInt &dim,
     ierr = readBody(filePath); CHKERRQ(ierr);
 
     // check if the dimension of coordinates matches
-    if ((unsigned)dim != coords[0].size())
+    if ((unsigned)dim != coords.nCols())
         SETERRQ(PETSC_COMM_WORLD, PETSC_ERR_FILE_READ,
                 "The dimension of Lagrangian points are different than that "
                 "of the background mesh!\n");
 
+    // sort the points along a space-filling curve, if requested
+    ierr = reorderPoints(); CHKERRQ(ierr);
+
     // record the initial body coordinates
     coords0 = coords;
 
@@ -50,7 +107,7 @@ PetscErrorCode SingleBodyPoints::init(const MPI_Comm &comm, const PetscInt &dim,
 
     // initialize meshIdx, which only contains background mesh indices of local
     // Lagrangian points. The indices are defined by pressure cell.
-    meshIdx = type::IntVec2D(nLclPts, type::IntVec1D(dim, 0));
+    meshIdx = type::IntArray2D(nLclPts, dim, 0);
 
     // create info string
     ierr = createInfoString(); CHKERRQ(ierr);
@@ -58,6 +115,69 @@ PetscErrorCode SingleBodyPoints::init(const MPI_Comm &comm, const PetscInt &dim,
     PetscFunctionReturn(0);
 }  // init
 
+PetscErrorCode SingleBodyPoints::reorderPoints()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    char curve[PETSC_MAX_PATH_LEN] = "none";
+    ierr = PetscOptionsGetString(nullptr, nullptr, "-lagrangian_order", curve,
+                                 sizeof(curve), nullptr); CHKERRQ(ierr);
+
+    if (std::strcmp(curve, "none") == 0) PetscFunctionReturn(0);
+
+    if ((std::strcmp(curve, "morton") != 0) &&
+        (std::strcmp(curve, "hilbert") != 0))
+        SETERRQ1(comm, PETSC_ERR_ARG_WRONG,
+                 "Unknown ordering of Lagrangian points \"%s\" (choices are "
+                 "none, morton, and hilbert).\n",
+                 curve);
+
+    if (nPts < 2) PetscFunctionReturn(0);
+
+    // the bounding box of the body is mapped onto a lattice of integer
+    // coordinates (same spacing in all directions)
+    const PetscInt bits = (dim == 3) ? 21 : 31;
+    PetscReal bg[3], width = 0.0;
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        PetscReal ed = bg[d] = coords[0][d];
+        for (PetscInt k = 1; k < nPts; ++k)
+        {
+            bg[d] = std::min(bg[d], coords[k][d]);
+            ed = std::max(ed, coords[k][d]);
+        }
+        width = std::max(width, ed - bg[d]);
+    }
+    if (width <= 0.0) PetscFunctionReturn(0);
+    const PetscReal scale = ((1u << bits) - 1) / width;
+
+    std::vector<std::uint64_t> keys(nPts);
+    for (PetscInt k = 0; k < nPts; ++k)
+    {
+        std::uint32_t X[3] = {0, 0, 0};
+        for (PetscInt d = 0; d < dim; ++d)
+            X[d] = std::uint32_t((coords[k][d] - bg[d]) * scale);
+        keys[k] = getCurveKey(X, dim, bits, (curve[0] == 'h'));
+    }
+
+    // points with the same key keep the order of the file
+    order.resize(nPts);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&keys](const PetscInt &a, const PetscInt &b) {
+                         return keys[a] < keys[b];
+                     });
+
+    type::RealArray2D sorted(nPts, dim, 0.0);
+    for (PetscInt k = 0; k < nPts; ++k)
+        std::copy(coords[order[k]], coords[order[k]] + dim, sorted[k]);
+    coords = sorted;
+
+    PetscFunctionReturn(0);
+}  // reorderPoints
+
 PetscErrorCode SingleBodyPoints::createDMDA()
 {
     PetscErrorCode ierr;
@@ -94,24 +214,27 @@ PetscErrorCode SingleBodyPoints::createDMDA()
 
 PetscErrorCode SingleBodyPoints::updateMeshIdx(const type::Mesh &mesh)
 {
+    PetscErrorCode ierr;
+
     PetscFunctionBeginUser;
 
     // loop through points owned locally and find indices
     for (PetscInt i = bgPt, c = 0; i < edPt; ++i, ++c)
     {
+        const PetscReal *xyz = coords[i];
+        PetscInt *ijk = meshIdx[c];
+
         for (PetscInt d = 0; d < dim; ++d)
         {
-            if (mesh->min[d] >= coords[i][d] || mesh->max[d] <= coords[i][d])
+            if (mesh->min[d] >= xyz[d] || mesh->max[d] <= xyz[d])
             {
                 SETERRQ3(PETSC_COMM_WORLD, PETSC_ERR_MAX_VALUE,
                          "body coordinate %g is outside domain [%g, %g] !",
-                         coords[i][d], mesh->min[d], mesh->max[d]);
+                         xyz[d], mesh->min[d], mesh->max[d]);
             }
 
-            meshIdx[c][d] = std::upper_bound(mesh->coord[4][d],
-                                             mesh->coord[4][d] + mesh->n[4][d],
-                                             coords[i][d]) -
-                            mesh->coord[4][d] - 1;
+            // start from the previous cell (moving bodies barely move)
+            ierr = mesh->locateFrom(4, d, xyz[d], ijk[d]); CHKERRQ(ierr);
         }
     }
 
@@ -141,6 +264,10 @@ PetscErrorCode SingleBodyPoints::createInfoString()
         ss << "\tDistribution of Lagrangian points:" << std::endl << std::endl;
     }
 
+    if ((mpiRank == 0) && (order.size() > 0))
+        ss << "\tPoints sorted along a space-filling curve" << std::endl
+           << std::endl;
+
     ss << "\t\tRank " << mpiRank << ":" << std::endl;
     ss << "\t\t\tNumber of points: " << nLclPts << std::endl;
     ss << "\t\t\tRange of points: [" << bgPt << ", " << edPt << ")"
@@ -160,7 +287,7 @@ PetscErrorCode SingleBodyPoints::findProc(const PetscInt &i,
 
     if ((i < 0) || (i >= nPts))
         SETERRQ2(comm, PETSC_ERR_ARG_SIZ,
-                 "Index %d of Lagrangian point on the body %s is out of range.",
+                 "Index %D of Lagrangian point on the body %s is out of range.",
                  i, name.c_str());
 
     // find the process that own THE 1ST DoF OF THE POINT i
@@ -179,12 +306,12 @@ PetscErrorCode SingleBodyPoints::getGlobalIndex(const PetscInt &i,
 
     if ((i < 0) || (i >= nPts))
         SETERRQ2(comm, PETSC_ERR_ARG_SIZ,
-                 "Index %d of Lagrangian point on the body %s is out of range.",
+                 "Index %D of Lagrangian point on the body %s is out of range.",
                  i, name.c_str());
 
     if ((dof < 0) || (dof >= dim))
         SETERRQ2(comm, PETSC_ERR_ARG_SIZ,
-                 "DoF %d is not correct. The dimension is %d.", dof, dim);
+                 "DoF %D is not correct. The dimension is %D.", dof, dim);
 
     // for single body DM, the global is simple due to we use 1D DMDA.
     idx = i * dim + dof;
@@ -255,6 +382,13 @@ PetscErrorCode SingleBodyPoints::writeBody(const std::string &filepath)
 
     PetscFunctionBeginUser;
 
+    // the points are written in the order of the body file
+    type::IntVec1D rows(nPts);
+    if (order.size() > 0)
+        for (PetscInt k = 0; k < nPts; ++k) rows[order[k]] = k;
+    else
+        std::iota(rows.begin(), rows.end(), 0);
+
     PetscViewer viewer;
     ierr = PetscViewerCreate(comm, &viewer); CHKERRQ(ierr);
     ierr = PetscViewerSetType(viewer, PETSCVIEWERASCII); CHKERRQ(ierr);
@@ -265,8 +399,8 @@ PetscErrorCode SingleBodyPoints::writeBody(const std::string &filepath)
         for (PetscInt k = 0; k < nPts; ++k)
         {
             ierr = PetscViewerASCIIPrintf(
-                viewer, "%10.8e\t%10.8e\t%10.8e\n",
-                coords[k][0], coords[k][1], coords[k][2]); CHKERRQ(ierr);
+                viewer, "%10.8e\t%10.8e\t%10.8e\n", coords[rows[k]][0],
+                coords[rows[k]][1], coords[rows[k]][2]); CHKERRQ(ierr);
         }
     }
     else if (dim == 2)
@@ -275,7 +409,7 @@ PetscErrorCode SingleBodyPoints::writeBody(const std::string &filepath)
         {
             ierr = PetscViewerASCIIPrintf(
                 viewer, "%10.8e\t%10.8e\n",
-                coords[k][0], coords[k][1]); CHKERRQ(ierr);
+                coords[rows[k]][0], coords[rows[k]][1]); CHKERRQ(ierr);
         }
     }
     else
@@ -0,0 +1,309 @@
+/**
+ * \file singlebodyshape.cpp
+ * \brief Implementation of body::SingleBodyShape.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// PetIBM
+#include <petibm/parser.h>
+#include <petibm/singlebodyshape.h>
+
+namespace petibm
+{
+namespace body
+{
+SingleBodyShape::SingleBodyShape(const MPI_Comm &comm, const PetscInt &dim,
+                                 const std::string &type,
+                                 const std::string &name,
+                                 const YAML::Node &inNode,
+                                 const YAML::Node &meshNode)
+    : SingleBodyPoints(comm, dim, name)
+{
+    shape = type;
+    node = inNode;
+    filePath = "procedural " + shape;
+
+    getSpacing(meshNode);
+    init(comm, dim, name, filePath);
+}  // SingleBodyShape
+
+PetscErrorCode SingleBodyShape::getSpacing(const YAML::Node &meshNode)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    // the spacing may be prescribed by the user
+    if (node["spacing"].IsDefined())
+    {
+        ds = node["spacing"].as<PetscReal>();
+        PetscFunctionReturn(0);
+    }
+
+    // get the cell widths of the Eulerian mesh without creating it
+    PetscInt meshDim;
+    type::RealVec1D bg(3, 0.0), ed(3, 1.0);
+    type::IntVec1D n(3, 1);
+    type::RealVec2D dL(3, type::RealVec1D(1, 1.0));
+    ierr = parser::parseMesh(meshNode, meshDim, bg, ed, n, dL); CHKERRQ(ierr);
+
+    type::RealVec1D point;
+    ierr = getReferencePoint(point); CHKERRQ(ierr);
+
+    // smallest width of the cell that contains the reference point
+    ds = std::numeric_limits<PetscReal>::max();
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        if ((point[d] <= bg[d]) || (point[d] >= ed[d]))
+            SETERRQ3(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                     "The reference point of the body %s is outside the "
+                     "domain in direction %D (coordinate %g).\n",
+                     name.c_str(), d, point[d]);
+
+        PetscInt i = 0;
+        PetscReal x = bg[d] + dL[d][0];
+        while ((i < n[d] - 1) && (x < point[d])) x += dL[d][++i];
+        ds = std::min(ds, dL[d][i]);
+    }
+
+    PetscFunctionReturn(0);
+}  // getSpacing
+
+PetscErrorCode SingleBodyShape::getReferencePoint(
+    type::RealVec1D &point) const
+{
+    PetscFunctionBeginUser;
+
+    point = type::RealVec1D(3, 0.0);
+
+    if ((shape == "cylinder") || (shape == "sphere"))
+    {
+        type::RealVec1D center = node["center"].as<type::RealVec1D>();
+        std::copy(center.begin(), center.end(), point.begin());
+    }
+    else if (shape == "plate")
+    {
+        type::RealVec1D start = node["start"].as<type::RealVec1D>(),
+                        end = node["end"].as<type::RealVec1D>();
+        for (unsigned int d = 0; d < 2; ++d)
+            point[d] = 0.5 * (start[d] + end[d]);
+    }
+    else if (shape == "naca")
+    {
+        type::RealVec1D le = node["leadingEdge"].as<type::RealVec1D>();
+        std::copy(le.begin(), le.end(), point.begin());
+    }
+
+    // the 2D sections are extruded over the span in 3D
+    if ((dim == 3) && (shape != "sphere"))
+    {
+        type::RealVec1D span = node["span"].as<type::RealVec1D>();
+        point[2] = 0.5 * (span[0] + span[1]);
+    }
+
+    PetscFunctionReturn(0);
+}  // getReferencePoint
+
+PetscErrorCode SingleBodyShape::readBody(const std::string &filepath)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (shape == "sphere")
+    {
+        if (dim != 3)
+            SETERRQ1(comm, PETSC_ERR_ARG_WRONG,
+                     "The body %s is a sphere but the mesh is not 3D.\n",
+                     name.c_str());
+        ierr = createSphere(); CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+    }
+
+    type::RealVec2D section;
+    ierr = createSection(section); CHKERRQ(ierr);
+    PetscInt nSec = section.size();
+
+    if (dim == 2)
+    {
+        nPts = nSec;
+        coords = type::RealArray2D(nPts, 2, 0.0);
+        for (PetscInt k = 0; k < nSec; ++k)
+        {
+            coords[k][0] = section[k][0];
+            coords[k][1] = section[k][1];
+        }
+    }
+    else  // extrude the section in the z-direction
+    {
+        type::RealVec1D span = node["span"].as<type::RealVec1D>();
+        PetscInt nz = std::max(PetscInt(1),
+                               PetscInt(std::ceil((span[1] - span[0]) / ds)));
+        PetscReal dz = (span[1] - span[0]) / nz;
+
+        nPts = nSec * nz;
+        coords = type::RealArray2D(nPts, 3, 0.0);
+        for (PetscInt j = 0, c = 0; j < nz; ++j)
+        {
+            for (PetscInt k = 0; k < nSec; ++k, ++c)
+            {
+                coords[c][0] = section[k][0];
+                coords[c][1] = section[k][1];
+                coords[c][2] = span[0] + (j + 0.5) * dz;
+            }
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // readBody
+
+PetscErrorCode SingleBodyShape::createSection(type::RealVec2D &section) const
+{
+    PetscFunctionBeginUser;
+
+    if (shape == "cylinder")
+    {
+        type::RealVec1D center = node["center"].as<type::RealVec1D>();
+        PetscReal radius = node["radius"].as<PetscReal>();
+        PetscInt n = std::max(
+            PetscInt(3), PetscInt(std::ceil(2.0 * PETSC_PI * radius / ds)));
+
+        section = type::RealVec2D(n, type::RealVec1D(2));
+        for (PetscInt k = 0; k < n; ++k)
+        {
+            PetscReal theta = 2.0 * PETSC_PI * k / n;
+            section[k][0] = center[0] + radius * std::cos(theta);
+            section[k][1] = center[1] + radius * std::sin(theta);
+        }
+    }
+    else if (shape == "plate")
+    {
+        type::RealVec1D start = node["start"].as<type::RealVec1D>(),
+                        end = node["end"].as<type::RealVec1D>();
+        PetscReal length = std::hypot(end[0] - start[0], end[1] - start[1]);
+        PetscInt n = std::max(PetscInt(2),
+                              PetscInt(std::ceil(length / ds)) + 1);
+
+        section = type::RealVec2D(n, type::RealVec1D(2));
+        for (PetscInt k = 0; k < n; ++k)
+        {
+            PetscReal s = PetscReal(k) / (n - 1);
+            section[k][0] = start[0] + s * (end[0] - start[0]);
+            section[k][1] = start[1] + s * (end[1] - start[1]);
+        }
+    }
+    else if (shape == "naca")
+    {
+        std::string digits = node["designation"].as<std::string>();
+        if ((digits.size() != 4) ||
+            (digits.find_first_not_of("0123456789") != std::string::npos))
+            SETERRQ1(comm, PETSC_ERR_ARG_WRONG,
+                     "Only 4-digit NACA sections are supported (got %s).\n",
+                     digits.c_str());
+
+        PetscReal m = (digits[0] - '0') / 100.0,
+                  p = (digits[1] - '0') / 10.0,
+                  t = std::stod(digits.substr(2)) / 100.0;
+        PetscReal chord = node["chord"].as<PetscReal>();
+        type::RealVec1D le = node["leadingEdge"].as<type::RealVec1D>();
+        PetscReal alpha = node["angle"].as<PetscReal>(0.0) * PETSC_PI / 180.0;
+
+        // dense closed contour (unit chord): upper side from the trailing edge
+        // to the leading edge, then lower side back to the trailing edge
+        const PetscInt nDense = 2000;
+        type::RealVec2D contour(2 * nDense, type::RealVec1D(2));
+        for (PetscInt i = 0; i <= nDense; ++i)
+        {
+            PetscReal x = 0.5 * (1.0 - std::cos(PETSC_PI * i / nDense));
+            PetscReal yt = 5.0 * t * (0.2969 * std::sqrt(x) - 0.1260 * x -
+                                      0.3516 * x * x + 0.2843 * x * x * x -
+                                      0.1036 * x * x * x * x);
+            PetscReal yc = 0.0, dyc = 0.0;
+            if ((m > 0.0) && (p > 0.0))
+            {
+                PetscReal q = (x < p) ? p : 1.0 - p;
+                PetscReal a = (x < p) ? 0.0 : 1.0 - 2.0 * p;
+                yc = m / (q * q) * (a + 2.0 * p * x - x * x);
+                dyc = 2.0 * m / (q * q) * (p - x);
+            }
+            PetscReal theta = std::atan(dyc);
+
+            contour[nDense - i][0] = x - yt * std::sin(theta);
+            contour[nDense - i][1] = yc + yt * std::cos(theta);
+            if ((i > 0) && (i < nDense))
+            {
+                contour[nDense + i][0] = x + yt * std::sin(theta);
+                contour[nDense + i][1] = yc - yt * std::cos(theta);
+            }
+        }
+
+        // cumulative arc length of the closed contour
+        type::RealVec1D s(contour.size() + 1, 0.0);
+        for (std::size_t i = 0; i < contour.size(); ++i)
+        {
+            const type::RealVec1D &a = contour[i],
+                                  &b = contour[(i + 1) % contour.size()];
+            s[i + 1] = s[i] + chord * std::hypot(b[0] - a[0], b[1] - a[1]);
+        }
+
+        // points equally spaced along the contour, rotated by the angle of
+        // attack about the leading edge
+        PetscInt n = std::max(PetscInt(3),
+                              PetscInt(std::ceil(s.back() / ds)));
+        section = type::RealVec2D(n, type::RealVec1D(2));
+        for (PetscInt k = 0, i = 0; k < n; ++k)
+        {
+            PetscReal sk = s.back() * k / n;
+            while (s[i + 1] < sk) ++i;
+            const type::RealVec1D &a = contour[i],
+                                  &b = contour[(i + 1) % contour.size()];
+            PetscReal w = (sk - s[i]) / (s[i + 1] - s[i]);
+            PetscReal x = chord * (a[0] + w * (b[0] - a[0])),
+                      y = chord * (a[1] + w * (b[1] - a[1]));
+            section[k][0] = le[0] + x * std::cos(alpha) + y * std::sin(alpha);
+            section[k][1] = le[1] - x * std::sin(alpha) + y * std::cos(alpha);
+        }
+    }
+    else
+        SETERRQ1(comm, PETSC_ERR_ARG_WRONG,
+                 "The shape \"%s\" is not recognized!\n", shape.c_str());
+
+    PetscFunctionReturn(0);
+}  // createSection
+
+PetscErrorCode SingleBodyShape::createSphere()
+{
+    PetscFunctionBeginUser;
+
+    type::RealVec1D center = node["center"].as<type::RealVec1D>();
+    PetscReal radius = node["radius"].as<PetscReal>();
+
+    // Fibonacci lattice: about one point per area ds^2
+    nPts = std::max(
+        PetscInt(4), PetscInt(std::ceil(4.0 * PETSC_PI * radius * radius /
+                                        (ds * ds))));
+    coords = type::RealArray2D(nPts, 3, 0.0);
+
+    const PetscReal golden = PETSC_PI * (3.0 - std::sqrt(5.0));
+    for (PetscInt k = 0; k < nPts; ++k)
+    {
+        PetscReal z = 1.0 - (2.0 * k + 1.0) / nPts;
+        PetscReal r = std::sqrt(1.0 - z * z);
+        PetscReal phi = golden * k;
+        coords[k][0] = center[0] + radius * r * std::cos(phi);
+        coords[k][1] = center[1] + radius * r * std::sin(phi);
+        coords[k][2] = center[2] + radius * z;
+    }
+
+    PetscFunctionReturn(0);
+}  // createSphere
+
+}  // end of namespace body
+
+}  // end of namespace petibm
@@ -5,6 +5,8 @@
  * reserved. \license BSD 3-Clause License.
  */
 
+#include <cmath>
+
 #include <petibm/boundary.h>
 #include <petibm/boundarysimple.h>
 
@@ -48,5 +50,66 @@ PetscErrorCode createBoundary(const type::Mesh &mesh, const YAML::Node &node,
     PetscFunctionReturn(0);
 }  // createBoundary
 
+PetscErrorCode mirrorForces(const type::Boundary &bc,
+                            const type::BodyPack &bodies, const Vec &f,
+                            type::RealVec2D &forces)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    // symmetry planes (the x-velocity tells us the type of BC on a boundary)
+    std::vector<PetscInt> planes;
+    for (PetscInt b = 0; b < bc->dim * 2; ++b)
+        if (bc->bds[0][b]->type == type::BCType::SYMMETRY) planes.push_back(b);
+    if (planes.size() == 0) PetscFunctionReturn(0);
+
+    const type::Mesh &mesh = bc->mesh;
+    std::vector<Vec> unPacked(bodies->nBodies);
+    ierr = DMCompositeGetAccessArray(bodies->dmPack, f, bodies->nBodies,
+                                     nullptr, unPacked.data()); CHKERRQ(ierr);
+
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
+    {
+        const type::SingleBody &body = bodies->bodies[i];
+        type::RealVec1D fLocal(body->dim, 0.0);
+        PetscReal **fArray;
+
+        ierr = DMDAVecGetArrayDOF(body->da, unPacked[i], &fArray);
+        CHKERRQ(ierr);
+        for (PetscInt k = body->bgPt; k < body->edPt; ++k)
+        {
+            // a point lying on a symmetry plane is its own image, so it is
+            // only counted once for this plane
+            type::RealVec1D factor(body->dim, 1.0);
+            for (const PetscInt &b : planes)
+            {
+                PetscInt dir = b / 2;
+                PetscReal plane = (b % 2 == 0) ? mesh->min[dir]
+                                               : mesh->max[dir];
+                PetscReal tol = 1.0e-8 * (mesh->max[dir] - mesh->min[dir]);
+                if (std::abs(body->coords[k][dir] - plane) <= tol) continue;
+                for (PetscInt d = 0; d < body->dim; ++d)
+                    factor[d] *= (d == dir) ? 0.0 : 2.0;
+            }
+            // fArray is the force applied to the fluid
+            for (PetscInt d = 0; d < body->dim; ++d)
+                fLocal[d] -= factor[d] * fArray[k][d];
+        }
+        ierr = DMDAVecRestoreArrayDOF(body->da, unPacked[i], &fArray);
+        CHKERRQ(ierr);
+
+        forces[i].resize(body->dim);
+        ierr = MPI_Allreduce(fLocal.data(), forces[i].data(), body->dim,
+                             MPIU_REAL, MPI_SUM, body->comm); CHKERRQ(ierr);
+    }
+
+    ierr = DMCompositeRestoreAccessArray(bodies->dmPack, f, bodies->nBodies,
+                                         nullptr, unPacked.data());
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // mirrorForces
+
 }  // end of namespace boundary
 }  // end of namespace petibm
@@ -47,6 +47,20 @@ PetscErrorCode BoundarySimple::init(const type::Mesh &inMesh,
     type::RealVec2D bcValues;
     ierr = parser::parseBCs(node, bcTypes, bcValues); CHKERRQ(ierr);
 
+    // a symmetry plane applies to the whole velocity vector, so if one
+    // velocity component uses it on a boundary, all of them should
+    for (PetscInt b = 0; b < dim * 2; ++b)
+    {
+        PetscInt c = 0;
+        for (PetscInt f = 0; f < dim; ++f)
+            if (bcTypes[f][b] == int(type::BCType::SYMMETRY)) c += 1;
+
+        if ((c != 0) && (c != dim))
+            SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_INCOMP,
+                     "Not all velocity fields on boundary %s are SYMMETRY!\n",
+                     type::bl2str[type::BCLoc(b)].c_str());
+    }
+
     for (PetscInt f = 0; f < dim; ++f)
     {
         bds[f].resize(dim * 2);
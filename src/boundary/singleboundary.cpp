@@ -11,6 +11,7 @@
 #include <petibm/singleboundarydirichlet.h>
 #include <petibm/singleboundaryneumann.h>
 #include <petibm/singleboundaryperiodic.h>
+#include <petibm/singleboundarysymmetry.h>
 
 namespace petibm
 {
@@ -47,6 +48,10 @@ PetscErrorCode createSingleBoundary(const type::Mesh &mesh,
             singleBd = std::make_shared<SingleBoundaryConvective>(mesh, loc,
                                                                   field, value);
             break;
+        case type::BCType::SYMMETRY:
+            singleBd = std::make_shared<SingleBoundarySymmetry>(mesh, loc,
+                                                                field, value);
+            break;
     }
 
     PetscFunctionReturn(0);
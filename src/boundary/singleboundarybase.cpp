@@ -89,8 +89,9 @@ PetscErrorCode SingleBoundaryBase::init(const type::Mesh &inMesh,
     normal = ((int(loc) % 2) == 0) ? -1.0 : 1.0;
 
     // set onThisProc
-    ierr = misc::checkBoundaryProc(mesh->da[int(field)], mesh->n[int(field)],
-                                   loc, onThisProc); CHKERRQ(ierr);
+    ierr = misc::checkBoundaryProc(mesh->da[int(field)],
+                                   mesh->n.row(int(field)), loc, onThisProc);
+    CHKERRQ(ierr);
 
     // for processes on this boundary, set up IDs and values
     if (onThisProc)
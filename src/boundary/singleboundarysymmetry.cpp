@@ -0,0 +1,57 @@
+/**
+ * \file singleboundarysymmetry.cpp
+ * \brief Implementation of the class `SingleBoundarySymmetry`.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <petibm/singleboundarysymmetry.h>
+
+namespace petibm
+{
+namespace boundary
+{
+SingleBoundarySymmetry::SingleBoundarySymmetry(const type::Mesh &inMesh,
+                                               const type::BCLoc &inLoc,
+                                               const type::Field &inField,
+                                               const PetscReal &inValue)
+    : SingleBoundaryBase(inMesh, inLoc, inField, type::SYMMETRY, inValue)
+{
+}  // SingleBoundarySymmetry
+
+PetscErrorCode SingleBoundarySymmetry::setGhostICsKernel(
+    const PetscReal &targetValue, type::GhostPointInfo &p)
+{
+    PetscFunctionBeginUser;
+
+    PetscInt dir = int(loc) / 2;
+
+    if (dir == int(field))
+    {
+        // normal component: the ghost point sits on the plane, where the
+        // velocity vanishes
+        p.a0 = 0.0;
+        p.a1 = 0.0;
+    }
+    else
+    {
+        // tangential components: the ghost point mirrors its target point
+        p.a0 = 1.0;
+        p.a1 = 0.0;
+    }
+
+    p.value = p.a0 * targetValue + p.a1;
+
+    PetscFunctionReturn(0);
+}  // setGhostICsKernel
+
+PetscErrorCode SingleBoundarySymmetry::updateEqsKernel(
+    const PetscReal &targetValue, const PetscReal &dt, type::GhostPointInfo &p)
+{
+    PetscFunctionBeginUser;
+    // for symmetry BC, the coefficient a0 & a1 won't change
+    PetscFunctionReturn(0);
+}  // updateEqsKernel
+
+}  // end of namespace boundary
+}  // end of namespace petibm
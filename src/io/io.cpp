@@ -6,11 +6,18 @@
  */
 
 // STL
+#include <algorithm>
+#include <cstdio>
 #include <fstream>
+#include <map>
 #include <sstream>
+#include <thread>
+#include <utility>
 #include <vector>
 
 // PETSc
+#include <petscdmcomposite.h>
+#include <petscdmda.h>
 #include <petscviewerhdf5.h>
 
 // PetIBM
@@ -20,8 +27,86 @@ namespace petibm
 {
 namespace io
 {
+// check if a Vec is managed by a DMDA or by a DMComposite of DMDAs
+PetscErrorCode checkDMDAVec(const Vec &vec, PetscBool &flag, DM &pack);
+
+// get the box of a DMDA Vec owned by this process, in the layout of the HDF5
+// datasets written by PETSc (z, y, x, and dof)
+PetscErrorCode getHDF5Box(const Vec &vec, std::vector<hsize_t> &dims,
+                          std::vector<hsize_t> &start,
+                          std::vector<hsize_t> &count);
+
+// open a HDF5 file on this process only; the file is negative on failure
+// (no error is raised, so that the status can be shared with the other
+// processes before any of them returns)
+PetscErrorCode openHDF5File(const std::string &filePath,
+                            const PetscFileMode &mode, hid_t &file);
+
+// remove a HDF5 object (if it exists) before writing a new one at its path;
+// return a negative value on failure (without raising an error)
+herr_t removeHDF5Object(const hid_t &file, const std::string &path);
+
+// write a dataset of real numbers; return a negative value on failure
+// (without raising an error)
+herr_t writeHDF5Dataset(const hid_t &file, const std::string &path,
+                        const std::vector<hsize_t> &count, const hid_t &lcpl,
+                        const PetscScalar *data);
+
+// check if a dataset was written through aggregators
+PetscErrorCode checkHDF5Aggregated(const MPI_Comm comm,
+                                   const std::string &filePath,
+                                   const std::string &path, PetscBool &flag);
+
+// write a DMDA Vec to the subfiles and map it in the index file
+PetscErrorCode writeAggregatedDMDAVec(
+    const MPI_Comm comm, const MPI_Comm group, const Vec &vec,
+    const std::string &path, const std::vector<std::string> &subNames,
+    const std::vector<PetscMPIInt> &subIds, const hid_t &subFile,
+    const hid_t &idxFile);
+
+// read the box owned by this process of a DMDA Vec from a HDF5 dataset
+PetscErrorCode readHDF5Box(const hid_t &file, const hid_t &dapl,
+                           const std::string &path, Vec &vec);
+
+// byte ranges (offset and size) of files, by path
+typedef std::map<std::string, std::vector<std::pair<hsize_t, hsize_t>>>
+    ByteRanges;
+
+// add the byte ranges holding a box of a HDF5 dataset, following the mapping
+// of virtual datasets to their source datasets; return a negative value if
+// the storage can not be located (without raising an error)
+herr_t getHDF5ByteRanges(const hid_t &file, const std::string &filePath,
+                         const std::string &path,
+                         const std::vector<hsize_t> &start,
+                         const std::vector<hsize_t> &count,
+                         ByteRanges &ranges);
+
+// read a vector of Vec objects from a file written through aggregators
+PetscErrorCode readHDF5VecsAggregated(const MPI_Comm comm,
+                                      const std::string &filePath,
+                                      const std::string &loc,
+                                      const std::vector<std::string> &names,
+                                      std::vector<Vec> &vecs);
+
+// the HDF5 type of PetscReal
+inline hid_t getHDF5RealType()
+{
+#if defined(PETSC_USE_REAL_SINGLE)
+    return H5T_NATIVE_FLOAT;
+#else
+    return H5T_NATIVE_DOUBLE;
+#endif
+}  // getHDF5RealType
+
+// join a HDF5 group and the name of an object in it
+inline std::string joinHDF5Path(const std::string &loc, const std::string &name)
+{
+    if (!loc.empty() && loc.back() == '/') return loc + name;
+    return loc + "/" + name;
+}  // joinHDF5Path
+
 PetscErrorCode readLagrangianPoints(const std::string &file, PetscInt &nPts,
-                                    type::RealVec2D &coords)
+                                    type::RealArray2D &coords)
 {
     PetscFunctionBeginUser;
 
@@ -72,7 +157,7 @@ PetscErrorCode readLagrangianPoints(const std::string &file, PetscInt &nPts,
                 file.c_str());
 
         // initialize the size of coordinate array
-        coords = type::RealVec2D(nPts, type::RealVec1D(dim, 0.0));
+        coords = type::RealArray2D(nPts, dim, 0.0);
 
         // read again to get first coordinate set
         sline.str(line);
@@ -91,13 +176,13 @@ PetscErrorCode readLagrangianPoints(const std::string &file, PetscInt &nPts,
         for (PetscInt d = 0; d < dim; ++d)
             if (!(sline >> coords[c][d]))
                 SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_FILE_READ,
-                         "The number of doubles at line %d in file %s does not "
+                         "The number of doubles at line %D in file %s does not "
                          "match the dimension.\n",
                          c + 2, file.c_str());
 
         if (sline.peek() != EOF)
             SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_FILE_READ,
-                     "The number of doubles at line %d in file %s does not "
+                     "The number of doubles at line %D in file %s does not "
                      "match the dimension.\n",
                      c + 2, file.c_str());
 
@@ -142,9 +227,30 @@ PetscErrorCode writeHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
 {
     PetscErrorCode ierr;
     PetscViewer viewer;
+    PetscInt nAgg = 0;
 
     PetscFunctionBeginUser;
 
+    // write through aggregators if requested and if all Vecs support it
+    ierr = PetscOptionsGetInt(nullptr, nullptr, "-io_aggregators", &nAgg,
+                              nullptr); CHKERRQ(ierr);
+    if (nAgg > 0)
+    {
+        PetscBool flag = PETSC_TRUE;
+        for (unsigned int i = 0; i < vecs.size() && flag; ++i)
+        {
+            DM pack;
+            ierr = checkDMDAVec(vecs[i], flag, pack); CHKERRQ(ierr);
+        }
+
+        if (flag)
+        {
+            ierr = writeHDF5VecsAggregated(
+                comm, filePath, loc, names, vecs, nAgg, mode); CHKERRQ(ierr);
+            PetscFunctionReturn(0);
+        }
+    }
+
     // create viewer
     ierr = PetscViewerCreate(comm, &viewer); CHKERRQ(ierr);
     ierr = PetscViewerSetType(viewer, PETSCVIEWERHDF5); CHKERRQ(ierr);
@@ -240,6 +346,208 @@ PetscErrorCode writeHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
     PetscFunctionReturn(0);
 }  // writeHDF5Vecs
 
+PetscErrorCode coarsenDMDAVec(const Vec &fine, DM &coarseDA, Vec &coarse)
+{
+    PetscErrorCode ierr;
+    MPI_Comm comm;
+    DM da, ghostDA;
+    Vec local;
+    DMDAStencilType stencil;
+    PetscInt dim, width, n[3] = {1, 1, 1}, nc[3] = {1, 1, 1},
+                         np[3] = {1, 1, 1};
+    PetscInt gs[3] = {0, 0, 0}, gc[3] = {1, 1, 1};
+    PetscInt cs[3] = {0, 0, 0}, cc[3] = {1, 1, 1};
+    const PetscInt *l[3] = {nullptr, nullptr, nullptr};
+    std::vector<PetscInt> lc[3];
+    const PetscReal *fArray;
+    PetscReal *cArray;
+
+    PetscFunctionBeginUser;
+
+    coarseDA = PETSC_NULL;
+    coarse = PETSC_NULL;
+
+    ierr = PetscObjectGetComm((PetscObject)fine, &comm); CHKERRQ(ierr);
+    ierr = VecGetDM(fine, &da); CHKERRQ(ierr);
+    ierr = DMDAGetInfo(da, &dim, &n[0], &n[1], &n[2], &np[0], &np[1], &np[2],
+                       nullptr, &width, nullptr, nullptr, nullptr, &stencil);
+    CHKERRQ(ierr);
+    ierr = DMDAGetOwnershipRanges(da, &l[0], &l[1], &l[2]); CHKERRQ(ierr);
+
+    // the coarse point I covers the fine points 2I and 2I+1 and it belongs to
+    // the process owning 2I: the fine points [s, e) of a process give it the
+    // coarse points [(s+1)/2, (e+1)/2), so the reduction stays local (the
+    // ownership ranges are known by all processes, so they all agree on
+    // whether the level can be distributed)
+    for (PetscInt d = 0; d < dim; ++d)
+    {
+        nc[d] = (n[d] + 1) / 2;
+        lc[d].resize(np[d]);
+        for (PetscInt p = 0, s = 0; p < np[d]; s += l[d][p], ++p)
+        {
+            lc[d][p] = (s + l[d][p] + 1) / 2 - (s + 1) / 2;
+            if (lc[d][p] == 0) PetscFunctionReturn(0);
+        }
+    }
+
+    // the coarse DMDA has one layer of ghost points, so that it can be
+    // coarsened in turn
+    if (dim == 2)
+    {
+        ierr = DMDACreate2d(comm, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE,
+                            DMDA_STENCIL_BOX, nc[0], nc[1], np[0], np[1], 1,
+                            1, lc[0].data(), lc[1].data(), &coarseDA);
+        CHKERRQ(ierr);
+    }
+    else
+    {
+        ierr = DMDACreate3d(comm, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE,
+                            DM_BOUNDARY_NONE, DMDA_STENCIL_BOX, nc[0], nc[1],
+                            nc[2], np[0], np[1], np[2], 1, 1, lc[0].data(),
+                            lc[1].data(), lc[2].data(), &coarseDA);
+        CHKERRQ(ierr);
+    }
+    ierr = DMSetUp(coarseDA); CHKERRQ(ierr);
+    ierr = DMCreateGlobalVector(coarseDA, &coarse); CHKERRQ(ierr);
+
+    // the last coarse point of a process also covers the first fine point of
+    // the next one: the fine values are read with one layer of ghost points,
+    // through a DMDA with the same partition if the fine one has none
+    if (width >= 1 && stencil == DMDA_STENCIL_BOX)
+    {
+        ghostDA = da;
+        ierr = PetscObjectReference((PetscObject)ghostDA); CHKERRQ(ierr);
+    }
+    else if (dim == 2)
+    {
+        ierr = DMDACreate2d(comm, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE,
+                            DMDA_STENCIL_BOX, n[0], n[1], np[0], np[1], 1, 1,
+                            l[0], l[1], &ghostDA); CHKERRQ(ierr);
+        ierr = DMSetUp(ghostDA); CHKERRQ(ierr);
+    }
+    else
+    {
+        ierr = DMDACreate3d(comm, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE,
+                            DM_BOUNDARY_NONE, DMDA_STENCIL_BOX, n[0], n[1],
+                            n[2], np[0], np[1], np[2], 1, 1, l[0], l[1], l[2],
+                            &ghostDA); CHKERRQ(ierr);
+        ierr = DMSetUp(ghostDA); CHKERRQ(ierr);
+    }
+
+    ierr = DMGetLocalVector(ghostDA, &local); CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(ghostDA, fine, INSERT_VALUES, local);
+    CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(ghostDA, fine, INSERT_VALUES, local);
+    CHKERRQ(ierr);
+    ierr = DMDAGetGhostCorners(ghostDA, &gs[0], &gs[1], &gs[2], &gc[0],
+                               &gc[1], &gc[2]); CHKERRQ(ierr);
+    ierr = DMDAGetCorners(coarseDA, &cs[0], &cs[1], &cs[2], &cc[0], &cc[1],
+                          &cc[2]); CHKERRQ(ierr);
+
+    // average of the (up to) 2x2x2 fine points of each coarse point
+    ierr = VecGetArrayRead(local, &fArray); CHKERRQ(ierr);
+    ierr = VecGetArray(coarse, &cArray); CHKERRQ(ierr);
+    for (PetscInt K = cs[2], q = 0; K < cs[2] + cc[2]; ++K)
+        for (PetscInt J = cs[1]; J < cs[1] + cc[1]; ++J)
+            for (PetscInt I = cs[0]; I < cs[0] + cc[0]; ++I, ++q)
+            {
+                PetscInt lo[3] = {2 * I, 2 * J, 2 * K}, hi[3];
+                PetscReal sum = 0.0, count = 0.0;
+                for (PetscInt d = 0; d < 3; ++d)
+                    hi[d] = std::min(lo[d] + 1, n[d] - 1);
+                for (PetscInt k = lo[2]; k <= hi[2]; ++k)
+                    for (PetscInt j = lo[1]; j <= hi[1]; ++j)
+                    {
+                        PetscInt row =
+                            ((k - gs[2]) * gc[1] + j - gs[1]) * gc[0] - gs[0];
+                        for (PetscInt i = lo[0]; i <= hi[0]; ++i)
+                        {
+                            sum += fArray[row + i];
+                            count += 1.0;
+                        }
+                    }
+                cArray[q] = sum / count;
+            }
+    ierr = VecRestoreArray(coarse, &cArray); CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(local, &fArray); CHKERRQ(ierr);
+
+    ierr = DMRestoreLocalVector(ghostDA, &local); CHKERRQ(ierr);
+    ierr = DMDestroy(&ghostDA); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // coarsenDMDAVec
+
+PetscErrorCode writeHDF5Pyramid(const MPI_Comm comm,
+                                const std::string &filePath,
+                                const std::string &loc,
+                                const std::vector<std::string> &names,
+                                const std::vector<Vec> &vecs,
+                                const PetscInt &nLevels)
+{
+    PetscErrorCode ierr;
+    std::vector<DM> das(vecs.size(), PETSC_NULL);
+    std::vector<Vec> levels(vecs.begin(), vecs.end());
+    PetscInt l;
+
+    PetscFunctionBeginUser;
+
+    for (l = 1; l <= nLevels; ++l)
+    {
+        std::vector<DM> nextDAs(vecs.size(), PETSC_NULL);
+        std::vector<Vec> next(vecs.size(), PETSC_NULL);
+        PetscBool stop = PETSC_FALSE;
+
+        for (unsigned int i = 0; i < vecs.size(); ++i)
+        {
+            ierr = coarsenDMDAVec(levels[i], nextDAs[i], next[i]);
+            CHKERRQ(ierr);
+            if (next[i] == PETSC_NULL) stop = PETSC_TRUE;
+        }
+
+        // the pyramid stops at the first level that can not be distributed
+        // like the previous one (a process would own no point)
+        if (stop)
+        {
+            for (unsigned int i = 0; i < vecs.size(); ++i)
+            {
+                ierr = VecDestroy(&next[i]); CHKERRQ(ierr);
+                ierr = DMDestroy(&nextDAs[i]); CHKERRQ(ierr);
+            }
+            ierr = PetscInfo2(nullptr,
+                              "Only %D of the %D coarsened levels written\n",
+                              l - 1, nLevels); CHKERRQ(ierr);
+            break;
+        }
+
+        // the previous level is no longer needed (unless it is the input)
+        for (unsigned int i = 0; i < vecs.size(); ++i)
+        {
+            if (l > 1)
+            {
+                ierr = VecDestroy(&levels[i]); CHKERRQ(ierr);
+                ierr = DMDestroy(&das[i]); CHKERRQ(ierr);
+            }
+            levels[i] = next[i];
+            das[i] = nextDAs[i];
+        }
+
+        ierr = writeHDF5Vecs(comm, filePath,
+                             joinHDF5Path(loc, "lod" + std::to_string(l)),
+                             names, levels, FILE_MODE_APPEND); CHKERRQ(ierr);
+    }
+
+    if (l > 1)
+    {
+        for (unsigned int i = 0; i < vecs.size(); ++i)
+        {
+            ierr = VecDestroy(&levels[i]); CHKERRQ(ierr);
+            ierr = DMDestroy(&das[i]); CHKERRQ(ierr);
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // writeHDF5Pyramid
+
 PetscErrorCode readHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
                             const std::string &loc,
                             const std::vector<std::string> &names,
@@ -247,9 +555,25 @@ PetscErrorCode readHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
 {
     PetscErrorCode ierr;
     PetscViewer viewer;
+    PetscBool aggregated = PETSC_FALSE;
 
     PetscFunctionBeginUser;
 
+    // files written through aggregators only hold virtual datasets (or groups
+    // of them); they are read box by box so the number of processes can differ
+    if (!vecs.empty())
+    {
+        ierr = checkHDF5Aggregated(comm, filePath, joinHDF5Path(loc, names[0]),
+                                   aggregated); CHKERRQ(ierr);
+    }
+
+    if (aggregated)
+    {
+        ierr = readHDF5VecsAggregated(comm, filePath, loc, names, vecs);
+        CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+    }
+
     // create viewer
     ierr = PetscViewerCreate(comm, &viewer); CHKERRQ(ierr);
     ierr = PetscViewerSetType(viewer, PETSCVIEWERHDF5); CHKERRQ(ierr);
@@ -271,6 +595,691 @@ PetscErrorCode readHDF5Vecs(const MPI_Comm comm, const std::string &filePath,
     PetscFunctionReturn(0);
 }  // readHDF5Vecs
 
+PetscErrorCode writeHDF5VecsAggregated(const MPI_Comm comm,
+                                       const std::string &filePath,
+                                       const std::string &loc,
+                                       const std::vector<std::string> &names,
+                                       const std::vector<Vec> &vecs,
+                                       const PetscInt &nAgg,
+                                       const PetscFileMode mode)
+{
+    PetscErrorCode ierr;
+    PetscMPIInt size, rank, gRank;
+    MPI_Comm group;
+    hid_t subFile = -1, idxFile = -1;
+
+    PetscFunctionBeginUser;
+
+    if (nAgg < 1)
+        SETERRQ1(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                 "The number of aggregators (%D) should be positive.\n", nAgg);
+
+    ierr = MPI_Comm_size(comm, &size); CHKERRQ(ierr);
+    ierr = MPI_Comm_rank(comm, &rank); CHKERRQ(ierr);
+
+    // split processes into groups of consecutive ranks, one per aggregator
+    PetscInt n = std::min(nAgg, PetscInt(size));
+    std::vector<PetscMPIInt> subIds(size);
+    for (PetscMPIInt r = 0; r < size; ++r)
+        subIds[r] = PetscMPIInt((PetscInt(r) * n) / size);
+
+    ierr = MPI_Comm_split(comm, subIds[rank], rank, &group); CHKERRQ(ierr);
+    ierr = MPI_Comm_rank(group, &gRank); CHKERRQ(ierr);
+
+    // subfiles live next to the index file, so their names are relative
+    std::size_t pos = filePath.find_last_of('/');
+    std::string dir = (pos == std::string::npos) ? "" : filePath.substr(0, pos + 1);
+    std::string stem = filePath.substr(dir.size());
+    if (stem.size() > 3 && stem.substr(stem.size() - 3) == ".h5")
+        stem = stem.substr(0, stem.size() - 3);
+
+    std::vector<std::string> subNames(n);
+    for (PetscInt k = 0; k < n; ++k)
+        subNames[k] = stem + ".sub" + std::to_string(k) + ".h5";
+
+    // aggregators open their subfile, the first process opens the index file;
+    // a failure is shared with all processes before anyone sends data
+    PetscMPIInt failed = 0;
+    if (gRank == 0)
+    {
+        ierr = openHDF5File(dir + subNames[subIds[rank]], mode, subFile);
+        CHKERRQ(ierr);
+        if (subFile < 0) failed = 1;
+    }
+    if (rank == 0)
+    {
+        ierr = openHDF5File(filePath, mode, idxFile); CHKERRQ(ierr);
+        if (idxFile < 0) failed = 1;
+    }
+    ierr = MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+    CHKERRQ(ierr);
+    if (failed)
+    {
+        if (subFile >= 0) PetscStackCallHDF5(H5Fclose, (subFile));
+        if (idxFile >= 0) PetscStackCallHDF5(H5Fclose, (idxFile));
+        ierr = MPI_Comm_free(&group); CHKERRQ(ierr);
+        SETERRQ1(comm, PETSC_ERR_FILE_OPEN,
+                 "Could not open the HDF5 file %s or one of its subfiles.\n",
+                 filePath.c_str());
+    }
+
+    for (unsigned int i = 0; i < vecs.size(); ++i)
+    {
+        PetscBool flag;
+        DM pack;
+        std::string path = joinHDF5Path(loc, names[i]);
+
+        ierr = checkDMDAVec(vecs[i], flag, pack); CHKERRQ(ierr);
+        if (!flag)
+            SETERRQ1(comm, PETSC_ERR_SUP,
+                     "Vec %s is not managed by a DMDA or a DMComposite of "
+                     "DMDAs; it can not be written through aggregators.\n",
+                     names[i].c_str());
+
+        if (pack == nullptr)
+        {
+            ierr = writeAggregatedDMDAVec(comm, group, vecs[i], path, subNames,
+                                          subIds, subFile, idxFile);
+            CHKERRQ(ierr);
+            continue;
+        }
+
+        // a packed Vec is written as a group with one dataset per sub-Vec
+        PetscInt nSubs;
+        ierr = DMCompositeGetNumberDM(pack, &nSubs); CHKERRQ(ierr);
+        std::vector<Vec> subs(nSubs);
+        ierr = DMCompositeGetAccessArray(pack, vecs[i], nSubs, nullptr,
+                                         subs.data()); CHKERRQ(ierr);
+        for (PetscInt k = 0; k < nSubs; ++k)
+        {
+            ierr = writeAggregatedDMDAVec(
+                comm, group, subs[k], joinHDF5Path(path, std::to_string(k)),
+                subNames, subIds, subFile, idxFile); CHKERRQ(ierr);
+        }
+        ierr = DMCompositeRestoreAccessArray(pack, vecs[i], nSubs, nullptr,
+                                             subs.data()); CHKERRQ(ierr);
+    }
+
+    if (subFile >= 0) PetscStackCallHDF5(H5Fclose, (subFile));
+    if (idxFile >= 0) PetscStackCallHDF5(H5Fclose, (idxFile));
+
+    ierr = MPI_Comm_free(&group); CHKERRQ(ierr);
+
+    // all files have to be complete before anyone opens them again
+    ierr = MPI_Barrier(comm); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // writeHDF5VecsAggregated
+
+PetscErrorCode writeAggregatedDMDAVec(
+    const MPI_Comm comm, const MPI_Comm group, const Vec &vec,
+    const std::string &path, const std::vector<std::string> &subNames,
+    const std::vector<PetscMPIInt> &subIds, const hid_t &subFile,
+    const hid_t &idxFile)
+{
+    PetscErrorCode ierr;
+    PetscMPIInt size, rank, gSize, gRank, count;
+    std::vector<hsize_t> dims, start, nLcl;
+    const PetscScalar *array;
+    hid_t lcpl;
+
+    PetscFunctionBeginUser;
+
+    ierr = MPI_Comm_size(comm, &size); CHKERRQ(ierr);
+    ierr = MPI_Comm_rank(comm, &rank); CHKERRQ(ierr);
+    ierr = MPI_Comm_size(group, &gSize); CHKERRQ(ierr);
+    ierr = MPI_Comm_rank(group, &gRank); CHKERRQ(ierr);
+
+    ierr = getHDF5Box(vec, dims, start, nLcl); CHKERRQ(ierr);
+    const PetscInt nd = dims.size();
+
+    // meta data of the box: the rank, the starting indices, and the counts
+    std::vector<PetscInt> meta(2 * nd + 1);
+    meta[0] = rank;
+    for (PetscInt d = 0; d < nd; ++d)
+    {
+        meta[1 + d] = start[d];
+        meta[1 + nd + d] = nLcl[d];
+    }
+
+    PetscStackCallHDF5Return(lcpl, H5Pcreate, (H5P_LINK_CREATE));
+    PetscStackCallHDF5(H5Pset_create_intermediate_group, (lcpl, 1));
+
+    ierr = VecGetArrayRead(vec, &array); CHKERRQ(ierr);
+
+    // a failure of HDF5 does not stop the aggregator (or the first process)
+    // before the other processes are done with the communications; it is
+    // shared with all the processes at the end
+    PetscMPIInt failed = 0;
+
+    if (gRank == 0)  // the aggregator writes one dataset per process
+    {
+        std::vector<PetscInt> mMeta(2 * nd + 1);
+        std::vector<PetscScalar> buffer;
+
+        if (removeHDF5Object(subFile, path) < 0) failed = 1;
+
+        for (PetscMPIInt m = 0; m < gSize; ++m)
+        {
+            const PetscScalar *data = array;
+
+            if (m == 0)
+                mMeta = meta;
+            else
+            {
+                ierr = MPI_Recv(mMeta.data(), 2 * nd + 1, MPIU_INT, m, 0, group,
+                                MPI_STATUS_IGNORE); CHKERRQ(ierr);
+                PetscInt n = 1;
+                for (PetscInt d = 0; d < nd; ++d) n *= mMeta[1 + nd + d];
+                buffer.resize(n);
+                ierr = PetscMPIIntCast(n, &count); CHKERRQ(ierr);
+                ierr = MPI_Recv(buffer.data(), count, MPIU_SCALAR, m, 1, group,
+                                MPI_STATUS_IGNORE); CHKERRQ(ierr);
+                data = buffer.data();
+            }
+
+            // keep receiving the boxes of the group after a failure
+            if (failed) continue;
+
+            std::vector<hsize_t> c(mMeta.begin() + 1 + nd, mMeta.end());
+            std::string name = joinHDF5Path(path, std::to_string(mMeta[0]));
+            if (writeHDF5Dataset(subFile, name, c, lcpl, data) < 0) failed = 1;
+        }
+    }
+    else  // other processes send their box to the aggregator
+    {
+        PetscInt n;
+        ierr = VecGetLocalSize(vec, &n); CHKERRQ(ierr);
+        ierr = PetscMPIIntCast(n, &count); CHKERRQ(ierr);
+        ierr = MPI_Send(meta.data(), 2 * nd + 1, MPIU_INT, 0, 0, group);
+        CHKERRQ(ierr);
+        ierr = MPI_Send(array, count, MPIU_SCALAR, 0, 1, group); CHKERRQ(ierr);
+    }
+
+    ierr = VecRestoreArrayRead(vec, &array); CHKERRQ(ierr);
+
+    // the index file maps the boxes of all processes into one virtual dataset
+    std::vector<PetscInt> allMeta((rank == 0) ? size * (2 * nd + 1) : 0);
+    ierr = MPI_Gather(meta.data(), 2 * nd + 1, MPIU_INT, allMeta.data(),
+                      2 * nd + 1, MPIU_INT, 0, comm); CHKERRQ(ierr);
+
+    if (rank == 0)
+    {
+        hid_t space = -1, dcpl = -1, dset = -1;
+
+        H5E_BEGIN_TRY
+        {
+            space = H5Screate_simple(nd, dims.data(), nullptr);
+            dcpl = H5Pcreate(H5P_DATASET_CREATE);
+            if ((space < 0) || (dcpl < 0)) failed = 1;
+
+            for (PetscMPIInt r = 0; (r < size) && !failed; ++r)
+            {
+                const PetscInt *m = allMeta.data() + r * (2 * nd + 1);
+                std::vector<hsize_t> s(m + 1, m + 1 + nd),
+                                     c(m + 1 + nd, m + 1 + 2 * nd);
+                std::string name = joinHDF5Path(path, std::to_string(r));
+                hid_t src = H5Screate_simple(nd, c.data(), nullptr);
+
+                if ((src < 0) ||
+                    (H5Sselect_hyperslab(space, H5S_SELECT_SET, s.data(),
+                                         nullptr, c.data(), nullptr) < 0) ||
+                    (H5Pset_virtual(dcpl, space, subNames[subIds[r]].c_str(),
+                                    name.c_str(), src) < 0))
+                    failed = 1;
+                if (src >= 0) H5Sclose(src);
+            }
+
+            if (!failed && ((H5Sselect_all(space) < 0) ||
+                            (removeHDF5Object(idxFile, path) < 0)))
+                failed = 1;
+            if (!failed)
+            {
+                dset = H5Dcreate2(idxFile, path.c_str(), getHDF5RealType(),
+                                  space, lcpl, dcpl, H5P_DEFAULT);
+                if (dset < 0) failed = 1;
+            }
+
+            if (dset >= 0) H5Dclose(dset);
+            if (dcpl >= 0) H5Pclose(dcpl);
+            if (space >= 0) H5Sclose(space);
+        }
+        H5E_END_TRY;
+    }
+
+    PetscStackCallHDF5(H5Pclose, (lcpl));
+
+    // all processes raise the error
+    ierr = MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, comm);
+    CHKERRQ(ierr);
+    if (failed)
+        SETERRQ1(comm, PETSC_ERR_FILE_WRITE,
+                 "Could not write the dataset %s through the aggregators.\n",
+                 path.c_str());
+
+    PetscFunctionReturn(0);
+}  // writeAggregatedDMDAVec
+
+PetscErrorCode readHDF5VecsAggregated(const MPI_Comm comm,
+                                      const std::string &filePath,
+                                      const std::string &loc,
+                                      const std::vector<std::string> &names,
+                                      std::vector<Vec> &vecs)
+{
+    PetscErrorCode ierr;
+    hid_t file, dapl;
+
+    PetscFunctionBeginUser;
+
+    // every process reads its own boxes; the virtual datasets resolve the
+    // subfiles, which are searched in the directory of the index file
+    std::size_t pos = filePath.find_last_of('/');
+    std::string dir = (pos == std::string::npos) ? "." : filePath.substr(0, pos);
+
+    PetscStackCallHDF5Return(
+        file, H5Fopen, (filePath.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT));
+    PetscStackCallHDF5Return(dapl, H5Pcreate, (H5P_DATASET_ACCESS));
+    PetscStackCallHDF5(H5Pset_virtual_prefix, (dapl, dir.c_str()));
+
+    for (unsigned int i = 0; i < vecs.size(); ++i)
+    {
+        PetscBool flag;
+        DM pack;
+        std::string path = joinHDF5Path(loc, names[i]);
+
+        ierr = checkDMDAVec(vecs[i], flag, pack); CHKERRQ(ierr);
+        if (!flag)
+            SETERRQ1(comm, PETSC_ERR_SUP,
+                     "Vec %s is not managed by a DMDA or a DMComposite of "
+                     "DMDAs; it can not be read from aggregated files.\n",
+                     names[i].c_str());
+
+        if (pack == nullptr)
+        {
+            ierr = readHDF5Box(file, dapl, path, vecs[i]); CHKERRQ(ierr);
+            continue;
+        }
+
+        PetscInt nSubs;
+        ierr = DMCompositeGetNumberDM(pack, &nSubs); CHKERRQ(ierr);
+        std::vector<Vec> subs(nSubs);
+        ierr = DMCompositeGetAccessArray(pack, vecs[i], nSubs, nullptr,
+                                         subs.data()); CHKERRQ(ierr);
+        for (PetscInt k = 0; k < nSubs; ++k)
+        {
+            ierr = readHDF5Box(file, dapl,
+                               joinHDF5Path(path, std::to_string(k)), subs[k]);
+            CHKERRQ(ierr);
+        }
+        ierr = DMCompositeRestoreAccessArray(pack, vecs[i], nSubs, nullptr,
+                                             subs.data()); CHKERRQ(ierr);
+    }
+
+    PetscStackCallHDF5(H5Pclose, (dapl));
+    PetscStackCallHDF5(H5Fclose, (file));
+
+    PetscFunctionReturn(0);
+}  // readHDF5VecsAggregated
+
+PetscErrorCode readHDF5Box(const hid_t &file, const hid_t &dapl,
+                           const std::string &path, Vec &vec)
+{
+    PetscErrorCode ierr;
+    std::vector<hsize_t> dims, start, count, fDims;
+    hid_t dset, fSpace, mSpace;
+    int nd;
+    PetscScalar *array;
+
+    PetscFunctionBeginUser;
+
+    ierr = getHDF5Box(vec, dims, start, count); CHKERRQ(ierr);
+
+    PetscStackCallHDF5Return(dset, H5Dopen2, (file, path.c_str(), dapl));
+    PetscStackCallHDF5Return(fSpace, H5Dget_space, (dset));
+    PetscStackCallHDF5Return(nd, H5Sget_simple_extent_ndims, (fSpace));
+    fDims.resize(nd);
+    PetscStackCallHDF5Return(
+        nd, H5Sget_simple_extent_dims, (fSpace, fDims.data(), nullptr));
+
+    if (fDims != dims)
+        SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED,
+                 "The dataset %s does not match the size of the Vec.\n",
+                 path.c_str());
+
+    PetscStackCallHDF5(H5Sselect_hyperslab, (fSpace, H5S_SELECT_SET,
+                                             start.data(), nullptr,
+                                             count.data(), nullptr));
+    PetscStackCallHDF5Return(
+        mSpace, H5Screate_simple, (count.size(), count.data(), nullptr));
+
+    ierr = VecGetArray(vec, &array); CHKERRQ(ierr);
+    PetscStackCallHDF5(H5Dread, (dset, getHDF5RealType(), mSpace, fSpace,
+                                 H5P_DEFAULT, array));
+    ierr = VecRestoreArray(vec, &array); CHKERRQ(ierr);
+
+    PetscStackCallHDF5(H5Sclose, (mSpace));
+    PetscStackCallHDF5(H5Sclose, (fSpace));
+    PetscStackCallHDF5(H5Dclose, (dset));
+
+    PetscFunctionReturn(0);
+}  // readHDF5Box
+
+PetscErrorCode checkDMDAVec(const Vec &vec, PetscBool &flag, DM &pack)
+{
+    PetscErrorCode ierr;
+    DM dm;
+    PetscBool isDA, isPack;
+
+    PetscFunctionBeginUser;
+
+    flag = PETSC_FALSE;
+    pack = nullptr;
+
+    ierr = VecGetDM(vec, &dm); CHKERRQ(ierr);
+    if (dm == nullptr) PetscFunctionReturn(0);
+
+    ierr = PetscObjectTypeCompare((PetscObject)dm, DMDA, &isDA); CHKERRQ(ierr);
+    if (isDA)
+    {
+        flag = PETSC_TRUE;
+        PetscFunctionReturn(0);
+    }
+
+    ierr = PetscObjectTypeCompare((PetscObject)dm, DMCOMPOSITE, &isPack);
+    CHKERRQ(ierr);
+    if (!isPack) PetscFunctionReturn(0);
+
+    PetscInt n;
+    ierr = DMCompositeGetNumberDM(dm, &n); CHKERRQ(ierr);
+    std::vector<DM> dms(n);
+    ierr = DMCompositeGetEntriesArray(dm, dms.data()); CHKERRQ(ierr);
+    for (auto &sub : dms)
+    {
+        ierr = PetscObjectTypeCompare((PetscObject)sub, DMDA, &isDA);
+        CHKERRQ(ierr);
+        if (!isDA) PetscFunctionReturn(0);
+    }
+
+    flag = PETSC_TRUE;
+    pack = dm;
+
+    PetscFunctionReturn(0);
+}  // checkDMDAVec
+
+PetscErrorCode getHDF5Box(const Vec &vec, std::vector<hsize_t> &dims,
+                          std::vector<hsize_t> &start,
+                          std::vector<hsize_t> &count)
+{
+    PetscErrorCode ierr;
+    DM da;
+    PetscInt dim, dof, g[3], s[3], c[3];
+
+    PetscFunctionBeginUser;
+
+    ierr = VecGetDM(vec, &da); CHKERRQ(ierr);
+    ierr = DMDAGetInfo(da, &dim, &g[0], &g[1], &g[2], nullptr, nullptr,
+                       nullptr, &dof, nullptr, nullptr, nullptr, nullptr,
+                       nullptr); CHKERRQ(ierr);
+    ierr = DMDAGetCorners(da, &s[0], &s[1], &s[2], &c[0], &c[1], &c[2]);
+    CHKERRQ(ierr);
+
+    dims.clear();
+    start.clear();
+    count.clear();
+
+    // the slowest-varying index comes first
+    for (PetscInt d = dim - 1; d >= 0; --d)
+    {
+        dims.push_back(g[d]);
+        start.push_back(s[d]);
+        count.push_back(c[d]);
+    }
+
+    // same as PETSc: the degrees of freedom are the last dimension, if any
+    if (dof > 1)
+    {
+        dims.push_back(dof);
+        start.push_back(0);
+        count.push_back(dof);
+    }
+
+    PetscFunctionReturn(0);
+}  // getHDF5Box
+
+PetscErrorCode openHDF5File(const std::string &filePath,
+                            const PetscFileMode &mode, hid_t &file)
+{
+    PetscErrorCode ierr;
+    PetscBool exist = PETSC_FALSE;
+
+    PetscFunctionBeginUser;
+
+    if (mode == FILE_MODE_APPEND)
+    {
+        ierr = PetscTestFile(filePath.c_str(), 'r', &exist); CHKERRQ(ierr);
+    }
+
+    H5E_BEGIN_TRY
+    {
+        if (exist)
+            file = H5Fopen(filePath.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+        else
+            file = H5Fcreate(filePath.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+                             H5P_DEFAULT);
+    }
+    H5E_END_TRY;
+
+    PetscFunctionReturn(0);
+}  // openHDF5File
+
+herr_t removeHDF5Object(const hid_t &file, const std::string &path)
+{
+    herr_t status = 0;
+
+    H5E_BEGIN_TRY
+    {
+        // H5Lexists requires all the intermediate groups to exist
+        std::size_t pos = 0;
+        htri_t exist = 1;
+        while ((exist > 0) && (pos != std::string::npos))
+        {
+            pos = path.find('/', pos + 1);
+            std::string sub = path.substr(0, pos);
+            if (sub.empty() || sub == "/") continue;
+            exist = H5Lexists(file, sub.c_str(), H5P_DEFAULT);
+        }
+
+        if (exist < 0)
+            status = -1;
+        else if (exist > 0)
+            status = H5Ldelete(file, path.c_str(), H5P_DEFAULT);
+    }
+    H5E_END_TRY;
+
+    return status;
+}  // removeHDF5Object
+
+herr_t writeHDF5Dataset(const hid_t &file, const std::string &path,
+                        const std::vector<hsize_t> &count, const hid_t &lcpl,
+                        const PetscScalar *data)
+{
+    herr_t status = -1;
+
+    H5E_BEGIN_TRY
+    {
+        hid_t space = -1, dset = -1;
+
+        space = H5Screate_simple(count.size(), count.data(), nullptr);
+        if (space >= 0)
+            dset = H5Dcreate2(file, path.c_str(), getHDF5RealType(), space,
+                              lcpl, H5P_DEFAULT, H5P_DEFAULT);
+        if (dset >= 0)
+            status = H5Dwrite(dset, getHDF5RealType(), H5S_ALL, H5S_ALL,
+                              H5P_DEFAULT, data);
+        if ((dset >= 0) && (H5Dclose(dset) < 0)) status = -1;
+        if (space >= 0) H5Sclose(space);
+    }
+    H5E_END_TRY;
+
+    return status;
+}  // writeHDF5Dataset
+
+PetscErrorCode checkHDF5Aggregated(const MPI_Comm comm,
+                                   const std::string &filePath,
+                                   const std::string &path, PetscBool &flag)
+{
+    PetscErrorCode ierr;
+    PetscMPIInt rank, result = 0;
+
+    PetscFunctionBeginUser;
+
+    ierr = MPI_Comm_rank(comm, &rank); CHKERRQ(ierr);
+
+    // only the first process looks into the file; it must not return early
+    // on a failure, or the other processes would wait in MPI_Bcast forever:
+    // the failure is broadcast as a negative result instead
+    // (-1: can not open the file; -2: no such object; -3: can not read it)
+    if (rank == 0)
+    {
+        hid_t file = -1, obj = -1;
+
+        H5E_BEGIN_TRY
+        {
+            file = H5Fopen(filePath.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        }
+        H5E_END_TRY;
+        if (file < 0) result = -1;
+
+        // H5Lexists requires all the intermediate groups to exist
+        std::size_t pos = 0;
+        while ((result == 0) && (pos != std::string::npos))
+        {
+            pos = path.find('/', pos + 1);
+            std::string sub = path.substr(0, pos);
+            if (sub.empty() || sub == "/") continue;
+            if (H5Lexists(file, sub.c_str(), H5P_DEFAULT) <= 0) result = -2;
+        }
+
+        if (result == 0)
+        {
+            obj = H5Oopen(file, path.c_str(), H5P_DEFAULT);
+            if (obj < 0) result = -3;
+        }
+
+        if (result == 0)
+        {
+            H5I_type_t type = H5Iget_type(obj);
+
+            if (type == H5I_GROUP)  // packed Vec written through aggregators
+                result = 1;
+            else if (type == H5I_DATASET)
+            {
+                hid_t dcpl = H5Dget_create_plist(obj);
+                if (dcpl < 0)
+                    result = -3;
+                else
+                {
+                    result = (H5Pget_layout(dcpl) == H5D_VIRTUAL) ? 1 : 0;
+                    H5Pclose(dcpl);
+                }
+            }
+        }
+
+        if (obj >= 0) H5Oclose(obj);
+        if (file >= 0) H5Fclose(file);
+    }
+
+    ierr = MPI_Bcast(&result, 1, MPI_INT, 0, comm); CHKERRQ(ierr);
+
+    // all processes raise the error
+    if (result == -1)
+        SETERRQ1(comm, PETSC_ERR_FILE_OPEN,
+                 "Could not open the HDF5 file %s.\n", filePath.c_str());
+    if (result == -2)
+        SETERRQ2(comm, PETSC_ERR_FILE_UNEXPECTED,
+                 "No object %s in the HDF5 file %s.\n", path.c_str(),
+                 filePath.c_str());
+    if (result < 0)
+        SETERRQ2(comm, PETSC_ERR_FILE_READ,
+                 "Could not read the object %s of the HDF5 file %s.\n",
+                 path.c_str(), filePath.c_str());
+
+    flag = (result == 1) ? PETSC_TRUE : PETSC_FALSE;
+
+    PetscFunctionReturn(0);
+}  // checkHDF5Aggregated
+
+PetscErrorCode readMatCache(const MPI_Comm comm, const std::string &dir,
+                            const std::string &name, const std::string &key,
+                            const PetscInt &m, const PetscInt &n, Mat &mat,
+                            PetscBool &found)
+{
+    PetscErrorCode ierr;
+    PetscMPIInt rank;
+    PetscMPIInt match = 0;
+    PetscViewer viewer;
+
+    PetscFunctionBeginUser;
+
+    ierr = MPI_Comm_rank(comm, &rank); CHKERRQ(ierr);
+
+    // only the master process reads the key of the cached operator
+    if (rank == 0)
+    {
+        std::ifstream file(dir + "/" + name + ".key");
+        std::string cached;
+        if (file.good() && (file >> cached)) match = (cached == key);
+    }
+    ierr = MPI_Bcast(&match, 1, MPI_INT, 0, comm); CHKERRQ(ierr);
+
+    found = PetscBool(match);
+    if (!found) PetscFunctionReturn(0);
+
+    ierr = PetscViewerBinaryOpen(comm, (dir + "/" + name + ".dat").c_str(),
+                                 FILE_MODE_READ, &viewer); CHKERRQ(ierr);
+    ierr = MatCreate(comm, &mat); CHKERRQ(ierr);
+    ierr = MatSetSizes(mat, m, n, PETSC_DETERMINE, PETSC_DETERMINE);
+    CHKERRQ(ierr);
+    ierr = MatSetType(mat, MATAIJ); CHKERRQ(ierr);
+    ierr = MatLoad(mat, viewer); CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // readMatCache
+
+PetscErrorCode writeMatCache(const MPI_Comm comm, const std::string &dir,
+                             const std::string &name, const std::string &key,
+                             const Mat &mat)
+{
+    PetscErrorCode ierr;
+    PetscMPIInt rank;
+    PetscViewer viewer;
+
+    PetscFunctionBeginUser;
+
+    ierr = MPI_Comm_rank(comm, &rank); CHKERRQ(ierr);
+
+    // invalidate the current entry before overwriting the operator
+    if (rank == 0) std::remove((dir + "/" + name + ".key").c_str());
+
+    ierr = PetscViewerBinaryOpen(comm, (dir + "/" + name + ".dat").c_str(),
+                                 FILE_MODE_WRITE, &viewer); CHKERRQ(ierr);
+    ierr = MatView(mat, viewer); CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+
+    if (rank == 0)
+    {
+        std::ofstream file(dir + "/" + name + ".key");
+        file << key << std::endl;
+        if (!file.good())
+            SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_FILE_WRITE,
+                     "Could not write the key of the cached operator %s\n",
+                     name.c_str());
+    }
+
+    PetscFunctionReturn(0);
+}  // writeMatCache
+
 PetscErrorCode writePetscLog(const MPI_Comm comm, const std::string &filePath)
 {
     PetscErrorCode ierr;
@@ -288,5 +1297,316 @@ PetscErrorCode writePetscLog(const MPI_Comm comm, const std::string &filePath)
     PetscFunctionReturn(0);
 }  // writePetscLog
 
+herr_t getHDF5ByteRanges(const hid_t &file, const std::string &filePath,
+                         const std::string &path,
+                         const std::vector<hsize_t> &start,
+                         const std::vector<hsize_t> &count,
+                         ByteRanges &ranges)
+{
+    herr_t status = -1;
+    const std::size_t nd = start.size();
+
+    for (std::size_t d = 0; d < nd; ++d)
+        if (count[d] == 0) return 0;
+
+    H5E_BEGIN_TRY
+    {
+        hid_t dset = -1, space = -1, type = -1, dcpl = -1;
+        std::vector<hsize_t> dims(nd);
+
+        dset = H5Dopen2(file, path.c_str(), H5P_DEFAULT);
+        if (dset >= 0)
+        {
+            space = H5Dget_space(dset);
+            type = H5Dget_type(dset);
+            dcpl = H5Dget_create_plist(dset);
+        }
+        if ((space >= 0) && (type >= 0) && (dcpl >= 0) &&
+            (H5Sget_simple_extent_ndims(space) == int(nd)) &&
+            (H5Sget_simple_extent_dims(space, dims.data(), nullptr) >= 0))
+            status = 0;
+        for (std::size_t d = 0; (d < nd) && (status >= 0); ++d)
+            if (start[d] + count[d] > dims[d]) status = -1;
+
+        H5D_layout_t layout = (status >= 0) ? H5Pget_layout(dcpl)
+                                            : H5D_LAYOUT_ERROR;
+
+        if (layout == H5D_CONTIGUOUS)
+        {
+            // one range per row of the box along the last dimension
+            haddr_t base = H5Dget_offset(dset);
+            hsize_t size = H5Tget_size(type), nRows = 1;
+            std::vector<hsize_t> row(start);
+            auto &list = ranges[filePath];
+
+            if ((base == HADDR_UNDEF) || (size == 0)) status = -1;
+            for (std::size_t d = 0; d + 1 < nd; ++d) nRows *= count[d];
+            for (hsize_t r = 0; (r < nRows) && (status >= 0); ++r)
+            {
+                hsize_t linear = 0;
+                for (std::size_t d = 0; d < nd; ++d)
+                    linear = linear * dims[d] + row[d];
+                hsize_t offset = base + linear * size,
+                        length = count[nd - 1] * size;
+                if (!list.empty() &&
+                    (list.back().first + list.back().second == offset))
+                    list.back().second += length;
+                else
+                    list.emplace_back(offset, length);
+
+                for (std::size_t d = nd - 1; d-- > 0;)
+                {
+                    if (++row[d] < start[d] + count[d]) break;
+                    row[d] = start[d];
+                }
+            }
+        }
+        else if (layout == H5D_CHUNKED)
+        {
+            // the chunks intersecting the box (HDF5 ignores the selection
+            // when listing the chunks; chunks never written have no address)
+#if H5_VERSION_GE(1, 10, 5)
+            hsize_t nChunks = 0;
+            std::vector<hsize_t> chunk(nd), offset(nd);
+            unsigned mask;
+
+            if ((H5Pget_chunk(dcpl, nd, chunk.data()) != int(nd)) ||
+                (H5Dget_num_chunks(dset, space, &nChunks) < 0))
+                status = -1;
+            for (hsize_t k = 0; (k < nChunks) && (status >= 0); ++k)
+            {
+                haddr_t addr;
+                hsize_t size;
+                bool overlap = true;
+                if (H5Dget_chunk_info(dset, space, k, offset.data(), &mask,
+                                      &addr, &size) < 0)
+                    status = -1;
+                for (std::size_t d = 0; d < nd; ++d)
+                    if ((offset[d] >= start[d] + count[d]) ||
+                        (offset[d] + chunk[d] <= start[d]))
+                        overlap = false;
+                if ((status >= 0) && overlap && (addr != HADDR_UNDEF))
+                    ranges[filePath].emplace_back(addr, size);
+            }
+#else
+            status = -1;
+#endif
+        }
+        else if (layout == H5D_VIRTUAL)
+        {
+            // the parts of the box in the source datasets (in the same file
+            // or in files of the same directory)
+            std::size_t pos = filePath.find_last_of('/'), nMaps = 0;
+            std::string dir =
+                (pos == std::string::npos) ? "." : filePath.substr(0, pos);
+
+            if (H5Pget_virtual_count(dcpl, &nMaps) < 0) status = -1;
+            for (std::size_t m = 0; (m < nMaps) && (status >= 0); ++m)
+            {
+                std::vector<hsize_t> vLo(nd), vHi(nd), sLo(nd), sHi(nd),
+                    subStart(nd), subCount(nd);
+                hid_t vSpace = H5Pget_virtual_vspace(dcpl, m),
+                      sSpace = H5Pget_virtual_srcspace(dcpl, m);
+                bool overlap = true;
+
+                if ((vSpace < 0) || (sSpace < 0) ||
+                    (H5Sget_select_bounds(vSpace, vLo.data(), vHi.data()) <
+                     0) ||
+                    (H5Sget_select_bounds(sSpace, sLo.data(), sHi.data()) < 0))
+                    status = -1;
+                for (std::size_t d = 0; (d < nd) && (status >= 0); ++d)
+                {
+                    hsize_t lo = std::max(start[d], vLo[d]),
+                            hi = std::min(start[d] + count[d] - 1, vHi[d]);
+                    if (lo > hi) overlap = false;
+                    subStart[d] = sLo[d] + lo - vLo[d];
+                    subCount[d] = hi - lo + 1;
+                }
+                if (vSpace >= 0) H5Sclose(vSpace);
+                if (sSpace >= 0) H5Sclose(sSpace);
+                if ((status < 0) || !overlap) continue;
+
+                ssize_t nName = H5Pget_virtual_filename(dcpl, m, nullptr, 0),
+                        nDset = H5Pget_virtual_dsetname(dcpl, m, nullptr, 0);
+                if ((nName < 0) || (nDset < 0))
+                {
+                    status = -1;
+                    continue;
+                }
+                std::vector<char> name(nName + 1), dsetName(nDset + 1);
+                H5Pget_virtual_filename(dcpl, m, name.data(), name.size());
+                H5Pget_virtual_dsetname(dcpl, m, dsetName.data(),
+                                        dsetName.size());
+
+                std::string subPath = (std::string(name.data()) == ".")
+                                          ? filePath
+                                          : dir + "/" + name.data();
+                hid_t sub = (subPath == filePath)
+                                ? file
+                                : H5Fopen(subPath.c_str(), H5F_ACC_RDONLY,
+                                          H5P_DEFAULT);
+                if (sub < 0)
+                    status = -1;
+                else
+                    status = getHDF5ByteRanges(sub, subPath, dsetName.data(),
+                                               subStart, subCount, ranges);
+                if ((sub >= 0) && (sub != file)) H5Fclose(sub);
+            }
+        }
+        else
+            status = -1;
+
+        if (dcpl >= 0) H5Pclose(dcpl);
+        if (type >= 0) H5Tclose(type);
+        if (space >= 0) H5Sclose(space);
+        if (dset >= 0) H5Dclose(dset);
+    }
+    H5E_END_TRY;
+
+    return status;
+}  // getHDF5ByteRanges
+
+// background threads that read byte ranges into the page cache of the node
+static std::vector<std::thread> prefetchers;
+
+// read byte ranges of files by chunks; the content is discarded
+static void readByteRanges(const ByteRanges ranges)
+{
+    std::vector<char> buffer(std::size_t(1) << 23);
+
+    for (const auto &file : ranges)
+    {
+        std::ifstream in(file.first, std::ios::binary);
+        for (const auto &range : file.second)
+        {
+            in.clear();
+            in.seekg(range.first);
+            for (hsize_t left = range.second; (left > 0) && in;)
+            {
+                hsize_t n = std::min(left, hsize_t(buffer.size()));
+                in.read(buffer.data(), n);
+                left -= n;
+            }
+        }
+    }
+}  // readByteRanges
+
+PetscErrorCode prefetchHDF5Vecs(const std::string &filePath,
+                                const std::string &loc,
+                                const std::vector<std::string> &names,
+                                const std::vector<Vec> &vecs)
+{
+    PetscErrorCode ierr;
+    ByteRanges ranges;
+    hid_t file;
+
+    PetscFunctionBeginUser;
+
+    // a missing or invalid file is reported when it is read
+    H5E_BEGIN_TRY
+    {
+        file = H5Fopen(filePath.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    }
+    H5E_END_TRY;
+    if (file < 0) PetscFunctionReturn(0);
+
+    // datasets whose storage can not be located are not prefetched
+    for (unsigned int i = 0; i < vecs.size(); ++i)
+    {
+        PetscBool flag;
+        DM pack;
+        htri_t split = 0;
+        std::vector<hsize_t> dims, start, count;
+        std::string path = joinHDF5Path(loc, names[i]);
+
+        ierr = checkDMDAVec(vecs[i], flag, pack); CHKERRQ(ierr);
+        if (flag && (pack == nullptr))
+        {
+            ierr = getHDF5Box(vecs[i], dims, start, count); CHKERRQ(ierr);
+            getHDF5ByteRanges(file, filePath, path, start, count, ranges);
+            continue;
+        }
+
+        // the sub-Vecs of a DMComposite are split only in aggregated files
+        if (flag)
+        {
+            H5E_BEGIN_TRY
+            {
+                split = H5Lexists(file, joinHDF5Path(path, "0").c_str(),
+                                  H5P_DEFAULT);
+            }
+            H5E_END_TRY;
+        }
+
+        if (split > 0)
+        {
+            PetscInt nSubs;
+            ierr = DMCompositeGetNumberDM(pack, &nSubs); CHKERRQ(ierr);
+            std::vector<Vec> subs(nSubs);
+            ierr = DMCompositeGetAccessArray(pack, vecs[i], nSubs, nullptr,
+                                             subs.data()); CHKERRQ(ierr);
+            for (PetscInt k = 0; k < nSubs; ++k)
+            {
+                ierr = getHDF5Box(subs[k], dims, start, count); CHKERRQ(ierr);
+                getHDF5ByteRanges(file, filePath,
+                                  joinHDF5Path(path, std::to_string(k)), start,
+                                  count, ranges);
+            }
+            ierr = DMCompositeRestoreAccessArray(pack, vecs[i], nSubs, nullptr,
+                                                 subs.data()); CHKERRQ(ierr);
+        }
+        else  // one-dimensional dataset in the PETSc ordering
+        {
+            PetscInt bg, ed;
+            ierr = VecGetOwnershipRange(vecs[i], &bg, &ed); CHKERRQ(ierr);
+            getHDF5ByteRanges(file, filePath, path, {hsize_t(bg)},
+                              {hsize_t(ed - bg)}, ranges);
+        }
+    }
+
+    PetscStackCallHDF5(H5Fclose, (file));
+
+    // the ranges are read in order, merging the adjacent ones
+    for (auto entry = ranges.begin(); entry != ranges.end();)
+    {
+        auto &list = entry->second;
+        if (list.empty())
+        {
+            entry = ranges.erase(entry);
+            continue;
+        }
+        std::sort(list.begin(), list.end());
+        std::size_t n = 0;
+        for (std::size_t k = 0; k < list.size(); ++k)
+        {
+            if ((n > 0) && (list[n - 1].first + list[n - 1].second >=
+                            list[k].first))
+                list[n - 1].second =
+                    std::max(list[n - 1].first + list[n - 1].second,
+                             list[k].first + list[k].second) -
+                    list[n - 1].first;
+            else
+                list[n++] = list[k];
+        }
+        list.resize(n);
+        ++entry;
+    }
+
+    if (!ranges.empty()) prefetchers.emplace_back(readByteRanges, ranges);
+
+    PetscFunctionReturn(0);
+}  // prefetchHDF5Vecs
+
+PetscErrorCode joinPrefetch()
+{
+    PetscFunctionBeginUser;
+
+    for (auto &prefetcher : prefetchers)
+        if (prefetcher.joinable()) prefetcher.join();
+    prefetchers.clear();
+
+    PetscFunctionReturn(0);
+}  // joinPrefetch
+
 }  // end of namespace io
 }  // end of namespace petibm
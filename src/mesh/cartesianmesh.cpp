@@ -7,6 +7,7 @@
 
 // here goes C++ STL
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <numeric>
 #include <sstream>
@@ -26,6 +27,14 @@ namespace mesh
 {
 using namespace type;
 
+// number of consecutive equal spacings (up to `max`) starting at point `i`
+PetscInt getUniformRun(const PetscReal *line, const PetscInt &n,
+                       const PetscInt &i, const PetscInt &max);
+
+// move `idx` to the last point of `line` not greater than `x`
+void walkGridLine(const PetscReal *line, const PetscInt &n, const PetscReal &x,
+                  PetscInt &idx);
+
 // implementation of CartesianMesh::CastesianMesh
 CartesianMesh::CartesianMesh(const MPI_Comm &world, const YAML::Node &node)
 {
@@ -43,7 +52,7 @@ CartesianMesh::~CartesianMesh()
     ierr = PetscFinalized(&finalized); CHKERRV(ierr);
     if (finalized) return;
 
-    std::vector<AO>().swap(ao);  // DO NOT DESTROY UNDERLYING AOs!!
+    type::IntVec3D().swap(ownStarts);
 }  // ~CartesianMesh
 
 // implementation of CartesianMesh::destroy
@@ -55,10 +64,11 @@ PetscErrorCode CartesianMesh::destroy()
 
     type::RealVec3D().swap(dLTrue);
     type::RealVec3D().swap(coordTrue);
-    std::vector<AO>().swap(ao);  // DO NOT DESTROY UNDERLYING AOs!!
+    type::IntVec3D().swap(ownStarts);
     type::IntVec1D().swap(UPackNLocalAllProcs);
     type::IntVec2D().swap(offsetsAllProcs);
     type::IntVec1D().swap(offsetsPackAllProcs);
+    std::vector<std::vector<GridLineIndex>>().swap(lineIdx);
 
     ierr = MeshBase::destroy(); CHKERRQ(ierr);
 
@@ -88,25 +98,27 @@ PetscErrorCode CartesianMesh::init(const MPI_Comm &world,
     // 3D code in many places.
     min = RealVec1D(3, 0.0);
     max = RealVec1D(3, 1.0);
-    n = IntVec2D(5, IntVec1D(3, 1));
+    n = IntArray2D(5, 3, 1);
     coordTrue = RealVec3D(5, RealVec2D(3, RealVec1D(1, 0.0)));
     coord = GhostedVec3D(5, GhostedVec2D(3, nullptr));
     dLTrue = RealVec3D(5, RealVec2D(3, RealVec1D(1, 1.0)));
     dL = GhostedVec3D(5, GhostedVec2D(3, nullptr));
     da = std::vector<DM>(5, PETSC_NULL);
     nProc = IntVec1D(3, PETSC_DECIDE);
-    bg = IntVec2D(5, IntVec1D(3, 0));
-    ed = IntVec2D(5, IntVec1D(3, 1));
-    m = IntVec2D(5, IntVec1D(3, 0));
-    ao = std::vector<AO>(4);
+    bg = IntArray2D(5, 3, 0);
+    ed = IntArray2D(5, 3, 1);
+    m = IntArray2D(5, 3, 0);
+    ownStarts = IntVec3D(4, IntVec2D(3, IntVec1D(2, 0)));
     UNLocalAllProcs = IntVec2D(3, IntVec1D(mpiSize, 0));
     UPackNLocalAllProcs = IntVec1D(mpiSize, 0);
     offsetsAllProcs = IntVec2D(3, IntVec1D(mpiSize, 0));
     offsetsPackAllProcs = IntVec1D(mpiSize, 0);
 
     // index 3 represent pressure mesh; min & max always represent pressure mesh
-    ierr = parser::parseMesh(node["mesh"], dim, min, max, n[3], dLTrue[3]);
+    IntVec1D nTotal(n.row(3));
+    ierr = parser::parseMesh(node["mesh"], dim, min, max, nTotal, dLTrue[3]);
     CHKERRQ(ierr);
+    std::copy(nTotal.begin(), nTotal.end(), n[3]);
 
     // check periodic BC
     IntVec2D bcTypes;
@@ -120,6 +132,9 @@ PetscErrorCode CartesianMesh::init(const MPI_Comm &world,
     ierr = createVelocityMesh(); CHKERRQ(ierr);
     ierr = MPI_Barrier(comm); CHKERRQ(ierr);
 
+    // create indices to locate points in the gridlines
+    ierr = createLineIndices(); CHKERRQ(ierr);
+
     // create PETSc DMs
     ierr = initDMDA(); CHKERRQ(ierr);
 
@@ -546,7 +561,7 @@ PetscErrorCode CartesianMesh::createPressureDMDA()
 
     ierr = createSingleDMDA(3); CHKERRQ(ierr);
 
-    ierr = DMDAGetAO(da[3], &ao[3]); CHKERRQ(ierr);
+    ierr = createOwnershipRanges(3); CHKERRQ(ierr);
 
     ierr = DMDAGetInfo(da[3], nullptr, nullptr, nullptr, nullptr, &nProc[0],
                        &nProc[1], &nProc[2], nullptr, nullptr, nullptr, nullptr,
@@ -567,13 +582,41 @@ PetscErrorCode CartesianMesh::createVelocityPack()
     for (int i = 0; i < dim; ++i)
     {
         ierr = createSingleDMDA(i); CHKERRQ(ierr);
-        ierr = DMDAGetAO(da[i], &ao[i]); CHKERRQ(ierr);
+        ierr = createOwnershipRanges(i); CHKERRQ(ierr);
         ierr = DMCompositeAddDM(UPack, da[i]); CHKERRQ(ierr);
     }
 
     PetscFunctionReturn(0);
 }  // createVelocityPack
 
+// implementation of CartesianMesh::createOwnershipRanges
+PetscErrorCode CartesianMesh::createOwnershipRanges(const PetscInt &f)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    PetscInt np[3] = {1, 1, 1};
+    const PetscInt *l[3] = {nullptr, nullptr, nullptr};
+
+    ierr = DMDAGetInfo(da[f], nullptr, nullptr, nullptr, nullptr, &np[0],
+                       &np[1], &np[2], nullptr, nullptr, nullptr, nullptr,
+                       nullptr, nullptr); CHKERRQ(ierr);
+    ierr = DMDAGetOwnershipRanges(da[f], &l[0], &l[1], &l[2]); CHKERRQ(ierr);
+
+    // starting index of each process in each direction, and the total number
+    // of points as the last entry; a 2D DMDA has no ranges in z
+    for (PetscInt d = 0; d < 3; ++d)
+    {
+        ownStarts[f][d] = IntVec1D(np[d] + 1, 0);
+        for (PetscInt p = 0; p < np[d]; ++p)
+            ownStarts[f][d][p + 1] =
+                ownStarts[f][d][p] + ((l[d] == nullptr) ? n[f][d] : l[d][p]);
+    }
+
+    PetscFunctionReturn(0);
+}  // createOwnershipRanges
+
 // implementation of CartesianMesh::getNaturalIndex
 PetscErrorCode CartesianMesh::getNaturalIndex(const PetscInt &f,
                                               const MatStencil &s,
@@ -601,7 +644,7 @@ PetscErrorCode CartesianMesh::getNaturalIndex(const PetscInt &f,
     if ((i < -1) || (i > n[f][0]) || (j < -1) || (j > n[f][1]) || (k < -1) ||
         (k > n[f][2]))
         SETERRQ4(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
-                 "Stencil (%d, %d, %d) of field %d is out of domain.\n", i, j,
+                 "Stencil (%D, %D, %D) of field %D is out of domain.\n", i, j,
                  k, f);
 #endif
 
@@ -714,8 +757,35 @@ PetscErrorCode CartesianMesh::getGlobalIndex(const PetscInt &f,
 
     PetscErrorCode ierr;
 
+    // the natural index takes care of periodic and out-of-domain points
     ierr = getNaturalIndex(f, s, idx); CHKERRQ(ierr);
-    ierr = AOApplicationToPetsc(ao[f], 1, &idx); CHKERRQ(ierr);
+    if (idx == -1) PetscFunctionReturn(0);
+
+    // (i, j, k) of the point, wrapped into the domain
+    PetscInt ijk[3];
+    ijk[0] = idx % n[f][0];
+    ijk[1] = (idx / n[f][0]) % n[f][1];
+    ijk[2] = idx / (n[f][0] * n[f][1]);
+
+    // the process owning the point, and the point's range and index in it
+    PetscInt s0[3], w[3];
+    for (PetscInt d = 0; d < 3; ++d)
+    {
+        const IntVec1D &starts = ownStarts[f][d];
+        PetscInt p = std::upper_bound(starts.begin(), starts.end(), ijk[d]) -
+                     starts.begin() - 1;
+        s0[d] = starts[p];
+        w[d] = starts[p + 1] - starts[p];
+    }
+
+    // the processes are ordered along x first, then y and z, and each one
+    // holds its points in natural order: the processes before the owner
+    // hold complete slabs in z, then complete rows in y, then the blocks
+    // before it in x
+    idx = s0[2] * n[f][1] * n[f][0] + s0[1] * n[f][0] * w[2] +
+          s0[0] * w[1] * w[2] +
+          ((ijk[2] - s0[2]) * w[1] + (ijk[1] - s0[1])) * w[0] +
+          (ijk[0] - s0[0]);
 
     PetscFunctionReturn(0);
 }  // getGlobalIndex
@@ -811,7 +881,7 @@ PetscErrorCode CartesianMesh::write(const std::string &filePath) const
             std::string group = type::fd2str[type::Field(f)];
 
             ierr = io::writeHDF5Vecs(PETSC_COMM_SELF, filePath, group, names,
-                                     n[f], coord[f], mode); CHKERRQ(ierr);
+                                     n.row(f), coord[f], mode); CHKERRQ(ierr);
 
             mode = FILE_MODE_APPEND;
         }
@@ -840,5 +910,170 @@ PetscBool CartesianMesh::isPointOnLocalProc(const type::RealVec1D &point,
     return PETSC_TRUE;
 }  // isPointOnLocalProc
 
+// implementation of CartesianMesh::createLineIndices
+PetscErrorCode CartesianMesh::createLineIndices()
+{
+    PetscFunctionBeginUser;
+
+    // minimum number of equal spacings to make a uniform segment
+    const PetscInt minRun = 4;
+
+    lineIdx = std::vector<std::vector<GridLineIndex>>(
+        5, std::vector<GridLineIndex>(3));
+
+    // (the gridlines of the w-velocity in 2D have a single point)
+    for (PetscInt f = 0; f < 5; ++f)
+    {
+        for (PetscInt d = 0; d < dim; ++d)
+        {
+            const PetscReal *line = coord[f][d];
+            const PetscInt &nPts = n[f][d];
+            GridLineIndex &index = lineIdx[f][d];
+
+            PetscInt i = 0;
+            while (i < nPts - 1)
+            {
+                PetscInt run = getUniformRun(line, nPts, i, minRun);
+
+                index.bound.push_back(line[i]);
+                index.first.push_back(i);
+
+                if (run >= minRun || i + run == nPts - 1)
+                {
+                    // uniform segment: extend it as far as the spacing holds
+                    run = getUniformRun(line, nPts, i, nPts);
+                    index.count.push_back(run);
+                    index.h.push_back((line[i + run] - line[i]) / run);
+                    index.offset.push_back(-1);
+                    i += run;
+                    continue;
+                }
+
+                // stretched segment: extend it until a uniform one starts
+                PetscInt k = i;
+                PetscReal hMin = line[i + 1] - line[i];
+                do
+                {
+                    hMin = std::min(hMin, line[k + 1] - line[k]);
+                    k += 1;
+                } while (k < nPts - 1 &&
+                         getUniformRun(line, nPts, k, minRun) < minRun);
+
+                // buckets of the size of the smallest cell (but not too many)
+                PetscReal L = line[k] - line[i];
+                PetscInt nBuckets =
+                    std::min(PetscInt(std::ceil(L / hMin)), 4 * (k - i));
+                PetscReal hb = L / nBuckets;
+
+                index.count.push_back(nBuckets);
+                index.h.push_back(hb);
+                index.offset.push_back(index.table.size());
+
+                PetscInt idx = i;
+                for (PetscInt b = 0; b < nBuckets; ++b)
+                {
+                    walkGridLine(line, nPts, line[i] + b * hb, idx);
+                    index.table.push_back(idx);
+                }
+
+                i = k;
+            }
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // createLineIndices
+
+// implementation of CartesianMesh::locate
+PetscErrorCode CartesianMesh::locate(const PetscInt &f, const PetscInt &d,
+                                     const PetscReal &x, PetscInt &idx) const
+{
+    PetscFunctionBeginUser;
+
+    const PetscReal *line = coord[f][d];
+    const PetscInt &nPts = n[f][d];
+    const GridLineIndex &index = lineIdx[f][d];
+
+    if (x < line[0])
+    {
+        idx = -1;
+        PetscFunctionReturn(0);
+    }
+
+    if (x >= line[nPts - 1])
+    {
+        idx = nPts - 1;
+        PetscFunctionReturn(0);
+    }
+
+    // there are only a few segments (about one per sub-domain)
+    std::size_t s = 0;
+    while (s + 1 < index.bound.size() && index.bound[s + 1] <= x) ++s;
+
+    // first guess from the index of the segment
+    PetscInt b = PetscInt((x - index.bound[s]) / index.h[s]);
+    b = std::max(PetscInt(0), std::min(b, index.count[s] - 1));
+
+    if (index.offset[s] < 0)  // uniform segment
+        idx = index.first[s] + b;
+    else  // stretched segment
+        idx = index.table[index.offset[s] + b];
+
+    // fix round-off errors and positions inside a bucket
+    walkGridLine(line, nPts, x, idx);
+
+    PetscFunctionReturn(0);
+}  // locate
+
+// implementation of CartesianMesh::locateFrom
+PetscErrorCode CartesianMesh::locateFrom(const PetscInt &f, const PetscInt &d,
+                                         const PetscReal &x,
+                                         PetscInt &idx) const
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    const PetscReal *line = coord[f][d];
+    const PetscInt &nPts = n[f][d];
+
+    // walk if the point is still within a couple of cells of its previous one
+    if (idx >= 0 && idx < nPts)
+    {
+        PetscInt lo = std::max(idx - 2, PetscInt(0)),
+                 hi = std::min(idx + 3, nPts - 1);
+        if (line[lo] <= x && x < line[hi])
+        {
+            walkGridLine(line, nPts, x, idx);
+            PetscFunctionReturn(0);
+        }
+    }
+
+    ierr = locate(f, d, x, idx); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // locateFrom
+
+PetscInt getUniformRun(const PetscReal *line, const PetscInt &n,
+                       const PetscInt &i, const PetscInt &max)
+{
+    const PetscReal h = line[i + 1] - line[i];
+
+    PetscInt run = 1;
+    while (run < max && i + run < n - 1 &&
+           std::abs(line[i + run + 1] - line[i + run] - h) <= 1e-8 * h)
+        run += 1;
+
+    return run;
+}  // getUniformRun
+
+void walkGridLine(const PetscReal *line, const PetscInt &n, const PetscReal &x,
+                  PetscInt &idx)
+{
+    idx = std::max(PetscInt(0), std::min(idx, n - 1));
+    while (idx + 1 < n && line[idx + 1] <= x) ++idx;
+    while (idx >= 0 && line[idx] > x) --idx;
+}  // walkGridLine
+
 }  // end of namespace mesh
 }  // end of namespace petibm
@@ -52,7 +52,7 @@ PetscErrorCode MeshBase::destroy()
     dim = -1;
     type::RealVec1D().swap(min);
     type::RealVec1D().swap(max);
-    type::IntVec2D().swap(n);
+    n.clear();
     type::BoolVec2D().swap(periodic);
     type::GhostedVec3D().swap(coord);
     type::GhostedVec3D().swap(dL);
@@ -60,9 +60,9 @@ PetscErrorCode MeshBase::destroy()
     info = std::string();
 
     type::IntVec1D().swap(nProc);
-    type::IntVec2D().swap(bg);
-    type::IntVec2D().swap(ed);
-    type::IntVec2D().swap(m);
+    bg.clear();
+    ed.clear();
+    m.clear();
     UNLocal = pNLocal = 0;
 
     comm = MPI_COMM_NULL;
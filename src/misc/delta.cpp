@@ -66,6 +66,14 @@ PetscReal delta(const std::vector<PetscReal> &source,
                 const std::vector<PetscReal> &target,
                 const std::vector<PetscReal> &widths,
                 const DeltaKernel &kernel)
+{
+    return delta(source.data(), target.data(), widths, kernel);
+}  // delta
+
+// Discrete delta function (raw pointers to the coordinates).
+PetscReal delta(const PetscReal *source, const PetscReal *target,
+                const std::vector<PetscReal> &widths,
+                const DeltaKernel &kernel)
 {
     PetscReal phi = 1.0;
     for (unsigned int d = 0; d < widths.size(); ++d)
@@ -0,0 +1,245 @@
+/**
+ * \file energy.cpp
+ * \brief Implementation of the energy metering of logging stages.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <petibm/misc.h>
+
+namespace petibm
+{
+namespace misc
+{
+// a RAPL energy counter of the Linux powercap interface
+struct EnergyCounter
+{
+    std::string file;   // path of the file `energy_uj`
+    PetscReal range;    // value (in microjoules) at which the counter wraps
+    PetscReal last;     // last value read (in microjoules)
+    PetscInt domain;    // 0 for a package, 1 for DRAM
+};
+
+// energy metering: -1 if not initialized yet
+static PetscInt metering = -1;
+
+// counters read by this process (only the first process of each node has some)
+static std::vector<EnergyCounter> counters;
+
+// stack of the stages pushed through logStagePush
+static std::vector<PetscLogStage> stack;
+
+// names of the stages registered through logStageRegister
+static std::vector<std::string> stageNames(1, "Main Stage");
+
+// energy (in joules) of each stage, for packages and DRAM
+static std::vector<PetscReal> energy(2, 0.0);
+
+// read the content of a small text file; false if it can not be read
+template <typename T>
+static bool readValue(const std::string &file, T &value)
+{
+    std::ifstream in(file);
+    return bool(in >> value);
+}  // readValue
+
+// find the RAPL counters of the packages and of their DRAM sub-zones
+static void findCounters()
+{
+    const std::string root = "/sys/class/powercap/intel-rapl:";
+
+    for (PetscInt i = 0;; ++i)
+    {
+        std::string zone = root + std::to_string(i), name;
+        if (!readValue(zone + "/name", name)) break;
+
+        // the package zone, followed by its DRAM sub-zones (if any)
+        std::vector<std::string> zones(1, zone);
+        for (PetscInt j = 0;; ++j)
+        {
+            std::string sub = zone + ":" + std::to_string(j);
+            if (!readValue(sub + "/name", name)) break;
+            if (name == "dram") zones.push_back(sub);
+        }
+
+        for (unsigned int k = 0; k < zones.size(); ++k)
+        {
+            EnergyCounter c;
+            c.file = zones[k] + "/energy_uj";
+            c.domain = (k == 0) ? 0 : 1;
+            if (!readValue(zones[k] + "/max_energy_range_uj", c.range))
+                continue;
+            if (!readValue(c.file, c.last)) continue;
+            counters.push_back(c);
+        }
+    }
+}  // findCounters
+
+// add the energy consumed since the last reading to the current stage
+static void accumulateEnergy()
+{
+    PetscLogStage stage = stack.empty() ? 0 : stack.back();
+
+    if (energy.size() < std::size_t(2 * (stage + 1)))
+        energy.resize(2 * (stage + 1), 0.0);
+
+    for (auto &c : counters)
+    {
+        PetscReal value;
+        if (!readValue(c.file, value)) continue;
+
+        // the counters wrap around at their maximum range
+        PetscReal delta = value - c.last;
+        if (delta < 0.0) delta += c.range;
+        c.last = value;
+
+        energy[2 * stage + c.domain] += delta * 1.0e-6;
+    }
+}  // accumulateEnergy
+
+PetscErrorCode initEnergyMeter(const MPI_Comm &comm)
+{
+    PetscErrorCode ierr;
+    PetscBool flag = PETSC_FALSE;
+
+    PetscFunctionBeginUser;
+
+    if (metering >= 0) PetscFunctionReturn(0);
+
+    ierr = PetscOptionsGetBool(nullptr, nullptr, "-energy_log", &flag,
+                               nullptr); CHKERRQ(ierr);
+    metering = flag;
+    if (!metering) PetscFunctionReturn(0);
+
+    // only the first process of each node reads the counters of the node
+    MPI_Comm node;
+    PetscMPIInt nodeRank;
+    ierr = MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                               &node); CHKERRQ(ierr);
+    ierr = MPI_Comm_rank(node, &nodeRank); CHKERRQ(ierr);
+    ierr = MPI_Comm_free(&node); CHKERRQ(ierr);
+
+    if (nodeRank == 0) findCounters();
+
+    PetscFunctionReturn(0);
+}  // initEnergyMeter
+
+PetscErrorCode logStageRegister(const char name[], PetscLogStage *stage)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = PetscLogStageRegister(name, stage); CHKERRQ(ierr);
+
+    if (stageNames.size() < std::size_t(*stage + 1))
+        stageNames.resize(*stage + 1);
+    stageNames[*stage] = name;
+
+    PetscFunctionReturn(0);
+}  // logStageRegister
+
+PetscErrorCode logStagePush(const PetscLogStage &stage)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (metering > 0) accumulateEnergy();
+    stack.push_back(stage);
+
+    ierr = PetscLogStagePush(stage); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // logStagePush
+
+PetscErrorCode logStagePop()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (metering > 0) accumulateEnergy();
+    if (!stack.empty()) stack.pop_back();
+
+    ierr = PetscLogStagePop(); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // logStagePop
+
+PetscErrorCode writeEnergyLog(const MPI_Comm comm, const std::string &filePath,
+                              const PetscInt &nSteps)
+{
+    PetscErrorCode ierr;
+    PetscViewer viewer;
+
+    PetscFunctionBeginUser;
+
+    if (metering <= 0) PetscFunctionReturn(0);
+
+    // account for the energy of the current stage up to now
+    accumulateEnergy();
+
+    // sum over the nodes (processes without counters contribute zeros)
+    int nStages = stageNames.size(), nCounters = counters.size();
+    ierr = MPI_Allreduce(MPI_IN_PLACE, &nStages, 1, MPI_INT, MPI_MAX, comm);
+    CHKERRQ(ierr);
+    ierr = MPI_Allreduce(MPI_IN_PLACE, &nCounters, 1, MPI_INT, MPI_SUM, comm);
+    CHKERRQ(ierr);
+
+    std::vector<PetscReal> total(energy);
+    total.resize(2 * nStages, 0.0);
+    ierr = MPI_Allreduce(MPI_IN_PLACE, total.data(), PetscMPIInt(total.size()),
+                         MPIU_REAL, MPIU_SUM, comm); CHKERRQ(ierr);
+
+    ierr = PetscViewerCreate(comm, &viewer); CHKERRQ(ierr);
+    ierr = PetscViewerSetType(viewer, PETSCVIEWERASCII); CHKERRQ(ierr);
+    ierr = PetscViewerFileSetMode(viewer, FILE_MODE_WRITE); CHKERRQ(ierr);
+    ierr = PetscViewerFileSetName(viewer, filePath.c_str()); CHKERRQ(ierr);
+
+    if (nCounters == 0)
+    {
+        ierr = PetscViewerASCIIPrintf(
+            viewer, "No RAPL energy counters were found.\n"); CHKERRQ(ierr);
+        ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+        PetscFunctionReturn(0);
+    }
+
+    ierr = PetscViewerASCIIPrintf(
+        viewer, "Energy (in joules) summed over %D RAPL counters, %D time "
+                "steps\n\n", PetscInt(nCounters), nSteps); CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer, "%-20s %14s %14s %14s %14s\n",
+                                  "stage", "package", "DRAM", "total",
+                                  "per step"); CHKERRQ(ierr);
+
+    PetscReal sum[2] = {0.0, 0.0};
+    for (int s = 0; s < nStages; ++s)
+    {
+        PetscReal pkg = total[2 * s], dram = total[2 * s + 1];
+        std::string name = (std::size_t(s) < stageNames.size())
+                               ? stageNames[s] : std::to_string(s);
+        sum[0] += pkg;
+        sum[1] += dram;
+
+        ierr = PetscViewerASCIIPrintf(
+            viewer, "%-20s %14.6e %14.6e %14.6e %14.6e\n", name.c_str(), pkg,
+            dram, pkg + dram, (nSteps > 0) ? (pkg + dram) / nSteps : 0.0);
+        CHKERRQ(ierr);
+    }
+
+    ierr = PetscViewerASCIIPrintf(
+        viewer, "%-20s %14.6e %14.6e %14.6e %14.6e\n", "all stages", sum[0],
+        sum[1], sum[0] + sum[1],
+        (nSteps > 0) ? (sum[0] + sum[1]) / nSteps : 0.0); CHKERRQ(ierr);
+
+    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // writeEnergyLog
+
+}  // end of namespace misc
+}  // end of namespace petibm
@@ -94,15 +94,16 @@ PetscErrorCode LinInterpBase::init(const MPI_Comm &inComm,
 PetscErrorCode LinInterpBase::getBLGridlineIndices(const type::Mesh &mesh,
                                                    const type::Field &field)
 {
+    PetscErrorCode ierr;
+
     PetscFunctionBeginUser;
 
-    std::vector<PetscReal>::iterator low;
+    // index of the last gridline point strictly smaller than the target
     for (PetscInt d = 0; d < mesh->dim; ++d)
     {
-        type::RealVec1D line(mesh->coord[field][d],
-                             mesh->coord[field][d] + mesh->n[field][d]);
-        low = std::lower_bound(line.begin(), line.end(), target[d]);
-        idxDirs[d] = low - line.begin() - 1;
+        ierr = mesh->locate(field, d, target[d], idxDirs[d]); CHKERRQ(ierr);
+        if (idxDirs[d] >= 0 && mesh->coord[field][d][idxDirs[d]] == target[d])
+            idxDirs[d] -= 1;
     }
 
     PetscFunctionReturn(0);
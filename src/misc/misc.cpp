@@ -145,9 +145,9 @@ PetscErrorCode getGhostPointList(const type::Mesh &mesh,
     ierr = getPerpendAxes(axis, pAxes); CHKERRQ(ierr);
 
     // alias
-    const type::IntVec1D &bg = mesh->bg[field];
-    const type::IntVec1D &ed = mesh->ed[field];
-    const type::IntVec1D &n = mesh->n[field];
+    const PetscInt *bg = mesh->bg[field];
+    const PetscInt *ed = mesh->ed[field];
+    const PetscInt *n = mesh->n[field];
     const type::GhostedVec2D &dL = mesh->dL[field];
     const type::GhostedVec2D &coord = mesh->coord[field];
 
@@ -215,7 +215,7 @@ PetscErrorCode getPerpendAxes(const PetscInt &self, type::IntVec1D &pAxes)
             break;
         default:
             SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
-                     "Can not recongnize axis %d in the function "
+                     "Can not recongnize axis %D in the function "
                      "getPerpendAxes!",
                      self);
     }
@@ -12,6 +12,7 @@
 #include <petscdmcomposite.h>
 #include <petscviewerhdf5.h>
 
+#include <petibm/misc.h>
 #include <petibm/probes.h>
 
 namespace petibm
@@ -160,7 +161,7 @@ ProbeVolume::ProbeVolume(const MPI_Comm &comm,
 }  // ProbeVolume::ProbeVolume
 
 // Initialize the probe.
-PetscErrorCode ProbeVolume::init(const MPI_Comm &comm,
+PetscErrorCode ProbeVolume::init(const MPI_Comm &inComm,
                                  const YAML::Node &node,
                                  const type::Mesh &mesh)
 {
@@ -168,7 +169,12 @@ PetscErrorCode ProbeVolume::init(const MPI_Comm &comm,
 
     PetscFunctionBeginUser;
 
-    ierr = ProbeBase::init(comm, node, mesh); CHKERRQ(ierr);
+    isNatural = PETSC_NULL;
+    svec = PETSC_NULL;
+    dvec = PETSC_NULL;
+    ownComm = PETSC_FALSE;
+
+    ierr = ProbeBase::init(inComm, node, mesh); CHKERRQ(ierr);
 
     // store information about the type of PETSc Viewer object to use
     std::string vtype_str = node["viewer"].as<std::string>("ascii");
@@ -182,12 +188,8 @@ PetscErrorCode ProbeVolume::init(const MPI_Comm &comm,
     // data are added together and we write the time averaged data
     n_sum = node["n_sum"].as<PetscInt>(0);
 
-    isPetsc = PETSC_NULL;
-    isNatural = PETSC_NULL;
-    dvec = PETSC_NULL;
-
     // store information about the sub-volume to monitor
-    box = type::RealVec2D(3, type::RealVec1D(2, 0.0));
+    box = type::RealArray2D(3, 2, 0.0);
     for (auto item : node["box"])
     {
         type::Dir dir = type::str2dir[item.first.as<std::string>()];
@@ -200,6 +202,12 @@ PetscErrorCode ProbeVolume::init(const MPI_Comm &comm,
 
     // get information about the location of the sub-mesh
     ierr = getInfo(mesh, box); CHKERRQ(ierr);
+
+    // create a PETSc Index Set objects to the sub-vector of interest;
+    // from now on, the probe only involves the processes owning its points
+    ierr = createIS(mesh); CHKERRQ(ierr);
+    if (comm == MPI_COMM_NULL) PetscFunctionReturn(0);
+
     // create gridline coordinates for the sub-mesh
     ierr = createGrid(mesh); CHKERRQ(ierr);
     // write the sub-mesh to file
@@ -213,11 +221,13 @@ PetscErrorCode ProbeVolume::init(const MPI_Comm &comm,
     ierr = PetscViewerFileSetMode(viewer, FILE_MODE_APPEND); CHKERRQ(ierr);
     ierr = PetscViewerFileSetName(viewer, path.c_str()); CHKERRQ(ierr);
 
-    // create a PETSc Index Set objects to the sub-vector of interest
-    ierr = createIS(mesh); CHKERRQ(ierr);
     // write Index Set (natural ordering) to file
     ierr = writeIS(path); CHKERRQ(ierr);
 
+    // create the vector holding the values in the sub-volume
+    ierr = VecCreateMPI(comm, lclIdx.size(), PETSC_DETERMINE,
+                        &svec); CHKERRQ(ierr);
+
     PetscFunctionReturn(0);
 }  // ProbeVolume::init
 
@@ -228,32 +238,39 @@ PetscErrorCode ProbeVolume::destroy()
 
     PetscFunctionBeginUser;
 
+    // the sub-communicator is owned by the probe (only once it was split)
+    MPI_Comm subComm = (ownComm) ? comm : MPI_COMM_NULL;
+    ownComm = PETSC_FALSE;
+
     ierr = ProbeBase::destroy(); CHKERRQ(ierr);
-    if (isPetsc != PETSC_NULL) {ierr = ISDestroy(&isPetsc); CHKERRQ(ierr);}
     if (isNatural != PETSC_NULL) {ierr = ISDestroy(&isNatural); CHKERRQ(ierr);}
+    if (svec != PETSC_NULL) {ierr = VecDestroy(&svec); CHKERRQ(ierr);}
     if (dvec != PETSC_NULL) {ierr = VecDestroy(&dvec); CHKERRQ(ierr);}
+    type::IntVec1D().swap(lclIdx);
+    if (subComm != MPI_COMM_NULL)
+    {
+        ierr = MPI_Comm_free(&subComm); CHKERRQ(ierr);
+    }
 
     PetscFunctionReturn(0);
 }  // ProbeVolume::destroy
 
 // Get information about the sub-mesh area to monitor.
 PetscErrorCode ProbeVolume::getInfo(const type::Mesh &mesh,
-                                    const type::RealVec2D &box)
+                                    const type::RealArray2D &box)
 {
-    std::vector<PetscReal>::iterator low, up;
-
     PetscFunctionBeginUser;
 
     // get the starting index along a gridline and the number of points
     // for each direction of the sub-mesh
     for (PetscInt d = 0; d < mesh->dim; ++d)
     {
-        type::RealVec1D line(mesh->coord[field][d],
-                             mesh->coord[field][d] + mesh->n[field][d]);
-        low = std::lower_bound(line.begin(), line.end(), box[d][0] - atol);
-        up = std::upper_bound(line.begin(), line.end(), box[d][1] + atol);
-        startIdxDir[d] = low - line.begin();
-        nPtsDir[d] = up - line.begin() - startIdxDir[d];
+        const PetscReal *line = mesh->coord[field][d],
+                        *end = line + mesh->n[field][d];
+        const PetscReal *low = std::lower_bound(line, end, box[d][0] - atol);
+        const PetscReal *up = std::upper_bound(line, end, box[d][1] + atol);
+        startIdxDir[d] = low - line;
+        nPtsDir[d] = up - line - startIdxDir[d];
     }
 
     // get the number of points in the sub-volume
@@ -263,7 +280,8 @@ PetscErrorCode ProbeVolume::getInfo(const type::Mesh &mesh,
     PetscFunctionReturn(0);
 }  // ProbeVolume::getInfo
 
-// Create the index sets (PETSc and natural ordering) of the points to monitor.
+// Create the index set (natural ordering) of the points to monitor and the
+// sub-communicator of the processes that own them.
 PetscErrorCode ProbeVolume::createIS(const type::Mesh &mesh)
 {
     PetscErrorCode ierr;
@@ -272,8 +290,7 @@ PetscErrorCode ProbeVolume::createIS(const type::Mesh &mesh)
 
     DMDALocalInfo info;
     ierr = DMDAGetLocalInfo(mesh->da[field], &info); CHKERRQ(ierr);
-    std::vector<PetscInt> indices(nPts);
-    PetscInt count = 0;
+    std::vector<PetscInt> indices;
     for (PetscInt k = info.zs; k < info.zs + info.zm; ++k)
     {
         for (PetscInt j = info.ys; j < info.ys + info.ym; ++j)
@@ -284,26 +301,44 @@ PetscErrorCode ProbeVolume::createIS(const type::Mesh &mesh)
                     j >= startIdxDir[1] && j < startIdxDir[1] + nPtsDir[1] &&
                     k >= startIdxDir[2] && k < startIdxDir[2] + nPtsDir[2])
                 {
-                    indices[count] = k * (info.my * info.mx) + j * info.mx + i;
-                    count++;
+                    // natural index, to post-process the sub-volume
+                    indices.push_back(k * (info.my * info.mx) +
+                                      j * info.mx + i);
+                    // index in the local part of the field vector
+                    lclIdx.push_back(
+                        ((k - info.zs) * info.ym + (j - info.ys)) * info.xm +
+                        i - info.xs);
                 }
             }
         }
     }
-    indices.resize(count);
-
-    // AO will map `indices` from natural ordering to PETSc ordering.
-    // However, we need to keep the vector with natural-ordering indices
-    // so we can post-process the solution in the sub-volume.
-    std::vector<PetscInt> indices2(indices);
-
-    AO ao;
-    ierr = DMDAGetAO(mesh->da[field], &ao); CHKERRQ(ierr);
-    ierr = AOApplicationToPetsc(ao, count, &indices[0]); CHKERRQ(ierr);
-    ierr = ISCreateGeneral(comm, count, &indices[0],
-                           PETSC_COPY_VALUES, &isPetsc); CHKERRQ(ierr);
+
+    // offset of the field in the local part of the solution vector
+    // (the velocity components are packed one after the other)
+    offset = 0;
+    for (PetscInt f = 0; (field < mesh->dim) && (f < field); ++f)
+    {
+        DMDALocalInfo fInfo;
+        ierr = DMDAGetLocalInfo(mesh->da[f], &fInfo); CHKERRQ(ierr);
+        offset += fInfo.xm * fInfo.ym * fInfo.zm;
+    }
+
+    // gather the processes owning points of the volume (in the same order)
+    MPI_Comm subComm;
+    PetscMPIInt color = (lclIdx.size() > 0) ? 0 : MPI_UNDEFINED;
+    ierr = MPI_Comm_split(comm, color, commRank, &subComm); CHKERRQ(ierr);
+    comm = subComm;
+    ownComm = (comm != MPI_COMM_NULL) ? PETSC_TRUE : PETSC_FALSE;
+    if (comm == MPI_COMM_NULL)
+    {
+        commSize = commRank = 0;
+        PetscFunctionReturn(0);
+    }
+    ierr = MPI_Comm_size(comm, &commSize); CHKERRQ(ierr);
+    ierr = MPI_Comm_rank(comm, &commRank); CHKERRQ(ierr);
+
     // Create IS containing the (natural )index of the points in the sub-volume.
-    ierr = ISCreateGeneral(comm, count, &indices2[0],
+    ierr = ISCreateGeneral(comm, indices.size(), indices.data(),
                            PETSC_COPY_VALUES, &isNatural); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
@@ -483,7 +518,44 @@ PetscErrorCode ProbeVolume::writeIS_ASCII(const std::string &filePath)
     PetscFunctionReturn(0);
 }  // ProbeVolume::writeIS_ASCII
 
-// Monitor a sub-region of the full-domain PETSc Vec object.
+// Monitor the field solution on the processes owning points of the volume.
+PetscErrorCode ProbeVolume::monitor(const type::Solution &solution,
+                                    const type::Mesh &mesh,
+                                    const PetscInt &n,
+                                    const PetscReal &t)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    // the process does not own any point of the volume
+    if (comm == MPI_COMM_NULL) PetscFunctionReturn(0);
+
+    // monitor only if appropriate time-step index and appropriate time
+    if (n % n_monitor == 0 && t >= t_start && t <= t_end)
+    {
+        // the local values are read in the solution vector itself; no
+        // operation is collective over the communicator of the solution
+        if (field < mesh->dim)  // monitor a component of the velocity field
+        {
+            ierr = monitorVec(mesh->da[field], solution->UGlobal,
+                              n, t); CHKERRQ(ierr);
+        }
+        else if (field == 3)  // monitor the pressure field
+        {
+            ierr = monitorVec(mesh->da[3], solution->pGlobal,
+                              n, t); CHKERRQ(ierr);
+        }
+        else
+            SETERRQ(comm, PETSC_ERR_SUP,
+                    "Unsupported field. Supported fields are:\n"
+                    "\t u (0), v (1), w (2), and p (3).");
+    }
+
+    PetscFunctionReturn(0);
+}  // ProbeVolume::monitor
+
+// Monitor a sub-region of the PETSc Vec object holding the field.
 PetscErrorCode ProbeVolume::monitorVec(const DM &da,
                                        const Vec &fvec,
                                        const PetscInt &n,
@@ -493,9 +565,15 @@ PetscErrorCode ProbeVolume::monitorVec(const DM &da,
 
     PetscFunctionBeginUser;
 
-    // grab the part of the vector that corresponds to the sub-volume
-    Vec svec;
-    ierr = VecGetSubVector(fvec, isPetsc, &svec); CHKERRQ(ierr);
+    // copy the local values in the sub-volume into the sub-vector
+    const PetscReal *farray;
+    PetscReal *sarray;
+    ierr = VecGetArrayRead(fvec, &farray); CHKERRQ(ierr);
+    ierr = VecGetArray(svec, &sarray); CHKERRQ(ierr);
+    for (std::size_t c = 0; c < lclIdx.size(); ++c)
+        sarray[c] = farray[offset + lclIdx[c]];
+    ierr = VecRestoreArray(svec, &sarray); CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(fvec, &farray); CHKERRQ(ierr);
     if (n_sum != 0)  // we accumulate the data over the time-steps
     {
         if (dvec == PETSC_NULL)
@@ -518,7 +596,6 @@ PetscErrorCode ProbeVolume::monitorVec(const DM &da,
     {
         ierr = writeVec(svec, t); CHKERRQ(ierr);
     }
-    ierr = VecRestoreSubVector(fvec, isPetsc, &svec); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // ProbeVolume::monitorVec
@@ -580,7 +657,7 @@ PetscErrorCode ProbeVolume::writeVec_ASCII(const Vec &vec, const PetscReal &t)
     ierr = PetscViewerASCIIPrintf(viewer, "\nt = %e\n", t); CHKERRQ(ierr);
     if (count != 0)  // write number of time-steps accumulated
     {
-        ierr = PetscViewerASCIIPrintf(viewer, "count = %d\n", count); CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPrintf(viewer, "count = %D\n", count); CHKERRQ(ierr);
     }
     ierr = VecView(vec, viewer); CHKERRQ(ierr);
     ierr = PetscViewerPopFormat(viewer); CHKERRQ(ierr);
@@ -635,9 +712,6 @@ PetscErrorCode ProbePoint::init(const MPI_Comm &comm,
         ierr = createLinInterp(PETSC_COMM_SELF,
                                loc, mesh, field, interp); CHKERRQ(ierr);
     }
-    // create a local vector that will have ghost-point values
-    ierr = DMCreateLocalVector(mesh->da[field], &svec); CHKERRQ(ierr);
-
     PetscFunctionReturn(0);
 }  // ProbePoint::init
 
@@ -653,7 +727,6 @@ PetscErrorCode ProbePoint::destroy()
     {
         ierr = interp->destroy(); CHKERRQ(ierr);
     }
-    ierr = VecDestroy(&svec); CHKERRQ(ierr);
 
     PetscFunctionReturn(0);
 }  // ProbePoint::destroy
@@ -668,6 +741,10 @@ PetscErrorCode ProbePoint::monitorVec(const DM &da,
 
     PetscFunctionBeginUser;
 
+    // borrow a local vector that will have ghost-point values
+    Vec svec;
+    ierr = getWorkVec(da, PETSC_TRUE, svec); CHKERRQ(ierr);
+
     // scatter values to local vector
     ierr = DMGlobalToLocalBegin(da, fvec, INSERT_VALUES, svec); CHKERRQ(ierr);
     ierr = DMGlobalToLocalEnd(da, fvec, INSERT_VALUES, svec); CHKERRQ(ierr);
@@ -680,6 +757,8 @@ PetscErrorCode ProbePoint::monitorVec(const DM &da,
         ierr = PetscViewerFileSetMode(viewer, FILE_MODE_APPEND); CHKERRQ(ierr);
     }
 
+    ierr = restoreWorkVec(da, PETSC_TRUE, svec); CHKERRQ(ierr);
+
     PetscFunctionReturn(0);
 }  // ProbePoint::monitorVec
 
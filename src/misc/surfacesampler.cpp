@@ -0,0 +1,600 @@
+/**
+ * \file surfacesampler.cpp
+ * \brief Implementations of the surface sampler and factory function.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <map>
+
+#include <petscviewerhdf5.h>
+
+#include <petibm/operators.h>
+#include <petibm/singlebody.h>
+#include <petibm/surfacesampler.h>
+
+namespace  // anonymous namespace for internal linkage only
+{
+// get the unit eigenvector of the smallest eigenvalue of a symmetric 2x2 or
+// 3x3 matrix; false if the direction is not well defined
+bool smallestEigenvector(const PetscInt &dim, const PetscReal C[3][3],
+                         PetscReal n[3])
+{
+    PetscReal tr = C[0][0] + C[1][1] + ((dim == 3) ? C[2][2] : 0.0);
+    if (tr <= 0.0) return false;
+
+    n[0] = n[1] = n[2] = 0.0;
+
+    if (dim == 2)
+    {
+        PetscReal a = C[0][0], b = C[0][1], c = C[1][1];
+        PetscReal lambda = 0.5 * (a + c) - std::hypot(0.5 * (a - c), b);
+        PetscReal v[2][2] = {{b, lambda - a}, {lambda - c, b}};
+        PetscReal norms[2] = {std::hypot(v[0][0], v[0][1]),
+                              std::hypot(v[1][0], v[1][1])};
+        PetscInt k = (norms[0] >= norms[1]) ? 0 : 1;
+        if (norms[k] <= 1.0e-6 * tr) return false;
+        n[0] = v[k][0] / norms[k];
+        n[1] = v[k][1] / norms[k];
+        return true;
+    }
+
+    // smallest eigenvalue (trigonometric solution of the characteristic
+    // equation of a symmetric matrix)
+    PetscReal q = tr / 3.0;
+    PetscReal p1 = C[0][1] * C[0][1] + C[0][2] * C[0][2] + C[1][2] * C[1][2];
+    PetscReal p2 = (C[0][0] - q) * (C[0][0] - q) +
+                   (C[1][1] - q) * (C[1][1] - q) +
+                   (C[2][2] - q) * (C[2][2] - q) + 2.0 * p1;
+    PetscReal p = std::sqrt(p2 / 6.0);
+    if (p <= 1.0e-12 * tr) return false;
+
+    PetscReal B[3][3];
+    for (PetscInt i = 0; i < 3; ++i)
+        for (PetscInt j = 0; j < 3; ++j)
+            B[i][j] = (C[i][j] - ((i == j) ? q : 0.0)) / p;
+    PetscReal r = 0.5 * (B[0][0] * (B[1][1] * B[2][2] - B[1][2] * B[2][1]) -
+                         B[0][1] * (B[1][0] * B[2][2] - B[1][2] * B[2][0]) +
+                         B[0][2] * (B[1][0] * B[2][1] - B[1][1] * B[2][0]));
+    r = std::min(std::max(r, PetscReal(-1.0)), PetscReal(1.0));
+    PetscReal lambda =
+        q + 2.0 * p * std::cos(std::acos(r) / 3.0 + 2.0 * PETSC_PI / 3.0);
+
+    // the eigenvector is orthogonal to the rows of C - lambda I
+    PetscReal M[3][3];
+    for (PetscInt i = 0; i < 3; ++i)
+        for (PetscInt j = 0; j < 3; ++j)
+            M[i][j] = C[i][j] - ((i == j) ? lambda : 0.0);
+
+    PetscReal best = 0.0;
+    const PetscInt pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (auto &pr : pairs)
+    {
+        const PetscReal *a = M[pr[0]], *b = M[pr[1]];
+        PetscReal c[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
+                          a[0] * b[1] - a[1] * b[0]};
+        PetscReal norm = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]);
+        if (norm > best)
+        {
+            best = norm;
+            for (PetscInt d = 0; d < 3; ++d) n[d] = c[d] / norm;
+        }
+    }
+
+    return (best > 1.0e-6 * tr * tr);
+}  // smallestEigenvector
+}  // end of anonymous namespace
+
+namespace petibm
+{
+namespace misc
+{
+// Factory function to create a sampler of the surface of a body.
+PetscErrorCode createSurfaceSampler(const MPI_Comm &comm,
+                                    const YAML::Node &node,
+                                    const type::Mesh &mesh,
+                                    const type::Boundary &bc,
+                                    const type::BodyPack &bodies,
+                                    type::SurfaceSampler &sampler)
+{
+    PetscFunctionBeginUser;
+
+    sampler = std::make_shared<SurfaceSampler>(comm, node, mesh, bc, bodies);
+
+    PetscFunctionReturn(0);
+}  // createSurfaceSampler
+
+// Constructor. Initialize the sampler.
+SurfaceSampler::SurfaceSampler(const MPI_Comm &comm, const YAML::Node &node,
+                               const type::Mesh &mesh,
+                               const type::Boundary &bc,
+                               const type::BodyPack &bodies)
+{
+    init(comm, node, mesh, bc, bodies);
+}  // SurfaceSampler::SurfaceSampler
+
+// Destructor.
+SurfaceSampler::~SurfaceSampler()
+{
+    PetscErrorCode ierr;
+    PetscBool finalized;
+
+    PetscFunctionBeginUser;
+
+    ierr = PetscFinalized(&finalized); CHKERRV(ierr);
+    if (finalized) return;
+
+    ierr = destroy(); CHKERRV(ierr);
+}  // SurfaceSampler::~SurfaceSampler
+
+// Manually destroy data in the object.
+PetscErrorCode SurfaceSampler::destroy()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = MatDestroy(&P); CHKERRQ(ierr);
+    ierr = MatDestroy(&GU); CHKERRQ(ierr);
+    ierr = VecDestroy(&grad); CHKERRQ(ierr);
+    for (auto &v : values)
+    {
+        ierr = VecDestroy(&v); CHKERRQ(ierr);
+    }
+    values.clear();
+    ierr = VecScatterDestroy(&toFile); CHKERRQ(ierr);
+    ierr = VecDestroy(&fileValues); CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer); CHKERRQ(ierr);
+    type::RealVec2D().swap(points);
+    type::RealVec2D().swap(normals);
+    mesh.reset();
+    bc.reset();
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::destroy
+
+// Initialize the sampler.
+PetscErrorCode SurfaceSampler::init(const MPI_Comm &inComm,
+                                    const YAML::Node &node,
+                                    const type::Mesh &inMesh,
+                                    const type::Boundary &inBc,
+                                    const type::BodyPack &bodies)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    comm = inComm;
+    ierr = MPI_Comm_rank(comm, &commRank); CHKERRQ(ierr);
+    mesh = inMesh;
+    bc = inBc;
+
+    P = GU = PETSC_NULL;
+    grad = PETSC_NULL;
+    toFile = PETSC_NULL;
+    fileValues = PETSC_NULL;
+    viewer = PETSC_NULL;
+
+    // find the body to sample
+    std::string bodyName = node["body"].as<std::string>();
+    body = -1;
+    for (PetscInt i = 0; i < bodies->nBodies; ++i)
+        if (bodies->bodies[i]->name == bodyName) body = i;
+    if (body < 0)
+        SETERRQ1(comm, PETSC_ERR_ARG_WRONG,
+                 "The body \"%s\" to sample does not exist.\n",
+                 bodyName.c_str());
+
+    // store information about what to sample and when to sample
+    name = node["name"].as<std::string>(bodyName);
+    path = node["path"].as<std::string>();
+    n_monitor = node["n_monitor"].as<PetscInt>(1);
+    t_start = node["t_start"].as<PetscReal>(0.0);
+    t_end = node["t_end"].as<PetscReal>(1e12);
+    offset = node["offset"].as<PetscReal>(0.0);
+    if (!(offset >= 0.0) || std::isinf(offset))
+        SETERRQ2(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                 "The offset of the sampler \"%s\" must be a non-negative "
+                 "distance (got %g).\n", name.c_str(), (double)offset);
+    shear = node["shear"].as<bool>(true) ? PETSC_TRUE : PETSC_FALSE;
+    moving = PETSC_FALSE;
+
+    ierr = delta::getKernel(node["delta"].as<std::string>("ROMA_ET_AL_1999"),
+                            kernel, kernelSize); CHKERRQ(ierr);
+
+    // sampling points, normals, and interpolation operators
+    ierr = createPoints(bodies, PETSC_TRUE); CHKERRQ(ierr);
+    ierr = createFileOrder(bodies); CHKERRQ(ierr);
+
+    // keep the samples of a previous run when restarting
+    PetscMPIInt exists = 0;
+    if (commRank == 0) exists = std::ifstream(path).good() ? 1 : 0;
+    ierr = MPI_Bcast(&exists, 1, MPI_INT, 0, comm); CHKERRQ(ierr);
+
+    ierr = PetscViewerCreate(comm, &viewer); CHKERRQ(ierr);
+    ierr = PetscViewerSetType(viewer, PETSCVIEWERHDF5); CHKERRQ(ierr);
+    ierr = PetscViewerFileSetMode(
+        viewer, (exists) ? FILE_MODE_APPEND : FILE_MODE_WRITE); CHKERRQ(ierr);
+    ierr = PetscViewerFileSetName(viewer, path.c_str()); CHKERRQ(ierr);
+
+    ierr = writePoints(""); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::init
+
+// Declare the body as moving.
+PetscErrorCode SurfaceSampler::setMoving(const PetscBool &flag)
+{
+    PetscFunctionBeginUser;
+
+    moving = flag;
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::setMoving
+
+// Compute the sampling points and the normals, and create the operators.
+PetscErrorCode SurfaceSampler::createPoints(const type::BodyPack &bodies,
+                                            const PetscBool &strict)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    const type::SingleBody &b = bodies->bodies[body];
+    const PetscInt &dim = mesh->dim;
+
+    // centroid of the body
+    PetscReal c[3] = {0.0, 0.0, 0.0};
+    for (PetscInt i = 0; i < b->nPts; ++i)
+        for (PetscInt d = 0; d < dim; ++d) c[d] += b->coords[i][d] / b->nPts;
+
+    // the neighborhood of a point extends over two widths of its cell
+    type::RealVec1D radius(b->nLclPts, 0.0);
+    PetscReal rMax = 0.0;
+    for (PetscInt k = 0; k < b->nLclPts; ++k)
+    {
+        const PetscReal *X = b->coords[b->bgPt + k];
+        for (PetscInt d = 0; d < dim; ++d)
+        {
+            PetscInt idx;
+            ierr = mesh->locate(4, d, X[d], idx); CHKERRQ(ierr);
+            idx = std::min(std::max(idx, PetscInt(0)), mesh->n[3][d] - 1);
+            radius[k] = std::max(radius[k], 2.0 * mesh->dL[3][d][idx]);
+        }
+        rMax = std::max(rMax, radius[k]);
+    }
+
+    // bucket the points of the body in cubes as wide as the largest radius
+    typedef std::array<PetscInt, 3> Key;
+    auto getKey = [this, rMax](const PetscReal *X) -> Key {
+        Key key = {0, 0, 0};
+        for (PetscInt d = 0; d < mesh->dim; ++d)
+            key[d] = PetscInt(std::floor((X[d] - mesh->min[d]) / rMax));
+        return key;
+    };
+    std::map<Key, type::IntVec1D> buckets;
+    if (b->nLclPts > 0)
+        for (PetscInt i = 0; i < b->nPts; ++i)
+            buckets[getKey(b->coords[i])].push_back(i);
+
+    points.assign(b->nLclPts, type::RealVec1D(dim, 0.0));
+    normals.assign(b->nLclPts, type::RealVec1D(dim, 0.0));
+    const PetscInt zRange = (dim == 3) ? 1 : 0;
+    for (PetscInt k = 0; k < b->nLclPts; ++k)
+    {
+        const PetscReal *X = b->coords[b->bgPt + k];
+        Key key = getKey(X);
+
+        // covariance of the positions of the neighbors
+        PetscInt m = 0;
+        PetscReal mean[3] = {0.0, 0.0, 0.0}, C[3][3] = {{0.0}};
+        for (PetscInt oz = -zRange; oz <= zRange; ++oz)
+            for (PetscInt oy = -1; oy <= 1; ++oy)
+                for (PetscInt ox = -1; ox <= 1; ++ox)
+                {
+                    Key nb = {key[0] + ox, key[1] + oy, key[2] + oz};
+                    auto it = buckets.find(nb);
+                    if (it == buckets.end()) continue;
+
+                    for (auto j : it->second)
+                    {
+                        PetscReal dx[3] = {0.0, 0.0, 0.0}, r2 = 0.0;
+                        for (PetscInt d = 0; d < dim; ++d)
+                        {
+                            dx[d] = b->coords[j][d] - X[d];
+                            r2 += dx[d] * dx[d];
+                        }
+                        if (r2 > radius[k] * radius[k]) continue;
+
+                        ++m;
+                        for (PetscInt d = 0; d < dim; ++d)
+                        {
+                            mean[d] += dx[d];
+                            for (PetscInt e = 0; e < dim; ++e)
+                                C[d][e] += dx[d] * dx[e];
+                        }
+                    }
+                }
+        for (PetscInt d = 0; d < dim; ++d)
+            for (PetscInt e = 0; e < dim; ++e)
+                C[d][e] = C[d][e] / m - (mean[d] / m) * (mean[e] / m);
+
+        // the normal is the direction of least variance; fall back on the
+        // direction from the centroid for isolated or aligned neighbors
+        PetscReal n[3] = {0.0, 0.0, 0.0}, dot = 0.0;
+        if ((m <= dim) || !smallestEigenvector(dim, C, n))
+        {
+            PetscReal norm = 0.0;
+            for (PetscInt d = 0; d < dim; ++d)
+            {
+                n[d] = X[d] - c[d];
+                norm += n[d] * n[d];
+            }
+            norm = std::sqrt(norm);
+            if (norm > 0.0)
+                for (PetscInt d = 0; d < dim; ++d) n[d] /= norm;
+            else
+                n[0] = 1.0;
+        }
+
+        // orient the normal away from the centroid
+        for (PetscInt d = 0; d < dim; ++d) dot += n[d] * (X[d] - c[d]);
+        PetscReal sign = (dot < 0.0) ? -1.0 : 1.0;
+
+        for (PetscInt d = 0; d < dim; ++d)
+        {
+            normals[k][d] = sign * n[d];
+            points[k][d] = X[d] + offset * normals[k][d];
+        }
+    }
+    ierr = placePoints(strict); CHKERRQ(ierr);
+
+    // interpolation operators at the sampling points
+    ierr = MatDestroy(&P); CHKERRQ(ierr);
+    ierr = petibm::operators::createPressureSampling(
+        mesh, bc, points, kernel, kernelSize, P); CHKERRQ(ierr);
+    if (shear)
+    {
+        ierr = MatDestroy(&GU); CHKERRQ(ierr);
+        ierr = petibm::operators::createVelocityGradientSampling(
+            mesh, bc, points, kernel, kernelSize, GU); CHKERRQ(ierr);
+    }
+
+    // the distribution of the points does not change when the body moves
+    if (values.size() == 0)
+    {
+        values.resize(1 + ((shear) ? dim : 0));
+        for (auto &v : values)
+        {
+            ierr = MatCreateVecs(P, nullptr, &v); CHKERRQ(ierr);
+        }
+        if (shear)
+        {
+            ierr = MatCreateVecs(GU, nullptr, &grad); CHKERRQ(ierr);
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::createPoints
+
+// Keep the sampling points inside of the domain.
+PetscErrorCode SurfaceSampler::placePoints(const PetscBool &strict)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    PetscInt nOutside = 0;
+    for (auto &X : points)
+    {
+        PetscBool outside = PETSC_FALSE;
+        for (PetscInt d = 0; d < mesh->dim; ++d)
+        {
+            const PetscReal &lo = mesh->min[d], &hi = mesh->max[d];
+            if ((X[d] >= lo) && (X[d] <= hi)) continue;
+
+            if (mesh->periodic[0][d])
+            {
+                X[d] = lo + std::fmod(X[d] - lo, hi - lo);
+                if (X[d] < lo) X[d] += hi - lo;
+                continue;
+            }
+
+            // center of the nearest cell
+            outside = PETSC_TRUE;
+            X[d] = (X[d] < lo) ? mesh->coord[3][d][0]
+                               : mesh->coord[3][d][mesh->n[3][d] - 1];
+        }
+        if (outside) ++nOutside;
+    }
+
+    ierr = MPI_Allreduce(MPI_IN_PLACE, &nOutside, 1, MPIU_INT, MPI_SUM, comm);
+    CHKERRQ(ierr);
+    if (nOutside == 0) PetscFunctionReturn(0);
+
+    if (strict)
+        SETERRQ3(comm, PETSC_ERR_ARG_OUTOFRANGE,
+                 "The offset %g of the sampler \"%s\" puts %D sampling "
+                 "points outside of the domain.\n", (double)offset,
+                 name.c_str(), nOutside);
+
+    ierr = PetscPrintf(comm,
+                       "Warning: %D sampling points of \"%s\" left the "
+                       "domain and are sampled in the nearest cells.\n",
+                       nOutside, name.c_str()); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::placePoints
+
+// Create the scatter permuting the sampled values to the order of the file.
+PetscErrorCode SurfaceSampler::createFileOrder(const type::BodyPack &bodies)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    const type::SingleBody &b = bodies->bodies[body];
+
+    // the points are stored in the order of the file
+    if (b->order.size() == 0) PetscFunctionReturn(0);
+
+    // the local sampling points are the local Lagrangian points
+    type::IntVec1D idxFile(b->nLclPts);
+    for (PetscInt k = 0; k < b->nLclPts; ++k)
+        idxFile[k] = b->order[b->bgPt + k];
+
+    IS isMem, isFile;
+    ierr = ISCreateStride(PETSC_COMM_SELF, b->nLclPts, b->bgPt, 1, &isMem);
+    CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, b->nLclPts, idxFile.data(),
+                           PETSC_COPY_VALUES, &isFile); CHKERRQ(ierr);
+    ierr = VecDuplicate(values[0], &fileValues); CHKERRQ(ierr);
+    ierr = VecScatterCreate(values[0], isMem, fileValues, isFile, &toFile);
+    CHKERRQ(ierr);
+    ierr = ISDestroy(&isMem); CHKERRQ(ierr);
+    ierr = ISDestroy(&isFile); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::createFileOrder
+
+// Sample the pressure and the traction and write them to file.
+PetscErrorCode SurfaceSampler::monitor(const type::BodyPack &bodies,
+                                       const Vec &U, const Vec &p,
+                                       const PetscReal &nu, const PetscInt &n,
+                                       const PetscReal &t)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    // sample only at the appropriate time-step index and time
+    if ((n % n_monitor != 0) || (t < t_start) || (t > t_end))
+        PetscFunctionReturn(0);
+
+    std::string step = std::to_string(n);
+
+    if (moving)
+    {
+        ierr = createPoints(bodies, PETSC_FALSE); CHKERRQ(ierr);
+        ierr = writePoints(step); CHKERRQ(ierr);
+    }
+
+    // pressure
+    ierr = MatMult(P, p, values[0]); CHKERRQ(ierr);
+    ierr = writeVec("p", step, values[0]); CHKERRQ(ierr);
+    ierr = PetscViewerHDF5WriteAttribute(
+        viewer, ("/p/" + step).c_str(), "time", PETSC_REAL, &t); CHKERRQ(ierr);
+
+    if (!shear) PetscFunctionReturn(0);
+
+    // viscous traction from the interpolated gradient of the velocity
+    const PetscInt &dim = mesh->dim;
+    ierr = MatMult(GU, U, grad); CHKERRQ(ierr);
+
+    const PetscReal *g;
+    std::vector<PetscReal *> traction(dim);
+    ierr = VecGetArrayRead(grad, &g); CHKERRQ(ierr);
+    for (PetscInt i = 0; i < dim; ++i)
+    {
+        ierr = VecGetArray(values[1 + i], &traction[i]); CHKERRQ(ierr);
+    }
+
+    for (std::size_t k = 0; k < points.size(); ++k)
+        for (PetscInt i = 0; i < dim; ++i)
+        {
+            traction[i][k] = 0.0;
+            for (PetscInt j = 0; j < dim; ++j)
+                traction[i][k] += nu * normals[k][j] *
+                                  (g[(k * dim + i) * dim + j] +
+                                   g[(k * dim + j) * dim + i]);
+        }
+
+    for (PetscInt i = 0; i < dim; ++i)
+    {
+        ierr = VecRestoreArray(values[1 + i], &traction[i]); CHKERRQ(ierr);
+    }
+    ierr = VecRestoreArrayRead(grad, &g); CHKERRQ(ierr);
+
+    const std::string groups[3] = {"tx", "ty", "tz"};
+    for (PetscInt i = 0; i < dim; ++i)
+    {
+        ierr = writeVec(groups[i], step, values[1 + i]); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::monitor
+
+// Write the sampling points and the normals.
+PetscErrorCode SurfaceSampler::writePoints(const std::string &dataset)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    const std::string names[2][3] = {{"x", "y", "z"}, {"nx", "ny", "nz"}};
+
+    Vec v;
+    ierr = VecDuplicate(values[0], &v); CHKERRQ(ierr);
+
+    for (PetscInt q = 0; q < 2; ++q)
+    {
+        const type::RealVec2D &data = (q == 0) ? points : normals;
+        for (PetscInt d = 0; d < mesh->dim; ++d)
+        {
+            PetscReal *a;
+            ierr = VecGetArray(v, &a); CHKERRQ(ierr);
+            for (std::size_t k = 0; k < data.size(); ++k) a[k] = data[k][d];
+            ierr = VecRestoreArray(v, &a); CHKERRQ(ierr);
+
+            if (dataset.empty())
+            {
+                ierr = writeVec("points", names[q][d], v); CHKERRQ(ierr);
+            }
+            else
+            {
+                ierr = writeVec(names[q][d], dataset, v); CHKERRQ(ierr);
+            }
+        }
+    }
+
+    ierr = VecDestroy(&v); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::writePoints
+
+// Write a vector of sampled values.
+PetscErrorCode SurfaceSampler::writeVec(const std::string &group,
+                                        const std::string &dataset,
+                                        const Vec &vec)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    // the values are written in the order of the body file
+    Vec out = vec;
+    if (toFile != PETSC_NULL)
+    {
+        ierr = VecScatterBegin(toFile, vec, fileValues, INSERT_VALUES,
+                               SCATTER_FORWARD); CHKERRQ(ierr);
+        ierr = VecScatterEnd(toFile, vec, fileValues, INSERT_VALUES,
+                             SCATTER_FORWARD); CHKERRQ(ierr);
+        out = fileValues;
+    }
+
+    ierr = PetscViewerHDF5PushGroup(
+        viewer, ("/" + group).c_str()); CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject)out, dataset.c_str());
+    CHKERRQ(ierr);
+    ierr = VecView(out, viewer); CHKERRQ(ierr);
+    ierr = PetscViewerHDF5PopGroup(viewer); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // SurfaceSampler::writeVec
+
+}  // end of namespace misc
+}  // end of namespace petibm
@@ -29,13 +29,15 @@ std::map<std::string, BCType> str2bt{{"NOBC", NOBC},
                                      {"DIRICHLET", DIRICHLET},
                                      {"NEUMANN", NEUMANN},
                                      {"CONVECTIVE", CONVECTIVE},
-                                     {"PERIODIC", PERIODIC}};
+                                     {"PERIODIC", PERIODIC},
+                                     {"SYMMETRY", SYMMETRY}};
 // default values of type::bt2str
 std::map<BCType, std::string> bt2str{{NOBC, "NOBC"},
                                      {DIRICHLET, "DIRICHLET"},
                                      {NEUMANN, "NEUMANN"},
                                      {CONVECTIVE, "CONVECTIVE"},
-                                     {PERIODIC, "PERIODIC"}};
+                                     {PERIODIC, "PERIODIC"},
+                                     {SYMMETRY, "SYMMETRY"}};
 
 // default values of type::str2bl
 std::map<std::string, BCLoc> str2bl{
@@ -0,0 +1,164 @@
+/**
+ * \file workspace.cpp
+ * \brief Implementation of the shared pool of work vectors.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <petibm/misc.h>
+
+namespace petibm
+{
+namespace misc
+{
+// work vectors of a DM (local or global) that are not lent
+struct WorkVecs
+{
+    std::vector<Vec> free;  // vectors available in the pool
+    PetscInt lent = 0;      // number of vectors currently borrowed
+};
+
+// the pool, keyed by DM and by the kind of vectors (local or global);
+// the pool holds a reference to each DM, so a key is never reused by
+// another DM while the entry exists
+static std::map<std::pair<DM, PetscBool>, WorkVecs> pool;
+
+// memory-lean mode: -1 if not checked yet
+static PetscInt leanMemory = -1;
+
+// true if clearWorkVecs is registered with PetscFinalize
+static bool registered = false;
+
+PetscErrorCode isLeanMemory(PetscBool &lean)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (leanMemory < 0)
+    {
+        PetscBool flag = PETSC_FALSE;
+        ierr = PetscOptionsGetBool(
+            nullptr, nullptr, "-lean_memory", &flag, nullptr); CHKERRQ(ierr);
+        leanMemory = flag;
+    }
+    lean = PetscBool(leanMemory);
+
+    PetscFunctionReturn(0);
+}  // isLeanMemory
+
+PetscErrorCode getWorkVec(const DM &dm, const PetscBool &local, Vec &vec)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    if (!registered)
+    {
+        ierr = PetscRegisterFinalize(clearWorkVecs); CHKERRQ(ierr);
+        registered = true;
+    }
+
+    auto key = std::make_pair(dm, local);
+    auto it = pool.find(key);
+    if (it == pool.end())
+    {
+        ierr = PetscObjectReference((PetscObject)dm); CHKERRQ(ierr);
+        it = pool.emplace(key, WorkVecs()).first;
+    }
+
+    WorkVecs &work = it->second;
+    if (work.free.empty())
+    {
+        if (local)
+        {
+            ierr = DMCreateLocalVector(dm, &vec); CHKERRQ(ierr);
+        }
+        else
+        {
+            ierr = DMCreateGlobalVector(dm, &vec); CHKERRQ(ierr);
+        }
+    }
+    else
+    {
+        vec = work.free.back();
+        work.free.pop_back();
+    }
+    work.lent += 1;
+
+    PetscFunctionReturn(0);
+}  // getWorkVec
+
+PetscErrorCode restoreWorkVec(const DM &dm, const PetscBool &local, Vec &vec)
+{
+    PetscErrorCode ierr;
+    PetscBool lean;
+
+    PetscFunctionBeginUser;
+
+    auto it = pool.find(std::make_pair(dm, local));
+    if (it == pool.end() || it->second.lent == 0)
+        SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_WRONGSTATE,
+                "The vector was not borrowed from the workspace pool\n");
+
+    WorkVecs &work = it->second;
+    work.lent -= 1;
+
+    ierr = isLeanMemory(lean); CHKERRQ(ierr);
+    if (lean)
+    {
+        ierr = VecDestroy(&vec); CHKERRQ(ierr);
+    }
+    else
+    {
+        work.free.push_back(vec);
+        vec = nullptr;
+    }
+
+    // release the DM once nothing of it is left in the pool
+    if (work.lent == 0 && work.free.empty())
+    {
+        DM da = it->first.first;
+        pool.erase(it);
+        ierr = DMDestroy(&da); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // restoreWorkVec
+
+PetscErrorCode clearWorkVecs()
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    for (auto it = pool.begin(); it != pool.end();)
+    {
+        for (auto &v : it->second.free)
+        {
+            ierr = VecDestroy(&v); CHKERRQ(ierr);
+        }
+        it->second.free.clear();
+
+        if (it->second.lent == 0)
+        {
+            DM da = it->first.first;
+            it = pool.erase(it);
+            ierr = DMDestroy(&da); CHKERRQ(ierr);
+        }
+        else
+            ++it;
+    }
+
+    // register again on the next use (needed after PetscFinalize)
+    registered = false;
+
+    PetscFunctionReturn(0);
+}  // clearWorkVecs
+
+}  // end of namespace misc
+}  // end of namespace petibm
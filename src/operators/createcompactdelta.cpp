@@ -0,0 +1,739 @@
+/**
+ * \file createcompactdelta.cpp
+ * \brief Definition of functions creating compact Delta operators.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+// STL
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// PETSc
+#include <petscmat.h>
+#include <petscvec.h>
+
+// PetIBM
+#include <petibm/bodypack.h>
+#include <petibm/boundary.h>
+#include <petibm/delta.h>
+#include <petibm/mesh.h>
+#include <petibm/singlebody.h>
+#include <petibm/type.h>
+
+namespace petibm
+{
+namespace operators
+{
+// defined in createdelta.cpp
+void getBoundaryFlags(const type::Mesh &mesh, const type::Boundary &bc,
+                      std::vector<bool> &periodic,
+                      std::vector<std::vector<bool>> &symmetric);
+
+// defined in createdelta.cpp
+bool getNeighbor(const type::Mesh &mesh, const PetscInt &dof,
+                 const PetscInt &d, const PetscInt &s,
+                 const std::vector<bool> &periodic,
+                 const std::vector<std::vector<bool>> &symmetric,
+                 PetscInt &idx, PetscReal &x, PetscReal &sign);
+}  // end of namespace operators
+}  // end of namespace petibm
+
+namespace  // anonymous namespace for internal linkage only
+{
+// the largest support of a kernel (in number of cells per direction)
+const PetscInt maxWidth = 8;
+
+// factorized weights of a Delta operator, shared by the operator, its
+// transpose, and their products
+struct CompactDeltaData
+{
+    petibm::type::Mesh mesh;
+
+    PetscInt dim;    // number of dimensions
+    PetscInt width;  // width of the support of the kernel (2 * window + 1)
+    PetscInt nRows;  // number of local rows (Lagrangian points x components)
+    PetscInt nRowsGlobal;  // number of rows
+
+    // 1D weights of each row, including the signs of mirrored neighbors
+    // (dim x width values per row)
+    std::vector<PetscReal> weights;
+
+    // coordinates of the neighbors of each row in the local box of its
+    // velocity field, per direction (dim x width values per row; -1 for
+    // neighbors outside the domain)
+    std::vector<PetscInt> coords;
+
+    // sizes of the local box of each velocity field (3 values per field);
+    // the box is the product of the indices touched in each direction
+    std::vector<PetscInt> boxSizes;
+
+    // position of the local box of each velocity field in the gathered
+    // vector
+    std::vector<PetscInt> boxOffsets;
+
+    // scatter gathering the touched velocity points into a sequential vector
+    VecScatter gather;
+
+    // values at the points of the local boxes (only the touched points are
+    // gathered)
+    Vec values;
+};
+
+// context of a compact Delta operator (or of its transpose)
+struct CompactDeltaCtx
+{
+    std::shared_ptr<CompactDeltaData> data;
+
+    // whether the operator is the transpose of the Delta operator
+    PetscBool transposed;
+
+    // diagonal scaling of the Lagrangian side (empty if none)
+    std::vector<PetscReal> rowScale;
+
+    // diagonal scaling of the touched velocity points (empty if none)
+    std::vector<PetscReal> pointScale;
+};
+
+// context of the product of a compact Delta operator and of its transpose
+struct CompactProductCtx
+{
+    Mat A;    // compact Delta operator
+    Mat B;    // compact transposed Delta operator
+    Vec tmp;  // velocity vector holding the product B x
+};
+
+// a private function visiting the non-zero entries of a local row; the
+// visitor receives the position of the velocity point in the gathered vector
+// and the weight
+template <typename Visitor>
+inline void visitRow(const CompactDeltaData &data, const PetscInt &r,
+                     Visitor visit)
+{
+    const PetscInt f = r % data.dim;  // velocity component of the row
+    const PetscInt *c = &data.coords[r * data.dim * data.width];
+    const PetscReal *w = &data.weights[r * data.dim * data.width];
+
+    const PetscInt nx = data.boxSizes[3 * f], ny = data.boxSizes[3 * f + 1];
+    const PetscInt nk = (data.dim == 3) ? data.width : 1;
+    const PetscInt *cx = c, *cy = c + data.width,
+                   *cz = (data.dim == 3) ? c + 2 * data.width : nullptr;
+    const PetscReal *wx = w, *wy = w + data.width,
+                    *wz = (data.dim == 3) ? w + 2 * data.width : nullptr;
+
+    for (PetscInt k = 0; k < nk; ++k)
+    {
+        PetscReal wk = (data.dim == 3) ? wz[k] : 1.0;
+        if (wk == 0.0) continue;
+        PetscInt pk = (data.dim == 3) ? cz[k] * ny : 0;
+        for (PetscInt j = 0; j < data.width; ++j)
+        {
+            if (wy[j] == 0.0) continue;
+            PetscInt pj = data.boxOffsets[f] + (pk + cy[j]) * nx;
+            for (PetscInt i = 0; i < data.width; ++i)
+            {
+                if (wx[i] == 0.0) continue;
+                visit(pj + cx[i], wx[i] * wy[j] * wk);
+            }
+        }
+    }
+}  // visitRow
+
+// a private function applying the Delta operator: y (+)= Delta x
+PetscErrorCode applyDelta(const CompactDeltaCtx *ctx, const Vec &x,
+                          const Vec &y, const PetscBool &add)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    const CompactDeltaData &data = *ctx->data;
+    const PetscReal *v;
+    PetscReal *yArry;
+
+    // gather the values of the touched velocity points
+    ierr = VecScatterBegin(data.gather, x, data.values, INSERT_VALUES,
+                           SCATTER_FORWARD); CHKERRQ(ierr);
+    ierr = VecScatterEnd(data.gather, x, data.values, INSERT_VALUES,
+                         SCATTER_FORWARD); CHKERRQ(ierr);
+
+    ierr = VecGetArrayRead(data.values, &v); CHKERRQ(ierr);
+    ierr = VecGetArray(y, &yArry); CHKERRQ(ierr);
+
+    for (PetscInt r = 0; r < data.nRows; ++r)
+    {
+        PetscReal sum = 0.0;
+        visitRow(data, r, [&](const PetscInt &pos, const PetscReal &w) {
+            sum += w * v[pos] *
+                   (ctx->pointScale.empty() ? 1.0 : ctx->pointScale[pos]);
+        });
+        if (!ctx->rowScale.empty()) sum *= ctx->rowScale[r];
+        yArry[r] = add ? yArry[r] + sum : sum;
+    }
+
+    ierr = VecRestoreArray(y, &yArry); CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(data.values, &v); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // applyDelta
+
+// a private function applying the transposed Delta operator:
+// y (+)= Delta^T x
+PetscErrorCode applyDeltaTranspose(const CompactDeltaCtx *ctx, const Vec &x,
+                                   const Vec &y, const PetscBool &add)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    const CompactDeltaData &data = *ctx->data;
+    const PetscReal *xArry;
+    PetscReal *v;
+
+    // spread the local rows onto the touched velocity points
+    ierr = VecSet(data.values, 0.0); CHKERRQ(ierr);
+    ierr = VecGetArrayRead(x, &xArry); CHKERRQ(ierr);
+    ierr = VecGetArray(data.values, &v); CHKERRQ(ierr);
+
+    for (PetscInt r = 0; r < data.nRows; ++r)
+    {
+        PetscReal xr = xArry[r] * (ctx->rowScale.empty() ? 1.0
+                                                         : ctx->rowScale[r]);
+        if (xr == 0.0) continue;
+        visitRow(data, r, [&](const PetscInt &pos, const PetscReal &w) {
+            v[pos] += w * xr;
+        });
+    }
+
+    if (!ctx->pointScale.empty())
+        for (std::size_t i = 0; i < ctx->pointScale.size(); ++i)
+            v[i] *= ctx->pointScale[i];
+
+    ierr = VecRestoreArray(data.values, &v); CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(x, &xArry); CHKERRQ(ierr);
+
+    // sum up the contributions of all processes
+    if (!add)
+    {
+        ierr = VecSet(y, 0.0); CHKERRQ(ierr);
+    }
+    ierr = VecScatterBegin(data.gather, data.values, y, ADD_VALUES,
+                           SCATTER_REVERSE); CHKERRQ(ierr);
+    ierr = VecScatterEnd(data.gather, data.values, y, ADD_VALUES,
+                         SCATTER_REVERSE); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // applyDeltaTranspose
+
+// a private function for the MatMult and MatMultTranspose of compact Delta
+// operators
+template <bool transpose>
+PetscErrorCode CompactDeltaMult(Mat mat, Vec x, Vec y)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactDeltaCtx *ctx;
+
+    ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
+
+    if (bool(ctx->transposed) != transpose)
+    {
+        ierr = applyDeltaTranspose(ctx, x, y, PETSC_FALSE); CHKERRQ(ierr);
+    }
+    else
+    {
+        ierr = applyDelta(ctx, x, y, PETSC_FALSE); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // CompactDeltaMult
+
+// a private function for the MatMultAdd and MatMultTransposeAdd of compact
+// Delta operators
+template <bool transpose>
+PetscErrorCode CompactDeltaMultAdd(Mat mat, Vec x, Vec y, Vec z)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactDeltaCtx *ctx;
+
+    ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
+
+    if (z != y)
+    {
+        ierr = VecCopy(y, z); CHKERRQ(ierr);
+    }
+
+    if (bool(ctx->transposed) != transpose)
+    {
+        ierr = applyDeltaTranspose(ctx, x, z, PETSC_TRUE); CHKERRQ(ierr);
+    }
+    else
+    {
+        ierr = applyDelta(ctx, x, z, PETSC_TRUE); CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // CompactDeltaMultAdd
+
+// a private function multiplying a scaling by the local values of a vector
+// (the values of the touched velocity points if gathered)
+PetscErrorCode scale(const CompactDeltaData &data, const Vec &vec,
+                     const PetscBool &gathered, std::vector<PetscReal> &s)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    const PetscReal *arry;
+    Vec src = vec;
+
+    if (gathered)
+    {
+        ierr = VecScatterBegin(data.gather, vec, data.values, INSERT_VALUES,
+                               SCATTER_FORWARD); CHKERRQ(ierr);
+        ierr = VecScatterEnd(data.gather, vec, data.values, INSERT_VALUES,
+                             SCATTER_FORWARD); CHKERRQ(ierr);
+        src = data.values;
+    }
+
+    PetscInt n;
+    ierr = VecGetLocalSize(src, &n); CHKERRQ(ierr);
+    if (s.empty()) s.assign(n, 1.0);
+
+    ierr = VecGetArrayRead(src, &arry); CHKERRQ(ierr);
+    for (PetscInt i = 0; i < n; ++i) s[i] *= arry[i];
+    ierr = VecRestoreArrayRead(src, &arry); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // scale
+
+// a private function for the MatDiagonalScale of compact Delta operators
+PetscErrorCode CompactDeltaDiagonalScale(Mat mat, Vec left, Vec right)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactDeltaCtx *ctx;
+
+    ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
+
+    // the velocity side is on the left of the transposed operator
+    if (left)
+    {
+        ierr = scale(*ctx->data, left, ctx->transposed,
+                     ctx->transposed ? ctx->pointScale : ctx->rowScale);
+        CHKERRQ(ierr);
+    }
+    if (right)
+    {
+        ierr = scale(*ctx->data, right, PetscBool(!ctx->transposed),
+                     ctx->transposed ? ctx->rowScale : ctx->pointScale);
+        CHKERRQ(ierr);
+    }
+
+    PetscFunctionReturn(0);
+}  // CompactDeltaDiagonalScale
+
+// a private function for the destroying of compact Delta operators
+PetscErrorCode CompactDeltaDestroy(Mat mat)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactDeltaCtx *ctx;
+
+    ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
+
+    // the last operator using the weights destroys the PETSc objects
+    if (ctx->data.use_count() == 1)
+    {
+        ierr = VecScatterDestroy(&ctx->data->gather); CHKERRQ(ierr);
+        ierr = VecDestroy(&ctx->data->values); CHKERRQ(ierr);
+    }
+
+    delete ctx;
+
+    PetscFunctionReturn(0);
+}  // CompactDeltaDestroy
+
+// a private function creating a shell matrix from the context of a compact
+// Delta operator
+PetscErrorCode createCompactShell(CompactDeltaCtx *ctx, Mat &Op)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    const CompactDeltaData &data = *ctx->data;
+
+    // sizes of the Delta operator, swapped for its transpose
+    PetscInt m = data.nRows, n = data.mesh->UNLocal,
+             M = data.nRowsGlobal, N = data.mesh->UN;
+    if (ctx->transposed)
+    {
+        std::swap(m, n);
+        std::swap(M, N);
+    }
+
+    ierr = MatCreateShell(data.mesh->comm, m, n, M, N, (void *)ctx, &Op);
+    CHKERRQ(ierr);
+
+    ierr = MatShellSetOperation(Op, MATOP_MULT,
+                                (void (*)(void))CompactDeltaMult<false>);
+    CHKERRQ(ierr);
+    ierr = MatShellSetOperation(Op, MATOP_MULT_TRANSPOSE,
+                                (void (*)(void))CompactDeltaMult<true>);
+    CHKERRQ(ierr);
+    ierr = MatShellSetOperation(Op, MATOP_MULT_ADD,
+                                (void (*)(void))CompactDeltaMultAdd<false>);
+    CHKERRQ(ierr);
+    ierr = MatShellSetOperation(Op, MATOP_MULT_TRANSPOSE_ADD,
+                                (void (*)(void))CompactDeltaMultAdd<true>);
+    CHKERRQ(ierr);
+    ierr = MatShellSetOperation(Op, MATOP_DIAGONAL_SCALE,
+                                (void (*)(void))CompactDeltaDiagonalScale);
+    CHKERRQ(ierr);
+    ierr = MatShellSetOperation(Op, MATOP_DESTROY,
+                                (void (*)(void))CompactDeltaDestroy);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createCompactShell
+
+// a private function for the MatMult of the product of compact operators
+PetscErrorCode CompactProductMult(Mat mat, Vec x, Vec y)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactProductCtx *ctx;
+
+    ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
+
+    ierr = MatMult(ctx->B, x, ctx->tmp); CHKERRQ(ierr);
+    ierr = MatMult(ctx->A, ctx->tmp, y); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // CompactProductMult
+
+// a private function for the MatGetDiagonal of the product of compact
+// operators; the diagonal is needed by Jacobi preconditioners
+PetscErrorCode CompactProductGetDiagonal(Mat mat, Vec diag)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactProductCtx *ctx;
+    CompactDeltaCtx *a, *b;
+    PetscReal *dArry;
+
+    ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
+    ierr = MatShellGetContext(ctx->A, (void *)&a); CHKERRQ(ierr);
+    ierr = MatShellGetContext(ctx->B, (void *)&b); CHKERRQ(ierr);
+
+    const CompactDeltaData &data = *a->data;
+
+    // entries of a row, as pairs of a velocity point and a weight
+    const PetscInt nk = (data.dim == 3) ? data.width : 1;
+    std::vector<std::pair<PetscInt, PetscReal>> entries;
+    entries.reserve(data.width * data.width * nk);
+
+    // (A B)_rr = sA_r sB_r sum_c Delta_rc^2 sA_c sB_c
+    ierr = VecGetArray(diag, &dArry); CHKERRQ(ierr);
+    for (PetscInt r = 0; r < data.nRows; ++r)
+    {
+        // next to a symmetry plane, a velocity point and its mirror image
+        // are visited separately: merge the weights of a point before
+        // squaring them
+        entries.clear();
+        visitRow(data, r, [&](const PetscInt &pos, const PetscReal &w) {
+            entries.emplace_back(pos, w);
+        });
+        std::sort(entries.begin(), entries.end());
+
+        PetscReal sum = 0.0;
+        for (std::size_t e = 0; e < entries.size();)
+        {
+            const PetscInt pos = entries[e].first;
+            PetscReal w = 0.0;
+            for (; e < entries.size() && entries[e].first == pos; ++e)
+                w += entries[e].second;
+            sum += w * w *
+                   (a->pointScale.empty() ? 1.0 : a->pointScale[pos]) *
+                   (b->pointScale.empty() ? 1.0 : b->pointScale[pos]);
+        }
+        if (!a->rowScale.empty()) sum *= a->rowScale[r];
+        if (!b->rowScale.empty()) sum *= b->rowScale[r];
+        dArry[r] = sum;
+    }
+    ierr = VecRestoreArray(diag, &dArry); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // CompactProductGetDiagonal
+
+// a private function for the destroying of the product of compact operators
+PetscErrorCode CompactProductDestroy(Mat mat)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactProductCtx *ctx;
+
+    ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
+
+    ierr = MatDestroy(&ctx->A); CHKERRQ(ierr);
+    ierr = MatDestroy(&ctx->B); CHKERRQ(ierr);
+    ierr = VecDestroy(&ctx->tmp); CHKERRQ(ierr);
+
+    delete ctx;
+
+    PetscFunctionReturn(0);
+}  // CompactProductDestroy
+}  // end of anonymous namespace
+
+namespace petibm
+{
+namespace operators
+{
+// implementation of petibm::operators::createCompactDelta
+PetscErrorCode createCompactDelta(const type::Mesh &mesh,
+                                  const type::Boundary &bc,
+                                  const type::BodyPack &bodies,
+                                  const delta::DeltaKernel &kernel,
+                                  const PetscInt &kernelSize, Mat &Op)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    std::shared_ptr<CompactDeltaData> data =
+        std::make_shared<CompactDeltaData>();
+
+    std::vector<bool> periodic;
+    std::vector<std::vector<bool>> symmetric;
+
+    data->mesh = mesh;
+    getBoundaryFlags(mesh, bc, periodic, symmetric);
+    data->dim = mesh->dim;
+    data->width = 2 * kernelSize + 1;
+    data->nRows = bodies->nLclPts * bodies->dim;
+    data->nRowsGlobal = bodies->nPts * bodies->dim;
+
+    if (data->width > maxWidth)
+        SETERRQ1(mesh->comm, PETSC_ERR_ARG_OUTOFRANGE,
+                 "The support of the kernel is too wide (%D cells) for "
+                 "compact Delta operators.\n", data->width);
+
+    const PetscInt rowSize = data->dim * data->width;
+    data->weights.assign(data->nRows * rowSize, 0.0);
+    data->coords.assign(data->nRows * rowSize, -1);
+
+    // loop through all bodies; local rows are packed body by body, then
+    // point by point, then component by component; the mesh indices of the
+    // neighbors are stored until they are mapped to the local boxes
+    PetscInt r = 0;
+    for (PetscInt bIdx = 0; bIdx < bodies->nBodies; ++bIdx)
+    {
+        // get an alias of the current body (for code readability)
+        const type::SingleBody &body = bodies->bodies[bIdx];
+
+        // get the cell widths of the background mesh
+        // (the regularized delta functions work for uniform meshes)
+        std::vector<PetscReal> widths(mesh->dim);
+        for (PetscInt d = 0; d < mesh->dim; ++d)
+            widths[d] = mesh->dL[0][d][body->meshIdx[0][d]];
+
+        for (PetscInt iLcl = 0, iGlb = body->bgPt; iLcl < body->nLclPts;
+             iLcl++, iGlb++)
+        {
+            const PetscInt *IJK = body->meshIdx[iLcl];
+            const PetscReal *XYZ = body->coords[iGlb];
+
+            for (PetscInt dof = 0; dof < body->dim; ++dof, ++r)
+            {
+                PetscReal *w = &data->weights[r * rowSize];
+                PetscInt *c = &data->coords[r * rowSize];
+
+                // the Delta function is the product of 1D kernels
+                for (PetscInt d = 0; d < mesh->dim; ++d)
+                    for (PetscInt o = 0; o < data->width; ++o)
+                    {
+                        PetscInt idx;
+                        PetscReal x, sign;
+                        if (getNeighbor(mesh, dof, d, IJK[d] - kernelSize + o,
+                                        periodic, symmetric, idx, x, sign))
+                        {
+                            w[d * data->width + o] =
+                                sign * kernel(XYZ[d] - x, widths[d]);
+                            c[d * data->width + o] = idx;
+                        }
+                    }
+            }
+        }
+    }
+
+    // sorted mesh indices touched by the local rows, per field and direction
+    std::vector<std::vector<type::IntVec1D>> touched(
+        data->dim, std::vector<type::IntVec1D>(data->dim));
+    for (PetscInt i = 0; i < data->nRows * rowSize; ++i)
+        if (data->weights[i] != 0.0)
+            touched[(i / rowSize) % data->dim][(i % rowSize) / data->width]
+                .push_back(data->coords[i]);
+
+    data->boxSizes.assign(3 * data->dim, 1);
+    data->boxOffsets.assign(data->dim + 1, 0);
+    for (PetscInt f = 0; f < data->dim; ++f)
+    {
+        for (PetscInt d = 0; d < data->dim; ++d)
+        {
+            type::IntVec1D &t = touched[f][d];
+            std::sort(t.begin(), t.end());
+            t.erase(std::unique(t.begin(), t.end()), t.end());
+            data->boxSizes[3 * f + d] = t.size();
+        }
+        data->boxOffsets[f + 1] = data->boxOffsets[f] +
+                                  data->boxSizes[3 * f] *
+                                      data->boxSizes[3 * f + 1] *
+                                      data->boxSizes[3 * f + 2];
+    }
+
+    // map the mesh indices of the neighbors to coordinates in the boxes
+    for (PetscInt i = 0; i < data->nRows * rowSize; ++i)
+    {
+        if (data->weights[i] == 0.0) continue;
+        const type::IntVec1D &t =
+            touched[(i / rowSize) % data->dim][(i % rowSize) / data->width];
+        data->coords[i] =
+            std::lower_bound(t.begin(), t.end(), data->coords[i]) - t.begin();
+    }
+
+    // positions of the touched velocity points in the boxes
+    type::IntVec1D positions;
+    for (PetscInt i = 0; i < data->nRows; ++i)
+        visitRow(*data, i, [&](const PetscInt &pos, const PetscReal &) {
+            positions.push_back(pos);
+        });
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()),
+                    positions.end());
+
+    // packed global indices of the touched velocity points
+    PetscInt nPoints = positions.size();
+    type::IntVec1D cols(nPoints);
+    for (PetscInt c = 0; c < nPoints; ++c)
+    {
+        PetscInt f = 0;
+        while (positions[c] >= data->boxOffsets[f + 1]) ++f;
+        PetscInt p = positions[c] - data->boxOffsets[f],
+                 nx = data->boxSizes[3 * f], ny = data->boxSizes[3 * f + 1];
+        PetscInt ijk[3] = {p % nx, (p / nx) % ny, p / (nx * ny)};
+        for (PetscInt d = 0; d < data->dim; ++d)
+            ijk[d] = touched[f][d][ijk[d]];
+        ierr = mesh->getPackedGlobalIndex(f, ijk[0], ijk[1], ijk[2], cols[c]);
+        CHKERRQ(ierr);
+    }
+
+    // create the scatter gathering the touched velocity points into the boxes
+    IS isFrom, isTo;
+    Vec U;
+    ierr = VecCreateSeq(PETSC_COMM_SELF, data->boxOffsets[data->dim],
+                        &data->values); CHKERRQ(ierr);
+    ierr = VecSet(data->values, 0.0); CHKERRQ(ierr);
+    ierr = VecCreateMPI(mesh->comm, mesh->UNLocal, mesh->UN, &U);
+    CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, nPoints, cols.data(),
+                           PETSC_COPY_VALUES, &isFrom); CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, nPoints, positions.data(),
+                           PETSC_COPY_VALUES, &isTo); CHKERRQ(ierr);
+    ierr = VecScatterCreate(U, isFrom, data->values, isTo, &data->gather);
+    CHKERRQ(ierr);
+    ierr = ISDestroy(&isTo); CHKERRQ(ierr);
+    ierr = ISDestroy(&isFrom); CHKERRQ(ierr);
+    ierr = VecDestroy(&U); CHKERRQ(ierr);
+
+    // create the matrix-free operator
+    CompactDeltaCtx *ctx = new CompactDeltaCtx;
+    ctx->data = data;
+    ctx->transposed = PETSC_FALSE;
+    ierr = createCompactShell(ctx, Op); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createCompactDelta
+
+// implementation of petibm::operators::createCompactDeltaTranspose
+PetscErrorCode createCompactDeltaTranspose(const Mat &Op, Mat &OpT)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactDeltaCtx *ctx;
+
+    ierr = MatShellGetContext(Op, (void *)&ctx); CHKERRQ(ierr);
+
+    // share the weights, but not the scalings
+    CompactDeltaCtx *ctxT = new CompactDeltaCtx;
+    ctxT->data = ctx->data;
+    ctxT->transposed = PetscBool(!ctx->transposed);
+    ierr = createCompactShell(ctxT, OpT); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createCompactDeltaTranspose
+
+// implementation of petibm::operators::createCompactDeltaProduct
+PetscErrorCode createCompactDeltaProduct(const Mat &A, const Mat &B,
+                                         Mat &AB)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    CompactDeltaCtx *a, *b;
+
+    ierr = MatShellGetContext(A, (void *)&a); CHKERRQ(ierr);
+    ierr = MatShellGetContext(B, (void *)&b); CHKERRQ(ierr);
+
+    const CompactDeltaData &data = *a->data;
+
+    if (a->transposed || !b->transposed || (a->data != b->data))
+        SETERRQ(data.mesh->comm, PETSC_ERR_ARG_INCOMP,
+                "The product of compact Delta operators needs a Delta "
+                "operator and a transpose sharing its weights.\n");
+
+    CompactProductCtx *ctx = new CompactProductCtx;
+    ctx->A = A;
+    ctx->B = B;
+    ierr = PetscObjectReference((PetscObject)A); CHKERRQ(ierr);
+    ierr = PetscObjectReference((PetscObject)B); CHKERRQ(ierr);
+    ierr = MatCreateVecs(A, &ctx->tmp, nullptr); CHKERRQ(ierr);
+
+    ierr = MatCreateShell(data.mesh->comm, data.nRows, data.nRows,
+                          data.nRowsGlobal, data.nRowsGlobal, (void *)ctx,
+                          &AB); CHKERRQ(ierr);
+    ierr = MatShellSetOperation(AB, MATOP_MULT,
+                                (void (*)(void))CompactProductMult);
+    CHKERRQ(ierr);
+    ierr = MatShellSetOperation(AB, MATOP_GET_DIAGONAL,
+                                (void (*)(void))CompactProductGetDiagonal);
+    CHKERRQ(ierr);
+    ierr = MatShellSetOperation(AB, MATOP_DESTROY,
+                                (void (*)(void))CompactProductDestroy);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createCompactDeltaProduct
+
+}  // end of namespace operators
+}  // end of namespace petibm
@@ -8,14 +8,17 @@
 // TODO: investigate if exact interpolation is necessary
 
 // STL
+#include <array>
 #include <memory>
 
 // PETSc
 #include <petscmat.h>
+#include <petscvec.h>
 
 // PetIBM
 #include <petibm/boundary.h>
 #include <petibm/mesh.h>
+#include <petibm/misc.h>
 
 namespace  // anonymous namespace for internal linkage only
 {
@@ -24,18 +27,47 @@ struct NonLinearCtx
 {
     const petibm::type::Mesh mesh;
     const petibm::type::Boundary bc;
-    std::vector<Vec> qLocal;
+
+    // scatters gathering the values read by the kernels into local vectors
+    std::vector<VecScatter> halo;
 
     NonLinearCtx(const petibm::type::Mesh &_mesh,
                  const petibm::type::Boundary &_bc)
-        : mesh(_mesh), bc(_bc), qLocal(_mesh->dim)
-    {
-        // create necessary local vectors
-        for (PetscInt f = 0; f < mesh->dim; ++f)
-            DMCreateLocalVector(mesh->da[f], &qLocal[f]);
-    };
+        : mesh(_mesh), bc(_bc), halo(_mesh->dim, PETSC_NULL){};
 };
 
+// a private function returning the offsets of the points of the field g that
+// are read by the kernel of the field f
+std::vector<std::array<PetscInt, 3>> getReadOffsets(const PetscInt &dim,
+                                                    const PetscInt &f,
+                                                    const PetscInt &g)
+{
+    std::vector<std::array<PetscInt, 3>> offsets(1, {{0, 0, 0}});
+
+    // a field reads its own face neighbors
+    if (f == g)
+    {
+        for (PetscInt d = 0; d < dim; ++d)
+            for (PetscInt s = -1; s <= 1; s += 2)
+            {
+                offsets.push_back({{0, 0, 0}});
+                offsets.back()[d] = s;
+            }
+        return offsets;
+    }
+
+    // another field is read at the corners of the face of the control volume
+    // normal to the direction g, in the plane of the directions f and g
+    offsets.resize(4, {{0, 0, 0}});
+    offsets[1][f] = 1;
+    offsets[2][g] = -1;
+    offsets[3][f] = 1;
+    offsets[3][g] = -1;
+
+    return offsets;
+}  // getReadOffsets
+
+
 // a private kernel for the convection at a u-velocity point in 2D.
 inline PetscReal kernelU(NonLinearCtx const *const &ctx,
                          const std::vector<PetscReal **> &flux,
@@ -210,15 +242,32 @@ PetscErrorCode ConvectionMult2D(Mat mat, Vec x, Vec y)
 
     std::vector<PetscReal **> yArry(2);
 
+    std::vector<Vec> qLocal(2);
+
     // get the context
     ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
 
-    // get local (including overlapped points) values of x
-    ierr = DMCompositeScatterArray(ctx->mesh->UPack, x, ctx->qLocal.data());
-    CHKERRQ(ierr);
+    // borrow local vectors from the workspace pool
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = petibm::misc::getWorkVec(ctx->mesh->da[f], PETSC_TRUE,
+                                        qLocal[f]); CHKERRQ(ierr);
+    }
+
+    // gather the values of x read by the kernels into the local vectors
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = VecScatterBegin(ctx->halo[f], x, qLocal[f], INSERT_VALUES,
+                               SCATTER_FORWARD); CHKERRQ(ierr);
+    }
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = VecScatterEnd(ctx->halo[f], x, qLocal[f], INSERT_VALUES,
+                             SCATTER_FORWARD); CHKERRQ(ierr);
+    }
 
     // set the values of ghost points in local vectors
-    ierr = ctx->bc->copyValues2LocalVecs(ctx->qLocal); CHKERRQ(ierr);
+    ierr = ctx->bc->copyValues2LocalVecs(qLocal); CHKERRQ(ierr);
 
     // get unPacked vectors of y
     ierr = DMCompositeGetAccessArray(ctx->mesh->UPack, y, ctx->mesh->dim,
@@ -227,7 +276,7 @@ PetscErrorCode ConvectionMult2D(Mat mat, Vec x, Vec y)
     // get underlying data of Vecs
     for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
     {
-        ierr = DMDAVecGetArrayRead(ctx->mesh->da[f], ctx->qLocal[f], &xArry[f]);
+        ierr = DMDAVecGetArrayRead(ctx->mesh->da[f], qLocal[f], &xArry[f]);
         CHKERRQ(ierr);
 
         ierr = DMDAVecGetArray(ctx->mesh->da[f], unPacked[f], &yArry[f]);
@@ -247,7 +296,7 @@ PetscErrorCode ConvectionMult2D(Mat mat, Vec x, Vec y)
     // return underlying arrays of Vecs
     for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
     {
-        ierr = DMDAVecRestoreArrayRead(ctx->mesh->da[f], ctx->qLocal[f],
+        ierr = DMDAVecRestoreArrayRead(ctx->mesh->da[f], qLocal[f],
                                        &xArry[f]); CHKERRQ(ierr);
 
         ierr = DMDAVecRestoreArray(ctx->mesh->da[f], unPacked[f], &yArry[f]);
@@ -259,6 +308,13 @@ PetscErrorCode ConvectionMult2D(Mat mat, Vec x, Vec y)
                                          nullptr, unPacked.data());
     CHKERRQ(ierr);
 
+    // return local vectors to the workspace pool
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = petibm::misc::restoreWorkVec(ctx->mesh->da[f], PETSC_TRUE,
+                                            qLocal[f]); CHKERRQ(ierr);
+    }
+
     PetscFunctionReturn(0);
 }  // ConvectionMult2D
 
@@ -278,15 +334,32 @@ PetscErrorCode ConvectionMult3D(Mat mat, Vec x, Vec y)
 
     std::vector<PetscReal ***> yArry(3);
 
+    std::vector<Vec> qLocal(3);
+
     // get the context
     ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
 
-    // get local (including overlapped points) vectors of x
-    ierr = DMCompositeScatterArray(ctx->mesh->UPack, x, ctx->qLocal.data());
-    CHKERRQ(ierr);
+    // borrow local vectors from the workspace pool
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = petibm::misc::getWorkVec(ctx->mesh->da[f], PETSC_TRUE,
+                                        qLocal[f]); CHKERRQ(ierr);
+    }
+
+    // gather the values of x read by the kernels into the local vectors
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = VecScatterBegin(ctx->halo[f], x, qLocal[f], INSERT_VALUES,
+                               SCATTER_FORWARD); CHKERRQ(ierr);
+    }
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = VecScatterEnd(ctx->halo[f], x, qLocal[f], INSERT_VALUES,
+                             SCATTER_FORWARD); CHKERRQ(ierr);
+    }
 
     // set the values of ghost points in local vectors
-    ierr = ctx->bc->copyValues2LocalVecs(ctx->qLocal); CHKERRQ(ierr);
+    ierr = ctx->bc->copyValues2LocalVecs(qLocal); CHKERRQ(ierr);
 
     // get unPacked vectors of y
     ierr = DMCompositeGetAccessArray(ctx->mesh->UPack, y, ctx->mesh->dim,
@@ -295,7 +368,7 @@ PetscErrorCode ConvectionMult3D(Mat mat, Vec x, Vec y)
     // get underlying data of Vecs
     for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
     {
-        ierr = DMDAVecGetArrayRead(ctx->mesh->da[f], ctx->qLocal[f], &xArry[f]);
+        ierr = DMDAVecGetArrayRead(ctx->mesh->da[f], qLocal[f], &xArry[f]);
         CHKERRQ(ierr);
 
         ierr = DMDAVecGetArray(ctx->mesh->da[f], unPacked[f], &yArry[f]);
@@ -323,7 +396,7 @@ PetscErrorCode ConvectionMult3D(Mat mat, Vec x, Vec y)
     // return underlying arrays of Vecs
     for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
     {
-        ierr = DMDAVecRestoreArrayRead(ctx->mesh->da[f], ctx->qLocal[f],
+        ierr = DMDAVecRestoreArrayRead(ctx->mesh->da[f], qLocal[f],
                                        &xArry[f]); CHKERRQ(ierr);
 
         ierr = DMDAVecRestoreArray(ctx->mesh->da[f], unPacked[f], &yArry[f]);
@@ -335,6 +408,13 @@ PetscErrorCode ConvectionMult3D(Mat mat, Vec x, Vec y)
                                          nullptr, unPacked.data());
     CHKERRQ(ierr);
 
+    // return local vectors to the workspace pool
+    for (PetscInt f = 0; f < ctx->mesh->dim; ++f)
+    {
+        ierr = petibm::misc::restoreWorkVec(ctx->mesh->da[f], PETSC_TRUE,
+                                            qLocal[f]); CHKERRQ(ierr);
+    }
+
     PetscFunctionReturn(0);
 }  // ConvectionMult3D
 
@@ -351,10 +431,10 @@ PetscErrorCode ConvectionDestroy(Mat mat)
     // get the context
     ierr = MatShellGetContext(mat, (void *)&ctx); CHKERRQ(ierr);
 
-    // destroy qLocal
-    for (PetscInt f = 0; f < ctx->mesh->dim; f++)
+    // destroy the scatters
+    for (auto &scatter : ctx->halo)
     {
-        ierr = VecDestroy(&ctx->qLocal[f]); CHKERRQ(ierr);
+        ierr = VecScatterDestroy(&scatter); CHKERRQ(ierr);
     }
 
     // deallocate the memory space pointed by ctx
@@ -368,6 +448,102 @@ namespace petibm
 {
 namespace operators
 {
+// implementation of petibm::operators::createConvectionHalo
+PetscErrorCode createConvectionHalo(const type::Mesh &mesh,
+                                    std::vector<VecScatter> &halo)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    Vec global;
+
+    halo.assign(mesh->dim, PETSC_NULL);
+
+    ierr = misc::getWorkVec(mesh->UPack, PETSC_FALSE, global);
+    CHKERRQ(ierr);
+
+    for (PetscInt g = 0; g < mesh->dim; ++g)
+    {
+        PetscInt gs[3] = {0, 0, 0}, gm[3] = {1, 1, 1};
+        std::vector<PetscBool> needed;
+        std::vector<PetscInt> from, to;
+        IS isFrom, isTo;
+        Vec local;
+
+        ierr = DMDAGetGhostCorners(mesh->da[g], &gs[0], &gs[1], &gs[2], &gm[0],
+                                   &gm[1], &gm[2]); CHKERRQ(ierr);
+
+        // mark the points of the field g read by the kernels of all fields
+        needed.assign(gm[0] * gm[1] * gm[2], PETSC_FALSE);
+        for (PetscInt f = 0; f < mesh->dim; ++f)
+            for (const auto &o : getReadOffsets(mesh->dim, f, g))
+                for (PetscInt k = mesh->bg[f][2]; k < mesh->ed[f][2]; ++k)
+                    for (PetscInt j = mesh->bg[f][1]; j < mesh->ed[f][1]; ++j)
+                        for (PetscInt i = mesh->bg[f][0]; i < mesh->ed[f][0];
+                             ++i)
+                        {
+                            PetscInt p[3] = {i + o[0] - gs[0],
+                                             j + o[1] - gs[1],
+                                             k + o[2] - gs[2]};
+                            if ((p[0] < 0) || (p[0] >= gm[0]) || (p[1] < 0) ||
+                                (p[1] >= gm[1]) || (p[2] < 0) ||
+                                (p[2] >= gm[2]))
+                                continue;
+                            needed[(p[2] * gm[1] + p[1]) * gm[0] + p[0]] =
+                                PETSC_TRUE;
+                        }
+
+        // map the marked points to packed global and local indices
+        for (PetscInt k = gs[2]; k < gs[2] + gm[2]; ++k)
+            for (PetscInt j = gs[1]; j < gs[1] + gm[1]; ++j)
+                for (PetscInt i = gs[0]; i < gs[0] + gm[0]; ++i)
+                {
+                    PetscInt c =
+                        ((k - gs[2]) * gm[1] + (j - gs[1])) * gm[0] + i - gs[0];
+                    if (!needed[c]) continue;
+
+                    PetscInt p[3] = {i, j, k};
+                    PetscBool inside = PETSC_TRUE;
+                    for (PetscInt d = 0; d < mesh->dim; ++d)
+                    {
+                        if ((p[d] >= 0) && (p[d] < mesh->n[g][d])) continue;
+                        if (!mesh->periodic[d][d]) inside = PETSC_FALSE;
+                        p[d] = (p[d] + mesh->n[g][d]) % mesh->n[g][d];
+                    }
+                    if (!inside) continue;
+
+                    PetscInt gIdx, lIdx;
+                    ierr = mesh->getPackedGlobalIndex(g, p[0], p[1], p[2],
+                                                      gIdx); CHKERRQ(ierr);
+                    ierr = mesh->getLocalIndex(g, i, j, k, lIdx);
+                    CHKERRQ(ierr);
+                    from.push_back(gIdx);
+                    to.push_back(lIdx);
+                }
+
+        ierr = ISCreateGeneral(PETSC_COMM_SELF, from.size(), from.data(),
+                               PETSC_COPY_VALUES, &isFrom); CHKERRQ(ierr);
+        ierr = ISCreateGeneral(PETSC_COMM_SELF, to.size(), to.data(),
+                               PETSC_COPY_VALUES, &isTo); CHKERRQ(ierr);
+
+        ierr = misc::getWorkVec(mesh->da[g], PETSC_TRUE, local);
+        CHKERRQ(ierr);
+        ierr = VecScatterCreate(global, isFrom, local, isTo, &halo[g]);
+        CHKERRQ(ierr);
+        ierr = misc::restoreWorkVec(mesh->da[g], PETSC_TRUE, local);
+        CHKERRQ(ierr);
+
+        ierr = ISDestroy(&isFrom); CHKERRQ(ierr);
+        ierr = ISDestroy(&isTo); CHKERRQ(ierr);
+    }
+
+    ierr = misc::restoreWorkVec(mesh->UPack, PETSC_FALSE, global);
+    CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createConvectionHalo
+
 // implementation of petibm::operators::createConvection
 PetscErrorCode createConvection(const type::Mesh &mesh,
                                 const type::Boundary &bd, Mat &H)
@@ -387,6 +563,9 @@ PetscErrorCode createConvection(const type::Mesh &mesh,
     // allocate space for ctx
     ctx = new NonLinearCtx(mesh, bd);
 
+    // create the narrow halo exchanges of the kernels
+    ierr = createConvectionHalo(mesh, ctx->halo); CHKERRQ(ierr);
+
     // create a matrix-free operator
     ierr = MatCreateShell(mesh->comm, mesh->UNLocal, mesh->UNLocal, N, N,
                           (void *)ctx, &H); CHKERRQ(ierr);
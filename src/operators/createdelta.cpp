@@ -26,9 +26,79 @@ namespace operators
 // works
 
 PetscErrorCode getEulerianNeighbors(
-    const type::Mesh &mesh, const PetscInt &dof, const type::IntVec1D &IJK,
-    const std::vector<bool> &periodic, const PetscInt &window,
-    type::IntVec2D &ijk, type::RealVec2D &xyz);
+    const type::Mesh &mesh, const PetscInt &dof, const PetscInt *IJK,
+    const std::vector<bool> &periodic,
+    const std::vector<std::vector<bool>> &symmetric, const PetscInt &window,
+    type::IntVec2D &ijk, type::RealVec2D &xyz, type::RealVec2D &sign);
+
+// get the periodic and symmetry-plane flags of the velocity boundaries
+void getBoundaryFlags(const type::Mesh &mesh, const type::Boundary &bc,
+                      std::vector<bool> &periodic,
+                      std::vector<std::vector<bool>> &symmetric)
+{
+    periodic.assign(mesh->dim, false);
+    symmetric.assign(mesh->dim, std::vector<bool>(2, false));
+    for (PetscInt d = 0; d < mesh->dim; ++d)
+    {
+        // the the x-component of the velocity is periodic in a direction,
+        // so are the other components of the velocity
+        periodic[d] = (bc->bds[0][d * 2]->type == type::BCType::PERIODIC);
+        // same for symmetry planes, which are checked side by side
+        for (PetscInt side = 0; side < 2; ++side)
+            symmetric[d][side] =
+                (bc->bds[0][d * 2 + side]->type == type::BCType::SYMMETRY);
+    }
+}  // getBoundaryFlags
+
+// get the index, the coordinate, and the sign of the s-th grid point of the
+// field dof in the direction d, wrapped around periodic boundaries or mirrored
+// across symmetry planes; false if there is no such point
+bool getNeighbor(const type::Mesh &mesh, const PetscInt &dof,
+                 const PetscInt &d, const PetscInt &s,
+                 const std::vector<bool> &periodic,
+                 const std::vector<std::vector<bool>> &symmetric,
+                 PetscInt &idx, PetscReal &x, PetscReal &sign)
+{
+    const PetscInt &n = mesh->n[dof][d];
+
+    sign = 1.0;
+
+    if (s >= 0 && s < n)
+    {
+        idx = s;
+        x = mesh->coord[dof][d][s];
+    }
+    else if (periodic[d])
+    {
+        PetscReal L = mesh->max[d] - mesh->min[d];
+        idx = (s < 0) ? s + n : s - n;
+        x = mesh->coord[dof][d][s] + ((s < 0) ? -L : L);
+    }
+    else if (symmetric[d][(s < 0) ? 0 : 1])
+    {
+        // the neighbor is the image of an interior point across the
+        // symmetry plane; the normal velocity flips sign there
+        PetscReal plane;
+        if (s < 0)
+        {
+            plane = mesh->min[d];
+            idx = (dof == d) ? -2 - s : -1 - s;
+        }
+        else
+        {
+            plane = mesh->max[d];
+            idx = (dof == d) ? 2 * n - s : 2 * n - 1 - s;
+        }
+        // skip the normal velocity on the plane itself (always zero)
+        if (idx < 0 || idx >= n) return false;
+        x = 2.0 * plane - mesh->coord[dof][d][idx];
+        sign = (dof == d) ? -1.0 : 1.0;
+    }
+    else
+        return false;
+
+    return true;
+}  // getNeighbor
 
 // implementation of petibm::operators::createDelta
 PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
@@ -41,14 +111,10 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
 
     PetscErrorCode ierr;
 
-    // get periodic flags and domain sizes
-    std::vector<bool> periodic(mesh->dim);  // flags to check periodicity
-    for (PetscInt d = 0; d < mesh->dim; ++d)
-    {
-        // the the x-component of the velocity is periodic in a direction,
-        // so are the other components of the velocity
-        periodic[d] = (bc->bds[0][d]->type == type::BCType::PERIODIC);
-    }
+    // get periodic and symmetry-plane flags
+    std::vector<bool> periodic;  // flags to check periodicity
+    std::vector<std::vector<bool>> symmetric;
+    getBoundaryFlags(mesh, bc, periodic, symmetric);
 
     ierr = MatCreate(mesh->comm, &Op); CHKERRQ(ierr);
     ierr = MatSetSizes(Op, bodies->nLclPts * bodies->dim, mesh->UNLocal,
@@ -81,8 +147,8 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
              iLcl++, iGlb++)
         {
             // get alias of coordinates and background index of current point
-            const type::IntVec1D &IJK = body->meshIdx[iLcl];
-            const type::RealVec1D &XYZ = body->coords[iGlb];
+            const PetscInt *IJK = body->meshIdx[iLcl];
+            const PetscReal *XYZ = body->coords[iGlb];
 
             // loop through all directions
             for (PetscInt dof = 0; dof < body->dim; ++dof)
@@ -96,20 +162,21 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
                     bIdx, iGlb, dof, row); CHKERRQ(ierr);
 
                 type::IntVec2D ijk;
-                type::RealVec2D coords;
+                type::RealVec2D coords, sign;
                 ierr = getEulerianNeighbors(
-                    mesh, dof, IJK, periodic, kernelSize, ijk, coords); CHKERRQ(ierr);
+                    mesh, dof, IJK, periodic, symmetric, kernelSize,
+                    ijk, coords, sign); CHKERRQ(ierr);
 
                 type::RealVec1D xyz(mesh->dim, 0.0);
                 if (mesh->dim == 3)
                 {
-                    for (unsigned int k = 0; k < ijk[2].size(); ++k)
+                    for (PetscInt k = 0; k < PetscInt(ijk[2].size()); ++k)
                     {
                         xyz[2] = coords[2][k];
-                        for (unsigned int j = 0; j < ijk[1].size(); ++j)
+                        for (PetscInt j = 0; j < PetscInt(ijk[1].size()); ++j)
                         {
                             xyz[1] = coords[1][j];
-                            for (unsigned int i = 0; i < ijk[0].size(); ++i)
+                            for (PetscInt i = 0; i < PetscInt(ijk[0].size()); ++i)
                             {
                                 xyz[0] = coords[0][i];
                                 // get packed column index
@@ -119,8 +186,8 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
                                     col); CHKERRQ(ierr);
                                 
                                 PetscReal val;
-                                val = delta::delta(
-                                    XYZ, xyz, widths, kernel); CHKERRQ(ierr);
+                                val = sign[0][i] * sign[1][j] * sign[2][k] *
+                                      delta::delta(XYZ, xyz.data(), widths, kernel);
                                 
                                 cols.push_back(col);
                                 vals.push_back(val);
@@ -130,10 +197,10 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
                 }
                 else if (mesh->dim == 2)
                 {
-                    for (unsigned int j = 0; j < ijk[1].size(); ++j)
+                    for (PetscInt j = 0; j < PetscInt(ijk[1].size()); ++j)
                     {
                         xyz[1] = coords[1][j];
-                        for (unsigned int i = 0; i < ijk[0].size(); ++i)
+                        for (PetscInt i = 0; i < PetscInt(ijk[0].size()); ++i)
                         {
                             xyz[0] = coords[0][i];
                             // get packed column index
@@ -143,8 +210,8 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
                                 col); CHKERRQ(ierr);
                             
                             PetscReal val;
-                            val = delta::delta(
-                                XYZ, xyz, widths, kernel); CHKERRQ(ierr);
+                            val = sign[0][i] * sign[1][j] *
+                                  delta::delta(XYZ, xyz.data(), widths, kernel);
                             
                             cols.push_back(col);
                             vals.push_back(val);
@@ -155,9 +222,11 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
                     SETERRQ(mesh->comm, PETSC_ERR_ARG_WRONG,
                             "Only 2D and 3D configurations are supported.\n");
 
-                ierr = MatSetValues(Op, 1, &row,
-                                    cols.size(), cols.data(), vals.data(),
-                                    INSERT_VALUES); CHKERRQ(ierr);
+                // mirrored neighbors may share columns with direct ones, so
+                // their contributions have to be summed up
+                ierr = MatSetValues(Op, 1, &row, PetscInt(cols.size()),
+                                    cols.data(), vals.data(),
+                                    ADD_VALUES); CHKERRQ(ierr);
             }
         }
     }
@@ -169,38 +238,28 @@ PetscErrorCode createDelta(const type::Mesh &mesh, const type::Boundary &bc,
 }  // createDelta
 
 PetscErrorCode getEulerianNeighbors(
-    const type::Mesh &mesh, const PetscInt &dof, const type::IntVec1D &IJK,
-    const std::vector<bool> &periodic, const PetscInt &window,
-    type::IntVec2D &ijk, type::RealVec2D &xyz)
+    const type::Mesh &mesh, const PetscInt &dof, const PetscInt *IJK,
+    const std::vector<bool> &periodic,
+    const std::vector<std::vector<bool>> &symmetric, const PetscInt &window,
+    type::IntVec2D &ijk, type::RealVec2D &xyz, type::RealVec2D &sign)
 {
     PetscFunctionBeginUser;
 
     xyz.resize(mesh->dim);
     ijk.resize(mesh->dim);
+    sign.resize(mesh->dim);
 
     for (PetscInt d = 0; d < mesh->dim; ++d)
     {
         for (PetscInt s = IJK[d] - window; s <= IJK[d] + window; ++s)
         {
-            if (s >= 0 && s < mesh->n[dof][d])
-            {
-                ijk[d].push_back(s);
-                xyz[d].push_back(mesh->coord[dof][d][s]);
-            }
-            else if (periodic[d])
-            {
-                PetscReal L = mesh->max[d] - mesh->min[d];
-                if (s < 0)
-                {
-                    ijk[d].push_back(s + mesh->n[dof][d]);
-                    xyz[d].push_back(mesh->coord[dof][d][s] - L);
-                }
-                else
-                {
-                    ijk[d].push_back(s - mesh->n[dof][d]);
-                    xyz[d].push_back(mesh->coord[dof][d][s] + L);
-                }
-            }
+            PetscInt idx;
+            PetscReal x, sgn;
+            if (!getNeighbor(mesh, dof, d, s, periodic, symmetric, idx, x, sgn))
+                continue;
+            ijk[d].push_back(idx);
+            xyz[d].push_back(x);
+            sign[d].push_back(sgn);
         }
     }
 
@@ -6,7 +6,9 @@
  */
 
 // STL
+#include <algorithm>
 #include <functional>
+#include <string>
 #include <vector>
 
 // here goes PETSc headers
@@ -230,5 +232,86 @@ PetscErrorCode createIdentity(const type::Mesh &mesh, Mat &I)
     PetscFunctionReturn(0);
 }  // createIdentity
 
+// implementation of petibm::operators::createSponge
+PetscErrorCode createSponge(const type::Mesh &mesh, const YAML::Node &node,
+                            Mat &S)
+{
+    PetscFunctionBeginUser;
+
+    PetscErrorCode ierr;
+
+    // a sponge zone: a band along a boundary of the domain
+    struct Zone
+    {
+        PetscInt d;           // direction normal to the boundary
+        PetscReal start;      // coordinate where the damping starts
+        PetscReal width;      // signed width (negative on a "Minus" boundary)
+        PetscReal strength;   // damping rate on the boundary
+    };
+
+    std::vector<Zone> zones;
+    for (const auto &z : node["zones"])
+    {
+        std::string loc = z["location"].as<std::string>();
+        PetscInt d = loc.empty() ? -1 : loc[0] - 'x';
+        if ((d < 0) || (d >= mesh->dim) ||
+            ((loc.substr(1) != "Minus") && (loc.substr(1) != "Plus")))
+            SETERRQ1(mesh->comm, PETSC_ERR_ARG_WRONG,
+                     "The location \"%s\" of a sponge zone is not "
+                     "recognized!\n", loc.c_str());
+
+        Zone zone;
+        zone.d = d;
+        zone.width = z["width"].as<PetscReal>();
+        zone.strength = z["strength"].as<PetscReal>();
+        if ((zone.width <= 0.0) || (zone.strength < 0.0))
+            SETERRQ1(mesh->comm, PETSC_ERR_ARG_OUTOFRANGE,
+                     "The sponge zone at %s needs a positive width and a "
+                     "non-negative strength.\n", loc.c_str());
+        if (loc.substr(1) == "Plus")
+            zone.start = mesh->max[d] - zone.width;
+        else
+        {
+            zone.start = mesh->min[d] + zone.width;
+            zone.width = -zone.width;
+        }
+        zones.push_back(zone);
+    }
+
+    // the damping rate ramps up smoothly (zero slope where the zone starts);
+    // where zones overlap, the strongest damping wins
+    auto sigma = [&mesh, &zones](const PetscInt &f, const PetscInt &i,
+                                 const PetscInt &j,
+                                 const PetscInt &k) -> PetscReal {
+        const PetscInt ijk[3] = {i, j, k};
+        PetscReal value = 0.0;
+        for (const auto &zone : zones)
+        {
+            PetscReal x = mesh->coord[f][zone.d][ijk[zone.d]];
+            PetscReal xi = (x - zone.start) / zone.width;
+            if (xi <= 0.0) continue;
+            xi = std::min(xi, PetscReal(1.0));
+            value = std::max(value,
+                             zone.strength * xi * xi * (3.0 - 2.0 * xi));
+        }
+        return value;
+    };
+
+    // kernels are kernel functions to calculate entry values
+    std::vector<KernelType> kernel(3);
+
+    // set kernels
+    for (PetscInt f = 0; f < 3; ++f)
+        kernel[f] = [f, &sigma](const PetscInt &i, const PetscInt &j,
+                                const PetscInt &k) -> PetscReal {
+            return sigma(f, i, j, k);
+        };
+
+    // call the function to create matrix
+    ierr = createDiagMatrix(mesh, kernel, S); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createSponge
+
 }  // end of namespace operators
 }  // end of namespace petibm
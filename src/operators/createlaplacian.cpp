@@ -103,12 +103,14 @@ PetscErrorCode LCorrectionDestroy(Mat mat)
 // j: the y-index of current row in the Cartesian mesh.
 // k: the z-index of current row in the Cartesian mesh.
 // L: the Laplacian matrix.
+// mask: whether each direction (x, y, z) contributes to the operator.
 // rowModifiers: an object holding information about where in a matrix should be
 // modified.
 inline PetscErrorCode setRowValues(
     const petibm::type::Mesh &mesh, const petibm::type::Boundary &bc,
     const GetStencilsFunc &getStencils, const PetscInt &f, const PetscInt &i,
     const PetscInt &j, const PetscInt &k, Mat &L,
+    const petibm::type::IntVec1D &mask,
     std::map<MatStencil, petibm::type::RowModifier> &rowModifiers)
 {
     PetscFunctionBeginUser;
@@ -133,6 +135,10 @@ inline PetscErrorCode setRowValues(
     // so we don't have to use "if" to find out the boundary points
     for (PetscInt dir = 0; dir < mesh->dim; ++dir)
     {
+        // excluded directions keep zeros, which are not inserted in the matrix
+        // and give zero coefficients to their ghost points
+        if (!mask[dir]) continue;
+
         // determine the index based on the direction
         const PetscInt &self = (dir == 0) ? i : (dir == 1) ? j : k;
 
@@ -168,7 +174,8 @@ namespace operators
 {
 // implementation of petibm::operators::createLaplacian
 PetscErrorCode createLaplacian(const type::Mesh &mesh, const type::Boundary &bc,
-                               Mat &L, Mat &LCorrection)
+                               Mat &L, Mat &LCorrection,
+                               const type::IntVec1D &directions)
 {
     using namespace std::placeholders;
 
@@ -180,6 +187,17 @@ PetscErrorCode createLaplacian(const type::Mesh &mesh, const type::Boundary &bc,
 
     LagrangianCtx *ctx;
 
+    // directions contributing to the operator (all of them by default)
+    type::IntVec1D mask(3, (directions.size() == 0) ? 1 : 0);
+    for (auto dir : directions)
+    {
+        if ((dir < 0) || (dir >= mesh->dim))
+            SETERRQ2(mesh->comm, PETSC_ERR_ARG_OUTOFRANGE,
+                     "Direction %D is not valid for a %DD mesh.\n", dir,
+                     mesh->dim);
+        mask[dir] = 1;
+    }
+
     // initialize modifier, regardless what's inside it now
     ctx = new LagrangianCtx(bc);
 
@@ -220,7 +238,8 @@ PetscErrorCode createLaplacian(const type::Mesh &mesh, const type::Boundary &bc,
             {mesh->bg[field][0], mesh->ed[field][0]},
             std::bind(setRowValues, std::ref(mesh), std::ref(bc),
                       std::ref(getStencils), std::ref(field), _3, _2, _1,
-                      std::ref(L), std::ref(ctx->modifier[field])));
+                      std::ref(L), std::cref(mask),
+                      std::ref(ctx->modifier[field])));
         CHKERRQ(ierr);
     }
 
@@ -0,0 +1,348 @@
+/**
+ * \file createsampling.cpp
+ * \brief Definition of functions creating operators that sample the pressure
+ *        and the velocity gradient at arbitrary points.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+// STL
+#include <algorithm>
+#include <cmath>
+
+// PETSc
+#include <petscmat.h>
+
+// PetIBM
+#include <petibm/boundary.h>
+#include <petibm/delta.h>
+#include <petibm/mesh.h>
+#include <petibm/type.h>
+
+namespace petibm
+{
+namespace operators
+{
+// defined in createdelta.cpp
+void getBoundaryFlags(const type::Mesh &mesh, const type::Boundary &bc,
+                      std::vector<bool> &periodic,
+                      std::vector<std::vector<bool>> &symmetric);
+
+// defined in createdelta.cpp
+bool getNeighbor(const type::Mesh &mesh, const PetscInt &dof,
+                 const PetscInt &d, const PetscInt &s,
+                 const std::vector<bool> &periodic,
+                 const std::vector<std::vector<bool>> &symmetric,
+                 PetscInt &idx, PetscReal &x, PetscReal &sign);
+}  // end of namespace operators
+}  // end of namespace petibm
+
+namespace  // anonymous namespace for internal linkage only
+{
+// grid points of a field around a location, one direction at a time
+struct Stencil
+{
+    petibm::type::IntVec2D idx;   // indices of the grid points (-1 for the
+                                  // normal velocity on a symmetry plane)
+    petibm::type::RealVec2D x;    // coordinates of the grid points
+    petibm::type::RealVec2D w;    // widths of the cells of the grid points
+    petibm::type::RealVec2D sign; // -1 for mirrored normal velocities
+};
+
+// get the grid points of the field f within `window` cells of a location;
+// unlike in createdelta.cpp, the coordinates of the periodic images are
+// computed from the wrapped index (the pressure grid has no ghost points)
+PetscErrorCode getStencil(const petibm::type::Mesh &mesh, const PetscInt &f,
+                          const PetscReal *X, const PetscInt &window,
+                          const std::vector<bool> &periodic,
+                          const std::vector<std::vector<bool>> &symmetric,
+                          Stencil &st)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    st.idx.assign(3, petibm::type::IntVec1D(1, 0));
+    st.x.assign(3, petibm::type::RealVec1D(1, 0.0));
+    st.w.assign(3, petibm::type::RealVec1D(1, 1.0));
+    st.sign.assign(3, petibm::type::RealVec1D(1, 1.0));
+
+    for (PetscInt d = 0; d < mesh->dim; ++d)
+    {
+        st.idx[d].clear();
+        st.x[d].clear();
+        st.w[d].clear();
+        st.sign[d].clear();
+
+        const PetscInt &n = mesh->n[f][d];
+        PetscReal L = mesh->max[d] - mesh->min[d];
+
+        PetscInt base;
+        ierr = mesh->locate(f, d, X[d], base); CHKERRQ(ierr);
+
+        for (PetscInt s = base - window; s <= base + window + 1; ++s)
+        {
+            PetscInt idx;
+            PetscReal x, sign = 1.0;
+            if (periodic[d] && ((s < 0) || (s >= n)))
+            {
+                idx = ((s % n) + n) % n;
+                x = mesh->coord[f][d][idx] + ((s - idx) / n) * L;
+            }
+            else if ((f == d) && (((s == -1) && symmetric[d][0]) ||
+                                  ((s == n) && symmetric[d][1])))
+            {
+                // the normal velocity on a symmetry plane is zero, but it
+                // still counts in the normalization of the weights
+                st.idx[d].push_back(-1);
+                st.x[d].push_back((s < 0) ? mesh->min[d] : mesh->max[d]);
+                st.w[d].push_back(mesh->dL[f][d][(s < 0) ? 0 : n - 1]);
+                st.sign[d].push_back(0.0);
+                continue;
+            }
+            else if (!petibm::operators::getNeighbor(mesh, f, d, s, periodic,
+                                                     symmetric, idx, x, sign))
+                continue;
+
+            st.idx[d].push_back(idx);
+            st.x[d].push_back(x);
+            st.w[d].push_back(mesh->dL[f][d][idx]);
+            st.sign[d].push_back(sign);
+        }
+    }
+
+    PetscFunctionReturn(0);
+}  // getStencil
+
+// get the columns and the weights interpolating the field f at a location;
+// the weights are normalized so that constant fields are reproduced exactly
+PetscErrorCode getWeights(const petibm::type::Mesh &mesh, const PetscInt &f,
+                          const PetscReal *X, const Stencil &st,
+                          const std::vector<PetscReal> &widths,
+                          const petibm::delta::DeltaKernel &kernel,
+                          petibm::type::IntVec1D &cols,
+                          petibm::type::RealVec1D &vals)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    cols.clear();
+    vals.clear();
+
+    // 1D weights (kernel times cell width) of each direction
+    petibm::type::RealVec2D phi(3, petibm::type::RealVec1D(1, 1.0));
+    for (PetscInt d = 0; d < mesh->dim; ++d)
+    {
+        phi[d].resize(st.x[d].size());
+        for (std::size_t s = 0; s < st.x[d].size(); ++s)
+            phi[d][s] = kernel(X[d] - st.x[d][s], widths[d]) * st.w[d][s];
+    }
+
+    PetscReal sum = 0.0;
+    for (std::size_t k = 0; k < phi[2].size(); ++k)
+        for (std::size_t j = 0; j < phi[1].size(); ++j)
+            for (std::size_t i = 0; i < phi[0].size(); ++i)
+            {
+                PetscReal w = phi[0][i] * phi[1][j] * phi[2][k];
+                if (w == 0.0) continue;
+
+                sum += w;
+                if ((st.idx[0][i] < 0) || (st.idx[1][j] < 0) ||
+                    (st.idx[2][k] < 0))
+                    continue;
+
+                PetscInt col;
+                ierr = mesh->getPackedGlobalIndex(
+                    f, st.idx[0][i], st.idx[1][j], st.idx[2][k], col);
+                CHKERRQ(ierr);
+
+                cols.push_back(col);
+                vals.push_back(w * st.sign[0][i] * st.sign[1][j] *
+                               st.sign[2][k]);
+            }
+
+    if (sum > 0.0)
+        for (auto &v : vals) v /= sum;
+
+    PetscFunctionReturn(0);
+}  // getWeights
+
+// get the widths of the pressure cell that contains a location
+PetscErrorCode getWidths(const petibm::type::Mesh &mesh, const PetscReal *X,
+                         std::vector<PetscReal> &widths)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    widths.resize(mesh->dim);
+    for (PetscInt d = 0; d < mesh->dim; ++d)
+    {
+        if ((X[d] < mesh->min[d]) || (X[d] > mesh->max[d]))
+            SETERRQ3(mesh->comm, PETSC_ERR_ARG_OUTOFRANGE,
+                     "Sampling coordinate %g is outside domain [%g, %g].\n",
+                     X[d], mesh->min[d], mesh->max[d]);
+
+        PetscInt idx;
+        ierr = mesh->locate(4, d, X[d], idx); CHKERRQ(ierr);
+        idx = std::min(std::max(idx, PetscInt(0)), mesh->n[3][d] - 1);
+        widths[d] = mesh->dL[3][d][idx];
+    }
+
+    PetscFunctionReturn(0);
+}  // getWidths
+
+// create a sparse matrix with a given number of local rows and columns
+PetscErrorCode createSamplingMat(const petibm::type::Mesh &mesh,
+                                 const PetscInt &nRows, const PetscInt &nCols,
+                                 const PetscInt &NCols, const PetscInt &nnz,
+                                 Mat &Op)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    ierr = MatCreate(mesh->comm, &Op); CHKERRQ(ierr);
+    ierr = MatSetSizes(Op, nRows, nCols, PETSC_DETERMINE, NCols); CHKERRQ(ierr);
+    ierr = MatSetFromOptions(Op); CHKERRQ(ierr);
+    ierr = MatSeqAIJSetPreallocation(Op, nnz, nullptr); CHKERRQ(ierr);
+    ierr = MatMPIAIJSetPreallocation(Op, nnz, nullptr, nnz, nullptr);
+    CHKERRQ(ierr);
+    ierr = MatSetOption(Op, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+    CHKERRQ(ierr);
+    ierr = MatSetOption(Op, MAT_IGNORE_ZERO_ENTRIES, PETSC_TRUE); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createSamplingMat
+}  // end of anonymous namespace
+
+namespace petibm
+{
+namespace operators
+{
+// implementation of petibm::operators::createPressureSampling
+PetscErrorCode createPressureSampling(const type::Mesh &mesh,
+                                      const type::Boundary &bc,
+                                      const type::RealVec2D &points,
+                                      const delta::DeltaKernel &kernel,
+                                      const PetscInt &kernelSize, Mat &P)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    std::vector<bool> periodic;
+    std::vector<std::vector<bool>> symmetric;
+    getBoundaryFlags(mesh, bc, periodic, symmetric);
+
+    PetscInt nPts = points.size();
+    PetscInt nnz = std::pow(2 * kernelSize + 2, mesh->dim);
+    ierr = createSamplingMat(mesh, nPts, mesh->pNLocal, mesh->pN, nnz, P);
+    CHKERRQ(ierr);
+
+    PetscInt rStart;
+    ierr = MatGetOwnershipRange(P, &rStart, nullptr); CHKERRQ(ierr);
+
+    for (PetscInt k = 0; k < nPts; ++k)
+    {
+        const PetscReal *X = points[k].data();
+
+        std::vector<PetscReal> widths;
+        ierr = getWidths(mesh, X, widths); CHKERRQ(ierr);
+
+        Stencil st;
+        ierr = getStencil(mesh, 3, X, kernelSize, periodic, symmetric, st);
+        CHKERRQ(ierr);
+
+        type::IntVec1D cols;
+        type::RealVec1D vals;
+        ierr = getWeights(mesh, 3, X, st, widths, kernel, cols, vals);
+        CHKERRQ(ierr);
+
+        PetscInt row = rStart + k;
+        ierr = MatSetValues(P, 1, &row, PetscInt(cols.size()), cols.data(),
+                            vals.data(), ADD_VALUES); CHKERRQ(ierr);
+    }
+
+    ierr = MatAssemblyBegin(P, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(P, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createPressureSampling
+
+// implementation of petibm::operators::createVelocityGradientSampling
+PetscErrorCode createVelocityGradientSampling(const type::Mesh &mesh,
+                                              const type::Boundary &bc,
+                                              const type::RealVec2D &points,
+                                              const delta::DeltaKernel &kernel,
+                                              const PetscInt &kernelSize,
+                                              Mat &GU)
+{
+    PetscErrorCode ierr;
+
+    PetscFunctionBeginUser;
+
+    std::vector<bool> periodic;
+    std::vector<std::vector<bool>> symmetric;
+    getBoundaryFlags(mesh, bc, periodic, symmetric);
+
+    // the shifted locations need one more cell on each side
+    PetscInt nPts = points.size(), dim = mesh->dim;
+    PetscInt nnz = std::pow(2 * kernelSize + 4, dim);
+    ierr = createSamplingMat(mesh, nPts * dim * dim, mesh->UNLocal, mesh->UN,
+                             nnz, GU); CHKERRQ(ierr);
+
+    PetscInt rStart;
+    ierr = MatGetOwnershipRange(GU, &rStart, nullptr); CHKERRQ(ierr);
+
+    for (PetscInt k = 0; k < nPts; ++k)
+    {
+        const PetscReal *X = points[k].data();
+
+        std::vector<PetscReal> widths;
+        ierr = getWidths(mesh, X, widths); CHKERRQ(ierr);
+
+        for (PetscInt i = 0; i < dim; ++i)
+        {
+            Stencil st;
+            ierr = getStencil(mesh, i, X, kernelSize + 1, periodic, symmetric,
+                              st); CHKERRQ(ierr);
+
+            // central difference of the interpolated component i between
+            // two locations shifted by one cell width in the direction j
+            for (PetscInt j = 0; j < dim; ++j)
+            {
+                PetscReal h = widths[j];
+                type::RealVec1D XPos(X, X + dim), XNeg(X, X + dim);
+                XPos[j] += h;
+                XNeg[j] -= h;
+
+                type::IntVec1D cols[2];
+                type::RealVec1D vals[2];
+                ierr = getWeights(mesh, i, XPos.data(), st, widths, kernel,
+                                  cols[0], vals[0]); CHKERRQ(ierr);
+                ierr = getWeights(mesh, i, XNeg.data(), st, widths, kernel,
+                                  cols[1], vals[1]); CHKERRQ(ierr);
+                for (auto &v : vals[0]) v /= (2.0 * h);
+                for (auto &v : vals[1]) v /= (-2.0 * h);
+
+                PetscInt row = rStart + (k * dim + i) * dim + j;
+                for (PetscInt s = 0; s < 2; ++s)
+                {
+                    ierr = MatSetValues(GU, 1, &row, PetscInt(cols[s].size()),
+                                        cols[s].data(), vals[s].data(),
+                                        ADD_VALUES); CHKERRQ(ierr);
+                }
+            }
+        }
+    }
+
+    ierr = MatAssemblyBegin(GU, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(GU, MAT_FINAL_ASSEMBLY); CHKERRQ(ierr);
+
+    PetscFunctionReturn(0);
+}  // createVelocityGradientSampling
+
+}  // end of namespace operators
+}  // end of namespace petibm
@@ -201,6 +201,20 @@ PetscErrorCode getSettings(YAML::Node &node)
     if (flag) node["logs"] = s;
     ierr = createDirectory(node["logs"].as<std::string>()); CHKERRQ(ierr);
 
+    // Get the directory where to cache assembled operators; the cache is only
+    // used when the option `-cache` is passed. Without a value, the cache is
+    // the `cache` folder under the output directory.
+    ierr =
+        PetscOptionsGetString(nullptr, nullptr, "-cache", s, sizeof(s), &flag);
+    CHKERRQ(ierr);
+    if (flag)
+    {
+        node["cache"] = (s[0] == '\0')
+                            ? node["output"].as<std::string>() + "/cache"
+                            : std::string(s);
+        ierr = createDirectory(node["cache"].as<std::string>()); CHKERRQ(ierr);
+    }
+
     // Get the path of the global YAML configuration file;
     // default is the file `config.yaml` in the working directory.
     // TODO: if user provides a relative path, where should it be relative to?
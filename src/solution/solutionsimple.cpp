@@ -172,6 +172,16 @@ PetscErrorCode SolutionSimple::write(const std::string &filePath) const
     // write to a HDF5 file
     ierr = io::writeHDF5Vecs(comm, filePath, "/", names, vecs); CHKERRQ(ierr);
 
+    // write the coarsened levels, if requested
+    PetscInt nLevels = 0;
+    ierr = PetscOptionsGetInt(nullptr, nullptr, "-lod_levels", &nLevels,
+                              nullptr); CHKERRQ(ierr);
+    if (nLevels > 0)
+    {
+        ierr = io::writeHDF5Pyramid(comm, filePath, "/", names, vecs, nLevels);
+        CHKERRQ(ierr);
+    }
+
     // nullify the reference to pressure Vec
     vecs.back() = PETSC_NULL;
     // return individual Vec objects to the packed Vec object
@@ -5,6 +5,9 @@
  * \license BSD 3-Clause License.
  */
 
+// STL
+#include <algorithm>
+
 // here goes headers from our PetIBM
 #include <petibm/timeintegration.h>
 
@@ -31,6 +34,13 @@ PetscErrorCode TimeIntegrationBase::printInfo() const
     info += "\tCoefficients of Explicit terms: [";
     for (auto it : explicitCoeffs) info += (std::to_string(it) + ", ");
     info += "]\n\n";
+    if (implicitDirections.size() > 0)
+    {
+        info += "\tImplicit treatment only in directions: [";
+        for (auto it : implicitDirections)
+            info += (type::dir2str[type::Dir(it)] + ", ");
+        info += "]\n\n";
+    }
 
     ierr = PetscPrintf(PETSC_COMM_WORLD, "%s", info.c_str()); CHKERRQ(ierr);
 
@@ -79,6 +89,38 @@ PetscErrorCode createTimeIntegration(const std::string &name,
                  scheme.c_str());
     }
 
+    // directions in which the implicit term is treated implicitly (optional)
+    const YAML::Node &dirs = node["parameters"][name + "ImplicitDirections"];
+    if (dirs.IsDefined())
+    {
+        if (integration->implicitCoeff == 0.0)
+            SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                     "The key \"%sImplicitDirections\" requires a scheme with "
+                     "an implicit term.\n", name.c_str());
+
+        for (auto item : dirs)
+        {
+            std::string dir = item.as<std::string>();
+            if (type::str2dir.count(dir) == 0)
+                SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE,
+                         "Unknown direction \"%s\" in \"%sImplicitDirections"
+                         "\".\n", dir.c_str(), name.c_str());
+            integration->implicitDirections.push_back(type::str2dir[dir]);
+        }
+
+        if (integration->implicitDirections.size() == 0)
+            SETERRQ1(PETSC_COMM_WORLD, PETSC_ERR_ARG_WRONG,
+                     "The list \"%sImplicitDirections\" is empty.\n",
+                     name.c_str());
+
+        std::sort(integration->implicitDirections.begin(),
+                  integration->implicitDirections.end());
+        integration->implicitDirections.erase(
+            std::unique(integration->implicitDirections.begin(),
+                        integration->implicitDirections.end()),
+            integration->implicitDirections.end());
+    }
+
     PetscFunctionReturn(0);
 }  // createTimeIntegration
 
@@ -0,0 +1,77 @@
+#!/bin/sh
+# Regression test of the operator cache with moving bodies, through the
+# program petibm-rigidkinematics: the forces on a translating cylinder are the
+# same without the cache, with an empty cache, and with the entries cached by
+# the previous run.
+
+set -e
+
+exe="${top_builddir:-..}/applications/rigidkinematics/petibm-rigidkinematics"
+dir=rigidkinematics-test
+
+rm -rf $dir
+mkdir -p $dir
+
+cat > $dir/config.yaml << 'END'
+flow:
+  nu: 0.1
+  initialVelocity: [0.0, 0.0]
+  boundaryConditions:
+    - {location: xMinus, u: [DIRICHLET, 0.0], v: [DIRICHLET, 0.0]}
+    - {location: xPlus, u: [DIRICHLET, 0.0], v: [DIRICHLET, 0.0]}
+    - {location: yMinus, u: [DIRICHLET, 0.0], v: [DIRICHLET, 0.0]}
+    - {location: yPlus, u: [DIRICHLET, 0.0], v: [DIRICHLET, 0.0]}
+mesh:
+  - direction: x
+    start: -1.0
+    subDomains: [{end: 1.0, cells: 32, stretchRatio: 1.0}]
+  - direction: y
+    start: -1.0
+    subDomains: [{end: 1.0, cells: 32, stretchRatio: 1.0}]
+parameters:
+  dt: 0.01
+  nt: 3
+  nsave: 1000
+  nrestart: 1000
+  convection: ADAMS_BASHFORTH_2
+  diffusion: CRANK_NICOLSON
+bodies:
+  - type: cylinder
+    name: cylinder
+    center: [0.0, 0.0]
+    radius: 0.25
+    motion:
+      translation:
+        x: {law: linear, rate: 2.0}
+END
+
+# run without the cache, then twice with the same cache directory
+$exe -directory $dir -output $dir/nocache > $dir/nocache.log 2>&1
+for run in cache1 cache2
+do
+    $exe -directory $dir -output $dir/$run -cache $dir/cache \
+        > $dir/$run.log 2>&1
+done
+
+# compare the time and the forces of each time step (relative tolerance)
+for run in cache1 cache2
+do
+    paste $dir/nocache/forces-0.txt $dir/$run/forces-0.txt | awk '
+        {
+            n = NF / 2;
+            for (i = 1; i <= n; ++i)
+            {
+                d = $i - $(i + n); if (d < 0) d = -d;
+                r = $i; if (r < 0) r = -r;
+                if (d > 1.0e-6 * r + 1.0e-10) bad = 1;
+            }
+        }
+        END { exit bad }' || { echo "forces differ with the cache ($run)"; exit 1; }
+    test $(wc -l < $dir/$run/forces-0.txt) -eq 3
+done
+
+# the projection operators are cached, not the operators of the forces
+test -f $dir/cache/decoupledibpm-BNG.key
+test ! -f $dir/cache/decoupledibpm-BNH.key
+
+echo "rigidkinematics-test: passed"
@@ -0,0 +1,299 @@
+/**
+ * \file kinematics_test.cpp
+ * \brief Unit-tests for the prescribed rigid motions of bodies.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/kinematics.h>
+#include <petibm/singlebody.h>
+
+using namespace petibm;
+
+// step of the central finite differences
+const PetscReal h = 1.0e-5;
+
+// value of a law at the time t
+PetscReal value(const body::MotionLaw &law, const PetscReal &t)
+{
+    PetscReal s, ds;
+    law.evaluate(t, s, ds);
+    return s;
+}  // value
+
+// compare the time derivative of a law to central finite differences
+void checkDerivative(const body::MotionLaw &law, const PetscReal &t)
+{
+    PetscReal s, ds;
+    law.evaluate(t, s, ds);
+    ASSERT_NEAR((value(law, t + h) - value(law, t - h)) / (2.0 * h), ds,
+                1.0e-6) << "time " << t;
+}  // checkDerivative
+
+// compare the derivatives of a transformation to central finite differences
+void checkTransformDerivatives(const body::Kinematics &kinematics,
+                               const PetscReal &t)
+{
+    PetscReal d[3], dd[3], R[3][3], dR[3][3];
+    PetscReal dP[3], ddP[3], RP[3][3], dRP[3][3];
+    PetscReal dM[3], ddM[3], RM[3][3], dRM[3][3];
+
+    kinematics.getTransform(t, d, dd, R, dR);
+    kinematics.getTransform(t + h, dP, ddP, RP, dRP);
+    kinematics.getTransform(t - h, dM, ddM, RM, dRM);
+
+    for (PetscInt i = 0; i < 3; ++i)
+    {
+        ASSERT_NEAR((dP[i] - dM[i]) / (2.0 * h), dd[i], 1.0e-6)
+            << "displacement " << i << " at time " << t;
+        for (PetscInt j = 0; j < 3; ++j)
+            ASSERT_NEAR((RP[i][j] - RM[i][j]) / (2.0 * h), dR[i][j], 1.0e-6)
+                << "rotation (" << i << ", " << j << ") at time " << t;
+    }
+}  // checkTransformDerivatives
+
+// compare the velocities of the local points to central finite differences
+// of their positions
+void checkVelocities(const type::SingleBody &body,
+                     body::Kinematics &kinematics, const PetscReal &t)
+{
+    const PetscInt n = body->nLclPts * body->dim;
+    std::vector<PetscReal> U(n), XP(n), XM(n);
+    PetscBool moved;
+
+    kinematics.update(body, t + h, U.data(), moved);
+    std::copy(body->coords[body->bgPt], body->coords[body->bgPt] + n,
+              XP.begin());
+    kinematics.update(body, t - h, U.data(), moved);
+    std::copy(body->coords[body->bgPt], body->coords[body->bgPt] + n,
+              XM.begin());
+    kinematics.update(body, t, U.data(), moved);
+
+    for (PetscInt k = 0; k < n; ++k)
+        ASSERT_NEAR((XP[k] - XM[k]) / (2.0 * h), U[k], 1.0e-6)
+            << "value " << k << " at time " << t;
+}  // checkVelocities
+
+// linear law: known values
+TEST(MotionLawTest, linear)
+{
+    body::MotionLaw law(PETSC_COMM_WORLD,
+                        YAML::Load("{law: linear, value: 1.0, rate: 3.0}"),
+                        ".");
+    PetscReal s, ds;
+    law.evaluate(2.0, s, ds);
+    ASSERT_DOUBLE_EQ(7.0, s);
+    ASSERT_DOUBLE_EQ(3.0, ds);
+}
+
+// Fourier law: known values and derivatives against finite differences
+TEST(MotionLawTest, fourier)
+{
+    body::MotionLaw law(
+        PETSC_COMM_WORLD,
+        YAML::Load("{law: fourier, frequency: 0.5, a0: 0.1, a: [0.2, 0.3], "
+                   "b: [0.4]}"),
+        ".");
+    for (PetscReal t : {0.0, 0.3, 1.1, 2.7})
+    {
+        PetscReal w = PETSC_PI;  // 2 pi f
+        PetscReal expected = 0.1 + 0.2 * std::cos(w * t) +
+                             0.3 * std::cos(2.0 * w * t) +
+                             0.4 * std::sin(w * t);
+        ASSERT_NEAR(expected, value(law, t), 1.0e-12) << "time " << t;
+        checkDerivative(law, t);
+    }
+}
+
+// table: piecewise-linear interpolation, held constant outside of the table
+TEST(MotionLawTest, table)
+{
+    body::MotionLaw law(
+        PETSC_COMM_WORLD,
+        YAML::Load("{law: table, times: [0.0, 1.0, 3.0], "
+                   "values: [0.0, 2.0, 1.0]}"),
+        ".");
+    PetscReal s, ds;
+
+    law.evaluate(-1.0, s, ds);
+    ASSERT_DOUBLE_EQ(0.0, s);
+    ASSERT_DOUBLE_EQ(0.0, ds);
+
+    law.evaluate(0.5, s, ds);
+    ASSERT_DOUBLE_EQ(1.0, s);
+    ASSERT_DOUBLE_EQ(2.0, ds);
+
+    law.evaluate(1.5, s, ds);
+    ASSERT_DOUBLE_EQ(1.75, s);
+    ASSERT_DOUBLE_EQ(-0.5, ds);
+
+    law.evaluate(4.0, s, ds);
+    ASSERT_DOUBLE_EQ(1.0, s);
+    ASSERT_DOUBLE_EQ(0.0, ds);
+
+    // the slope of each segment (away from the tabulated times)
+    for (PetscReal t : {0.25, 0.75, 2.0, 2.9}) checkDerivative(law, t);
+}
+
+// 2D transformation: translation and rotation (in degrees) about z
+TEST(KinematicsTest, transform2D)
+{
+    body::Kinematics kinematics(
+        PETSC_COMM_WORLD, 2, "body",
+        YAML::Load("{translation: {x: {law: linear, rate: 1.0}, "
+                   "y: {law: fourier, frequency: 0.2, b: [0.5]}}, "
+                   "rotation: {z: {law: linear, rate: 90.0}}}"),
+        ".");
+    PetscReal d[3], dd[3], R[3][3], dR[3][3];
+
+    // a quarter of a turn after one second
+    kinematics.getTransform(1.0, d, dd, R, dR);
+    ASSERT_NEAR(1.0, d[0], 1.0e-12);
+    ASSERT_NEAR(0.5 * std::sin(0.4 * PETSC_PI), d[1], 1.0e-12);
+    ASSERT_NEAR(0.0, d[2], 1.0e-12);
+    ASSERT_NEAR(0.0, R[0][0], 1.0e-12);
+    ASSERT_NEAR(-1.0, R[0][1], 1.0e-12);
+    ASSERT_NEAR(1.0, R[1][0], 1.0e-12);
+    ASSERT_NEAR(0.0, R[1][1], 1.0e-12);
+    ASSERT_NEAR(1.0, R[2][2], 1.0e-12);
+
+    // the angular velocity is converted from degrees to radians
+    ASSERT_NEAR(-PETSC_PI / 2.0, dR[0][0], 1.0e-12);
+
+    for (PetscReal t : {0.0, 0.4, 1.3})
+        checkTransformDerivatives(kinematics, t);
+}
+
+// 3D transformation: rotations about the three axes (product rule)
+TEST(KinematicsTest, transform3D)
+{
+    body::Kinematics kinematics(
+        PETSC_COMM_WORLD, 3, "body",
+        YAML::Load("{translation: {z: {law: linear, rate: -2.0}}, "
+                   "rotation: {x: {law: linear, rate: 30.0}, "
+                   "y: {law: fourier, frequency: 0.5, b: [20.0]}, "
+                   "z: {law: table, times: [0.0, 2.0], "
+                   "values: [0.0, 45.0]}}}"),
+        ".");
+    PetscReal d[3], dd[3], R[3][3], dR[3][3];
+
+    // R = Rz Ry Rx at t = 0.5: 15 degrees about x, 20 about y, and 11.25
+    // about z
+    kinematics.getTransform(0.5, d, dd, R, dR);
+    const PetscReal ax = PETSC_PI / 12.0, ay = PETSC_PI / 9.0,
+                    az = PETSC_PI / 16.0;
+    const PetscReal expected[3][3] = {
+        {std::cos(az) * std::cos(ay),
+         std::cos(az) * std::sin(ay) * std::sin(ax) -
+             std::sin(az) * std::cos(ax),
+         std::cos(az) * std::sin(ay) * std::cos(ax) +
+             std::sin(az) * std::sin(ax)},
+        {std::sin(az) * std::cos(ay),
+         std::sin(az) * std::sin(ay) * std::sin(ax) +
+             std::cos(az) * std::cos(ax),
+         std::sin(az) * std::sin(ay) * std::cos(ax) -
+             std::cos(az) * std::sin(ax)},
+        {-std::sin(ay), std::cos(ay) * std::sin(ax),
+         std::cos(ay) * std::cos(ax)}};
+    for (PetscInt i = 0; i < 3; ++i)
+        for (PetscInt j = 0; j < 3; ++j)
+            ASSERT_NEAR(expected[i][j], R[i][j], 1.0e-12)
+                << "rotation (" << i << ", " << j << ")";
+    ASSERT_NEAR(-1.0, d[2], 1.0e-12);
+
+    for (PetscReal t : {0.2, 0.7, 1.5})
+        checkTransformDerivatives(kinematics, t);
+}
+
+// 2D update: rotation about a pivot followed by a translation
+TEST(KinematicsTest, update2D)
+{
+    type::SingleBody body;
+    body::createSingleBody(PETSC_COMM_WORLD, 2, "points", "body2d",
+                           "body/body2d.txt", body);
+    body::Kinematics kinematics(
+        PETSC_COMM_WORLD, 2, "body2d",
+        YAML::Load("{pivot: [0.5, 0.5], "
+                   "translation: {x: {law: linear, rate: 1.0}}, "
+                   "rotation: {z: {law: linear, rate: 90.0}}}"),
+        ".");
+
+    std::vector<PetscReal> U(body->nLclPts * 2);
+    PetscBool moved;
+    kinematics.update(body, 1.0, U.data(), moved);
+    ASSERT_EQ(PETSC_TRUE, moved);
+
+    // a quarter of a turn about the pivot, then a unit translation in x
+    for (PetscInt k = body->bgPt; k < body->bgPt + body->nLclPts; ++k)
+    {
+        const PetscReal rx = body->coords0[k][0] - 0.5,
+                        ry = body->coords0[k][1] - 0.5;
+        ASSERT_NEAR(0.5 + 1.0 - ry, body->coords[k][0], 1.0e-12);
+        ASSERT_NEAR(0.5 + rx, body->coords[k][1], 1.0e-12);
+    }
+
+    for (PetscReal t : {0.0, 0.6, 1.9}) checkVelocities(body, kinematics, t);
+}
+
+// 3D update: rotations about a pivot and a translation
+TEST(KinematicsTest, update3D)
+{
+    type::SingleBody body;
+    body::createSingleBody(PETSC_COMM_WORLD, 3, "points", "body3d",
+                           "body/body3d.txt", body);
+    body::Kinematics kinematics(
+        PETSC_COMM_WORLD, 3, "body3d",
+        YAML::Load("{pivot: [0.5, 0.4, 0.3], "
+                   "translation: {y: {law: fourier, frequency: 1.0, "
+                   "a: [0.1]}}, "
+                   "rotation: {x: {law: linear, rate: 45.0}, "
+                   "z: {law: fourier, frequency: 0.25, b: [30.0]}}}"),
+        ".");
+
+    for (PetscReal t : {0.1, 0.8, 2.3}) checkVelocities(body, kinematics, t);
+}
+
+// a constant law does not move the points after the first update
+TEST(KinematicsTest, constantLaw)
+{
+    type::SingleBody body;
+    body::createSingleBody(PETSC_COMM_WORLD, 2, "points", "body2d",
+                           "body/body2d.txt", body);
+    body::Kinematics kinematics(
+        PETSC_COMM_WORLD, 2, "body2d",
+        YAML::Load("{translation: {x: {law: linear, value: 0.5}}}"), ".");
+
+    std::vector<PetscReal> U(body->nLclPts * 2);
+    PetscBool moved;
+
+    // the first update moves the points from their initial positions
+    kinematics.update(body, 0.0, U.data(), moved);
+    ASSERT_EQ(PETSC_TRUE, moved);
+
+    kinematics.update(body, 1.0, U.data(), moved);
+    ASSERT_EQ(PETSC_FALSE, moved);
+    for (PetscInt k = 0; k < body->nLclPts * 2; ++k)
+        ASSERT_DOUBLE_EQ(0.0, U[k]);
+}
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
@@ -0,0 +1,143 @@
+/**
+ * \file lagrangianorder_test.cpp
+ * \brief Unit-tests for the ordering of the Lagrangian points along
+ *        space-filling curves.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/bodypack.h>
+#include <petibm/singlebody.h>
+
+using namespace petibm;
+
+// read the coordinates of the points of a 2D body file (one row per point)
+std::vector<std::vector<PetscReal>> readPoints(const std::string &path,
+                                               const bool &header)
+{
+    std::ifstream file(path);
+    std::vector<std::vector<PetscReal>> points;
+    PetscInt n;
+    if (header) file >> n;
+    PetscReal x, y;
+    while (file >> x >> y) points.push_back({x, y});
+    return points;
+}  // readPoints
+
+// load the 2D body with the points sorted along the given curve
+void checkOrder(const std::string &curve)
+{
+    YAML::Node config, bodyNode;
+    bodyNode["file"] = "body2d.txt";
+    config["directory"] = "body";
+    config["bodies"].push_back(bodyNode);
+
+    type::BodyPack bodies;
+    PetscOptionsSetValue(nullptr, "-lagrangian_order", curve.c_str());
+    body::createBodyPack(PETSC_COMM_WORLD, 2, config, bodies);
+    PetscOptionsClearValue(nullptr, "-lagrangian_order");
+
+    const type::SingleBody &body = bodies->bodies[0];
+    std::vector<std::vector<PetscReal>> filePoints =
+        readPoints("body/body2d.txt", true);
+    ASSERT_EQ((std::size_t)body->nPts, filePoints.size());
+
+    // the order is a permutation of the indices of the file
+    ASSERT_EQ((std::size_t)body->nPts, body->order.size());
+    type::IntVec1D sorted(body->order), indices(body->nPts);
+    std::sort(sorted.begin(), sorted.end());
+    std::iota(indices.begin(), indices.end(), 0);
+    ASSERT_EQ(indices, sorted);
+
+    // the points in memory are the points of the file, permuted
+    for (PetscInt k = 0; k < body->nPts; ++k)
+        for (PetscInt d = 0; d < 2; ++d)
+        {
+            ASSERT_EQ(filePoints[body->order[k]][d], body->coords[k][d]);
+            ASSERT_EQ(body->coords[k][d], body->coords0[k][d]);
+        }
+
+    // the body is written in the order of the file
+    std::string path = "lagrangianorder-" + curve + ".txt";
+    body->writeBody(path);
+    PetscMPIInt rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    if (rank == 0)
+    {
+        std::vector<std::vector<PetscReal>> written = readPoints(path, false);
+        ASSERT_EQ(filePoints.size(), written.size());
+        for (std::size_t k = 0; k < written.size(); ++k)
+            for (PetscInt d = 0; d < 2; ++d)
+                ASSERT_NEAR(filePoints[k][d], written[k][d], 1.0e-8);
+    }
+
+    // a packed Vec permuted to the order of the file and back is unchanged
+    Vec mem, file, back;
+    DMCreateGlobalVector(bodies->dmPack, &mem);
+    VecDuplicate(mem, &file);
+    VecDuplicate(mem, &back);
+    for (PetscInt i = body->bgPt; i < body->edPt; ++i)
+        for (PetscInt d = 0; d < 2; ++d)
+        {
+            PetscInt idx;
+            bodies->getPackedGlobalIndex(0, i, d, idx);
+            VecSetValue(mem, idx, 10.0 * i + d, INSERT_VALUES);
+        }
+    VecAssemblyBegin(mem);
+    VecAssemblyEnd(mem);
+
+    bodies->reorderVec(mem, file, PETSC_TRUE);
+    for (PetscInt i = body->bgPt; i < body->edPt; ++i)
+    {
+        // index in memory of the i-th point of the file
+        PetscInt m = std::find(body->order.begin(), body->order.end(), i) -
+                     body->order.begin();
+        for (PetscInt d = 0; d < 2; ++d)
+        {
+            PetscInt idx;
+            PetscReal value;
+            bodies->getPackedGlobalIndex(0, i, d, idx);
+            VecGetValues(file, 1, &idx, &value);
+            ASSERT_EQ(10.0 * m + d, value) << "point " << i << " of the file";
+        }
+    }
+
+    bodies->reorderVec(file, back, PETSC_FALSE);
+    PetscBool equal;
+    VecEqual(mem, back, &equal);
+    ASSERT_EQ(PETSC_TRUE, equal);
+
+    VecDestroy(&back);
+    VecDestroy(&file);
+    VecDestroy(&mem);
+}  // checkOrder
+
+// points sorted along a Hilbert curve
+TEST(LagrangianOrderTest, hilbert) { checkOrder("hilbert"); }
+
+// points sorted along a Z-order (Morton) curve
+TEST(LagrangianOrderTest, morton) { checkOrder("morton"); }
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
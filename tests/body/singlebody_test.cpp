@@ -5,6 +5,7 @@
  * \license BSD 3-Clause License.
  */
 
+#include <cmath>
 #include <vector>
 
 #include <petsc.h>
@@ -225,6 +226,64 @@ TEST_F(SingleBodyTest, calculateAvgForces3D)
     VecDestroy(&f);
 }
 
+TEST(SingleBodyShapeTest, cylinder2D)
+{
+    using namespace YAML;
+    Node mesh, body;
+    type::SingleBody cylinder;
+
+    mesh.push_back(Node(NodeType::Map));
+    mesh[0]["direction"] = "x";
+    mesh[1]["direction"] = "y";
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        mesh[i]["start"] = -2.0;
+        mesh[i]["subDomains"].push_back(Node(NodeType::Map));
+        mesh[i]["subDomains"][0]["end"] = 2.0;
+        mesh[i]["subDomains"][0]["cells"] = 80;
+        mesh[i]["subDomains"][0]["stretchRatio"] = 1.0;
+    }
+
+    body["type"] = "cylinder";
+    body["center"].push_back(0.0);
+    body["center"].push_back(0.0);
+    body["radius"] = 0.5;
+
+    // spacing derived from the mesh: 0.05
+    petibm::body::createSingleBody(PETSC_COMM_WORLD, 2, "cylinder",
+                                   "cylinder", body, mesh, cylinder);
+    ASSERT_EQ(2, cylinder->dim);
+    ASSERT_EQ(63, cylinder->nPts);
+    for (PetscInt k = 0; k < cylinder->nPts; ++k)
+        ASSERT_NEAR(0.5, std::hypot(cylinder->coords[k][0],
+                                    cylinder->coords[k][1]), 1.0e-12);
+}
+
+TEST(SingleBodyShapeTest, sphere3D)
+{
+    using namespace YAML;
+    Node body;
+    type::SingleBody sphere;
+
+    body["type"] = "sphere";
+    body["center"].push_back(0.0);
+    body["center"].push_back(0.0);
+    body["center"].push_back(0.0);
+    body["radius"] = 0.5;
+    body["spacing"] = 0.1;
+
+    petibm::body::createSingleBody(PETSC_COMM_WORLD, 3, "sphere", "sphere",
+                                   body, Node(), sphere);
+    ASSERT_EQ(3, sphere->dim);
+    ASSERT_EQ(315, sphere->nPts);
+    for (PetscInt k = 0; k < sphere->nPts; ++k)
+    {
+        const PetscReal *xyz = sphere->coords[k];
+        ASSERT_NEAR(0.5, std::sqrt(xyz[0] * xyz[0] + xyz[1] * xyz[1] +
+                                   xyz[2] * xyz[2]), 1.0e-12);
+    }
+}
+
 // Run all tests
 int main(int argc, char **argv)
 {
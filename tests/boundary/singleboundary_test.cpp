@@ -5,11 +5,17 @@
  * \license BSD 3-Clause License.
  */
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 #include <petsc.h>
 
 #include <gtest/gtest.h>
 #include <yaml-cpp/yaml.h>
 
+#include <petibm/bodypack.h>
+#include <petibm/boundary.h>
 #include <petibm/mesh.h>
 #include <petibm/parser.h>
 #include <petibm/singleboundary.h>
@@ -77,11 +83,15 @@ protected:
         petibm::boundary::createSingleBoundary(
             mesh, type::BCLoc::XMINUS, type::Field::u, 0.0,
             type::BCType::DIRICHLET, boundary);
+        petibm::boundary::createSingleBoundary(
+            mesh, type::BCLoc::YPLUS, type::Field::u, 0.0,
+            type::BCType::SYMMETRY, symBoundary);
     };
 
     virtual void TearDown(){};
 
     type::SingleBoundary boundary;
+    type::SingleBoundary symBoundary;
 };  // SingleBoundaryTest
 
 TEST_F(SingleBoundaryTest, init)
@@ -95,6 +105,148 @@ TEST_F(SingleBoundaryTest, init)
     ASSERT_EQ(0.0, boundary->value);
 }
 
+TEST_F(SingleBoundaryTest, symmetry)
+{
+    ASSERT_EQ(type::BCLoc::YPLUS, symBoundary->loc);
+    ASSERT_EQ(type::Field::u, symBoundary->field);
+    ASSERT_EQ(type::BCType::SYMMETRY, symBoundary->type);
+    ASSERT_EQ(1.0, symBoundary->normal);
+    ASSERT_EQ(type::BCType::SYMMETRY, type::str2bt["SYMMETRY"]);
+}
+
+// create the boundary conditions of a unit cube with the given types on the
+// six boundaries
+void createCubeBoundary(const std::vector<std::string> &types,
+                        type::Mesh &mesh, type::Boundary &bc)
+{
+    using namespace YAML;
+
+    Node config;
+    std::vector<std::string> dirs = {"x", "y", "z"},
+                             locs = {"xMinus", "xPlus", "yMinus",
+                                     "yPlus",  "zMinus", "zPlus"};
+
+    config["mesh"].push_back(Node(NodeType::Map));
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        config["mesh"][i]["direction"] = dirs[i];
+        config["mesh"][i]["start"] = 0.0;
+        config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+        config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+        config["mesh"][i]["subDomains"][0]["cells"] = 8;
+        config["mesh"][i]["subDomains"][0]["stretchRatio"] = 1.0;
+    }
+
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+        Node bcNode;
+        bcNode["location"] = locs[i];
+        for (const char *comp : {"u", "v", "w"})
+        {
+            bcNode[comp].push_back(types[i]);
+            bcNode[comp].push_back(0.0);
+        }
+        config["flow"]["boundaryConditions"].push_back(bcNode);
+    }
+
+    petibm::mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+    petibm::boundary::createBoundary(mesh, config, bc);
+}  // createCubeBoundary
+
+// forces on a body made of the given points, each point exerting the force
+// (1, 2, 3) on the fluid, with mirror images across the symmetry planes
+type::RealVec1D mirroredForce(const std::vector<std::string> &types,
+                              const type::RealVec2D &points)
+{
+    type::Mesh mesh;
+    type::Boundary bc;
+    createCubeBoundary(types, mesh, bc);
+
+    PetscMPIInt rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    if (rank == 0)
+    {
+        std::ofstream file("mirrorbody3d.txt");
+        file << points.size() << "\n";
+        for (const auto &point : points)
+            file << point[0] << " " << point[1] << " " << point[2] << "\n";
+    }
+    MPI_Barrier(PETSC_COMM_WORLD);
+
+    YAML::Node config, bodyNode;
+    bodyNode["file"] = "mirrorbody3d.txt";
+    config["directory"] = ".";
+    config["bodies"].push_back(bodyNode);
+    type::BodyPack bodies;
+    petibm::body::createBodyPack(PETSC_COMM_WORLD, 3, config, bodies);
+
+    // the packed Vec holds the forces applied to the fluid
+    Vec f;
+    DMCreateGlobalVector(bodies->dmPack, &f);
+    const type::SingleBody &body = bodies->bodies[0];
+    for (PetscInt k = body->bgPt; k < body->edPt; ++k)
+        for (PetscInt d = 0; d < 3; ++d)
+        {
+            PetscInt idx;
+            bodies->getPackedGlobalIndex(0, k, d, idx);
+            VecSetValue(f, idx, -(d + 1.0), INSERT_VALUES);
+        }
+    VecAssemblyBegin(f);
+    VecAssemblyEnd(f);
+
+    type::RealVec2D forces;
+    bodies->calculateAvgForces(f, forces);
+    petibm::boundary::mirrorForces(bc, bodies, f, forces);
+    VecDestroy(&f);
+
+    return forces[0];
+}  // mirroredForce
+
+TEST(MirrorForcesTest, noSymmetry)
+{
+    type::RealVec1D force = mirroredForce(
+        std::vector<std::string>(6, "DIRICHLET"),
+        {{0.3, 0.4, 0.5}, {0.6, 0.7, 0.2}});
+    ASSERT_EQ(type::RealVec1D({2.0, 4.0, 6.0}), force);
+}
+
+TEST(MirrorForcesTest, oneSymmetryPlane)
+{
+    std::vector<std::string> types(6, "DIRICHLET");
+    types[2] = "SYMMETRY";  // yMinus
+
+    // tangential components doubled, normal component cancelled
+    type::RealVec1D force =
+        mirroredForce(types, {{0.3, 0.4, 0.5}, {0.6, 0.7, 0.2}});
+    ASSERT_EQ(type::RealVec1D({4.0, 0.0, 12.0}), force);
+}
+
+TEST(MirrorForcesTest, twoSymmetryPlanes)
+{
+    std::vector<std::string> types(6, "DIRICHLET");
+    types[3] = "SYMMETRY";  // yPlus
+    types[4] = "SYMMETRY";  // zMinus
+
+    // four images of each point: the force along x is multiplied by four
+    type::RealVec1D force =
+        mirroredForce(types, {{0.3, 0.4, 0.5}, {0.6, 0.7, 0.2}});
+    ASSERT_EQ(type::RealVec1D({8.0, 0.0, 0.0}), force);
+}
+
+TEST(MirrorForcesTest, pointOnSymmetryPlane)
+{
+    std::vector<std::string> types(6, "DIRICHLET");
+    types[2] = "SYMMETRY";  // yMinus
+    types[4] = "SYMMETRY";  // zMinus
+
+    // the first point lies on the plane y = 0 (it is its own image across
+    // this plane) but not on the plane z = 0; the second point lies on both
+    // planes and is counted once
+    type::RealVec1D force =
+        mirroredForce(types, {{0.3, 0.0, 0.5}, {0.6, 0.0, 0.0}});
+    ASSERT_EQ(type::RealVec1D({2.0 + 1.0, 4.0 + 2.0, 0.0 + 3.0}), force);
+}
+
 // Run all tests
 int main(int argc, char **argv)
 {
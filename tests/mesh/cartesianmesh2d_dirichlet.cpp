@@ -5,6 +5,9 @@
  * \license BSD 3-Clause License.
  */
 
+#include <algorithm>
+#include <vector>
+
 #include <petsc.h>
 
 #include <gtest/gtest.h>
@@ -1011,3 +1014,43 @@ TEST_F(CartesianMeshTest2D_AllDirichlet, check_getPackedGlobalIndex_ijk_ghost)
         }
     }
 }
+
+// test point location against a binary search on the gridlines
+TEST_F(CartesianMeshTest2D_AllDirichlet, check_locate)
+{
+    PetscErrorCode ierr;
+
+    for (PetscInt f = 0; f < 5; ++f)
+    {
+        if (f == 2) continue;  // no w-velocity in 2D
+
+        for (PetscInt d = 0; d < 2; ++d)
+        {
+            const PetscReal *line = mesh->coord[f][d];
+            const PetscInt n = mesh->n[f][d];
+            const PetscReal lo = line[0] - 0.1, hi = line[n - 1] + 0.1;
+
+            // points sweeping the gridline, plus the gridline points
+            std::vector<PetscReal> xs;
+            for (PetscInt i = 0; i <= 1000; ++i)
+                xs.push_back(lo + (hi - lo) * i / 1000);
+            xs.insert(xs.end(), line, line + n);
+
+            PetscInt prev = 0;
+            for (auto &x : xs)
+            {
+                PetscInt expected, idx;
+
+                expected = std::upper_bound(line, line + n, x) - line - 1;
+
+                ierr = mesh->locate(f, d, x, idx);
+                ASSERT_FALSE(ierr);
+                ASSERT_EQ(expected, idx);
+
+                ierr = mesh->locateFrom(f, d, x, prev);
+                ASSERT_FALSE(ierr);
+                ASSERT_EQ(expected, prev);
+            }
+        }
+    }
+}
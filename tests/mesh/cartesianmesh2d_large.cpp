@@ -0,0 +1,124 @@
+/**
+ * \file cartesianmesh2d_large.cpp
+ * \brief Smoke test of `CartesianMesh` with more than 2^31 unknowns.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ *
+ * The test only exists in builds with 64-bit indices and it is skipped unless
+ * the command-line option `-large_mesh` is passed (it needs several GB of
+ * memory per process). For example:
+ *
+ *     PETSC_OPTIONS="-large_mesh" mpiexec -np 4 ./cartesianmesh-test
+ */
+
+#include <limits>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/mesh.h>
+
+#if defined(PETSC_USE_64BIT_INDICES)
+
+class CartesianMeshTest2D_Large : public ::testing::Test
+{
+protected:
+    CartesianMeshTest2D_Large(){};
+
+    virtual ~CartesianMeshTest2D_Large(){};
+
+    static void SetUpTestCase()
+    {
+        using namespace YAML;
+
+        PetscErrorCode ierr;
+        Node config;
+
+        ierr = PetscOptionsHasName(nullptr, nullptr, "-large_mesh", &run);
+        ASSERT_FALSE(ierr);
+        if (!run) return;
+
+        config["mesh"].push_back(Node(NodeType::Map));
+        config["mesh"][0]["direction"] = "x";
+        config["mesh"][1]["direction"] = "y";
+        for (unsigned int i = 0; i < 2; ++i)
+        {
+            config["mesh"][i]["start"] = 0.0;
+            config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+            config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+            config["mesh"][i]["subDomains"][0]["cells"] = n[i];
+            config["mesh"][i]["subDomains"][0]["stretchRatio"] = 1.0;
+        }
+
+        config["flow"] = YAML::Node(NodeType::Map);
+        config["flow"]["boundaryConditions"].push_back(Node(NodeType::Map));
+        config["flow"]["boundaryConditions"][0]["location"] = "xMinus";
+        config["flow"]["boundaryConditions"][1]["location"] = "xPlus";
+        config["flow"]["boundaryConditions"][2]["location"] = "yMinus";
+        config["flow"]["boundaryConditions"][3]["location"] = "yPlus";
+
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            config["flow"]["boundaryConditions"][i]["u"][0] = "DIRICHLET";
+            config["flow"]["boundaryConditions"][i]["u"][1] = 0.0;
+            config["flow"]["boundaryConditions"][i]["v"][0] = "DIRICHLET";
+            config["flow"]["boundaryConditions"][i]["v"][1] = 0.0;
+        }
+
+        ierr = petibm::mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+        ASSERT_FALSE(ierr);
+    };
+
+    virtual void SetUp(){};
+
+    virtual void TearDown(){};
+
+    static void TearDownTestCase() { mesh.reset(); };
+
+    static PetscBool run;
+    static const PetscInt n[2];
+    static petibm::type::Mesh mesh;
+};  // CartesianMeshTest2D_Large
+
+PetscBool CartesianMeshTest2D_Large::run = PETSC_FALSE;
+const PetscInt CartesianMeshTest2D_Large::n[2] = {65536, 32768};
+petibm::type::Mesh CartesianMeshTest2D_Large::mesh = nullptr;
+
+// test the sizes do not overflow
+TEST_F(CartesianMeshTest2D_Large, check_sizes)
+{
+    if (!run) return;
+
+    ASSERT_EQ(n[0] * n[1], mesh->pN);
+    ASSERT_GT(mesh->pN, PetscInt(std::numeric_limits<int>::max()));
+    ASSERT_EQ((n[0] - 1) * n[1] + n[0] * (n[1] - 1), mesh->UN);
+}
+
+// test the indices of the last points
+TEST_F(CartesianMeshTest2D_Large, check_last_indices)
+{
+    if (!run) return;
+
+    PetscErrorCode ierr;
+    PetscInt idx;
+
+    ierr = mesh->getNaturalIndex(3, n[0] - 1, n[1] - 1, 0, idx);
+    ASSERT_FALSE(ierr);
+    ASSERT_EQ(mesh->pN - 1, idx);
+
+    // the last process owns the last points of every field
+    if ((mesh->ed[3][0] == n[0]) && (mesh->ed[3][1] == n[1]))
+    {
+        ierr = mesh->getGlobalIndex(3, n[0] - 1, n[1] - 1, 0, idx);
+        ASSERT_FALSE(ierr);
+        ASSERT_EQ(mesh->pN - 1, idx);
+
+        ierr = mesh->getPackedGlobalIndex(1, n[0] - 1, n[1] - 2, 0, idx);
+        ASSERT_FALSE(ierr);
+        ASSERT_EQ(mesh->UN - 1, idx);
+    }
+}
+
+#endif
@@ -0,0 +1,237 @@
+/**
+ * \file coarsendmdavec_test.cpp
+ * \brief Unit-tests for the coarsening of DMDA Vec objects.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include <petsc.h>
+
+#include "gtest/gtest.h"
+
+#include "petibm/io.h"
+
+// linear field sampled at the grid point (i, j)
+PetscReal linearField(const PetscReal &i, const PetscReal &j)
+{
+    return 1.0 + 2.0 * i - 3.0 * j;
+}
+
+// create a 2D DMDA and a Vec holding the linear field; by default, the DMDA
+// has ghost points and PETSc decides the partition, otherwise the processes
+// are all along x with the given numbers of points and there is no ghost point
+void createLinearVec(const PetscInt &nx, const PetscInt &ny, DM &da, Vec &vec,
+                     const PetscInt *lx = nullptr)
+{
+    PetscMPIInt size;
+    PetscInt s[2], c[2];
+    PetscReal **array;
+
+    MPI_Comm_size(PETSC_COMM_WORLD, &size);
+    if (lx == nullptr)
+        DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE,
+                     DMDA_STENCIL_BOX, nx, ny, PETSC_DECIDE, PETSC_DECIDE, 1,
+                     1, nullptr, nullptr, &da);
+    else
+        DMDACreate2d(PETSC_COMM_WORLD, DM_BOUNDARY_NONE, DM_BOUNDARY_NONE,
+                     DMDA_STENCIL_STAR, nx, ny, size, 1, 1, 0, lx, nullptr,
+                     &da);
+    DMSetUp(da);
+    DMCreateGlobalVector(da, &vec);
+
+    DMDAGetCorners(da, &s[0], &s[1], nullptr, &c[0], &c[1], nullptr);
+    DMDAVecGetArray(da, vec, &array);
+    for (PetscInt j = s[1]; j < s[1] + c[1]; ++j)
+        for (PetscInt i = s[0]; i < s[0] + c[0]; ++i)
+            array[j][i] = linearField(i, j);
+    DMDAVecRestoreArray(da, vec, &array);
+}
+
+// check the size of a coarse Vec and its values against the average of the
+// linear field over the (up to) 2x2 fine points of each coarse point
+void checkCoarseVec(const PetscInt &nx, const PetscInt &ny, const DM &coarseDA,
+                    const Vec &coarse)
+{
+    PetscInt dim, n[2], s[2], c[2];
+    const PetscReal **array;
+
+    DMDAGetInfo(coarseDA, &dim, &n[0], &n[1], nullptr, nullptr, nullptr,
+                nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                nullptr);
+    ASSERT_EQ(2, dim);
+    ASSERT_EQ((nx + 1) / 2, n[0]);
+    ASSERT_EQ((ny + 1) / 2, n[1]);
+
+    DMDAGetCorners(coarseDA, &s[0], &s[1], nullptr, &c[0], &c[1], nullptr);
+    DMDAVecGetArrayRead(coarseDA, coarse, &array);
+    for (PetscInt j = s[1]; j < s[1] + c[1]; ++j)
+        for (PetscInt i = s[0]; i < s[0] + c[0]; ++i)
+        {
+            // the last coarse point only covers one fine point if the number
+            // of fine points is odd
+            PetscReal xi = (2 * i + std::min(2 * i + 1, nx - 1)) / 2.0,
+                      xj = (2 * j + std::min(2 * j + 1, ny - 1)) / 2.0;
+            ASSERT_NEAR(linearField(xi, xj), array[j][i], 1.0e-12)
+                << "coarse point (" << i << ", " << j << ")";
+        }
+    DMDAVecRestoreArrayRead(coarseDA, coarse, &array);
+}
+
+// coarsen a linear field with the given numbers of fine points
+void testCoarsening(const PetscInt &nx, const PetscInt &ny)
+{
+    DM da, coarseDA;
+    Vec fine, coarse;
+
+    createLinearVec(nx, ny, da, fine);
+    petibm::io::coarsenDMDAVec(fine, coarseDA, coarse);
+    checkCoarseVec(nx, ny, coarseDA, coarse);
+
+    VecDestroy(&coarse);
+    DMDestroy(&coarseDA);
+    VecDestroy(&fine);
+    DMDestroy(&da);
+}
+
+// even numbers of points in both directions
+TEST(coarsenDMDAVecTest, evenSizes) { testCoarsening(8, 6); }
+
+// odd numbers of points in both directions
+TEST(coarsenDMDAVecTest, oddSizes) { testCoarsening(7, 5); }
+
+// odd number of points in one direction only
+TEST(coarsenDMDAVecTest, mixedSizes) { testCoarsening(9, 4); }
+
+// successive levels of a pyramid (coarsening of a coarse Vec): 11 -> 6 -> 3
+// points in x and 7 -> 4 -> 2 points in y
+TEST(coarsenDMDAVecTest, twoLevels)
+{
+    DM da, coarseDA, coarserDA;
+    Vec fine, coarse, coarser;
+    PetscInt s[2], c[2];
+    const PetscReal **array;
+
+    createLinearVec(11, 7, da, fine);
+    petibm::io::coarsenDMDAVec(fine, coarseDA, coarse);
+    petibm::io::coarsenDMDAVec(coarse, coarserDA, coarser);
+
+    // averages of the averages of the first level
+    PetscReal first[2][6];
+    for (PetscInt l = 0; l < 2; ++l)
+    {
+        PetscInt n = (l == 0) ? 11 : 7, nc = (n + 1) / 2;
+        for (PetscInt i = 0; i < nc; ++i)
+            first[l][i] = (2 * i + std::min(2 * i + 1, n - 1)) / 2.0;
+    }
+
+    DMDAGetCorners(coarserDA, &s[0], &s[1], nullptr, &c[0], &c[1], nullptr);
+    DMDAVecGetArrayRead(coarserDA, coarser, &array);
+    for (PetscInt j = s[1]; j < s[1] + c[1]; ++j)
+        for (PetscInt i = s[0]; i < s[0] + c[0]; ++i)
+        {
+            PetscReal xi = (first[0][2 * i] +
+                            first[0][std::min(2 * i + 1, (PetscInt)5)]) / 2.0,
+                      xj = (first[1][2 * j] +
+                            first[1][std::min(2 * j + 1, (PetscInt)3)]) / 2.0;
+            ASSERT_NEAR(linearField(xi, xj), array[j][i], 1.0e-12)
+                << "coarse point (" << i << ", " << j << ")";
+        }
+    DMDAVecRestoreArrayRead(coarserDA, coarser, &array);
+
+    PetscInt n[2];
+    DMDAGetInfo(coarserDA, nullptr, &n[0], &n[1], nullptr, nullptr, nullptr,
+                nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+                nullptr);
+    ASSERT_EQ(3, n[0]);
+    ASSERT_EQ(2, n[1]);
+
+    VecDestroy(&coarser);
+    DMDestroy(&coarserDA);
+    VecDestroy(&coarse);
+    DMDestroy(&coarseDA);
+    VecDestroy(&fine);
+    DMDestroy(&da);
+}
+
+// uneven partition along x, with odd numbers of points and odd starts: each
+// process owns the coarse points whose first fine point it owns
+TEST(coarsenDMDAVecTest, finePartition)
+{
+    DM da, coarseDA;
+    Vec fine, coarse;
+    PetscMPIInt size;
+    PetscInt s, c, cs, cc, nx = 0;
+
+    MPI_Comm_size(PETSC_COMM_WORLD, &size);
+    std::vector<PetscInt> lx(size);
+    for (PetscMPIInt p = 0; p < size; ++p)
+    {
+        lx[p] = 3 + p % 2;
+        nx += lx[p];
+    }
+
+    createLinearVec(nx, 5, da, fine, lx.data());
+    petibm::io::coarsenDMDAVec(fine, coarseDA, coarse);
+    ASSERT_TRUE(coarse != PETSC_NULL);
+    checkCoarseVec(nx, 5, coarseDA, coarse);
+
+    DMDAGetCorners(da, &s, nullptr, nullptr, &c, nullptr, nullptr);
+    DMDAGetCorners(coarseDA, &cs, nullptr, nullptr, &cc, nullptr, nullptr);
+    ASSERT_EQ((s + 1) / 2, cs);
+    ASSERT_EQ((s + c + 1) / 2 - (s + 1) / 2, cc);
+
+    VecDestroy(&coarse);
+    DMDestroy(&coarseDA);
+    VecDestroy(&fine);
+    DMDestroy(&da);
+}
+
+// a level is not created if a process would own no coarse point: with more
+// than one process, the second one owns the single fine point 1
+TEST(coarsenDMDAVecTest, notDistributable)
+{
+    DM da, coarseDA;
+    Vec fine, coarse;
+    PetscMPIInt size;
+    PetscInt nx = 0;
+
+    MPI_Comm_size(PETSC_COMM_WORLD, &size);
+    std::vector<PetscInt> lx(size, 2);
+    lx[0] = 1;
+    if (size > 1) lx[1] = 1;
+    for (PetscMPIInt p = 0; p < size; ++p) nx += lx[p];
+
+    createLinearVec(nx, 4, da, fine, lx.data());
+    petibm::io::coarsenDMDAVec(fine, coarseDA, coarse);
+    if (size > 1)
+    {
+        ASSERT_TRUE(coarse == PETSC_NULL);
+        ASSERT_TRUE(coarseDA == PETSC_NULL);
+    }
+    else
+    {
+        ASSERT_TRUE(coarse != PETSC_NULL);
+        checkCoarseVec(nx, 4, coarseDA, coarse);
+    }
+
+    VecDestroy(&coarse);
+    DMDestroy(&coarseDA);
+    VecDestroy(&fine);
+    DMDestroy(&da);
+}
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 
 #include "petibm/delta.h"
+#include "petibm/type.h"
 
 using namespace petibm::delta;
 
@@ -47,6 +48,24 @@ TEST(deltaRomaEtAlTest, decreasingInfluence)
         ASSERT_GT(Roma_et_al_1999(vals[i], h), Roma_et_al_1999(vals[i + 1], h));
 }
 
+// check the overload on raw pointers matches the one on std::vector objects
+TEST(deltaTest, rawPointers)
+{
+    DeltaKernel kernel = Roma_et_al_1999;
+    std::vector<PetscReal> widths{1.0, 0.5, 0.25};
+    std::vector<PetscReal> source{0.1, 0.2, 0.3}, target{0.5, 0.4, 0.2};
+
+    // rows of a contiguous 2D array are passed as raw pointers
+    petibm::type::RealArray2D coords(2, 3);
+    std::copy(source.begin(), source.end(), coords[0]);
+    std::copy(target.begin(), target.end(), coords[1]);
+    ASSERT_EQ(3u, coords.stride());
+    ASSERT_EQ(source, coords.row(0));
+
+    EXPECT_EQ(delta(source, target, widths, kernel),
+              delta(coords[0], coords[1], widths, kernel));
+}
+
 // Run all tests
 int main(int argc, char **argv)
 {
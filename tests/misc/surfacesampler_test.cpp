@@ -0,0 +1,188 @@
+/**
+ * \file surfacesampler_test.cpp
+ * \brief Unit-tests for the sampling points and normals of surface samplers.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/bodypack.h>
+#include <petibm/boundary.h>
+#include <petibm/mesh.h>
+#include <petibm/singlebody.h>
+#include <petibm/surfacesampler.h>
+
+using namespace petibm;
+
+// surface sampler giving access to its sampling points and normals
+class ExposedSurfaceSampler : public misc::SurfaceSampler
+{
+public:
+    using misc::SurfaceSampler::SurfaceSampler;
+    const type::RealVec2D &getPoints() const { return points; };
+    const type::RealVec2D &getNormals() const { return normals; };
+};
+
+// unit box with uniform cells, a body whose points are written in a file,
+// and a sampler of that body
+YAML::Node createConfig(const PetscInt &dim, const PetscInt &cells,
+                        const std::string &file,
+                        const std::vector<std::vector<PetscReal>> &points,
+                        const PetscReal &offset)
+{
+    using namespace YAML;
+    Node config;
+    std::vector<std::string> dirs = {"x", "y", "z"},
+                             locs = {"xMinus", "xPlus", "yMinus",
+                                     "yPlus",  "zMinus", "zPlus"},
+                             comps = {"u", "v", "w"};
+
+    config["mesh"].push_back(Node(NodeType::Map));
+    for (PetscInt i = 0; i < dim; ++i)
+    {
+        config["mesh"][i]["direction"] = dirs[i];
+        config["mesh"][i]["start"] = 0.0;
+        config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+        config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+        config["mesh"][i]["subDomains"][0]["cells"] = cells;
+        config["mesh"][i]["subDomains"][0]["stretchRatio"] = 1.0;
+    }
+
+    for (PetscInt i = 0; i < 2 * dim; ++i)
+    {
+        Node bcNode;
+        bcNode["location"] = locs[i];
+        for (PetscInt c = 0; c < dim; ++c)
+        {
+            bcNode[comps[c]].push_back("DIRICHLET");
+            bcNode[comps[c]].push_back(0.0);
+        }
+        config["flow"]["boundaryConditions"].push_back(bcNode);
+    }
+
+    PetscMPIInt rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    if (rank == 0)
+    {
+        std::ofstream out(file);
+        out.precision(16);
+        out << points.size() << "\n";
+        for (const auto &X : points)
+        {
+            for (PetscInt d = 0; d < dim; ++d) out << X[d] << " ";
+            out << "\n";
+        }
+    }
+    MPI_Barrier(PETSC_COMM_WORLD);
+
+    Node bodyNode;
+    bodyNode["name"] = "body";
+    bodyNode["file"] = file;
+    config["directory"] = ".";
+    config["bodies"].push_back(bodyNode);
+
+    config["surfaceSampling"][0]["body"] = "body";
+    config["surfaceSampling"][0]["path"] = file + ".h5";
+    config["surfaceSampling"][0]["offset"] = offset;
+
+    return config;
+}  // createConfig
+
+// check that the normals point radially outward from the center, and that
+// the sampling points are offset along them
+void checkRadialNormals(const PetscInt &dim, const PetscInt &cells,
+                        const std::string &file,
+                        const std::vector<std::vector<PetscReal>> &points,
+                        const PetscReal &offset)
+{
+    YAML::Node config = createConfig(dim, cells, file, points, offset);
+
+    type::Mesh mesh;
+    type::Boundary bc;
+    type::BodyPack bodies;
+    mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+    boundary::createBoundary(mesh, config, bc);
+    body::createBodyPack(PETSC_COMM_WORLD, dim, config, bodies);
+
+    ExposedSurfaceSampler sampler(PETSC_COMM_WORLD,
+                                  config["surfaceSampling"][0], mesh, bc,
+                                  bodies);
+
+    const type::SingleBody &body = bodies->bodies[0];
+    const type::RealVec2D &samples = sampler.getPoints(),
+                          &normals = sampler.getNormals();
+    ASSERT_EQ((std::size_t)body->nLclPts, normals.size());
+    for (PetscInt k = 0; k < body->nLclPts; ++k)
+    {
+        const PetscReal *X = body->coords[body->bgPt + k];
+        PetscReal radial[3] = {0.0, 0.0, 0.0}, r = 0.0, norm = 0.0, dot = 0.0;
+        for (PetscInt d = 0; d < dim; ++d)
+        {
+            radial[d] = X[d] - 0.5;
+            r += radial[d] * radial[d];
+            norm += normals[k][d] * normals[k][d];
+        }
+        r = std::sqrt(r);
+        for (PetscInt d = 0; d < dim; ++d)
+            dot += normals[k][d] * radial[d] / r;
+
+        EXPECT_NEAR(1.0, norm, 1.0e-12) << "point " << k;
+        EXPECT_GT(dot, 0.999) << "point " << k;
+        for (PetscInt d = 0; d < dim; ++d)
+            EXPECT_NEAR(X[d] + offset * normals[k][d], samples[k][d], 1.0e-12)
+                << "point " << k;
+    }
+}  // checkRadialNormals
+
+// circle of radius 0.25 centered in the unit square
+TEST(SurfaceSamplerTest, circleNormals)
+{
+    const PetscInt n = 200;
+    std::vector<std::vector<PetscReal>> points(n);
+    for (PetscInt i = 0; i < n; ++i)
+    {
+        PetscReal theta = 2.0 * PETSC_PI * i / n;
+        points[i] = {0.5 + 0.25 * std::cos(theta),
+                     0.5 + 0.25 * std::sin(theta)};
+    }
+    checkRadialNormals(2, 32, "samplercircle.txt", points, 0.05);
+}
+
+// sphere of radius 0.3 centered in the unit cube (points on a Fibonacci
+// lattice)
+TEST(SurfaceSamplerTest, sphereNormals)
+{
+    const PetscInt n = 800;
+    const PetscReal golden = PETSC_PI * (3.0 - std::sqrt(5.0));
+    std::vector<std::vector<PetscReal>> points(n);
+    for (PetscInt i = 0; i < n; ++i)
+    {
+        PetscReal z = 1.0 - (2.0 * i + 1.0) / n,
+                  rho = std::sqrt(1.0 - z * z), phi = golden * i;
+        points[i] = {0.5 + 0.3 * rho * std::cos(phi),
+                     0.5 + 0.3 * rho * std::sin(phi), 0.5 + 0.3 * z};
+    }
+    checkRadialNormals(3, 16, "samplersphere.txt", points, 0.05);
+}
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
@@ -0,0 +1,221 @@
+/**
+ * \file createcompactdelta_test.cpp
+ * \brief Unit-tests for the compact Delta operators against the assembled
+ *        ones.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/bodypack.h>
+#include <petibm/boundary.h>
+#include <petibm/delta.h>
+#include <petibm/mesh.h>
+#include <petibm/operators.h>
+
+using namespace petibm;
+
+// norm of the difference of two vectors, relative to the norm of the first
+PetscReal relativeDiff(const Vec &expected, const Vec &actual)
+{
+    Vec diff;
+    PetscReal norm, diffNorm;
+    VecDuplicate(expected, &diff);
+    VecWAXPY(diff, -1.0, actual, expected);
+    VecNorm(expected, NORM_2, &norm);
+    VecNorm(diff, NORM_2, &diffNorm);
+    VecDestroy(&diff);
+    return diffNorm / norm;
+}
+
+// unit square with 16x16 uniform cells, periodic in x; the boundaries in y
+// are either periodic or a symmetry plane (y = 0) and a wall (y = 1)
+YAML::Node createConfig(const bool &symmetry)
+{
+    using namespace YAML;
+    Node config;
+
+    config["mesh"].push_back(Node(NodeType::Map));
+    config["mesh"][0]["direction"] = "x";
+    config["mesh"][1]["direction"] = "y";
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+        config["mesh"][i]["start"] = 0.0;
+        config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+        config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+        config["mesh"][i]["subDomains"][0]["cells"] = 16;
+        config["mesh"][i]["subDomains"][0]["stretchRatio"] = 1.0;
+    }
+
+    config["flow"] = Node(NodeType::Map);
+    std::vector<std::string> locs = {"xMinus", "xPlus", "yMinus", "yPlus"};
+    std::vector<std::string> types = {"PERIODIC", "PERIODIC", "PERIODIC",
+                                      "PERIODIC"};
+    if (symmetry)
+    {
+        types[2] = "SYMMETRY";
+        types[3] = "DIRICHLET";
+    }
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        Node bcNode;
+        bcNode["location"] = locs[i];
+        bcNode["u"].push_back(types[i]);
+        bcNode["u"].push_back(0.0);
+        bcNode["v"].push_back(types[i]);
+        bcNode["v"].push_back(0.0);
+        config["flow"]["boundaryConditions"].push_back(bcNode);
+    }
+
+    // Lagrangian points whose kernels cross the boundaries (and one interior
+    // point)
+    PetscMPIInt rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    if (rank == 0)
+    {
+        std::ofstream file("compactbody2d.txt");
+        file << "5\n"
+             << "0.01 0.5\n"
+             << "0.52 0.015\n"
+             << "0.985 0.99\n"
+             << "0.003 0.04\n"
+             << "0.5 0.5\n";
+    }
+    MPI_Barrier(PETSC_COMM_WORLD);
+    Node bodyNode;
+    bodyNode["file"] = "compactbody2d.txt";
+    config["directory"] = ".";
+    config["bodies"].push_back(bodyNode);
+
+    return config;
+}  // createConfig
+
+// compare the compact operators (Delta, its transpose, and the product with
+// a diagonal scaling) to the assembled ones
+void compareOperators(const bool &symmetry)
+{
+    YAML::Node config = createConfig(symmetry);
+
+    type::Mesh mesh;
+    type::Boundary bc;
+    type::BodyPack bodies;
+    delta::DeltaKernel kernel;
+    PetscInt kernelSize;
+
+    mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+    boundary::createBoundary(mesh, config, bc);
+    body::createBodyPack(PETSC_COMM_WORLD, 2, config, bodies);
+    bodies->updateMeshIdx(mesh);
+    delta::getKernel("ROMA_ET_AL_1999", kernel, kernelSize);
+
+    // assembled operators: E, H = E^T, and E D H with a diagonal D
+    Mat E, H, DH, EDH;
+    Vec D;
+    operators::createDelta(mesh, bc, bodies, kernel, kernelSize, E);
+    MatTranspose(E, MAT_INITIAL_MATRIX, &H);
+    MatCreateVecs(E, &D, nullptr);
+    {
+        PetscInt begin, end;
+        VecGetOwnershipRange(D, &begin, &end);
+        for (PetscInt i = begin; i < end; ++i)
+            VecSetValue(D, i, 1.0 + 0.001 * i, INSERT_VALUES);
+        VecAssemblyBegin(D);
+        VecAssemblyEnd(D);
+    }
+    MatDuplicate(H, MAT_COPY_VALUES, &DH);
+    MatDiagonalScale(DH, D, nullptr);
+    MatMatMult(E, DH, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &EDH);
+
+    // compact operators
+    Mat cE, cDH, cEDH;
+    operators::createCompactDelta(mesh, bc, bodies, kernel, kernelSize, cE);
+    operators::createCompactDeltaTranspose(cE, cDH);
+    MatDiagonalScale(cDH, D, nullptr);
+    operators::createCompactDeltaProduct(cE, cDH, cEDH);
+
+    // random velocity and force vectors
+    Vec U, F, expectedF, actualF, expectedU, actualU;
+    PetscRandom rand;
+    PetscRandomCreate(PETSC_COMM_WORLD, &rand);
+    PetscRandomSetFromOptions(rand);
+    MatCreateVecs(E, &U, &F);
+    VecSetRandom(U, rand);
+    VecSetRandom(F, rand);
+    PetscRandomDestroy(&rand);
+    VecDuplicate(F, &expectedF);
+    VecDuplicate(F, &actualF);
+    VecDuplicate(U, &expectedU);
+    VecDuplicate(U, &actualU);
+
+    // MatMult
+    MatMult(E, U, expectedF);
+    MatMult(cE, U, actualF);
+    EXPECT_LE(relativeDiff(expectedF, actualF), 1.0e-12) << "MatMult";
+
+    // MatMultTranspose
+    MatMultTranspose(E, F, expectedU);
+    MatMultTranspose(cE, F, actualU);
+    EXPECT_LE(relativeDiff(expectedU, actualU), 1.0e-12)
+        << "MatMultTranspose";
+
+    // MatMult of the scaled transpose
+    MatMult(DH, F, expectedU);
+    MatMult(cDH, F, actualU);
+    EXPECT_LE(relativeDiff(expectedU, actualU), 1.0e-12)
+        << "MatMult (scaled transpose)";
+
+    // MatMult of the product
+    MatMult(EDH, F, expectedF);
+    MatMult(cEDH, F, actualF);
+    EXPECT_LE(relativeDiff(expectedF, actualF), 1.0e-12)
+        << "MatMult (product)";
+
+    // MatGetDiagonal of the product (used by Jacobi preconditioners)
+    MatGetDiagonal(EDH, expectedF);
+    MatGetDiagonal(cEDH, actualF);
+    EXPECT_LE(relativeDiff(expectedF, actualF), 1.0e-12)
+        << "MatGetDiagonal (product)";
+
+    VecDestroy(&actualU);
+    VecDestroy(&expectedU);
+    VecDestroy(&actualF);
+    VecDestroy(&expectedF);
+    VecDestroy(&F);
+    VecDestroy(&U);
+    MatDestroy(&cEDH);
+    MatDestroy(&cDH);
+    MatDestroy(&cE);
+    VecDestroy(&D);
+    MatDestroy(&EDH);
+    MatDestroy(&DH);
+    MatDestroy(&H);
+    MatDestroy(&E);
+}  // compareOperators
+
+// periodic boundaries in both directions
+TEST(CreateCompactDeltaTest, periodic2D) { compareOperators(false); }
+
+// periodic boundaries in x and a symmetry plane at y = 0, where a velocity
+// point and its mirror image both belong to the support of a kernel
+TEST(CreateCompactDeltaTest, symmetry2D) { compareOperators(true); }
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
@@ -0,0 +1,206 @@
+/**
+ * \file createconvectionhalo_test.cpp
+ * \brief Unit-tests for the narrow halo of the convective operator.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/mesh.h>
+#include <petibm/operators.h>
+
+using namespace petibm;
+
+// value of the local vectors that the halo does not write
+const PetscReal untouched = -1.0e+30;
+
+// box with the given numbers of cells, periodic in the given directions
+YAML::Node createConfig(const std::vector<PetscInt> &cells,
+                        const std::vector<bool> &periodic)
+{
+    using namespace YAML;
+    Node config;
+    std::vector<std::string> dirs = {"x", "y", "z"},
+                             locs = {"xMinus", "xPlus", "yMinus",
+                                     "yPlus",  "zMinus", "zPlus"},
+                             comps = {"u", "v", "w"};
+    const unsigned int dim = cells.size();
+
+    config["mesh"].push_back(Node(NodeType::Map));
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+        config["mesh"][i]["direction"] = dirs[i];
+        config["mesh"][i]["start"] = 0.0;
+        config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+        config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+        config["mesh"][i]["subDomains"][0]["cells"] = cells[i];
+        config["mesh"][i]["subDomains"][0]["stretchRatio"] = 1.0;
+    }
+
+    for (unsigned int i = 0; i < 2 * dim; ++i)
+    {
+        Node bcNode;
+        bcNode["location"] = locs[i];
+        for (unsigned int c = 0; c < dim; ++c)
+        {
+            bcNode[comps[c]].push_back(periodic[i / 2] ? "PERIODIC"
+                                                       : "DIRICHLET");
+            bcNode[comps[c]].push_back(0.0);
+        }
+        config["flow"]["boundaryConditions"].push_back(bcNode);
+    }
+
+    return config;
+}  // createConfig
+
+// offsets of the points of the field g read by the convective kernel of the
+// field f: the face neighbors of its own field, and the corners of the face
+// normal to the direction g in the plane (f, g) for another field
+std::vector<std::array<PetscInt, 3>> readOffsets(const PetscInt &dim,
+                                                 const PetscInt &f,
+                                                 const PetscInt &g)
+{
+    std::vector<std::array<PetscInt, 3>> offsets(1, {{0, 0, 0}});
+    if (f == g)
+    {
+        for (PetscInt d = 0; d < dim; ++d)
+            for (PetscInt s = -1; s <= 1; s += 2)
+            {
+                offsets.push_back({{0, 0, 0}});
+                offsets.back()[d] = s;
+            }
+        return offsets;
+    }
+    offsets.resize(4, {{0, 0, 0}});
+    offsets[1][f] = 1;
+    offsets[2][g] = -1;
+    offsets[3][f] = 1;
+    offsets[3][g] = -1;
+    return offsets;
+}  // readOffsets
+
+// compare the local vectors filled by the halo of the convective operator to
+// the ones filled by the box-stencil halo of the DMDAs
+void compareHalos(const std::vector<PetscInt> &cells,
+                  const std::vector<bool> &periodic)
+{
+    type::Mesh mesh;
+    mesh::createMesh(PETSC_COMM_WORLD, createConfig(cells, periodic), mesh);
+    const PetscInt dim = mesh->dim;
+
+    // random velocity field
+    Vec global;
+    PetscRandom rand;
+    DMCreateGlobalVector(mesh->UPack, &global);
+    PetscRandomCreate(PETSC_COMM_WORLD, &rand);
+    PetscRandomSetFromOptions(rand);
+    VecSetRandom(global, rand);
+    PetscRandomDestroy(&rand);
+
+    // reference: full box halo of the DMDAs
+    std::vector<Vec> boxLocal(dim);
+    for (PetscInt g = 0; g < dim; ++g)
+        DMGetLocalVector(mesh->da[g], &boxLocal[g]);
+    DMCompositeScatterArray(mesh->UPack, global, boxLocal.data());
+
+    std::vector<VecScatter> halo;
+    operators::createConvectionHalo(mesh, halo);
+    ASSERT_EQ((std::size_t)dim, halo.size());
+
+    for (PetscInt g = 0; g < dim; ++g)
+    {
+        Vec local;
+        DMGetLocalVector(mesh->da[g], &local);
+        VecSet(local, untouched);
+        VecScatterBegin(halo[g], global, local, INSERT_VALUES,
+                        SCATTER_FORWARD);
+        VecScatterEnd(halo[g], global, local, INSERT_VALUES, SCATTER_FORWARD);
+
+        PetscInt gs[3] = {0, 0, 0}, gm[3] = {1, 1, 1};
+        DMDAGetGhostCorners(mesh->da[g], &gs[0], &gs[1], &gs[2], &gm[0],
+                            &gm[1], &gm[2]);
+        const PetscReal *narrow, *box;
+        VecGetArrayRead(local, &narrow);
+        VecGetArrayRead(boxLocal[g], &box);
+
+        // every value written by the halo is the value of the box halo
+        PetscInt n;
+        VecGetLocalSize(local, &n);
+        for (PetscInt c = 0; c < n; ++c)
+            if (narrow[c] != untouched)
+                ASSERT_EQ(box[c], narrow[c])
+                    << "field " << g << ", local point " << c;
+
+        // every point read by the kernels inside the domain is written
+        for (PetscInt f = 0; f < dim; ++f)
+            for (const auto &o : readOffsets(dim, f, g))
+                for (PetscInt k = mesh->bg[f][2]; k < mesh->ed[f][2]; ++k)
+                    for (PetscInt j = mesh->bg[f][1]; j < mesh->ed[f][1]; ++j)
+                        for (PetscInt i = mesh->bg[f][0]; i < mesh->ed[f][0];
+                             ++i)
+                        {
+                            PetscInt p[3] = {i + o[0], j + o[1], k + o[2]};
+                            bool inside = true;
+                            for (PetscInt d = 0; d < 3; ++d)
+                            {
+                                if ((p[d] < gs[d]) || (p[d] >= gs[d] + gm[d]))
+                                    inside = false;
+                                if ((d < dim) && !mesh->periodic[d][d] &&
+                                    ((p[d] < 0) || (p[d] >= mesh->n[g][d])))
+                                    inside = false;
+                            }
+                            if (!inside) continue;
+
+                            PetscInt c = ((p[2] - gs[2]) * gm[1] +
+                                          (p[1] - gs[1])) * gm[0] +
+                                         p[0] - gs[0];
+                            ASSERT_NE(untouched, narrow[c])
+                                << "field " << g << " read by field " << f
+                                << " at (" << p[0] << ", " << p[1] << ", "
+                                << p[2] << ")";
+                        }
+
+        VecRestoreArrayRead(boxLocal[g], &box);
+        VecRestoreArrayRead(local, &narrow);
+        DMRestoreLocalVector(mesh->da[g], &local);
+    }
+
+    for (auto &scatter : halo) VecScatterDestroy(&scatter);
+    for (PetscInt g = 0; g < dim; ++g)
+        DMRestoreLocalVector(mesh->da[g], &boxLocal[g]);
+    VecDestroy(&global);
+}  // compareHalos
+
+// 2D, periodic in y (run on several processes to exchange values between
+// them)
+TEST(CreateConvectionHaloTest, halo2D)
+{
+    compareHalos({12, 10}, {false, true});
+}
+
+// 3D, periodic in x and z
+TEST(CreateConvectionHaloTest, halo3D)
+{
+    compareHalos({8, 6, 6}, {true, false, true});
+}
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
@@ -0,0 +1,169 @@
+/**
+ * \file createdelta_test.cpp
+ * \brief Unit-tests for the function `petibm::operators::createDelta` next to
+ *        a symmetry plane.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/bodypack.h>
+#include <petibm/boundary.h>
+#include <petibm/delta.h>
+#include <petibm/mesh.h>
+#include <petibm/operators.h>
+
+using namespace petibm;
+
+class CreateDeltaTest : public ::testing::Test
+{
+protected:
+    CreateDeltaTest(){};
+
+    virtual ~CreateDeltaTest(){};
+
+    virtual void SetUp()
+    {
+        using namespace YAML;
+        Node config;
+
+        // unit square with 20x20 uniform cells
+        config["mesh"].push_back(Node(NodeType::Map));
+        config["mesh"][0]["direction"] = "x";
+        config["mesh"][1]["direction"] = "y";
+        for (unsigned int i = 0; i < 2; ++i)
+        {
+            config["mesh"][i]["start"] = 0.0;
+            config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+            config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+            config["mesh"][i]["subDomains"][0]["cells"] = 20;
+            config["mesh"][i]["subDomains"][0]["stretchRatio"] = 1.0;
+        }
+
+        // symmetry plane at y = 0
+        config["flow"] = Node(NodeType::Map);
+        std::vector<std::string> locs = {"xMinus", "xPlus", "yMinus",
+                                         "yPlus"};
+        for (unsigned int i = 0; i < 4; ++i)
+        {
+            Node bcNode;
+            std::string type = (i == 2) ? "SYMMETRY" : "DIRICHLET";
+            bcNode["location"] = locs[i];
+            bcNode["u"].push_back(type);
+            bcNode["u"].push_back(0.0);
+            bcNode["v"].push_back(type);
+            bcNode["v"].push_back(0.0);
+            config["flow"]["boundaryConditions"].push_back(bcNode);
+        }
+
+        // one Lagrangian point closer to the plane than the kernel support
+        PetscMPIInt rank;
+        MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+        if (rank == 0)
+        {
+            std::ofstream file("symmetrybody2d.txt");
+            file << "1\n" << X[0] << " " << X[1] << "\n";
+        }
+        MPI_Barrier(PETSC_COMM_WORLD);
+        Node bodyNode;
+        bodyNode["file"] = "symmetrybody2d.txt";
+        config["directory"] = ".";
+        config["bodies"].push_back(bodyNode);
+
+        mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+        boundary::createBoundary(mesh, config, bc);
+        body::createBodyPack(PETSC_COMM_WORLD, 2, config, bodies);
+        bodies->updateMeshIdx(mesh);
+        delta::getKernel("ROMA_ET_AL_1999", kernel, kernelSize);
+        operators::createDelta(mesh, bc, bodies, kernel, kernelSize, E);
+    };
+
+    virtual void TearDown() { MatDestroy(&E); };
+
+    const PetscReal X[2] = {0.51, 0.01};
+    type::Mesh mesh;
+    type::Boundary bc;
+    type::BodyPack bodies;
+    delta::DeltaKernel kernel;
+    PetscInt kernelSize;
+    Mat E;
+
+};  // CreateDeltaTest
+
+// the rows of the point next to the plane hold the contributions of the
+// grid points and of their mirror images (with a flipped normal velocity)
+TEST_F(CreateDeltaTest, mirroredImages2D)
+{
+    if (bodies->nLclPts == 0) return;
+
+    std::vector<PetscReal> widths(2, 0.05);
+    for (PetscInt dof = 0; dof < 2; ++dof)
+    {
+        PetscInt row;
+        bodies->getPackedGlobalIndex(0, 0, dof, row);
+        PetscReal sign = (dof == 1) ? -1.0 : 1.0;
+        for (PetscInt j = 0; j < mesh->n[dof][1]; ++j)
+        {
+            for (PetscInt i = 0; i < mesh->n[dof][0]; ++i)
+            {
+                PetscReal x[2] = {mesh->coord[dof][0][i],
+                                  mesh->coord[dof][1][j]};
+                PetscReal xImage[2] = {x[0], -x[1]};
+                PetscReal expected =
+                    delta::delta(X, x, widths, kernel) +
+                    sign * delta::delta(X, xImage, widths, kernel);
+
+                PetscInt col;
+                PetscReal value;
+                mesh->getPackedGlobalIndex(dof, i, j, 0, col);
+                MatGetValues(E, 1, &row, 1, &col, &value);
+                ASSERT_NEAR(expected, value, 1.0e-12)
+                    << "field " << dof << ", point (" << i << ", " << j
+                    << ")";
+            }
+        }
+    }
+}
+
+// a uniform tangential velocity is interpolated exactly: with the mirror
+// images, the stencil next to the plane is a complete one
+TEST_F(CreateDeltaTest, uniformTangential2D)
+{
+    Vec U, UB;
+    MatCreateVecs(E, &U, &UB);
+    VecSet(U, 1.0);
+    MatMult(E, U, UB);
+
+    if (bodies->nLclPts > 0)
+    {
+        const PetscReal *ub;
+        VecGetArrayRead(UB, &ub);
+        // the weights of a complete stencil sum up to 1/h^2
+        ASSERT_NEAR(1.0 / (0.05 * 0.05), ub[0], 1.0e-10);
+        VecRestoreArrayRead(UB, &ub);
+    }
+
+    VecDestroy(&UB);
+    VecDestroy(&U);
+}
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
@@ -0,0 +1,156 @@
+/**
+ * \file createlaplacian_test.cpp
+ * \brief Unit-tests for the Laplacian operators restricted to some
+ *        directions.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/boundary.h>
+#include <petibm/mesh.h>
+#include <petibm/operators.h>
+#include <petibm/solution.h>
+
+using namespace petibm;
+
+// norm of the difference of two vectors, relative to the norm of the first
+PetscReal relativeDiff(const Vec &expected, const Vec &actual)
+{
+    Vec diff;
+    PetscReal norm, diffNorm;
+    VecDuplicate(expected, &diff);
+    VecWAXPY(diff, -1.0, actual, expected);
+    VecNorm(expected, NORM_2, &norm);
+    VecNorm(diff, NORM_2, &diffNorm);
+    VecDestroy(&diff);
+    return diffNorm / norm;
+}
+
+// stretched box, periodic in x, with non-zero Dirichlet conditions on the
+// other boundaries
+YAML::Node createConfig(const PetscInt &dim)
+{
+    using namespace YAML;
+    Node config;
+    std::vector<std::string> dirs = {"x", "y", "z"},
+                             locs = {"xMinus", "xPlus", "yMinus",
+                                     "yPlus",  "zMinus", "zPlus"},
+                             comps = {"u", "v", "w"};
+
+    config["mesh"].push_back(Node(NodeType::Map));
+    for (PetscInt i = 0; i < dim; ++i)
+    {
+        config["mesh"][i]["direction"] = dirs[i];
+        config["mesh"][i]["start"] = 0.0;
+        config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+        config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+        config["mesh"][i]["subDomains"][0]["cells"] = 12 - 2 * i;
+        config["mesh"][i]["subDomains"][0]["stretchRatio"] =
+            (i == 0) ? 1.0 : 1.05;
+    }
+
+    for (PetscInt i = 0; i < 2 * dim; ++i)
+    {
+        Node bcNode;
+        bcNode["location"] = locs[i];
+        for (PetscInt c = 0; c < dim; ++c)
+        {
+            bcNode[comps[c]].push_back((i < 2) ? "PERIODIC" : "DIRICHLET");
+            bcNode[comps[c]].push_back((i < 2) ? 0.0 : 1.0 + i + 0.5 * c);
+        }
+        config["flow"]["boundaryConditions"].push_back(bcNode);
+    }
+
+    return config;
+}  // createConfig
+
+// check that the operators restricted to complementary lists of directions
+// sum to the full Laplacian and boundary correction
+void checkSplit(const PetscInt &dim, const type::IntVec1D &dirs)
+{
+    YAML::Node config = createConfig(dim);
+
+    type::Mesh mesh;
+    type::Boundary bc;
+    type::Solution solution;
+    mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+    boundary::createBoundary(mesh, config, bc);
+    solution::createSolution(mesh, solution);
+
+    // random velocity field, and the corresponding ghost-point equations
+    PetscRandom rand;
+    PetscRandomCreate(PETSC_COMM_WORLD, &rand);
+    PetscRandomSetFromOptions(rand);
+    VecSetRandom(solution->UGlobal, rand);
+    PetscRandomDestroy(&rand);
+    bc->setGhostICs(solution);
+
+    type::IntVec1D others;
+    for (PetscInt d = 0; d < dim; ++d)
+        if (std::find(dirs.begin(), dirs.end(), d) == dirs.end())
+            others.push_back(d);
+
+    Mat L, LCorrection, LA, LCorrectionA, LB, LCorrectionB;
+    operators::createLaplacian(mesh, bc, L, LCorrection);
+    operators::createLaplacian(mesh, bc, LA, LCorrectionA, dirs);
+    operators::createLaplacian(mesh, bc, LB, LCorrectionB, others);
+
+    Vec expected, actual, tmp;
+    VecDuplicate(solution->UGlobal, &expected);
+    VecDuplicate(solution->UGlobal, &actual);
+    VecDuplicate(solution->UGlobal, &tmp);
+
+    MatMult(L, solution->UGlobal, expected);
+    MatMult(LA, solution->UGlobal, actual);
+    MatMult(LB, solution->UGlobal, tmp);
+    VecAXPY(actual, 1.0, tmp);
+    EXPECT_LE(relativeDiff(expected, actual), 1.0e-12) << "L";
+
+    MatMult(LCorrection, solution->UGlobal, expected);
+    MatMult(LCorrectionA, solution->UGlobal, actual);
+    MatMult(LCorrectionB, solution->UGlobal, tmp);
+    VecAXPY(actual, 1.0, tmp);
+    EXPECT_LE(relativeDiff(expected, actual), 1.0e-12) << "LCorrection";
+
+    VecDestroy(&tmp);
+    VecDestroy(&actual);
+    VecDestroy(&expected);
+    MatDestroy(&LCorrectionB);
+    MatDestroy(&LB);
+    MatDestroy(&LCorrectionA);
+    MatDestroy(&LA);
+    MatDestroy(&LCorrection);
+    MatDestroy(&L);
+}  // checkSplit
+
+// 2D: implicit in the stretched direction only
+TEST(CreateLaplacianTest, split2D) { checkSplit(2, {1}); }
+
+// 3D: one implicit direction, then two
+TEST(CreateLaplacianTest, split3D)
+{
+    checkSplit(3, {1});
+    checkSplit(3, {0, 2});
+}
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main
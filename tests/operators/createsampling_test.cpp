@@ -0,0 +1,222 @@
+/**
+ * \file createsampling_test.cpp
+ * \brief Unit-tests for the operators sampling the pressure and the gradient
+ *        of the velocity at arbitrary points.
+ * \copyright Copyright (c) 2016-2018, Barba group. All rights reserved.
+ * \license BSD 3-Clause License.
+ */
+
+#include <string>
+#include <vector>
+
+#include <petsc.h>
+
+#include <gtest/gtest.h>
+#include <yaml-cpp/yaml.h>
+
+#include <petibm/boundary.h>
+#include <petibm/delta.h>
+#include <petibm/mesh.h>
+#include <petibm/operators.h>
+
+using namespace petibm;
+
+// unit box with 16 uniform cells per direction and the given types of
+// boundary conditions (xMinus, xPlus, yMinus, ...)
+YAML::Node createConfig(const std::vector<std::string> &types)
+{
+    using namespace YAML;
+    Node config;
+    std::vector<std::string> dirs = {"x", "y", "z"},
+                             locs = {"xMinus", "xPlus", "yMinus",
+                                     "yPlus",  "zMinus", "zPlus"},
+                             comps = {"u", "v", "w"};
+    const unsigned int dim = types.size() / 2;
+
+    config["mesh"].push_back(Node(NodeType::Map));
+    for (unsigned int i = 0; i < dim; ++i)
+    {
+        config["mesh"][i]["direction"] = dirs[i];
+        config["mesh"][i]["start"] = 0.0;
+        config["mesh"][i]["subDomains"].push_back(Node(NodeType::Map));
+        config["mesh"][i]["subDomains"][0]["end"] = 1.0;
+        config["mesh"][i]["subDomains"][0]["cells"] = 16;
+        config["mesh"][i]["subDomains"][0]["stretchRatio"] = 1.0;
+    }
+
+    for (unsigned int i = 0; i < 2 * dim; ++i)
+    {
+        Node bcNode;
+        bcNode["location"] = locs[i];
+        for (unsigned int c = 0; c < dim; ++c)
+        {
+            bcNode[comps[c]].push_back(types[i]);
+            bcNode[comps[c]].push_back(0.0);
+        }
+        config["flow"]["boundaryConditions"].push_back(bcNode);
+    }
+
+    return config;
+}  // createConfig
+
+// linear field: value at X of the component c (pressure for c = 3)
+typedef std::vector<std::vector<PetscReal>> Coefficients;
+PetscReal linearField(const Coefficients &a, const PetscInt &c,
+                      const PetscReal *X, const PetscInt &dim)
+{
+    PetscReal value = a[c][0];
+    for (PetscInt d = 0; d < dim; ++d) value += a[c][d + 1] * X[d];
+    return value;
+}
+
+// velocity vector holding a linear field at the velocity points
+void createVelocity(const type::Mesh &mesh, const Coefficients &a, Vec &U)
+{
+    DMCreateGlobalVector(mesh->UPack, &U);
+    for (PetscInt f = 0; f < mesh->dim; ++f)
+        for (PetscInt k = mesh->bg[f][2]; k < mesh->ed[f][2]; ++k)
+            for (PetscInt j = mesh->bg[f][1]; j < mesh->ed[f][1]; ++j)
+                for (PetscInt i = mesh->bg[f][0]; i < mesh->ed[f][0]; ++i)
+                {
+                    PetscInt ijk[3] = {i, j, k}, idx;
+                    PetscReal X[3] = {0.0, 0.0, 0.0};
+                    for (PetscInt d = 0; d < mesh->dim; ++d)
+                        X[d] = mesh->coord[f][d][ijk[d]];
+                    mesh->getPackedGlobalIndex(f, i, j, k, idx);
+                    VecSetValue(U, idx, linearField(a, f, X, mesh->dim),
+                                INSERT_VALUES);
+                }
+    VecAssemblyBegin(U);
+    VecAssemblyEnd(U);
+}  // createVelocity
+
+// the first process owns all the sampling points
+type::RealVec2D getLocalPoints(const type::RealVec2D &points)
+{
+    PetscMPIInt rank;
+    MPI_Comm_rank(PETSC_COMM_WORLD, &rank);
+    return (rank == 0) ? points : type::RealVec2D();
+}
+
+// check the sampled gradient of a linear velocity field
+void checkGradient(const std::vector<std::string> &types,
+                   const Coefficients &a, const type::RealVec2D &points)
+{
+    YAML::Node config = createConfig(types);
+
+    type::Mesh mesh;
+    type::Boundary bc;
+    delta::DeltaKernel kernel;
+    PetscInt kernelSize;
+    mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+    boundary::createBoundary(mesh, config, bc);
+    delta::getKernel("ROMA_ET_AL_1999", kernel, kernelSize);
+
+    const PetscInt dim = mesh->dim;
+    type::RealVec2D local = getLocalPoints(points);
+
+    Mat GU;
+    Vec U, grad;
+    operators::createVelocityGradientSampling(mesh, bc, local, kernel,
+                                              kernelSize, GU);
+    createVelocity(mesh, a, U);
+    MatCreateVecs(GU, nullptr, &grad);
+    MatMult(GU, U, grad);
+
+    const PetscReal *g;
+    VecGetArrayRead(grad, &g);
+    for (std::size_t k = 0; k < local.size(); ++k)
+        for (PetscInt i = 0; i < dim; ++i)
+            for (PetscInt j = 0; j < dim; ++j)
+                EXPECT_NEAR(a[i][j + 1], g[(k * dim + i) * dim + j], 1.0e-10)
+                    << "d u_" << i << " / d x_" << j << " at point " << k;
+    VecRestoreArrayRead(grad, &g);
+
+    VecDestroy(&grad);
+    VecDestroy(&U);
+    MatDestroy(&GU);
+}  // checkGradient
+
+// a linear pressure is reproduced away from the walls
+TEST(CreateSamplingTest, linearPressure)
+{
+    YAML::Node config = createConfig(
+        {"DIRICHLET", "DIRICHLET", "DIRICHLET", "DIRICHLET"});
+
+    type::Mesh mesh;
+    type::Boundary bc;
+    delta::DeltaKernel kernel;
+    PetscInt kernelSize;
+    mesh::createMesh(PETSC_COMM_WORLD, config, mesh);
+    boundary::createBoundary(mesh, config, bc);
+    delta::getKernel("ROMA_ET_AL_1999", kernel, kernelSize);
+
+    const Coefficients a = {{}, {}, {}, {1.0, 2.0, -3.0}};
+    type::RealVec2D local = getLocalPoints(
+        {{0.31, 0.47}, {0.5, 0.5}, {0.62, 0.27}, {0.8, 0.8}});
+
+    Mat P;
+    Vec p, sampled;
+    operators::createPressureSampling(mesh, bc, local, kernel, kernelSize, P);
+    DMCreateGlobalVector(mesh->da[3], &p);
+    for (PetscInt j = mesh->bg[3][1]; j < mesh->ed[3][1]; ++j)
+        for (PetscInt i = mesh->bg[3][0]; i < mesh->ed[3][0]; ++i)
+        {
+            PetscInt idx;
+            PetscReal X[2] = {mesh->coord[3][0][i], mesh->coord[3][1][j]};
+            mesh->getGlobalIndex(3, i, j, 0, idx);
+            VecSetValue(p, idx, linearField(a, 3, X, 2), INSERT_VALUES);
+        }
+    VecAssemblyBegin(p);
+    VecAssemblyEnd(p);
+    MatCreateVecs(P, nullptr, &sampled);
+    MatMult(P, p, sampled);
+
+    const PetscReal *values;
+    VecGetArrayRead(sampled, &values);
+    for (std::size_t k = 0; k < local.size(); ++k)
+        EXPECT_NEAR(linearField(a, 3, local[k].data(), 2), values[k],
+                    1.0e-12) << "point " << k;
+    VecRestoreArrayRead(sampled, &values);
+
+    VecDestroy(&sampled);
+    VecDestroy(&p);
+    MatDestroy(&P);
+}
+
+// exact gradient of a linear velocity away from the walls
+TEST(CreateSamplingTest, gradientInterior)
+{
+    checkGradient({"DIRICHLET", "DIRICHLET", "DIRICHLET", "DIRICHLET"},
+                  {{1.0, 2.0, -3.0}, {-1.0, 0.5, 4.0}},
+                  {{0.31, 0.47}, {0.5, 0.5}, {0.62, 0.27}, {0.7, 0.66}});
+}
+
+// exact gradient of a linear velocity next to a periodic boundary (x) and to
+// a symmetry plane (y = 0), where the tangential components are even and the
+// normal component is odd
+TEST(CreateSamplingTest, gradientPeriodicSymmetry)
+{
+    checkGradient({"PERIODIC", "PERIODIC", "SYMMETRY", "DIRICHLET",
+                   "DIRICHLET", "DIRICHLET"},
+                  {{1.0, 0.0, 0.0, 2.0},
+                   {0.0, 0.0, -3.0, 0.0},
+                   {-1.0, 0.0, 0.0, 0.5}},
+                  {{0.02, 0.03, 0.5},
+                   {0.98, 0.05, 0.45},
+                   {0.5, 0.01, 0.55},
+                   {0.001, 0.5, 0.4}});
+}
+
+// Run all tests
+int main(int argc, char **argv)
+{
+    PetscErrorCode ierr, status;
+
+    ::testing::InitGoogleTest(&argc, argv);
+    ierr = PetscInitialize(&argc, &argv, nullptr, nullptr); CHKERRQ(ierr);
+    status = RUN_ALL_TESTS();
+    ierr = PetscFinalize(); CHKERRQ(ierr);
+
+    return status;
+}  // main